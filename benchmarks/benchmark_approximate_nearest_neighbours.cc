@@ -0,0 +1,176 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It compares the approximate nearest neighbour search of a random
+  projection forest to the exact search of the brute-force backend. For
+  different numbers of trees and refinement iterations, the benchmark
+  reports the time for building the forest, the time for the search,
+  and the recall, i.e. the fraction of the true nearest neighbours that
+  have been found.
+
+  The point clouds are sampled from a low-dimensional subspace with some
+  additional noise, which mimics high-dimensional data such as patches
+  of images.
+
+  Usage: benchmark_approximate_nearest_neighbours [POINTS] [K]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/RandomProjectionForest.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+
+using T             = double;
+using Points        = PointCloud<T>;
+using Distance      = distances::Euclidean<T>;
+using Neighbours    = NeighbourList<std::size_t, T>;
+
+Points makePointCloud( std::size_t n, std::size_t dimension, std::size_t intrinsicDimension, std::mt19937& rng )
+{
+  std::normal_distribution<T> distribution( T(0), T(1) );
+
+  std::vector<T> basis( intrinsicDimension * dimension );
+  for( auto&& x : basis )
+    x = distribution( rng );
+
+  Points pointCloud( n, dimension );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<T> c( intrinsicDimension );
+    for( auto&& x : c )
+      x = distribution( rng );
+
+    std::vector<T> p( dimension );
+
+    for( std::size_t j = 0; j < dimension; j++ )
+    {
+      p[j] = T(0.1) * distribution( rng );
+
+      for( std::size_t l = 0; l < intrinsicDimension; l++ )
+        p[j] += c[l] * basis[l * dimension + j];
+    }
+
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  return pointCloud;
+}
+
+double recall( const Neighbours& expected, const Neighbours& actual )
+{
+  std::size_t hits = 0;
+
+  for( std::size_t i = 0; i < expected.size(); i++ )
+  {
+    std::vector<std::size_t> u( expected.indices.begin() + static_cast<std::ptrdiff_t>( expected.offsets[i] ),
+                                expected.indices.begin() + static_cast<std::ptrdiff_t>( expected.offsets[i+1] ) );
+
+    std::vector<std::size_t> v( actual.indices.begin() + static_cast<std::ptrdiff_t>( actual.offsets[i] ),
+                                actual.indices.begin() + static_cast<std::ptrdiff_t>( actual.offsets[i+1] ) );
+
+    std::vector<std::size_t> w;
+
+    std::sort( u.begin(), u.end() );
+    std::sort( v.begin(), v.end() );
+    std::set_intersection( u.begin(), u.end(), v.begin(), v.end(), std::back_inserter( w ) );
+
+    hits += w.size();
+  }
+
+  return expected.indices.empty() ? 1.0 : static_cast<double>( hits ) / static_cast<double>( expected.indices.size() );
+}
+
+void print( std::size_t dimension, const std::string& name, unsigned trees, unsigned iterations, double buildTime, double searchTime, double recall )
+{
+  std::cout << std::left
+            << std::setw(8)  << dimension
+            << std::setw(12) << name
+            << std::right
+            << std::setw(8)  << trees
+            << std::setw(12) << iterations
+            << std::fixed << std::setprecision(2)
+            << std::setw(12) << buildTime
+            << std::setw(12) << searchTime
+            << std::setprecision(4)
+            << std::setw(12) << recall
+            << "\n";
+}
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 10000;
+  unsigned k    = 10;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  if( argc >= 3 )
+    k = static_cast<unsigned>( std::stoul( argv[2] ) );
+
+  std::cout << "Points: " << n << ", k: " << k << "\n\n";
+
+  std::cout << std::left
+            << std::setw(8)  << "Dim"
+            << std::setw(12) << "Backend"
+            << std::right
+            << std::setw(8)  << "Trees"
+            << std::setw(12) << "Iterations"
+            << std::setw(12) << "Build"
+            << std::setw(12) << "k-NN"
+            << std::setw(12) << "Recall"
+            << "\n";
+
+  std::mt19937 rng( 42 );
+
+  for( std::size_t dimension : { 50, 200, 1000 } )
+  {
+    auto pointCloud = makePointCloud( n, dimension, 10, rng );
+
+    Neighbours expected;
+
+    {
+      aleph::utilities::Timer timer;
+
+      BruteForce<Points, Distance> bruteForce( pointCloud );
+      bruteForce.neighbourSearch( k, expected );
+
+      print( dimension, "BruteForce", 0, 0, 0.0, timer.elapsed_ms(), 1.0 );
+    }
+
+    for( unsigned trees : { 1, 4, 8, 16 } )
+    {
+      for( unsigned iterations : { 0, 1, 2 } )
+      {
+        aleph::utilities::Timer buildTimer;
+        RandomProjectionForest<Points, Distance> forest( pointCloud, trees, 32, iterations );
+        auto buildTime = buildTimer.elapsed_ms();
+
+        Neighbours actual;
+
+        aleph::utilities::Timer searchTimer;
+        forest.neighbourSearch( k, actual );
+        auto searchTime = searchTimer.elapsed_ms();
+
+        print( dimension, "RPForest", trees, iterations, buildTime, searchTime, recall( expected, actual ) );
+      }
+    }
+  }
+}
@@ -0,0 +1,146 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for solving the assignment problem that arises in
+  the calculation of the Wasserstein distance between random persistence
+  diagrams, comparing the Munkres solver with the solver by Jonker and
+  Volgenant for increasing sizes.
+
+  Usage: benchmark_assignment [MAXIMUM POINTS]
+*/
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/detail/JonkerVolgenant.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Matrix.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Munkres.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cmath>
+
+using DataType           = double;
+using Matrix             = aleph::distances::detail::Matrix<DataType>;
+using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+/**
+  Creates the cost matrix of two persistence diagrams with respect to the
+  2-Wasserstein distance. Every point may either be assigned to a point
+  of the other diagram or to its own orthogonal projection onto the
+  diagonal, whereas projections are assigned among each other for free.
+*/
+
+Matrix makeCostMatrix( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+{
+  std::vector<PersistenceDiagram::Point> P1( D1.begin(), D1.end() );
+  std::vector<PersistenceDiagram::Point> P2( D2.begin(), D2.end() );
+
+  auto n1 = P1.size();
+  auto n2 = P2.size();
+
+  Matrix costs( n1 + n2 );
+
+  auto square = [] ( DataType x )
+  {
+    return x * x;
+  };
+
+  for( std::size_t i = 0; i < n1 + n2; i++ )
+  {
+    for( std::size_t j = 0; j < n1 + n2; j++ )
+    {
+      if( i < n1 && j < n2 )
+        costs( i, j ) = square( std::max( std::abs( P1[i].x() - P2[j].x() ), std::abs( P1[i].y() - P2[j].y() ) ) );
+      else if( i < n1 )
+        costs( i, j ) = j - n2 == i ? square( P1[i].persistence() / 2 ) : std::numeric_limits<DataType>::max();
+      else if( j < n2 )
+        costs( i, j ) = i - n1 == j ? square( P2[j].persistence() / 2 ) : std::numeric_limits<DataType>::max();
+      else
+        costs( i, j ) = DataType();
+    }
+  }
+
+  return costs;
+}
+
+int main( int argc, char** argv )
+{
+  std::size_t maximum = 200;
+
+  if( argc >= 2 )
+    maximum = std::stoul( argv[1] );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> coordinate( DataType(0), DataType(1) );
+
+  auto makeDiagram = [&] ( std::size_t n )
+  {
+    PersistenceDiagram D;
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto x = coordinate( rng );
+      auto y = coordinate( rng );
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+
+    return D;
+  };
+
+  std::cout << std::left
+            << std::setw(8)  << "Points"
+            << std::setw(20) << "Method"
+            << std::right
+            << std::setw(12) << "Time [ms]"
+            << std::setw(16) << "Cost"
+            << "\n";
+
+  auto report = [] ( std::size_t n, const std::string& method, double time, DataType cost )
+  {
+    std::cout << std::left
+              << std::setw(8)  << n
+              << std::setw(20) << method
+              << std::right << std::fixed
+              << std::setw(12) << std::setprecision(2) << time
+              << std::setw(16) << std::setprecision(8) << cost
+              << "\n";
+
+    std::cout.unsetf( std::ios_base::fixed );
+  };
+
+  for( std::size_t n = 25; n <= maximum; n *= 2 )
+  {
+    auto costs = makeCostMatrix( makeDiagram( n ), makeDiagram( n ) );
+
+    {
+      aleph::utilities::Timer timer;
+
+      aleph::distances::detail::Munkres<DataType> solver( costs );
+      solver();
+
+      report( n, "Munkres", timer.elapsed_ms(), solver.cost( costs ) );
+    }
+
+    {
+      aleph::utilities::Timer timer;
+
+      aleph::distances::detail::JonkerVolgenant<DataType> solver( costs );
+      solver.assignment();
+
+      report( n, "Jonker-Volgenant", timer.elapsed_ms(), solver.cost( costs ) );
+    }
+  }
+}
@@ -0,0 +1,106 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for calculating the Bottleneck distance between a
+  random persistence diagram and a perturbed copy of it, both exactly
+  and with different relative errors. For small diagrams, the explicit
+  bipartite graph is measured as well.
+
+  Usage: benchmark_bottleneck [POINTS]
+*/
+
+#include <aleph/geometry/distances/Infinity.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using DataType           = double;
+using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+/** Infinity distance of a different type, which forces the use of the explicit bipartite graph */
+struct GraphDistance : aleph::geometry::distances::InfinityDistance<DataType>
+{
+};
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 2000;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> coordinate( DataType(0), DataType(1) );
+  std::normal_distribution<DataType> noise( DataType(0), DataType(0.01) );
+
+  PersistenceDiagram D1;
+  PersistenceDiagram D2;
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto x = coordinate( rng );
+    auto y = coordinate( rng );
+
+    if( x > y )
+      std::swap( x, y );
+
+    D1.add( x, y );
+
+    auto u = x + noise( rng );
+    auto v = y + noise( rng );
+
+    if( u > v )
+      std::swap( u, v );
+
+    D2.add( u, v );
+  }
+
+  std::cout << "Points: " << n << "\n\n";
+
+  std::cout << std::left
+            << std::setw(16) << "Method"
+            << std::right
+            << std::setw(12) << "Time [ms]"
+            << std::setw(16) << "Distance"
+            << "\n";
+
+  auto report = [] ( const std::string& method, double time, DataType distance )
+  {
+    std::cout << std::left
+              << std::setw(16) << method
+              << std::right << std::fixed
+              << std::setw(12) << std::setprecision(2) << time
+              << std::setw(16) << std::setprecision(8) << distance
+              << "\n";
+  };
+
+  {
+    aleph::utilities::Timer timer;
+    auto d = aleph::distances::bottleneckDistance( D1, D2 );
+    report( "Exact", timer.elapsed_ms(), d );
+  }
+
+  for( double epsilon : { 0.01, 0.1 } )
+  {
+    aleph::utilities::Timer timer;
+    auto d = aleph::distances::bottleneckDistance( D1, D2, epsilon );
+    report( "Error " + std::to_string( epsilon ).substr( 0, 4 ), timer.elapsed_ms(), d );
+  }
+
+  if( n <= 200 )
+  {
+    aleph::utilities::Timer timer;
+    auto d = aleph::distances::bottleneckDistance<DataType, GraphDistance>( D1, D2 );
+    report( "Graph", timer.elapsed_ms(), d );
+  }
+}
@@ -0,0 +1,134 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for building cover trees of random point clouds
+  of increasing size, comparing incremental insertion into `CoverTree`
+  with the batch construction of `FlatCoverTree`. Moreover, it reports
+  the time for querying the 10 nearest neighbours of 10000 points.
+
+  Usage: benchmark_cover_tree [MAX_POINTS] [DIMENSION]
+*/
+
+#include <aleph/geometry/CoverTree.hh>
+#include <aleph/geometry/FlatCoverTree.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+
+using namespace aleph::geometry;
+
+class IndexMetric
+{
+public:
+  IndexMetric( const std::vector<double>& points, std::size_t dimension )
+    : _points( points.data() )
+    , _dimension( dimension )
+  {
+  }
+
+  double operator()( std::size_t i, std::size_t j ) const
+  {
+    return std::sqrt( _distance( _points + i * _dimension, _points + j * _dimension, _dimension ) );
+  }
+
+private:
+  const double* _points;
+  std::size_t _dimension;
+
+  distances::Euclidean<double> _distance;
+};
+
+int main( int argc, char** argv )
+{
+  std::size_t maxPoints = 1000000;
+  std::size_t dimension = 3;
+
+  std::size_t k       = 10;
+  std::size_t queries = 10000;
+
+  if( argc >= 2 )
+    maxPoints = std::stoul( argv[1] );
+
+  if( argc >= 3 )
+    dimension = std::stoul( argv[2] );
+
+  std::cout << "Dimension: " << dimension << "\n\n";
+
+  std::cout << std::left
+            << std::setw(12) << "Points"
+            << std::right
+            << std::setw(16) << "Incremental"
+            << std::setw(16) << "Queries"
+            << std::setw(16) << "Batch"
+            << std::setw(16) << "Queries"
+            << "\n";
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+
+  for( std::size_t n = 1000; n <= maxPoints; n *= 10 )
+  {
+    std::vector<double> points( n * dimension );
+
+    for( auto&& x : points )
+      x = distribution( rng );
+
+    IndexMetric metric( points, dimension );
+
+    std::cout << std::left
+              << std::setw(12) << n
+              << std::right << std::fixed << std::setprecision(2);
+
+    {
+      aleph::utilities::Timer buildTimer;
+
+      CoverTree<std::size_t, IndexMetric> tree( metric );
+
+      for( std::size_t i = 0; i < n; i++ )
+        tree.insert( i );
+
+      auto buildTime = buildTimer.elapsed_ms();
+
+      aleph::utilities::Timer queryTimer;
+      std::vector< std::pair<std::size_t, double> > neighbours;
+
+      for( std::size_t i = 0; i < std::min( n, queries ); i++ )
+        tree.neighbourSearch( i, k, std::back_inserter( neighbours ) );
+
+      std::cout << std::setw(16) << buildTime
+                << std::setw(16) << queryTimer.elapsed_ms();
+    }
+
+    {
+      aleph::utilities::Timer buildTimer;
+
+      FlatCoverTree<IndexMetric> tree( n, metric );
+
+      auto buildTime = buildTimer.elapsed_ms();
+
+      aleph::utilities::Timer queryTimer;
+      std::vector< std::pair<std::size_t, double> > neighbours;
+
+      for( std::size_t i = 0; i < std::min( n, queries ); i++ )
+        tree.neighbourSearch( i, k, std::back_inserter( neighbours ) );
+
+      std::cout << std::setw(16) << buildTime
+                << std::setw(16) << queryTimer.elapsed_ms();
+    }
+
+    std::cout << "\n";
+  }
+}
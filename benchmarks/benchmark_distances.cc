@@ -0,0 +1,116 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for calculating all pairwise distances of random
+  point clouds of different dimensions, using the one-to-many interface
+  of the distance kernels. Every supported instruction set is measured
+  separately.
+
+  Usage: benchmark_distances [POINTS]
+*/
+
+#include <aleph/geometry/distances/Euclidean.hh>
+#include <aleph/geometry/distances/Hamming.hh>
+#include <aleph/geometry/distances/Infinity.hh>
+#include <aleph/geometry/distances/Kernels.hh>
+#include <aleph/geometry/distances/Manhattan.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace aleph::geometry::distances;
+
+template <class Distance, class T> double benchmark( const std::vector<T>& points, std::size_t n, std::size_t dimension, T& checksum )
+{
+  Distance distance;
+  std::vector<T> result( n );
+
+  aleph::utilities::Timer timer;
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    oneToMany( distance, points.data() + i * dimension, points.data(), n, dimension, result.data() );
+    checksum += result[ ( i + 1 ) % n ];
+  }
+
+  return timer.elapsed_ms();
+}
+
+template <class T> void run( const std::string& type, std::size_t n )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t dimension : { 4, 16, 64, 256 } )
+  {
+    std::vector<T> points( n * dimension );
+
+    for( auto&& x : points )
+      x = distribution( rng );
+
+    for( auto instructionSet : { kernels::InstructionSet::Scalar,
+                                 kernels::InstructionSet::SSE2,
+                                 kernels::InstructionSet::AVX2,
+                                 kernels::InstructionSet::AVX512 } )
+    {
+      kernels::setInstructionSet( instructionSet );
+
+      // Instruction sets that are not supported have been replaced by
+      // the best supported one, so there is no need to measure them.
+      if( kernels::instructionSet() != instructionSet )
+        continue;
+
+      T checksum = T();
+
+      auto euclidean = benchmark< Euclidean<T> >       ( points, n, dimension, checksum );
+      auto manhattan = benchmark< Manhattan<T> >       ( points, n, dimension, checksum );
+      auto infinity  = benchmark< InfinityDistance<T> >( points, n, dimension, checksum );
+      auto hamming   = benchmark< Hamming<T> >         ( points, n, dimension, checksum );
+
+      static const char* names[] = { "Scalar", "SSE2", "AVX2", "AVX512" };
+
+      std::cout << std::left
+                << std::setw(8)  << type
+                << std::setw(8)  << dimension
+                << std::setw(8)  << names[ static_cast<int>( instructionSet ) ]
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(12) << euclidean
+                << std::setw(12) << manhattan
+                << std::setw(12) << infinity
+                << std::setw(12) << hamming
+                << std::setw(16) << checksum
+                << "\n";
+    }
+  }
+}
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 2000;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  std::cout << "Points: " << n << "\n\n";
+
+  std::cout << std::left
+            << std::setw(8)  << "Type"
+            << std::setw(8)  << "Dim"
+            << std::setw(8)  << "ISA"
+            << std::right
+            << std::setw(12) << "Euclidean"
+            << std::setw(12) << "Manhattan"
+            << std::setw(12) << "Infinity"
+            << std::setw(12) << "Hamming"
+            << std::setw(16) << "Checksum"
+            << "\n";
+
+  run<float> ( "float",  n );
+  run<double>( "double", n );
+}
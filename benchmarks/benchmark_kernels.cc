@@ -0,0 +1,112 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for calculating the Gram matrix of a set of random
+  persistence diagrams with the multi-scale kernel and with the sliced
+  Wasserstein kernel for different numbers of directions. Since the
+  costs grow with the number of pairs, the time for a Gram matrix of
+  10,000 diagrams is extrapolated from the measured throughput.
+
+  Usage: benchmark_kernels [DIAGRAMS] [POINTS]
+*/
+
+#include <aleph/persistenceDiagrams/PairwiseMatrix.hh>
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/kernels/MultiScaleKernel.hh>
+#include <aleph/persistenceDiagrams/kernels/SlicedWasserstein.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using DataType           = double;
+using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 200;
+  std::size_t m = 50;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  if( argc >= 3 )
+    m = std::stoul( argv[2] );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> coordinate( DataType(0), DataType(1) );
+
+  std::vector<PersistenceDiagram> diagrams( n );
+
+  for( auto&& D : diagrams )
+  {
+    for( std::size_t i = 0; i < m; i++ )
+    {
+      auto x = coordinate( rng );
+      auto y = coordinate( rng );
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+  }
+
+  std::cout << "Diagrams: " << n << "\n"
+            << "Points  : " << m << "\n\n";
+
+  std::cout << std::left
+            << std::setw(24) << "Kernel"
+            << std::right
+            << std::setw(12) << "Time [ms]"
+            << std::setw(16) << "Pairs [1/s]"
+            << std::setw(16) << "10k [min]"
+            << "\n";
+
+  auto report = [&n] ( const std::string& kernel, double time )
+  {
+    auto pairs          = static_cast<double>( n * ( n + 1 ) / 2 );
+    auto pairsPerSecond = pairs / time * 1000.0;
+
+    // Number of pairs of a Gram matrix of 10,000 diagrams
+    auto extrapolatedPairs = 10000.0 * 10001.0 / 2.0;
+
+    std::cout << std::left
+              << std::setw(24) << kernel
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << time
+              << std::setw(16) << std::setprecision(0) << pairsPerSecond
+              << std::setw(16) << std::setprecision(1) << extrapolatedPairs / pairsPerSecond / 60.0
+              << "\n";
+
+    std::cout.unsetf( std::ios_base::fixed );
+  };
+
+  if( n <= 1000 )
+  {
+    aleph::utilities::Timer timer;
+
+    aleph::pairwiseMatrix( diagrams,
+                           [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+                           {
+                             return aleph::multiScaleKernel( D1, D2, 1.0 );
+                           } );
+
+    report( "Multi-scale", timer.elapsed_ms() );
+  }
+
+  for( unsigned directions : { 10, 50 } )
+  {
+    aleph::utilities::Timer timer;
+    aleph::slicedWassersteinKernelMatrix( diagrams, 1.0, directions );
+
+    report( "Sliced Wasserstein " + std::to_string( directions ), timer.elapsed_ms() );
+  }
+}
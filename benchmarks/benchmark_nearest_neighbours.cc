@@ -0,0 +1,135 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for a radius search and a nearest neighbour search
+  of the brute-force backend, the cover tree backend, and the kd-tree
+  backend, using random point clouds of different dimensions.
+
+  Usage: benchmark_nearest_neighbours [POINTS] [K]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/CoverTreeNeighbours.hh>
+#include <aleph/geometry/KDTree.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cmath>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+
+using T        = double;
+using Points   = PointCloud<T>;
+using Distance = distances::Euclidean<T>;
+
+template <class Wrapper> void run( const std::string& name, const Points& pointCloud, T radius, unsigned k )
+{
+  aleph::utilities::Timer buildTimer;
+  Wrapper wrapper( pointCloud );
+  auto buildTime = buildTimer.elapsed_ms();
+
+  std::vector< std::vector<std::size_t> > indices;
+  std::vector< std::vector<T> > distances;
+
+  aleph::utilities::Timer radiusTimer;
+  wrapper.radiusSearch( radius, indices, distances );
+  auto radiusTime = radiusTimer.elapsed_ms();
+
+  std::size_t edges = 0;
+  for( auto&& neighbours : indices )
+    edges += neighbours.size();
+
+  aleph::utilities::Timer neighbourTimer;
+  wrapper.neighbourSearch( k, indices, distances );
+  auto neighbourTime = neighbourTimer.elapsed_ms();
+
+  std::cout << std::left
+            << std::setw(8)  << pointCloud.dimension()
+            << std::setw(12) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << buildTime
+            << std::setw(12) << radiusTime
+            << std::setw(12) << edges
+            << std::setw(12) << neighbourTime
+            << "\n";
+}
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 5000;
+  unsigned k    = 10;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  if( argc >= 3 )
+    k = static_cast<unsigned>( std::stoul( argv[2] ) );
+
+  std::cout << "Points: " << n << ", k: " << k << "\n\n";
+
+  std::cout << std::left
+            << std::setw(8)  << "Dim"
+            << std::setw(12) << "Backend"
+            << std::right
+            << std::setw(12) << "Build"
+            << std::setw(12) << "Radius"
+            << std::setw(12) << "Edges"
+            << std::setw(12) << "k-NN"
+            << "\n";
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t dimension : { 3, 16, 64 } )
+  {
+    Points pointCloud( n, dimension );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      std::vector<T> p( dimension );
+
+      for( auto&& x : p )
+        x = distribution( rng );
+
+      pointCloud.set( i, p.begin(), p.end() );
+    }
+
+    // Choose a radius that results in approximately 1% of all pairs of
+    // points being neighbours, based on a sample of pairs.
+    T radius = T();
+
+    {
+      distances::Euclidean<T> dist;
+      std::uniform_int_distribution<std::size_t> indexDistribution( 0, n - 1 );
+      std::vector<T> sample( 10000 );
+
+      for( auto&& x : sample )
+      {
+        auto p = pointCloud[ indexDistribution( rng ) ];
+        auto q = pointCloud[ indexDistribution( rng ) ];
+        x      = std::sqrt( dist( p.begin(), q.begin(), dimension ) );
+      }
+
+      std::nth_element( sample.begin(), sample.begin() + 100, sample.end() );
+      radius = sample[100];
+    }
+
+    run< BruteForce<Points, Distance> >         ( "BruteForce", pointCloud, radius, k );
+    run< CoverTreeNeighbours<Points, Distance> >( "CoverTree",  pointCloud, radius, k );
+    run< KDTree<Points, Distance> >             ( "KDTree",     pointCloud, radius, k );
+  }
+}
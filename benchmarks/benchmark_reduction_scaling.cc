@@ -0,0 +1,156 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the scaling behaviour of the chunk-parallel reduction for
+  an increasing number of threads. The input is the Vietoris--Rips
+  complex of a random point cloud in the unit cube. The wall time of the
+  twist algorithm is reported as a baseline, and the pairings of both
+  algorithms are checked for equality.
+
+  Usage: benchmark_reduction_scaling [POINTS] [EPSILON] [DIMENSION] [MAX_THREADS]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/persistentHomology/algorithms/ChunkParallel.hh>
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+
+#include <aleph/topology/representations/Vector.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+using DataType       = double;
+using Index          = unsigned;
+using PointCloud     = aleph::containers::PointCloud<DataType>;
+using Distance       = aleph::geometry::distances::Euclidean<DataType>;
+using Representation = aleph::topology::representations::Vector<Index>;
+using Matrix         = aleph::topology::BoundaryMatrix<Representation>;
+
+template <class Algorithm> double benchmark( const Matrix& M, Algorithm algorithm, aleph::PersistencePairing<Index>& pairing )
+{
+  auto N = M;
+
+  aleph::utilities::Timer timer;
+  algorithm( N );
+
+  auto time = timer.elapsed_ms();
+  pairing   = aleph::calculatePersistencePairing<aleph::persistentHomology::algorithms::Twist>( N );
+
+  return time;
+}
+
+int main( int argc, char** argv )
+{
+  unsigned n         = 300;
+  DataType epsilon   = 0.3;
+  unsigned dimension = 3;
+  int maxThreads     = 1;
+
+#ifdef _OPENMP
+  maxThreads = omp_get_max_threads();
+#endif
+
+  if( argc >= 2 )
+    n = unsigned( std::stoul( argv[1] ) );
+
+  if( argc >= 3 )
+    epsilon = DataType( std::stod( argv[2] ) );
+
+  if( argc >= 4 )
+    dimension = unsigned( std::stoul( argv[3] ) );
+
+  if( argc >= 5 )
+    maxThreads = std::stoi( argv[4] );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> distribution( DataType(0), DataType(1) );
+
+  PointCloud pointCloud( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  aleph::geometry::BruteForce<PointCloud, Distance> wrapper( pointCloud );
+
+  auto K = aleph::geometry::buildVietorisRipsComplex( wrapper, epsilon, dimension );
+  auto M = aleph::topology::makeBoundaryMatrix<Representation>( K );
+
+  std::cout << "Columns: " << M.getNumColumns() << "\n\n";
+
+  std::cout << std::left
+            << std::setw(8)  << "Matrix"
+            << std::setw(16) << "Algorithm"
+            << std::right
+            << std::setw(8)  << "Threads"
+            << std::setw(14) << "Time [ms]"
+            << std::setw(10) << "Speedup"
+            << "\n";
+
+  for( bool dualize : { false, true } )
+  {
+    auto N = dualize ? M.dualize() : M;
+
+    aleph::PersistencePairing<Index> expected;
+    aleph::PersistencePairing<Index> actual;
+
+    auto baseline = benchmark( N, aleph::persistentHomology::algorithms::Twist(), expected );
+
+    std::cout << std::left
+              << std::setw(8)  << ( dualize ? "dual" : "primal" )
+              << std::setw(16) << "Twist"
+              << std::right
+              << std::setw(8)  << 1
+              << std::setw(14) << std::fixed << std::setprecision(2) << baseline
+              << std::setw(10) << std::fixed << std::setprecision(2) << 1.0
+              << "\n";
+
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+#ifdef _OPENMP
+      omp_set_num_threads( threads );
+#endif
+
+      auto time = benchmark( N, aleph::persistentHomology::algorithms::ChunkParallel(), actual );
+
+      std::cout << std::left
+                << std::setw(8)  << ( dualize ? "dual" : "primal" )
+                << std::setw(16) << "ChunkParallel"
+                << std::right
+                << std::setw(8)  << threads
+                << std::setw(14) << std::fixed << std::setprecision(2) << time
+                << std::setw(10) << std::fixed << std::setprecision(2) << baseline / time
+                << "\n";
+
+      if( actual != expected )
+      {
+        std::cerr << "* Error: pairings of chunk-parallel and twist reduction do not coincide\n";
+        return -1;
+      }
+
+      // Ensures that the maximum number of threads is always used, even
+      // if it is not a power of two.
+      if( threads < maxThreads && threads * 2 > maxThreads )
+        threads = maxThreads / 2;
+    }
+  }
+}
@@ -0,0 +1,200 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It compares the boundary matrix representations in terms of their
+  wall time and the number of allocations that are required for the
+  reduction of a boundary matrix. Every matrix is reduced in its primal
+  and in its dual form, the latter being the default for calculations
+  of persistent homology, using the twist algorithm. Since clearing
+  removes most of the column additions of the dual matrix, the dual
+  matrix is also reduced with the standard algorithm, which is always
+  dominated by column additions.
+
+  The benchmark uses the Vietoris--Rips complexes of the point clouds
+  that are used by the test cases. Additional point clouds may be
+  specified on the command-line.
+
+  Usage: benchmark_representations [EPSILON] [DIMENSION] [FILE...]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/persistentHomology/algorithms/Standard.hh>
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+
+#include <aleph/topology/representations/Arena.hh>
+#include <aleph/topology/representations/BitTree.hh>
+#include <aleph/topology/representations/Set.hh>
+#include <aleph/topology/representations/Vector.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstdlib>
+
+// Allocation counting -------------------------------------------------
+//
+// Replacing the global allocation functions is the least intrusive way
+// of counting allocations for all representations alike. Newer versions
+// of GCC do not realize that both functions are replaced and warn about
+// mismatched calls.
+
+_Pragma( "GCC diagnostic push" )
+_Pragma( "GCC diagnostic ignored \"-Wpragmas\"" )
+_Pragma( "GCC diagnostic ignored \"-Wmismatched-new-delete\"" )
+
+static std::size_t numAllocations = 0;
+
+void* operator new( std::size_t size )
+{
+  ++numAllocations;
+
+  if( void* p = std::malloc( size ? size : 1 ) )
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void operator delete( void* p ) noexcept
+{
+  std::free( p );
+}
+
+_Pragma( "GCC diagnostic pop" )
+
+// ---------------------------------------------------------------------
+
+using DataType   = double;
+using Index      = unsigned;
+using PointCloud = aleph::containers::PointCloud<DataType>;
+using Distance   = aleph::geometry::distances::Euclidean<DataType>;
+using Standard   = aleph::persistentHomology::algorithms::Standard;
+using Twist      = aleph::persistentHomology::algorithms::Twist;
+
+template <class Representation, class ReductionAlgorithm, class SimplicialComplex>
+aleph::PersistencePairing<Index> benchmark( const std::string& name,
+                                            const std::string& input,
+                                            const SimplicialComplex& K,
+                                            bool dualize )
+{
+  auto M = aleph::topology::makeBoundaryMatrix<Representation>( K );
+
+  if( dualize )
+    M = M.dualize();
+
+  ReductionAlgorithm algorithm;
+  aleph::utilities::Timer timer;
+
+  numAllocations = 0;
+  timer.restart();
+
+  algorithm( M );
+
+  auto time        = timer.elapsed_ms();
+  auto allocations = numAllocations;
+
+  std::cout << std::left
+            << std::setw(32) << input
+            << std::setw(8)  << ( dualize ? "dual" : "primal" )
+            << std::setw(10) << ( std::is_same<ReductionAlgorithm, Twist>::value ? "Twist" : "Standard" )
+            << std::setw(10) << name
+            << std::right
+            << std::setw(12) << M.getNumColumns()
+            << std::setw(14) << allocations
+            << std::setw(14) << std::fixed << std::setprecision(2) << time
+            << "\n";
+
+  return aleph::calculatePersistencePairing<ReductionAlgorithm>( M );
+}
+
+int main( int argc, char** argv )
+{
+  DataType epsilon   = 1.0;
+  unsigned dimension = 3;
+
+  if( argc >= 2 )
+    epsilon = DataType( std::stod( argv[1] ) );
+
+  if( argc >= 3 )
+    dimension = unsigned( std::stoul( argv[2] ) );
+
+  std::vector<std::string> inputs;
+
+  for( int i = 3; i < argc; i++ )
+    inputs.push_back( argv[i] );
+
+  if( inputs.empty() )
+  {
+    inputs = {
+      ALEPH_BENCHMARK_INPUT_DIRECTORY "/Iris_comma_separated.txt",
+      ALEPH_BENCHMARK_INPUT_DIRECTORY "/S1vS1_08_20.txt",
+      ALEPH_BENCHMARK_INPUT_DIRECTORY "/S1vS1_10_19.txt"
+    };
+  }
+
+  std::cout << std::left
+            << std::setw(32) << "Input"
+            << std::setw(8)  << "Matrix"
+            << std::setw(10) << "Algorithm"
+            << std::setw(10) << "Type"
+            << std::right
+            << std::setw(12) << "Columns"
+            << std::setw(14) << "Allocations"
+            << std::setw(14) << "Time [ms]"
+            << "\n";
+
+  for( auto&& input : inputs )
+  {
+    auto pointCloud = aleph::containers::load<DataType>( input );
+
+    aleph::geometry::BruteForce<PointCloud, Distance> wrapper( pointCloud );
+
+    auto K    = aleph::geometry::buildVietorisRipsComplex( wrapper, epsilon, dimension );
+    auto name = input.substr( input.find_last_of( '/' ) + 1 );
+
+    using namespace aleph::topology::representations;
+
+    for( bool dualize : { false, true } )
+    {
+      auto p1 = benchmark< Set<Index>,     Twist >( "Set",     name, K, dualize );
+      auto p2 = benchmark< Vector<Index>,  Twist >( "Vector",  name, K, dualize );
+      auto p3 = benchmark< Arena<Index>,   Twist >( "Arena",   name, K, dualize );
+      auto p4 = benchmark< BitTree<Index>, Twist >( "BitTree", name, K, dualize );
+
+      if( p1 != p2 || p2 != p3 || p3 != p4 )
+      {
+        std::cerr << "* Error: pairings of different representations do not coincide\n";
+        return -1;
+      }
+    }
+
+    {
+      auto p1 = benchmark< Vector<Index>,  Standard >( "Vector",  name, K, true );
+      auto p2 = benchmark< Arena<Index>,   Standard >( "Arena",   name, K, true );
+      auto p3 = benchmark< BitTree<Index>, Standard >( "BitTree", name, K, true );
+
+      if( p1 != p2 || p2 != p3 )
+      {
+        std::cerr << "* Error: pairings of different representations do not coincide\n";
+        return -1;
+      }
+    }
+  }
+}
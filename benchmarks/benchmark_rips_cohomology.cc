@@ -0,0 +1,172 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It compares the time and the peak memory usage of the implicit
+  cohomology engine for Vietoris--Rips complexes with the explicit
+  calculation, i.e. building the complex and reducing its boundary
+  matrix. The input is a set of random points in the unit cube. Every
+  calculation runs in a separate process, so the peak memory usage of
+  one calculation does not affect the other one.
+
+  Usage: benchmark_rips_cohomology [POINTS] [DIMENSION] [EPSILON]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/algorithms/RipsCohomology.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using DataType       = float;
+using PointCloud     = aleph::containers::PointCloud<DataType>;
+using Distance       = aleph::geometry::distances::Euclidean<DataType>;
+using RipsCohomology = aleph::persistentHomology::algorithms::RipsCohomology<DataType>;
+
+/** @returns Peak resident set size of the current process in MiB */
+double peakMemory()
+{
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+
+#ifdef __APPLE__
+  return static_cast<double>( usage.ru_maxrss ) / ( 1024.0 * 1024.0 );
+#else
+  return static_cast<double>( usage.ru_maxrss ) / 1024.0;
+#endif
+}
+
+/**
+  Runs a calculation in a child process and reports its time and its
+  peak memory usage. The calculation returns the number of simplices
+  it stores explicitly, which is zero for the implicit engine.
+*/
+
+template <class Function> void run( const std::string& name, Function f )
+{
+  std::cout << std::flush;
+
+  auto pid = fork();
+
+  if( pid == 0 )
+  {
+    aleph::utilities::Timer timer;
+
+    auto simplices = f();
+    auto time      = timer.elapsed_ms();
+
+    std::cout << std::left
+              << std::setw(12) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(16) << simplices
+              << std::setw(16) << time
+              << std::setw(16) << peakMemory()
+              << "\n"
+              << std::flush;
+
+    _exit( 0 );
+  }
+  else if( pid > 0 )
+  {
+    int status = 0;
+    waitpid( pid, &status, 0 );
+
+    // The explicit calculation may exceed the available memory and be
+    // terminated by the operating system.
+    if( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+      std::cout << std::left << std::setw(12) << name << "  did not finish\n";
+  }
+  else
+    std::cerr << "Unable to create process for '" << name << "'\n";
+}
+
+int main( int argc, char** argv )
+{
+  std::size_t n       = 10000;
+  unsigned dimension  = 2;
+  DataType epsilon    = DataType(0.1);
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  if( argc >= 3 )
+    dimension = static_cast<unsigned>( std::stoul( argv[2] ) );
+
+  if( argc >= 4 )
+    epsilon = static_cast<DataType>( std::stod( argv[3] ) );
+
+  std::cout << "Points   : " << n         << "\n"
+            << "Dimension: " << dimension << "\n"
+            << "Epsilon  : " << epsilon   << "\n"
+            << "\n";
+
+  // The point cloud is created by every process on its own, so that
+  // it does not contribute to the memory usage at the time of forking.
+  auto makePointCloud = [&n] ()
+  {
+    std::mt19937 rng( 42 );
+    std::uniform_real_distribution<DataType> distribution( DataType(0), DataType(1) );
+
+    PointCloud pointCloud( n, 3 );
+
+    for( std::size_t i = 0; i < n; i++ )
+      pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+    return pointCloud;
+  };
+
+  std::cout << std::left
+            << std::setw(12) << "Method"
+            << std::right
+            << std::setw(16) << "Simplices"
+            << std::setw(16) << "Time [ms]"
+            << std::setw(16) << "Peak [MiB]"
+            << "\n";
+
+  run( "Baseline", [&makePointCloud] ()
+  {
+    auto pointCloud = makePointCloud();
+
+    (void) pointCloud;
+    return std::size_t(0);
+  } );
+
+  run( "Implicit", [&makePointCloud, &dimension, &epsilon] ()
+  {
+    auto pointCloud = makePointCloud();
+
+    RipsCohomology ripsCohomology( pointCloud, Distance(), epsilon );
+
+    auto diagrams = ripsCohomology( dimension );
+
+    return std::size_t(0);
+  } );
+
+  run( "Explicit", [&makePointCloud, &dimension, &epsilon] ()
+  {
+    auto pointCloud = makePointCloud();
+
+    aleph::geometry::BruteForce<PointCloud, Distance> wrapper( pointCloud );
+
+    auto K        = aleph::geometry::buildVietorisRipsComplex( wrapper, epsilon, dimension );
+    auto diagrams = aleph::calculatePersistenceDiagrams( K );
+
+    return K.size();
+  } );
+}
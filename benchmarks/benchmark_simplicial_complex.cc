@@ -0,0 +1,115 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It compares the default simplicial complex with the flat simplicial
+  complex for bulk construction, sorting, and simplex queries. The input
+  is the Vietoris--Rips complex of a random point cloud in the unit cube.
+
+  Usage: benchmark_simplicial_complex [POINTS] [EPSILON] [DIMENSION]
+*/
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/topology/FlatSimplicialComplex.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using DataType   = double;
+using PointCloud = aleph::containers::PointCloud<DataType>;
+using Distance   = aleph::geometry::distances::Euclidean<DataType>;
+
+template <class SimplicialComplex, class Simplex> void benchmark( const std::string& name, const std::vector<Simplex>& simplices )
+{
+  aleph::utilities::Timer constructionTimer;
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+  auto construction = constructionTimer.elapsed_ms();
+
+  aleph::utilities::Timer sortingTimer;
+
+  K.sort( aleph::topology::filtrations::Data<Simplex>() );
+  auto sorting = sortingTimer.elapsed_ms();
+
+  aleph::utilities::Timer queryTimer;
+
+  std::size_t checksum = 0;
+  for( auto&& simplex : simplices )
+    checksum += K.index( simplex );
+
+  auto queries = queryTimer.elapsed_ms();
+
+  std::cout << std::left
+            << std::setw(12) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(16) << construction
+            << std::setw(12) << sorting
+            << std::setw(14) << queries
+            << std::setw(18) << checksum
+            << "\n";
+}
+
+int main( int argc, char** argv )
+{
+  unsigned n         = 1000;
+  DataType epsilon   = 0.2;
+  unsigned dimension = 3;
+
+  if( argc >= 2 )
+    n = unsigned( std::stoul( argv[1] ) );
+
+  if( argc >= 3 )
+    epsilon = DataType( std::stod( argv[2] ) );
+
+  if( argc >= 4 )
+    dimension = unsigned( std::stoul( argv[3] ) );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> distribution( DataType(0), DataType(1) );
+
+  PointCloud pointCloud( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  aleph::geometry::BruteForce<PointCloud, Distance> wrapper( pointCloud );
+
+  auto K = aleph::geometry::buildVietorisRipsComplex( wrapper, epsilon, dimension );
+
+  using Simplex = typename decltype(K)::ValueType;
+
+  std::vector<Simplex> simplices( K.begin(), K.end() );
+
+  // The input order should not benefit any of the complexes
+  std::shuffle( simplices.begin(), simplices.end(), rng );
+
+  std::cout << "Simplices: " << simplices.size() << "\n\n";
+
+  std::cout << std::left
+            << std::setw(12) << "Complex"
+            << std::right
+            << std::setw(16) << "Construction"
+            << std::setw(12) << "Sorting"
+            << std::setw(14) << "Queries"
+            << std::setw(18) << "Checksum"
+            << "\n";
+
+  benchmark< aleph::topology::SimplicialComplex<Simplex> >    ( "Default", simplices );
+  benchmark< aleph::topology::FlatSimplicialComplex<Simplex> >( "Flat",    simplices );
+}
@@ -0,0 +1,98 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It reports the time for calculating the Wasserstein distance between
+  two random persistence diagrams for different exponents, using the
+  auction algorithm with different relative errors. For small diagrams,
+  the exact calculation with a dense assignment solver is measured too.
+
+  Usage: benchmark_wasserstein [POINTS]
+*/
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/Wasserstein.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using DataType           = double;
+using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+int main( int argc, char** argv )
+{
+  std::size_t n = 2000;
+
+  if( argc >= 2 )
+    n = std::stoul( argv[1] );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> coordinate( DataType(0), DataType(1) );
+
+  auto makeDiagram = [&] ()
+  {
+    PersistenceDiagram D;
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto x = coordinate( rng );
+      auto y = coordinate( rng );
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+
+    return D;
+  };
+
+  auto D1 = makeDiagram();
+  auto D2 = makeDiagram();
+
+  std::cout << "Points: " << n << "\n\n";
+
+  std::cout << std::left
+            << std::setw(8)  << "Power"
+            << std::setw(16) << "Method"
+            << std::right
+            << std::setw(12) << "Time [ms]"
+            << std::setw(16) << "Distance"
+            << "\n";
+
+  for( DataType power : { DataType(1), DataType(2) } )
+  {
+    auto report = [&power] ( const std::string& method, double time, DataType distance )
+    {
+      std::cout << std::left
+                << std::setw(8)  << power
+                << std::setw(16) << method
+                << std::right << std::fixed
+                << std::setw(12) << std::setprecision(2) << time
+                << std::setw(16) << std::setprecision(8) << distance
+                << "\n";
+
+      std::cout.unsetf( std::ios_base::fixed );
+    };
+
+    for( double epsilon : { 0.01, 0.1 } )
+    {
+      aleph::utilities::Timer timer;
+      auto d = aleph::distances::wassersteinDistance( D1, D2, power, epsilon );
+      report( "Auction " + std::to_string( epsilon ).substr( 0, 4 ), timer.elapsed_ms(), d );
+    }
+
+    if( n <= 500 )
+    {
+      aleph::utilities::Timer timer;
+      auto d = aleph::distances::wassersteinDistance( D1, D2, power );
+      report( "Exact", timer.elapsed_ms(), d );
+    }
+  }
+}
@@ -18,8 +18,8 @@
 // Various classes for nearest-neighbour calculations and the expansion
 // process of a simplicial complex.
 
-#include <aleph/geometry/BruteForce.hh>
 #include <aleph/geometry/FLANN.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/RipsExpander.hh>
 #include <aleph/geometry/VietorisRipsComplex.hh>
 
@@ -46,6 +46,7 @@
 // as well as the standard distance calculations plus kernels.
 
 #include <aleph/persistenceDiagrams/Norms.hh>
+#include <aleph/persistenceDiagrams/PairwiseMatrix.hh>
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 #include <aleph/persistenceDiagrams/PersistenceIndicatorFunction.hh>
 
@@ -54,6 +55,7 @@
 #include <aleph/persistenceDiagrams/distances/Wasserstein.hh>
 
 #include <aleph/persistenceDiagrams/kernels/MultiScaleKernel.hh>
+#include <aleph/persistenceDiagrams/kernels/SlicedWasserstein.hh>
 
 #include <aleph/persistenceDiagrams/io/Raw.hh>
 
@@ -69,7 +71,9 @@
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include <cmath>
 
@@ -85,6 +89,7 @@ using Simplex            = aleph::topology::Simplex<DataType, VertexType>;
 using SimplicialComplex  = aleph::topology::SimplicialComplex<Simplex>;
 using RipsExpander       = aleph::geometry::RipsExpander<SimplicialComplex>;
 using StepFunction       = aleph::math::StepFunction<DataType>;
+using SymmetricMatrix    = aleph::math::SymmetricMatrix<DataType>;
 
 // Select a default value of calculating nearest neighbours. This is
 // only relevant for those functions that create complexes from data
@@ -93,7 +98,7 @@ template <class Distance> using NearestNeighbours
 #ifdef ALEPH_WITH_FLANN
   = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  = aleph::geometry::BruteForce<PointCloud, Distance>;
+  = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
 void wrapSimplex( py::module& m )
@@ -604,6 +609,21 @@ void wrapPersistentHomologyCalculation( py::module& m )
   );
 }
 
+// Converts a symmetric matrix into a square `numpy` array
+py::array_t<DataType> toArray( const SymmetricMatrix& M )
+{
+  auto n = M.numRows();
+
+  py::array_t<DataType> result( std::vector<std::size_t>( { n, n } ) );
+  auto buffer = static_cast<DataType*>( result.request().ptr );
+
+  for( std::size_t i = 0; i < n; i++ )
+    for( std::size_t j = 0; j < n; j++ )
+      buffer[i*n + j] = M(i,j);
+
+  return result;
+}
+
 void wrapDistanceCalculations( py::module& m )
 {
   using namespace pybind11::literals;
@@ -631,6 +651,59 @@ void wrapDistanceCalculations( py::module& m )
     "D2"_a,
     "p"_a = DataType(1)
   );
+
+  // Calculates all pairwise distances of a list of persistence diagrams
+  // in parallel. The distance is selected by its name. For a positive
+  // relative error, the Wasserstein distance is approximated, which is
+  // much faster for large diagrams. The bottleneck distance and the
+  // approximate Wasserstein distance build a kd-tree of every diagram
+  // only once.
+  m.def( "pairwiseDistances",
+    [] ( const std::vector<PersistenceDiagram>& diagrams, const std::string& distance, DataType p, double relativeError, const std::string& checkpoint )
+    {
+      SymmetricMatrix M;
+
+      if( distance == "bottleneck" )
+      {
+        M = aleph::pairwiseMatrix( diagrams,
+                                   aleph::distances::BottleneckDistance<DataType>( relativeError ),
+                                   checkpoint );
+      }
+      else if( distance == "hausdorff" )
+      {
+        M = aleph::pairwiseMatrix( diagrams,
+                                   [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+                                   {
+                                     return aleph::distances::hausdorffDistance( D1, D2 );
+                                   },
+                                   checkpoint );
+      }
+      else if( distance == "wasserstein" && relativeError > 0 )
+      {
+        M = aleph::pairwiseMatrix( diagrams,
+                                   aleph::distances::WassersteinDistance<DataType>( p, relativeError ),
+                                   checkpoint );
+      }
+      else if( distance == "wasserstein" )
+      {
+        M = aleph::pairwiseMatrix( diagrams,
+                                   [p] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+                                   {
+                                     return aleph::distances::wassersteinDistance( D1, D2, p );
+                                   },
+                                   checkpoint );
+      }
+      else
+        throw std::runtime_error( "Unknown distance '" + distance + "'" );
+
+      return toArray( M );
+    },
+    "diagrams"_a,
+    "distance"_a      = "wasserstein",
+    "p"_a             = DataType(1),
+    "relativeError"_a = 0.0,
+    "checkpoint"_a    = ""
+  );
 }
 
 void wrapKernelCalculations( py::module& m )
@@ -650,6 +723,60 @@ void wrapKernelCalculations( py::module& m )
       return aleph::multiScalePseudoMetric( D1, D2, sigma );
     }
   );
+
+  // Calculates the Gram matrix of the multi-scale kernel for a list of
+  // persistence diagrams in parallel.
+  m.def( "multiScaleKernelMatrix",
+    [] ( const std::vector<PersistenceDiagram>& diagrams, double sigma, const std::string& checkpoint )
+    {
+      auto M = aleph::pairwiseMatrix( diagrams,
+                                      [sigma] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+                                      {
+                                        return aleph::multiScaleKernel( D1, D2, sigma );
+                                      },
+                                      checkpoint );
+
+      return toArray( M );
+    },
+    "diagrams"_a,
+    "sigma"_a,
+    "checkpoint"_a = ""
+  );
+
+  m.def( "slicedWassersteinDistance",
+    [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2, unsigned directions )
+    {
+      return aleph::slicedWassersteinDistance( D1, D2, directions );
+    },
+    "D1"_a,
+    "D2"_a,
+    "directions"_a = 10
+  );
+
+  m.def( "slicedWassersteinKernel",
+    [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2, double sigma, unsigned directions )
+    {
+      return aleph::slicedWassersteinKernel( D1, D2, sigma, directions );
+    },
+    "D1"_a,
+    "D2"_a,
+    "sigma"_a,
+    "directions"_a = 10
+  );
+
+  // Calculates the Gram matrix of the sliced Wasserstein kernel for a list
+  // of persistence diagrams in parallel. Projections are only sorted once
+  // per diagram.
+  m.def( "slicedWassersteinKernelMatrix",
+    [] ( const std::vector<PersistenceDiagram>& diagrams, double sigma, unsigned directions, const std::string& checkpoint )
+    {
+      return toArray( aleph::slicedWassersteinKernelMatrix( diagrams, sigma, directions, checkpoint ) );
+    },
+    "diagrams"_a,
+    "sigma"_a,
+    "directions"_a = 10,
+    "checkpoint"_a = ""
+  );
 }
 
 void wrapRipsExpander( py::module& m )
@@ -808,6 +935,8 @@ PYBIND11_MODULE(aleph, m)
   wrapNorms(m);
   wrapPersistenceDiagram(m);
   wrapPersistencePairing(m);
+  wrapDistanceCalculations(m);
+  wrapKernelCalculations(m);
   wrapPersistentHomologyCalculation(m);
   wrapRipsExpander(m);
   wrapStepFunction(m);
@@ -0,0 +1,32 @@
+#ifndef ALEPH_DEFAULTS_HH__
+#define ALEPH_DEFAULTS_HH__
+
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/representations/Arena.hh>
+#include <aleph/topology/representations/Vector.hh>
+
+namespace aleph
+{
+
+namespace defaults
+{
+
+using Index              = unsigned;
+
+// The arena-based representation may be used as the default one by
+// defining this symbol prior to including any Aleph header. It must
+// be defined consistently for all translation units of a program.
+#ifdef ALEPH_DEFAULT_REPRESENTATION_ARENA
+  using Representation   = topology::representations::Arena<Index>;
+#else
+  using Representation   = topology::representations::Vector<Index>;
+#endif
+
+using ReductionAlgorithm = persistentHomology::algorithms::Twist;
+
+} // namespace defaults
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef ALEPH_CONTAINERS_SMALL_VECTOR_HH__
+#define ALEPH_CONTAINERS_SMALL_VECTOR_HH__
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace containers
+{
+
+/**
+  @class SmallVector
+  @brief Vector with inline storage for a small number of elements
+
+  Stores up to N elements within the object itself and only allocates
+  memory on the heap if more elements are required. The interface is a
+  subset of the one of `std::vector`. It is sufficient for storing the
+  vertices of a simplex, for example.
+
+  Elements must be default-constructible and copyable; no constructors
+  or destructors are run when elements are removed.
+
+  @tparam T Element type
+  @tparam N Number of elements that are stored inline
+*/
+
+template <class T, std::size_t N> class SmallVector
+{
+  static_assert( N > 0, "Small vector requires inline storage for at least one element" );
+
+public:
+  using value_type             = T;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = T&;
+  using const_reference        = const T&;
+  using pointer                = T*;
+  using const_pointer          = const T*;
+  using iterator               = T*;
+  using const_iterator         = const T*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  SmallVector() = default;
+
+  SmallVector( size_type n, const T& value )
+  {
+    this->reserve( n );
+    std::fill( _data, _data + n, value );
+
+    _size = n;
+  }
+
+  template <
+    class InputIterator,
+    class = typename std::enable_if< !std::is_integral<InputIterator>::value >::type
+  > SmallVector( InputIterator begin, InputIterator end )
+  {
+    for( ; begin != end; ++begin )
+      this->push_back( *begin );
+  }
+
+  SmallVector( const SmallVector& other )
+  {
+    this->reserve( other._size );
+    std::copy( other.begin(), other.end(), _data );
+
+    _size = other._size;
+  }
+
+  SmallVector( SmallVector&& other ) noexcept
+  {
+    this->swap( other );
+  }
+
+  SmallVector& operator=( SmallVector other ) noexcept
+  {
+    this->swap( other );
+    return *this;
+  }
+
+  ~SmallVector()
+  {
+    if( _data != _buffer )
+      delete[] _data;
+  }
+
+  void swap( SmallVector& other ) noexcept
+  {
+    // Inline buffers have to be exchanged element by element because
+    // the pointers must keep on referring to the own buffer.
+    bool thisInline  = _data == _buffer;
+    bool otherInline = other._data == other._buffer;
+
+    std::swap_ranges( _buffer, _buffer + N, other._buffer );
+
+    std::swap( _data,     other._data );
+    std::swap( _size,     other._size );
+    std::swap( _capacity, other._capacity );
+
+    if( otherInline )
+      _data = _buffer;
+
+    if( thisInline )
+      other._data = other._buffer;
+  }
+
+  // Iterators ---------------------------------------------------------
+
+  iterator       begin()       noexcept { return _data; }
+  const_iterator begin() const noexcept { return _data; }
+  iterator       end()         noexcept { return _data + _size; }
+  const_iterator end()   const noexcept { return _data + _size; }
+
+  reverse_iterator       rbegin()       noexcept { return reverse_iterator( this->end() ); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator( this->end() ); }
+  reverse_iterator       rend()         noexcept { return reverse_iterator( this->begin() ); }
+  const_reverse_iterator rend()   const noexcept { return const_reverse_iterator( this->begin() ); }
+
+  // Element access ----------------------------------------------------
+
+  reference       operator[]( size_type i )       noexcept { return _data[i]; }
+  const_reference operator[]( size_type i ) const noexcept { return _data[i]; }
+
+  const_reference at( size_type i ) const
+  {
+    if( i >= _size )
+      throw std::out_of_range( "Index is out of range" );
+
+    return _data[i];
+  }
+
+  reference       front()       noexcept { return _data[0]; }
+  const_reference front() const noexcept { return _data[0]; }
+  reference       back()        noexcept { return _data[_size - 1]; }
+  const_reference back()  const noexcept { return _data[_size - 1]; }
+
+  T*       data()       noexcept { return _data; }
+  const T* data() const noexcept { return _data; }
+
+  // Capacity ----------------------------------------------------------
+
+  bool      empty()    const noexcept { return _size == 0; }
+  size_type size()     const noexcept { return _size; }
+  size_type capacity() const noexcept { return _capacity; }
+
+  /** @returns true if the elements are stored inline */
+  bool isInline() const noexcept
+  {
+    return _data == _buffer;
+  }
+
+  void reserve( size_type n )
+  {
+    if( n <= _capacity )
+      return;
+
+    auto data = new T[n];
+    std::copy( this->begin(), this->end(), data );
+
+    if( _data != _buffer )
+      delete[] _data;
+
+    _data     = data;
+    _capacity = n;
+  }
+
+  // Modifiers ---------------------------------------------------------
+
+  void push_back( const T& value )
+  {
+    if( _size == _capacity )
+      this->reserve( 2 * _capacity );
+
+    _data[_size++] = value;
+  }
+
+  void pop_back() noexcept
+  {
+    --_size;
+  }
+
+  void clear() noexcept
+  {
+    _size = 0;
+  }
+
+  iterator erase( const_iterator first, const_iterator last )
+  {
+    auto begin = _data + ( first - _data );
+    auto end   = std::copy( _data + ( last - _data ), this->end(), begin );
+
+    _size = static_cast<size_type>( end - _data );
+    return begin;
+  }
+
+  // Comparison --------------------------------------------------------
+
+  bool operator==( const SmallVector& other ) const
+  {
+    return _size == other._size && std::equal( this->begin(), this->end(), other.begin() );
+  }
+
+  bool operator!=( const SmallVector& other ) const
+  {
+    return !this->operator==( other );
+  }
+
+  bool operator<( const SmallVector& other ) const
+  {
+    return std::lexicographical_compare( this->begin(), this->end(), other.begin(), other.end() );
+  }
+
+private:
+  T _buffer[N] = {};
+
+  T*        _data     = _buffer;
+  size_type _size     = 0;
+  size_type _capacity = N;
+};
+
+/**
+  Calculates the hash value of a small vector. The value coincides with
+  the one of a `std::vector` with the same elements.
+*/
+
+template <class T, std::size_t N> std::size_t hash_value( const SmallVector<T, N>& v )
+{
+  return boost::hash_range( v.begin(), v.end() );
+}
+
+} // namespace containers
+
+} // namespace aleph
+
+#endif
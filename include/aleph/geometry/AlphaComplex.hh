@@ -0,0 +1,1038 @@
+#ifndef ALEPH_GEOMETRY_ALPHA_COMPLEX_HH__
+#define ALEPH_GEOMETRY_ALPHA_COMPLEX_HH__
+
+#include <aleph/geometry/detail/Predicates.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+using Real = long double;
+
+/**
+  Calculates the smallest circumsphere of a simplex with \p k vertices,
+  i.e. the sphere whose centre lies in the affine hull of the simplex.
+
+  @returns Squared radius of the sphere; the centre is stored in \p centre
+*/
+
+template <std::size_t D> Real circumsphere( const std::array<double, D>* const* points, std::size_t k, std::array<Real, D>& centre )
+{
+  auto&& p = *points[0];
+
+  // The centre is p + \sum_i x_i (q_i - p), where the coefficients are
+  // the solution of a linear system involving the Gram matrix of the
+  // differences q_i - p.
+  std::array<std::array<Real, D>, D> V;
+  std::array<std::array<Real, D + 1>, D> A;
+
+  auto m = k - 1;
+
+  for( std::size_t i = 0; i < m; i++ )
+    for( std::size_t j = 0; j < D; j++ )
+      V[i][j] = Real( ( *points[i+1] )[j] ) - Real( p[j] );
+
+  for( std::size_t i = 0; i < m; i++ )
+  {
+    for( std::size_t j = 0; j < m; j++ )
+      A[i][j] = 2 * std::inner_product( V[i].begin(), V[i].end(), V[j].begin(), Real() );
+
+    A[i][m] = std::inner_product( V[i].begin(), V[i].end(), V[i].begin(), Real() );
+  }
+
+  // Gaussian elimination with partial pivoting
+  for( std::size_t i = 0; i < m; i++ )
+  {
+    auto pivot = i;
+
+    for( std::size_t j = i + 1; j < m; j++ )
+      if( std::abs( A[j][i] ) > std::abs( A[pivot][i] ) )
+        pivot = j;
+
+    std::swap( A[i], A[pivot] );
+
+    for( std::size_t j = i + 1; j < m; j++ )
+    {
+      auto f = A[j][i] / A[i][i];
+
+      for( std::size_t l = i; l <= m; l++ )
+        A[j][l] -= f * A[i][l];
+    }
+  }
+
+  std::array<Real, D> x;
+
+  for( std::size_t i = m; i-- > 0; )
+  {
+    x[i] = A[i][m];
+
+    for( std::size_t j = i + 1; j < m; j++ )
+      x[i] -= A[i][j] * x[j];
+
+    x[i] /= A[i][i];
+  }
+
+  Real r = 0;
+
+  for( std::size_t j = 0; j < D; j++ )
+  {
+    Real c = 0;
+
+    for( std::size_t i = 0; i < m; i++ )
+      c += x[i] * V[i][j];
+
+    centre[j] = Real( p[j] ) + c;
+    r        += c * c;
+  }
+
+  return r;
+}
+
+/**
+  Checks whether a point is affinely independent of \f$K-1\f$ other
+  points, which are known to be affinely independent.
+*/
+
+template <std::size_t D, std::size_t K> bool isAffinelyIndependent( const std::vector< std::array<double, D> >& points,
+                                                                    const std::vector<std::size_t>& basis,
+                                                                    std::size_t i )
+{
+  std::array<const std::array<double, D>*, K> differences;
+
+  for( std::size_t j = 0; j + 1 < K; j++ )
+    differences[j] = &points[ basis[j+1] ];
+
+  differences[K-1] = &points[i];
+
+  auto&& p = points[ basis.front() ];
+
+  // The Gram matrix of the differences is singular if and only if the
+  // points are affinely dependent; else, its determinant is positive.
+  return sign( InnerProducts<D, K>{ differences, differences, p, p } ) > 0;
+}
+
+/**
+  Finds a maximal set of affinely independent points. The points span
+  the affine hull of all points, whose dimension is one less than the
+  number of points in the set.
+*/
+
+template <std::size_t D> std::vector<std::size_t> affineBasis( const std::vector< std::array<double, D> >& points )
+{
+  std::vector<std::size_t> basis;
+
+  for( std::size_t i = 0; i < points.size() && basis.size() <= D; i++ )
+  {
+    bool independent = false;
+
+    switch( basis.size() )
+    {
+    case 0:
+      independent = true;
+      break;
+    case 1:
+      independent = isAffinelyIndependent<D, 1>( points, basis, i );
+      break;
+    case 2:
+      independent = isAffinelyIndependent<D, 2>( points, basis, i );
+      break;
+    default:
+      independent = isAffinelyIndependent<D, 3>( points, basis, i );
+      break;
+    }
+
+    if( independent )
+      basis.push_back( i );
+  }
+
+  return basis;
+}
+
+/**
+  @class DelaunayTriangulation
+  @brief Incremental Delaunay triangulation in up to three dimensions
+
+  Triangulates points in \f$D\f$ dimensions whose affine hull has
+  dimension \f$K\f$, so the cells of the triangulation are simplices
+  with \f$K+1\f$ vertices. For \f$K < D\f$, e.g. for points on a plane
+  in three dimensions, the predicates are evaluated in the subspace
+  without calculating coordinates with respect to a basis of it.
+
+  Points are inserted using the Bowyer--Watson algorithm: all simplices
+  whose circumsphere contains the new point are removed, and the point
+  is connected to the boundary of the resulting cavity. The simplices
+  that contain the new point are found by a visibility walk.
+
+  The convex hull of the points is handled by an additional *infinite*
+  vertex, which is connected to all facets of the hull. All predicates
+  are evaluated exactly, so the triangulation is valid for degenerate
+  inputs such as co-spherical points, too.
+*/
+
+template <std::size_t D, std::size_t K = D> class DelaunayTriangulation
+{
+public:
+  using Point     = std::array<double, D>;
+  using Simplex   = std::array<std::size_t, K + 1>;
+  using Facet     = std::array<std::size_t, K>;
+
+  /** Index of the infinite vertex */
+  static constexpr std::size_t infinite = std::numeric_limits<std::size_t>::max();
+
+  /**
+    Triangulates a set of points.
+
+    @param points Points to triangulate
+    @param basis  Affinely independent points that span the affine hull
+                  of all points, as calculated by affineBasis()
+
+    @throws std::runtime_error if the triangulation becomes inconsistent,
+    which indicates a bug
+  */
+
+  DelaunayTriangulation( const std::vector<Point>& points, const std::vector<std::size_t>& basis )
+    : _points( points )
+  {
+    auto n = _points.size();
+
+    if( basis.size() != K + 1 )
+      throw std::runtime_error( "Affine basis does not match dimension of triangulation" );
+
+    // Insert points along a space-filling curve in order to keep the
+    // walks between subsequent points short.
+    std::vector<std::size_t> order( n );
+    std::iota( order.begin(), order.end(), std::size_t(0) );
+
+    {
+      Point lower = _points.front();
+      Point upper = _points.front();
+
+      for( auto&& p : _points )
+      {
+        for( std::size_t j = 0; j < D; j++ )
+        {
+          lower[j] = std::min( lower[j], p[j] );
+          upper[j] = std::max( upper[j], p[j] );
+        }
+      }
+
+      std::vector<std::uint64_t> codes( n );
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        std::uint64_t code = 0;
+
+        for( std::size_t j = 0; j < D; j++ )
+        {
+          auto extent = upper[j] - lower[j];
+          auto q      = extent > 0 ? static_cast<std::uint64_t>( ( _points[i][j] - lower[j] ) / extent * 1023 ) : 0;
+
+          for( std::size_t b = 0; b < 10; b++ )
+            code |= ( ( q >> b ) & 1 ) << ( b * D + j );
+        }
+
+        codes[i] = code;
+      }
+
+      std::stable_sort( order.begin(), order.end(), [&codes] ( std::size_t i, std::size_t j ) { return codes[i] < codes[j]; } );
+    }
+
+    Simplex initial;
+    std::copy( basis.begin(), basis.end(), initial.begin() );
+
+    this->initialSimplex( initial );
+
+    for( auto&& i : order )
+    {
+      if( std::find( initial.begin(), initial.end(), i ) == initial.end() )
+        this->insert( i );
+    }
+  }
+
+  /** @returns All finite simplices of the triangulation */
+  std::vector<Simplex> simplices() const
+  {
+    std::vector<Simplex> result;
+
+    for( std::size_t c = 0; c < _cells.size(); c++ )
+    {
+      if( _alive[c] && !this->isInfinite( c ) )
+        result.push_back( _cells[c].vertices );
+    }
+
+    return result;
+  }
+
+  /**
+    @returns Pairs of duplicate points and the indices of the points
+    they duplicate. Duplicate points are not part of the triangulation.
+  */
+
+  const std::vector< std::pair<std::size_t, std::size_t> >& duplicates() const noexcept
+  {
+    return _duplicates;
+  }
+
+  /**
+    Checks the triangulation for consistency. Neighbouring cells must
+    refer to each other via the same facet, finite cells must not be
+    degenerate, every point must be a vertex or a duplicate, and every
+    cell must be locally Delaunay, i.e. no vertex of a neighbouring
+    cell may be in conflict with it. By the Delaunay lemma, the last
+    condition implies that the triangulation is a Delaunay triangulation.
+  */
+
+  bool isValid() const
+  {
+    std::vector<bool> used( _points.size(), false );
+
+    for( auto&& pair : _duplicates )
+      used[ pair.first ] = true;
+
+    for( std::size_t c = 0; c < _cells.size(); c++ )
+    {
+      if( !_alive[c] )
+        continue;
+
+      for( std::size_t i = 0; i <= K; i++ )
+      {
+        auto n = _cells[c].neighbours[i];
+
+        if( n >= _cells.size() || !_alive[n] )
+          return false;
+
+        auto&& neighbours = _cells[n].neighbours;
+        auto it           = std::find( neighbours.begin(), neighbours.end(), c );
+
+        if( it == neighbours.end() )
+          return false;
+
+        auto j = static_cast<std::size_t>( it - neighbours.begin() );
+        auto F = this->facet( c, i );
+        auto G = this->facet( n, j );
+
+        std::sort( F.begin(), F.end() );
+        std::sort( G.begin(), G.end() );
+
+        if( F != G )
+          return false;
+
+        auto w = _cells[n].vertices[j];
+
+        if( w != infinite && this->inConflict( c, _points[w] ) )
+          return false;
+      }
+
+      for( auto&& v : _cells[c].vertices )
+      {
+        if( v != infinite )
+          used[v] = true;
+      }
+
+      if( !this->isInfinite( c ) && this->isDegenerate( c ) )
+        return false;
+    }
+
+    return std::find( used.begin(), used.end(), false ) == used.end();
+  }
+
+private:
+
+  struct Cell
+  {
+    Simplex vertices;
+    Simplex neighbours;
+  };
+
+  bool isInfinite( std::size_t c ) const
+  {
+    auto&& vertices = _cells[c].vertices;
+    return std::find( vertices.begin(), vertices.end(), infinite ) != vertices.end();
+  }
+
+  /** @returns Facet of a cell opposite to one of its vertices */
+  Facet facet( std::size_t c, std::size_t i ) const
+  {
+    Facet result;
+
+    for( std::size_t j = 0, k = 0; j <= K; j++ )
+      if( j != i )
+        result[k++] = _cells[c].vertices[j];
+
+    return result;
+  }
+
+  template <std::size_t N> std::array<const Point*, N> pointers( const std::array<std::size_t, N>& vertices ) const
+  {
+    std::array<const Point*, N> result;
+
+    for( std::size_t i = 0; i < N; i++ )
+      result[i] = &_points[ vertices[i] ];
+
+    return result;
+  }
+
+  /**
+    Checks on which side of the hyperplane through a facet a point is,
+    in comparison to a reference point that is known not to lie on the
+    hyperplane.
+
+    @returns 1 if both points are on the same side, -1 if they are on
+    different sides, and 0 if the point lies on the hyperplane
+  */
+
+  int side( const Facet& facet, const Point& p, const Point& q ) const
+  {
+    return this->side( this->pointers( facet ), p, q, std::integral_constant<bool, K == D>() );
+  }
+
+  int side( const std::array<const Point*, K>& F, const Point& p, const Point& q, std::true_type ) const
+  {
+    return sign( Orientation<D>{ F, p } ) * sign( Orientation<D>{ F, q } );
+  }
+
+  int side( const std::array<const Point*, K>& F, const Point& p, const Point& q, std::false_type ) const
+  {
+    return sign( InnerProducts<D, K>{ F, F, p, q } );
+  }
+
+  /** Checks whether a point is strictly inside the circumsphere of a finite cell */
+  bool inSphere( std::size_t c, const Point& p ) const
+  {
+    return this->inSphere( this->pointers( _cells[c].vertices ), p, std::integral_constant<bool, K == D>() );
+  }
+
+  bool inSphere( const std::array<const Point*, K + 1>& S, const Point& p, std::true_type ) const
+  {
+    std::array<const Point*, K> F;
+    std::copy( S.begin(), S.begin() + K, F.begin() );
+
+    // The sign of the lifted determinant depends on the orientation of
+    // the cell.
+    return sign( InSphere<D>{ S, p } ) * sign( Orientation<D>{ F, *S[K] } ) > 0;
+  }
+
+  bool inSphere( const std::array<const Point*, K + 1>& S, const Point& p, std::false_type ) const
+  {
+    return sign( InSubspaceSphere<D, K>{ S, p } ) > 0;
+  }
+
+  /** Checks whether the vertices of a finite cell are affinely dependent */
+  bool isDegenerate( std::size_t c ) const
+  {
+    auto&& vertices = _cells[c].vertices;
+    auto F          = this->facet( c, K );
+
+    return this->side( F, _points[ vertices[K] ], _points[ vertices[K] ] ) == 0;
+  }
+
+  /** Checks whether a point is strictly inside the circumsphere of a cell */
+  bool inConflict( std::size_t c, const Point& p ) const
+  {
+    auto&& vertices = _cells[c].vertices;
+    auto it         = std::find( vertices.begin(), vertices.end(), infinite );
+
+    // For infinite cells, the circumsphere degenerates to the half-space
+    // beyond the hull facet. Points on the boundary of the half-space are
+    // in conflict if they are inside the circumsphere of the facet, which
+    // is the case if and only if they are inside the circumsphere of the
+    // finite cell on the other side of the facet.
+    if( it != vertices.end() )
+    {
+      auto i = static_cast<std::size_t>( it - vertices.begin() );
+      auto F = this->facet( c, i );
+      auto n = _cells[c].neighbours[i];
+      auto v = *std::find_if( _cells[n].vertices.begin(), _cells[n].vertices.end(), [&F] ( std::size_t u ) { return std::find( F.begin(), F.end(), u ) == F.end(); } );
+      auto s = this->side( F, p, _points[v] );
+
+      if( s != 0 )
+        return s < 0;
+
+      return this->inSphere( n, p );
+    }
+
+    return this->inSphere( c, p );
+  }
+
+  std::size_t createCell( const Simplex& vertices )
+  {
+    Cell cell;
+    cell.vertices = vertices;
+    cell.neighbours.fill( infinite );
+
+    if( !_free.empty() )
+    {
+      auto c = _free.back();
+      _free.pop_back();
+
+      _cells[c] = cell;
+      _alive[c] = true;
+      return c;
+    }
+
+    _cells.push_back( cell );
+    _alive.push_back( true );
+    _stamps.push_back( 0 );
+
+    return _cells.size() - 1;
+  }
+
+  /**
+    Connects the facets of new cells that are not connected yet by
+    matching their vertices.
+
+    @throws std::runtime_error if a facet remains unmatched
+  */
+
+  void connect( const std::vector<std::size_t>& cells )
+  {
+    // The number of new cells is small, so a linear search is faster
+    // than a map.
+    std::vector< std::pair< Facet, std::pair<std::size_t, std::size_t> > > facets;
+
+    for( auto&& c : cells )
+    {
+      for( std::size_t i = 0; i <= K; i++ )
+      {
+        if( _cells[c].neighbours[i] != infinite )
+          continue;
+
+        auto F = this->facet( c, i );
+        std::sort( F.begin(), F.end() );
+
+        auto it = std::find_if( facets.begin(), facets.end(), [&F] ( const std::pair< Facet, std::pair<std::size_t, std::size_t> >& pair ) { return pair.first == F; } );
+
+        if( it == facets.end() )
+          facets.push_back( std::make_pair( F, std::make_pair( c, i ) ) );
+        else
+        {
+          _cells[c].neighbours[i]                                    = it->second.first;
+          _cells[ it->second.first ].neighbours[ it->second.second ] = c;
+
+          *it = facets.back();
+          facets.pop_back();
+        }
+      }
+    }
+
+    if( !facets.empty() )
+      throw std::runtime_error( "Inconsistent Delaunay triangulation: unmatched facet" );
+  }
+
+  /**
+    Creates the initial triangulation, consisting of a simplex and the
+    infinite cells that are connected to its facets.
+  */
+
+  void initialSimplex( const Simplex& simplex )
+  {
+    std::vector<std::size_t> cells;
+    cells.push_back( this->createCell( simplex ) );
+
+    for( std::size_t i = 0; i <= K; i++ )
+    {
+      auto vertices = simplex;
+      vertices[i]   = infinite;
+
+      auto c = this->createCell( vertices );
+
+      _cells[c].neighbours[i]     = cells.front();
+      _cells[ cells.front() ].neighbours[i] = c;
+
+      cells.push_back( c );
+    }
+
+    this->connect( cells );
+
+    _last = cells.front();
+  }
+
+  /**
+    Walks from the last cell towards a point.
+
+    @returns Cell that is in conflict with the point, or `infinite` if
+    the point duplicates a vertex of the triangulation. In this case,
+    the duplicated vertex is stored in \p duplicate.
+
+    @throws std::runtime_error if the point is neither in conflict with
+    any cell nor a duplicate, which indicates a bug
+  */
+
+  std::size_t locate( const Point& p, std::size_t& duplicate ) const
+  {
+    auto c = _last;
+
+    if( !_alive[c] )
+      c = 0;
+
+    while( !_alive[c] )
+      ++c;
+
+    if( this->isInfinite( c ) )
+    {
+      auto&& vertices = _cells[c].vertices;
+      c               = _cells[c].neighbours[ static_cast<std::size_t>( std::find( vertices.begin(), vertices.end(), infinite ) - vertices.begin() ) ];
+    }
+
+    // Since the predicates are exact, the walk terminates in a Delaunay
+    // triangulation. It ends in an infinite cell if the point is outside
+    // the convex hull, or in a finite cell that contains the point. The
+    // number of steps is bounded nonetheless.
+    bool moved = true;
+
+    for( std::size_t steps = 0; moved && steps <= _cells.size(); steps++ )
+    {
+      moved = false;
+
+      for( std::size_t k = 0; k <= K; k++ )
+      {
+        auto i = ( k + steps ) % ( K + 1 );
+
+        if( this->side( this->facet( c, i ), p, _points[ _cells[c].vertices[i] ] ) < 0 )
+        {
+          c     = _cells[c].neighbours[i];
+          moved = true;
+
+          if( this->isInfinite( c ) )
+            return c;
+
+          break;
+        }
+      }
+    }
+
+    if( !moved )
+    {
+      // A point inside a cell or on its boundary is in conflict with the
+      // cell, unless it coincides with one of its vertices.
+      for( auto&& v : _cells[c].vertices )
+      {
+        if( _points[v] == p )
+        {
+          duplicate = v;
+          return infinite;
+        }
+      }
+
+      return c;
+    }
+
+    for( c = 0; c < _cells.size(); c++ )
+      if( _alive[c] && this->inConflict( c, p ) )
+        return c;
+
+    // Only duplicate points are not in conflict with any cell
+    for( c = 0; c < _cells.size(); c++ )
+    {
+      if( !_alive[c] )
+        continue;
+
+      for( auto&& v : _cells[c].vertices )
+      {
+        if( v != infinite && _points[v] == p )
+        {
+          duplicate = v;
+          return infinite;
+        }
+      }
+    }
+
+    throw std::runtime_error( "Inconsistent Delaunay triangulation: unable to locate point" );
+  }
+
+  void insert( std::size_t v )
+  {
+    auto&& p = _points[v];
+
+    std::size_t duplicate = infinite;
+    auto start            = this->locate( p, duplicate );
+
+    if( start == infinite )
+    {
+      _duplicates.push_back( std::make_pair( v, duplicate ) );
+      return;
+    }
+
+    // Find all cells in conflict with the new point; they form a
+    // connected cavity.
+    ++_stamp;
+
+    std::vector<std::size_t> cavity;
+    std::vector< std::pair<std::size_t, std::size_t> > boundary;
+    std::vector<std::size_t> stack( 1, start );
+
+    _stamps[start] = _stamp;
+
+    while( !stack.empty() )
+    {
+      auto c = stack.back();
+      stack.pop_back();
+
+      cavity.push_back( c );
+
+      for( std::size_t i = 0; i <= K; i++ )
+      {
+        auto n = _cells[c].neighbours[i];
+
+        if( n >= _cells.size() || !_alive[n] )
+          throw std::runtime_error( "Inconsistent Delaunay triangulation: missing neighbour" );
+
+        if( _stamps[n] == _stamp )
+          continue;
+
+        if( this->inConflict( n, p ) )
+        {
+          _stamps[n] = _stamp;
+          stack.push_back( n );
+        }
+        else
+          boundary.push_back( std::make_pair( c, i ) );
+      }
+    }
+
+    // Every facet of the cavity boundary results in a new cell that is
+    // connected to the cell outside of the cavity.
+    std::vector<std::size_t> cells;
+
+    for( auto&& pair : boundary )
+    {
+      auto c        = pair.first;
+      auto i        = pair.second;
+      auto outside  = _cells[c].neighbours[i];
+      auto vertices = _cells[c].vertices;
+      vertices[i]   = v;
+
+      auto d = this->createCell( vertices );
+
+      _cells[d].neighbours[i] = outside;
+
+      for( auto&& n : _cells[outside].neighbours )
+        if( n == c )
+          n = d;
+
+      cells.push_back( d );
+    }
+
+    for( auto&& c : cavity )
+    {
+      _alive[c] = false;
+      _free.push_back( c );
+    }
+
+    // Every new cell must be connected to other new cells via all of its
+    // facets that contain the new point.
+    this->connect( cells );
+
+    _last = cells.front();
+  }
+
+  const std::vector<Point>& _points;
+
+  std::vector<Cell> _cells;
+  std::vector<bool> _alive;
+  std::vector<std::size_t> _free;
+
+  std::vector<std::size_t> _stamps;
+  std::size_t _stamp = 0;
+
+  std::size_t _last = 0;
+
+  std::vector< std::pair<std::size_t, std::size_t> > _duplicates;
+};
+
+template <std::size_t D, std::size_t K> constexpr std::size_t DelaunayTriangulation<D, K>::infinite;
+
+/**
+  Calculates the simplices of the alpha complex of a set of points whose
+  affine hull has dimension \f$K\f$, along with the squared radii of the
+  smallest empty circumspheres, which determine their alpha values.
+*/
+
+template <std::size_t D, std::size_t K> std::vector< std::pair< std::vector<std::size_t>, Real > > alphaComplex( const std::vector< std::array<double, D> >& points,
+                                                                                                                 const std::vector<std::size_t>& basis )
+{
+  using Point   = std::array<double, D>;
+  using Centre  = std::array<Real, D>;
+  using Simplex = std::array<std::size_t, K + 1>;
+  using Record  = std::pair<Simplex, Real>;
+
+  constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+  DelaunayTriangulation<D, K> triangulation( points, basis );
+
+  std::vector< std::pair< std::vector<std::size_t>, Real > > result;
+
+  for( std::size_t i = 0; i < points.size(); i++ )
+    result.push_back( std::make_pair( std::vector<std::size_t>( 1, i ), Real() ) );
+
+  for( auto&& pair : triangulation.duplicates() )
+    result.push_back( std::make_pair( std::vector<std::size_t>( { pair.second, pair.first } ), Real() ) );
+
+  auto squaredRadius = [&points] ( const Simplex& simplex, std::size_t k, Centre& centre )
+  {
+    std::array<const Point*, K + 1> vertices;
+
+    for( std::size_t i = 0; i < k; i++ )
+      vertices[i] = &points[ simplex[i] ];
+
+    return circumsphere<D>( vertices.data(), k, centre );
+  };
+
+  // Top-dimensional simplices get the radius of their circumsphere.
+  std::vector<Record> current;
+
+  for( auto&& simplex : triangulation.simplices() )
+  {
+    auto s = simplex;
+    std::sort( s.begin(), s.end() );
+
+    Centre centre;
+    current.push_back( std::make_pair( s, squaredRadius( s, K + 1, centre ) ) );
+  }
+
+  // Lower-dimensional simplices get the radius of their smallest
+  // circumsphere if it is empty, i.e. if the simplex is *Gabriel*.
+  // Else, they are *attached* to one of their co-faces and get the
+  // smallest value of all co-faces.
+  for( std::size_t k = K + 1; k >= 2; k-- )
+  {
+    for( auto&& record : current )
+    {
+      std::vector<std::size_t> vertices( record.first.begin(), record.first.begin() + static_cast<std::ptrdiff_t>( k ) );
+      result.push_back( std::make_pair( vertices, record.second ) );
+    }
+
+    if( k == 2 )
+      break;
+
+    struct Face
+    {
+      Simplex simplex;
+      Real value;
+      std::size_t opposite;
+    };
+
+    std::vector<Face> faces;
+    faces.reserve( current.size() * k );
+
+    for( auto&& record : current )
+    {
+      for( std::size_t i = 0; i < k; i++ )
+      {
+        Face face;
+        face.simplex.fill( none );
+
+        for( std::size_t j = 0, l = 0; j < k; j++ )
+          if( j != i )
+            face.simplex[l++] = record.first[j];
+
+        face.value    = record.second;
+        face.opposite = record.first[i];
+
+        faces.push_back( face );
+      }
+    }
+
+    std::sort( faces.begin(), faces.end(), [] ( const Face& a, const Face& b ) { return a.simplex < b.simplex; } );
+
+    std::vector<Record> next;
+
+    for( std::size_t i = 0; i < faces.size(); )
+    {
+      auto j = i;
+
+      Centre centre;
+      auto r        = squaredRadius( faces[i].simplex, k - 1, centre );
+      auto minimum  = faces[i].value;
+      bool attached = false;
+
+      for( ; j < faces.size() && faces[j].simplex == faces[i].simplex; j++ )
+      {
+        auto&& q = points[ faces[j].opposite ];
+        Real d   = 0;
+
+        for( std::size_t l = 0; l < D; l++ )
+          d += ( Real( q[l] ) - centre[l] ) * ( Real( q[l] ) - centre[l] );
+
+        minimum  = std::min( minimum, faces[j].value );
+        attached = attached || d < r;
+      }
+
+      // The smallest circumsphere of a face is never larger than the
+      // circumspheres of its co-faces. Taking the minimum ensures that
+      // rounding errors do not violate the filtration order.
+      next.push_back( std::make_pair( faces[i].simplex, attached ? minimum : std::min( r, minimum ) ) );
+      i = j;
+    }
+
+    current.swap( next );
+  }
+
+  return result;
+}
+
+/**
+  Calculates the simplices of the alpha complex of a set of points in
+  \f$D\f$ dimensions, regardless of the dimension of their affine hull.
+  The dimension is determined at runtime and mapped to the corresponding
+  triangulation.
+*/
+
+template <std::size_t D, std::size_t K = D> struct AlphaComplexBuilder
+{
+  static std::vector< std::pair< std::vector<std::size_t>, Real > > build( const std::vector< std::array<double, D> >& points,
+                                                                            const std::vector<std::size_t>& basis )
+  {
+    if( basis.size() == K + 1 )
+      return alphaComplex<D, K>( points, basis );
+    else
+      return AlphaComplexBuilder<D, K - 1>::build( points, basis );
+  }
+};
+
+template <std::size_t D> struct AlphaComplexBuilder<D, 0>
+{
+  static std::vector< std::pair< std::vector<std::size_t>, Real > > build( const std::vector< std::array<double, D> >& points,
+                                                                            const std::vector<std::size_t>& basis )
+  {
+    // All points coincide, so they are duplicates of the first one.
+    std::vector< std::pair< std::vector<std::size_t>, Real > > result;
+
+    for( std::size_t i = 0; i < points.size(); i++ )
+      result.push_back( std::make_pair( std::vector<std::size_t>( 1, i ), Real() ) );
+
+    for( std::size_t i = 0; i < points.size(); i++ )
+    {
+      if( i != basis.front() )
+        result.push_back( std::make_pair( std::vector<std::size_t>( { basis.front(), i } ), Real() ) );
+    }
+
+    return result;
+  }
+};
+
+template <std::size_t D> std::vector< std::pair< std::vector<std::size_t>, Real > > alphaComplex( const std::vector< std::array<double, D> >& points )
+{
+  return AlphaComplexBuilder<D>::build( points, affineBasis( points ) );
+}
+
+} // namespace detail
+
+/**
+  Builds the alpha complex of a two-dimensional or three-dimensional
+  point cloud. The alpha complex is a subcomplex of the Delaunay
+  triangulation of the points. It has the same persistent homology as
+  the Čech complex but its size is linear in the number of points for
+  most inputs.
+
+  The simplices of the Delaunay triangulation are assigned the radius of
+  the smallest empty sphere that passes through their vertices. In order
+  to be consistent with `buildCechComplex()`, twice the radius is used
+  as the data of a simplex, so both complexes result in the same
+  persistence diagrams.
+
+  Duplicate points are connected to the point they duplicate by an edge
+  that appears at zero. If the points lie in a lower-dimensional affine
+  subspace, e.g. on a line or in a plane, the complex is calculated in
+  this subspace, so it does not contain any simplices of the dimension
+  of the points.
+
+  The Delaunay triangulation uses exact predicates, so the complex is
+  valid for degenerate inputs as well. Coordinates are rounded to
+  double precision for this purpose.
+
+  @param container Container with points in two or three dimensions
+
+  @returns Alpha complex, sorted according to the data of its simplices
+*/
+
+template <class Container> auto buildAlphaComplex( const Container& container ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, typename Container::IndexType> >
+{
+  using ElementType       = typename Container::ElementType;
+  using IndexType         = typename Container::IndexType;
+  using Simplex           = topology::Simplex<ElementType, IndexType>;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  auto n = container.size();
+  auto D = container.dimension();
+
+  if( D != 2 && D != 3 )
+    throw std::runtime_error( "Alpha complex is only supported for two or three dimensions" );
+
+  if( n == 0 )
+    return {};
+
+  std::vector< std::pair< std::vector<std::size_t>, detail::Real > > simplices;
+
+  if( D == 2 )
+  {
+    std::vector< std::array<double, 2> > points( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto&& p = container[ static_cast<IndexType>( i ) ];
+      points[i] = { { static_cast<double>( p[0] ), static_cast<double>( p[1] ) } };
+    }
+
+    simplices = detail::alphaComplex<2>( points );
+  }
+  else
+  {
+    std::vector< std::array<double, 3> > points( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto&& p = container[ static_cast<IndexType>( i ) ];
+      points[i] = { { static_cast<double>( p[0] ), static_cast<double>( p[1] ), static_cast<double>( p[2] ) } };
+    }
+
+    simplices = detail::alphaComplex<3>( points );
+  }
+
+  std::vector<Simplex> result;
+  result.reserve( simplices.size() );
+
+  for( auto&& pair : simplices )
+  {
+    std::vector<IndexType> vertices;
+
+    for( auto&& v : pair.first )
+      vertices.push_back( static_cast<IndexType>( v ) );
+
+    result.push_back( Simplex( vertices.begin(), vertices.end(), static_cast<ElementType>( 2 * std::sqrt( pair.second ) ) ) );
+  }
+
+  SimplicialComplex K( result.begin(), result.end() );
+  K.sort( topology::filtrations::Data<Simplex>() );
+
+  return K;
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
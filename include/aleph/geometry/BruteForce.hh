@@ -5,8 +5,18 @@
 #include <aleph/geometry/distances/Traits.hh>
 
 #include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
 #include <vector>
 
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
 namespace aleph
 {
 
@@ -21,6 +31,16 @@ namespace geometry
   available for the calculation of nearest neighbours. This class
   enumerates all pairs of points in order to determine those that
   are within the specified radius of each other.
+
+  Points are partitioned into tiles of consecutive points, which are
+  small enough to stay in the cache. Every pair of tiles is processed
+  exactly once, and every pair of points is evaluated exactly once, so
+  the distance functor is assumed to be symmetric. Pairs of tiles are
+  scheduled in rounds of disjoint tiles, which permits processing the
+  tiles of every round in parallel without any synchronization.
+
+  The container is required to store its points contiguously, and to
+  provide access to them via `data()`.
 */
 
 template <class Container, class DistanceFunctor>
@@ -31,91 +51,252 @@ public:
   using ElementType     = typename Container::ElementType;
   using Traits          = aleph::geometry::distances::Traits<DistanceFunctor>;
   using Distance        = DistanceFunctor;
+  using NeighbourList   = aleph::geometry::NeighbourList<IndexType, ElementType>;
 
   explicit BruteForce( const Container& container )
     : _container( container )
   {
   }
 
-  void radiusSearch( ElementType radius,
-                     std::vector< std::vector<IndexType> >& indices,
-                     std::vector< std::vector<ElementType> >& distances ) const
+  /**
+    Determines all neighbours of every point whose distance is strictly
+    less than the specified radius. Neighbours are reported in ascending
+    order of their indices; every point is a neighbour of itself unless
+    the radius is zero.
+  */
+
+  void radiusSearch( ElementType radius, NeighbourList& result ) const
   {
-    indices.clear();
-    distances.clear();
+    using ResultType = typename DistanceFunctor::ResultType;
 
-    indices.resize( this->size() );
-    distances.resize( this->size() );
+    struct Pair
+    {
+      IndexType   i;
+      IndexType   j;
+      ElementType d;
+    };
 
-    auto D               = _container.dimension();
-    DistanceFunctor dist = DistanceFunctor();
+    auto rounds = this->schedule();
+
+    std::vector< std::vector<Pair> > buffers;
+
+    #pragma omp parallel
+    {
+      std::vector<Pair> buffer;
+
+      for( auto&& round : rounds )
+      {
+        #pragma omp for schedule(dynamic)
+        for( long t = 0; t < static_cast<long>( round.size() ); t++ )
+        {
+          auto&& tile = round[ static_cast<std::size_t>( t ) ];
+
+          this->traverse( tile.first, tile.second,
+                          [this, &buffer, &radius] ( IndexType i, IndexType j, ResultType d )
+                          {
+                            // Comparing converted distances ensures that
+                            // the results do not depend on the rounding
+                            // of the radius.
+                            auto e = static_cast<ElementType>( _traits.from( d ) );
+
+                            if( e < radius )
+                              buffer.push_back( { i, j, e } );
+                          } );
+        }
+      }
+
+      #pragma omp critical
+      buffers.push_back( std::move( buffer ) );
+    }
+
+    // Scatter the pairs to both of their points -----------------------
 
-    for( IndexType i = 0; i < this->size(); i++ )
+    auto n = this->size();
+
+    result.offsets.assign( n + 1, 0 );
+
+    for( auto&& buffer : buffers )
     {
-      // I am not making any assumptions about the distance functor
-      // here. If it is not symmetric---and hence not a metric---we
-      // really need to traverse all pairs.
-      for( IndexType j = 0; j < this->size(); j++ )
+      for( auto&& pair : buffer )
       {
-        auto d = dist( _container[i].begin(),
-                       _container[j].begin(),
-                       D );
+        ++result.offsets[ pair.i + 1 ];
 
-        d = _traits.from( d );
+        if( pair.i != pair.j )
+          ++result.offsets[ pair.j + 1 ];
+      }
+    }
 
-        if( d < radius )
+    std::partial_sum( result.offsets.begin(), result.offsets.end(), result.offsets.begin() );
+
+    result.indices.resize( result.offsets.back() );
+    result.distances.resize( result.offsets.back() );
+
+    {
+      std::vector<std::size_t> cursors( result.offsets.begin(), result.offsets.end() - 1 );
+
+      for( auto&& buffer : buffers )
+      {
+        for( auto&& pair : buffer )
         {
-          indices[i].push_back( j );
-          distances[i].push_back( d );
+          auto d = pair.d;
+
+          result.indices[ cursors[pair.i] ]     = pair.j;
+          result.distances[ cursors[pair.i]++ ] = d;
+
+          if( pair.i != pair.j )
+          {
+            result.indices[ cursors[pair.j] ]     = pair.i;
+            result.distances[ cursors[pair.j]++ ] = d;
+          }
+        }
+
+        // Release memory as early as possible because the neighbour list
+        // requires twice as much storage.
+        std::vector<Pair>().swap( buffer );
+      }
+    }
+
+    // Sort neighbours by their indices --------------------------------
+
+    #pragma omp parallel
+    {
+      std::vector< std::pair<IndexType, ElementType> > neighbours;
+
+      #pragma omp for schedule(dynamic, 64)
+      for( long t = 0; t < static_cast<long>( n ); t++ )
+      {
+        auto i     = static_cast<std::size_t>( t );
+        auto begin = result.offsets[i];
+        auto end   = result.offsets[i+1];
+
+        neighbours.clear();
+
+        for( auto k = begin; k < end; k++ )
+          neighbours.push_back( std::make_pair( result.indices[k], result.distances[k] ) );
+
+        std::sort( neighbours.begin(), neighbours.end() );
+
+        for( auto k = begin; k < end; k++ )
+        {
+          result.indices[k]   = neighbours[k - begin].first;
+          result.distances[k] = neighbours[k - begin].second;
         }
       }
     }
   }
 
-  void neighbourSearch( unsigned k,
-                        std::vector< std::vector<IndexType> >& indices,
-                        std::vector< std::vector<ElementType> >& distances ) const
+  /** @overload radiusSearch() */
+  void radiusSearch( ElementType radius,
+                     std::vector< std::vector<IndexType> >& indices,
+                     std::vector< std::vector<ElementType> >& distances ) const
   {
-    indices.clear();
-    distances.clear();
+    NeighbourList result;
 
-    indices.resize( this->size() );
-    distances.resize( this->size() );
+    this->radiusSearch( radius, result );
+    result.unpack( indices, distances );
+  }
 
-    auto D               = _container.dimension();
-    DistanceFunctor dist = DistanceFunctor();
+  /**
+    Determines the \f$k\f$ nearest neighbours of every point, including
+    the point itself. Neighbours are reported in ascending order of their
+    distances; ties are broken by index. If \f$k\f$ exceeds the number of
+    points, all points will be reported.
+  */
+
+  void neighbourSearch( unsigned k, NeighbourList& result ) const
+  {
+    using ResultType = typename DistanceFunctor::ResultType;
+
+    auto n = this->size();
+    auto m = std::min( std::size_t( k ), n );
 
-    for( IndexType i = 0; i < this->size(); i++ )
+    result.offsets.resize( n + 1 );
+
+    for( std::size_t i = 0; i <= n; i++ )
+      result.offsets[i] = i * m;
+
+    result.indices.resize( n * m );
+    result.distances.resize( n * m );
+
+    if( m == 0 )
+      return;
+
+    // Every point keeps a bounded max-heap of its current candidates, so
+    // the largest distance can be replaced quickly. Since the tiles of a
+    // round are disjoint, every heap is modified by one thread only.
+    std::vector< std::pair<ResultType, IndexType> > heaps( n * m );
+    std::vector<std::size_t> sizes( n );
+
+    auto offer = [&heaps, &sizes, &m] ( IndexType i, IndexType j, ResultType d )
     {
-      // I am not making any assumptions about the distance functor
-      // here. If it is not symmetric---and hence not a metric---we
-      // really need to traverse all pairs.
-      for( IndexType j = 0; j < this->size(); j++ )
+      auto first     = heaps.begin() + static_cast<std::ptrdiff_t>( i * m );
+      auto candidate = std::make_pair( d, j );
+
+      if( sizes[i] < m )
+      {
+        first[ static_cast<std::ptrdiff_t>( sizes[i]++ ) ] = candidate;
+        std::push_heap( first, first + static_cast<std::ptrdiff_t>( sizes[i] ) );
+      }
+      else if( candidate < *first )
       {
-        auto d = dist( _container[i].begin(),
-                       _container[j].begin(),
-                       D );
+        std::pop_heap( first, first + static_cast<std::ptrdiff_t>( m ) );
+        first[ static_cast<std::ptrdiff_t>( m - 1 ) ] = candidate;
+        std::push_heap( first, first + static_cast<std::ptrdiff_t>( m ) );
+      }
+    };
 
-        d = _traits.from( d );
+    auto rounds = this->schedule();
 
-        indices[i].push_back( j );
-        distances[i].push_back( d );
+    #pragma omp parallel
+    {
+      for( auto&& round : rounds )
+      {
+        #pragma omp for schedule(dynamic)
+        for( long t = 0; t < static_cast<long>( round.size() ); t++ )
+        {
+          auto&& tile = round[ static_cast<std::size_t>( t ) ];
+
+          this->traverse( tile.first, tile.second,
+                          [&offer] ( IndexType i, IndexType j, ResultType d )
+                          {
+                            offer( i, j, d );
+
+                            if( i != j )
+                              offer( j, i, d );
+                          } );
+        }
       }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for( long t = 0; t < static_cast<long>( n ); t++ )
+    {
+      auto i     = static_cast<std::size_t>( t );
+      auto first = heaps.begin() + static_cast<std::ptrdiff_t>( i * m );
 
-      std::sort( indices[i].begin(), indices[i].end(),
-                 [&distances, &i] ( IndexType k, IndexType l )
-                 {
-                   return distances[i][k] < distances[i][l];
-                 }
-      );
+      std::sort_heap( first, first + static_cast<std::ptrdiff_t>( m ) );
 
-      std::sort( distances[i].begin(), distances[i].end() );
+      for( std::size_t l = 0; l < m; l++ )
+      {
+        auto&& candidate = first[ static_cast<std::ptrdiff_t>( l ) ];
 
-      distances[i].erase( distances[i].begin() + k, distances[i].end() );
-      indices[i].erase( indices[i].begin() + k, indices[i].end() );
+        result.indices[i * m + l]   = candidate.second;
+        result.distances[i * m + l] = static_cast<ElementType>( _traits.from( candidate.first ) );
+      }
     }
   }
 
+  /** @overload neighbourSearch() */
+  void neighbourSearch( unsigned k,
+                        std::vector< std::vector<IndexType> >& indices,
+                        std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->neighbourSearch( k, result );
+    result.unpack( indices, distances );
+  }
+
   std::size_t size() const noexcept
   {
     return _container.size();
@@ -123,6 +304,77 @@ public:
 
 private:
 
+  /** Number of points in every tile */
+  static constexpr std::size_t tileSize = 64;
+
+  /**
+    Creates rounds of pairs of tiles such that every pair of tiles occurs
+    exactly once and the tiles of every round are pairwise disjoint. The
+    first round contains the diagonal pairs; the remaining rounds follow
+    the circle method for round-robin tournaments.
+  */
+
+  std::vector< std::vector< std::pair<std::size_t, std::size_t> > > schedule() const
+  {
+    auto numTiles = ( this->size() + tileSize - 1 ) / tileSize;
+
+    std::vector< std::vector< std::pair<std::size_t, std::size_t> > > rounds( 1 );
+
+    for( std::size_t I = 0; I < numTiles; I++ )
+      rounds.front().push_back( std::make_pair( I, I ) );
+
+    if( numTiles < 2 )
+      return rounds;
+
+    // Add a dummy tile for an odd number of tiles; pairs involving this
+    // tile are skipped.
+    auto m = numTiles + ( numTiles % 2 );
+
+    for( std::size_t r = 0; r < m - 1; r++ )
+    {
+      std::vector< std::pair<std::size_t, std::size_t> > round;
+
+      for( std::size_t p = 0; p < m / 2; p++ )
+      {
+        auto I = p == 0 ? m - 1 : ( r + p ) % ( m - 1 );
+        auto J = p == 0 ? r     : ( r + m - 1 - p ) % ( m - 1 );
+
+        if( I < numTiles && J < numTiles )
+          round.push_back( std::make_pair( std::min( I, J ), std::max( I, J ) ) );
+      }
+
+      rounds.push_back( round );
+    }
+
+    return rounds;
+  }
+
+  /**
+    Evaluates the distances of all pairs of points of two tiles and
+    reports them to a functor. If both tiles coincide, every unordered
+    pair is reported once, including the pairs of points with themselves.
+  */
+
+  template <class Functor> void traverse( std::size_t I, std::size_t J, Functor f ) const
+  {
+    auto n      = this->size();
+    auto D      = _container.dimension();
+    auto points = _container.data();
+
+    DistanceFunctor dist = DistanceFunctor();
+
+    auto endI = std::min( n, ( I + 1 ) * tileSize );
+    auto endJ = std::min( n, ( J + 1 ) * tileSize );
+
+    for( auto i = I * tileSize; i < endI; i++ )
+    {
+      auto p = points + i * D;
+
+      for( auto j = I == J ? i : J * tileSize; j < endJ; j++ )
+        f( i, j, dist( p, points + j * D, D ) );
+    }
+  }
+
   /** Reference to the original container */
   const Container& _container;
 
@@ -130,8 +382,12 @@ private:
   Traits _traits;
 };
 
+template <class Container, class DistanceFunctor> constexpr std::size_t BruteForce<Container, DistanceFunctor>::tileSize;
+
 } // namespace geometry
 
 } // namespace aleph
 
+#pragma GCC diagnostic pop
+
 #endif
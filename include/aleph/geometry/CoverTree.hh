@@ -10,6 +10,8 @@
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // FIXME: remove after debugging
@@ -37,6 +39,11 @@ namespace geometry
   This implementation attempts to be as generic as possible. It uses
   the simplified description of the cover tree, as given by Izbicki,
   Shelton in "Faster Cover Trees".
+
+  The metric is a functor that calculates the distance between two
+  points. It is not required to be stateless, so it may, for example,
+  refer to the coordinates of points that are only stored as indices.
+  Queries require the metric to satisfy the triangle inequality.
 */
 
 template <class Point, class Metric> class CoverTree
@@ -51,6 +58,23 @@ public:
 
   constexpr static const double coveringConstant = 2.0;
 
+  /** Type of the distances that are calculated by the metric */
+  using DistanceType = typename std::decay<
+    decltype( std::declval<Metric&>()( std::declval<const Point&>(), std::declval<const Point&>() ) )
+  >::type;
+
+  /** Creates an empty cover tree with a default-constructed metric */
+  CoverTree()
+    : _metric( Metric() )
+  {
+  }
+
+  /** Creates an empty cover tree with a given metric */
+  explicit CoverTree( const Metric& metric )
+    : _metric( metric )
+  {
+  }
+
   class Node
   {
   public:
@@ -80,20 +104,14 @@ public:
       return _children.empty();
     }
 
-    void insert( const Point& p )
+    void insert( const Point& p, Metric& metric )
     {
-      auto d = Metric()( _point, p );
-
-      std::cerr << __FUNCTION__ << ": Inserting " << p << "\n";
-      std::cerr << __FUNCTION__ << ": Covering distance           = " << this->coveringDistance() << "\n";
-      std::cerr << __FUNCTION__ << ": Distance from point to root = " << d << "\n";
+      auto d = metric( _point, p );
 
       if( d > this->coveringDistance() )
       {
         while( d > 2 * this->coveringDistance() )
         {
-          std::cerr << __FUNCTION__ << ": Distance is bigger than covering distance; need to raise level of tree\n";
-
           // -----------------------------------------------------------
           //
           // Find a leaf node that can become the new root node with
@@ -133,16 +151,11 @@ public:
             }
           }
 
-          std::cerr << __FUNCTION__ << ": Found leaf node " << leaf->_point << "\n";
-
           // There is no leaf, so there is nothing to do and we just
           // skip to the bottom where we add the current node as the
           // new root of the tree.
           if( !leaf )
-          {
-            std::cerr << __FUNCTION__ << ": Unable to identify leaf node\n";
             break;
-          }
 
           assert( leaf );
           assert( parent );
@@ -179,20 +192,21 @@ public:
           auto oldRoot
             = std::unique_ptr<Node>( new Node( this->_point, this->_level ) );
 
+          oldRoot->_maxDistance = _maxDistance;
+
           for( auto&& child : _children )
             oldRoot->_children.push_back( std::move( child ) );
 
-          _point = leaf->_point;
-          _level = _level + 1;
+          _point       = leaf->_point;
+          _level       = _level + 1;
+          _maxDistance = static_cast<double>( metric( _point, oldRoot->_point ) ) + oldRoot->_maxDistance;
 
           _children.clear();
           _children.push_back( std::move( oldRoot ) );
 
           // Since the root of the tree changed, we also have to update
           // the distance calculation.
-          d = Metric()( _point, p );
-
-          std::cerr << __FUNCTION__ << ": " << leaf->_point << " is the new root\n";
+          d = metric( _point, p );
         }
 
         // Make current point the new root -----------------------------
@@ -204,11 +218,14 @@ public:
         auto oldRoot
           = std::unique_ptr<Node>( new Node( this->_point, this->_level ) );
 
+        oldRoot->_maxDistance = _maxDistance;
+
         for( auto&& child : _children )
           oldRoot->_children.push_back( std::move( child ) );
 
-        _point = p;
-        _level = _level + 1;
+        _point       = p;
+        _level       = _level + 1;
+        _maxDistance = static_cast<double>( d ) + oldRoot->_maxDistance;
 
         _children.clear();
         _children.push_back( std::move( oldRoot ) );
@@ -216,7 +233,8 @@ public:
         return;
       }
 
-      return insert_( p );
+      _maxDistance = std::max( _maxDistance, static_cast<double>( d ) );
+      return insert_( p, metric );
     }
 
     /**
@@ -224,18 +242,17 @@ public:
       node into the tree.
     */
 
-    void insert_( const Point& p )
+    void insert_( const Point& p, Metric& metric )
     {
       for( auto&& child : _children )
       {
-        auto d = Metric()( child->_point, p );
+        auto d = metric( child->_point, p );
         if( d <= child->coveringDistance() )
         {
-          std::cerr << __FUNCTION__ << ": Recursive enumeration of the tree\n";
-
           // We found a node in which the new point can be inserted
           // *without* violating the covering invariant.
-          child->insert_( p );
+          child->_maxDistance = std::max( child->_maxDistance, static_cast<double>( d ) );
+          child->insert_( p, metric );
           return;
         }
       }
@@ -252,6 +269,15 @@ public:
     Point _point; //< The point stored in the node
     long  _level; //< The level of the node
 
+    /**
+      Upper bound of the distance between the node and all of its
+      descendants. This bound is updated during insertion, and is
+      typically much smaller than the bound that follows from the
+      level of the node.
+    */
+
+    double _maxDistance = 0.0;
+
     /**
       All children of the node. Their order depends on the insertion
       order into the data set.
@@ -271,7 +297,7 @@ public:
     if( !_root )
       _root = std::unique_ptr<Node>( new Node(p,0) );
     else
-      _root->insert( p );
+      _root->insert( p, _metric );
   }
 
   /**
@@ -420,6 +446,133 @@ public:
     return result;
   }
 
+  // Queries -----------------------------------------------------------
+
+  /**
+    Reports all points whose distance to a query point is strictly less
+    than a given radius. Results are reported as pairs of a point and its
+    distance via an output iterator; their order is unspecified.
+
+    @param q      Query point; does not have to be part of the tree
+    @param radius Radius for the query
+    @param result Output iterator for `std::pair<Point, DistanceType>`
+  */
+
+  template <class OutputIterator> void radiusSearch( const Point& q, DistanceType radius, OutputIterator result ) const
+  {
+    if( !_root )
+      return;
+
+    std::vector< std::pair<const Node*, DistanceType> > nodes;
+    nodes.push_back( std::make_pair( _root.get(), _metric( q, _root->_point ) ) );
+
+    while( !nodes.empty() )
+    {
+      auto node = nodes.back().first;
+      auto d    = nodes.back().second;
+
+      nodes.pop_back();
+
+      if( d < radius )
+        *result++ = std::make_pair( node->_point, d );
+
+      for( auto&& child : node->_children )
+      {
+        auto e = _metric( q, child->_point );
+
+        // The subtree of the child cannot contain any points within the
+        // radius if its bounding ball is too far away from the query.
+        if( static_cast<double>( e ) - child->_maxDistance < static_cast<double>( radius ) )
+          nodes.push_back( std::make_pair( child.get(), e ) );
+      }
+    }
+  }
+
+  /**
+    Reports the \f$k\f$ nearest neighbours of a query point, sorted by
+    their distance to the query point. Results are reported as pairs of
+    a point and its distance via an output iterator. If the tree contains
+    fewer than \f$k\f$ points, all of them will be reported.
+
+    Nodes are visited in the order of the lower bounds of the distances
+    within their subtrees, so the search stops as soon as no subtree
+    can contain a closer point.
+
+    @param q      Query point; does not have to be part of the tree
+    @param k      Number of neighbours to report
+    @param result Output iterator for `std::pair<Point, DistanceType>`
+  */
+
+  template <class OutputIterator> void neighbourSearch( const Point& q, std::size_t k, OutputIterator result ) const
+  {
+    if( !_root || k == 0 )
+      return;
+
+    struct Candidate
+    {
+      double       bound;
+      DistanceType d;
+      const Node*  node;
+
+      bool operator<( const Candidate& other ) const noexcept
+      {
+        // Reversed in order to obtain a min-heap of the lower bounds
+        return bound > other.bound;
+      }
+    };
+
+    // Max-heap of the best neighbours found so far, sorted by distance
+    std::vector< std::pair<DistanceType, const Node*> > neighbours;
+
+    auto compareNeighbours = [] ( const std::pair<DistanceType, const Node*>& a,
+                                  const std::pair<DistanceType, const Node*>& b )
+    {
+      return a.first < b.first;
+    };
+
+    std::priority_queue<Candidate> candidates;
+
+    {
+      auto d = _metric( q, _root->_point );
+      candidates.push( { static_cast<double>( d ) - _root->_maxDistance, d, _root.get() } );
+    }
+
+    while( !candidates.empty() )
+    {
+      auto candidate = candidates.top();
+      candidates.pop();
+
+      if( neighbours.size() == k && candidate.bound >= static_cast<double>( neighbours.front().first ) )
+        break;
+
+      if( neighbours.size() < k )
+      {
+        neighbours.push_back( std::make_pair( candidate.d, candidate.node ) );
+        std::push_heap( neighbours.begin(), neighbours.end(), compareNeighbours );
+      }
+      else if( candidate.d < neighbours.front().first )
+      {
+        std::pop_heap( neighbours.begin(), neighbours.end(), compareNeighbours );
+        neighbours.back() = std::make_pair( candidate.d, candidate.node );
+        std::push_heap( neighbours.begin(), neighbours.end(), compareNeighbours );
+      }
+
+      for( auto&& child : candidate.node->_children )
+      {
+        auto d     = _metric( q, child->_point );
+        auto bound = static_cast<double>( d ) - child->_maxDistance;
+
+        if( neighbours.size() < k || bound < static_cast<double>( neighbours.front().first ) )
+          candidates.push( { bound, d, child.get() } );
+      }
+    }
+
+    std::sort_heap( neighbours.begin(), neighbours.end(), compareNeighbours );
+
+    for( auto&& neighbour : neighbours )
+      *result++ = std::make_pair( neighbour.second->_point, neighbour.first );
+  }
+
   // Tree attributes ---------------------------------------------------
 
   /**
@@ -498,7 +651,7 @@ public:
 
         for( auto&& child : parent->_children )
         {
-          auto d = Metric()( parent->_point, child->_point );
+          auto d = _metric( parent->_point, child->_point );
           if( d > parent->coveringDistance() )
           {
             std::cerr << __FUNCTION__ << ": Covering invariant is violated by ("
@@ -548,7 +701,7 @@ public:
 
             auto&& p = (*it1)->_point;
             auto&& q = (*it2)->_point;
-            auto d   = Metric()(p, q);
+            auto d   = _metric(p, q);
 
             if( d <= parent->separatingDistance() )
             {
@@ -609,17 +762,17 @@ public:
       // Need to evaluate the distance to the current node *once* at
       // this point. Since we select another `current` node later on
       // it is ensured that we only store the distance *once*.
-      auto d = Metric()( p, current->_point );
+      auto d = _metric( p, current->_point );
       if( d <= current->coveringDistance() )
         distances.push_back( static_cast<double>( d ) );
 
       for( auto&& child : current->_children )
       {
-        auto d = Metric()( p, child->_point );
+        auto d = _metric( p, child->_point );
         if( d <= child->coveringDistance() )
         {
           ancestorDistances.push_back(
-            Metric()( _root->_point, child->_point )
+            _metric( _root->_point, child->_point )
           );
 
           // Continue the recursion in the next level, using the current
@@ -676,10 +829,10 @@ public:
 
         // Sort points in *descending* distance from the new root node
         std::sort( allPoints.begin(), allPoints.end(),
-          [&current] ( const Point& p, const Point& q )
+          [this, &current] ( const Point& p, const Point& q )
           {
-            auto dp = Metric()( current->_point, p );
-            auto dq = Metric()( current->_point, q );
+            auto dp = _metric( current->_point, p );
+            auto dq = _metric( current->_point, q );
 
             return dp > dq;
           }
@@ -705,17 +858,17 @@ public:
 
     while( current )
     {
-      auto d = Metric()( p, current->_point );
+      auto d = _metric( p, current->_point );
       if( d <= current->coveringDistance() )
         edgeDistances.push_back( static_cast<double>( d ) );
 
       for( auto&& child : current->_children )
       {
-        auto d = Metric()( p, child->_point );
+        auto d = _metric( p, child->_point );
         if( d <= child->coveringDistance() )
         {
           rootDistances.push_back(
-            Metric()( _root->_point, child->_point )
+            _metric( _root->_point, child->_point )
           );
 
           // Continue the recursion in the next level, using the current
@@ -761,6 +914,14 @@ private:
 
   /** Root pointer of the tree */
   std::unique_ptr<Node> _root;
+
+  /**
+    Metric for distance calculations. Since metric functors are not
+    required to provide a `const` call operator, the metric needs to
+    be mutable in order to permit queries.
+  */
+
+  mutable Metric _metric;
 };
 
 } // namespace geometry
@@ -0,0 +1,199 @@
+#ifndef ALEPH_GEOMETRY_COVER_TREE_NEIGHBOURS_HH__
+#define ALEPH_GEOMETRY_COVER_TREE_NEIGHBOURS_HH__
+
+#include <aleph/geometry/FlatCoverTree.hh>
+#include <aleph/geometry/NearestNeighbours.hh>
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class CoverTreeNeighbours
+  @brief Nearest neighbour calculation based on a cover tree
+
+  Stores the indices of all points of a container in a cover tree and
+  uses the tree for answering radius queries and nearest neighbour
+  queries. The tree is built in batch mode, using `FlatCoverTree`. In
+  contrast to `FLANN`, this works for every distance functor that gives
+  rise to a metric, including the Manhattan distance and the infinity
+  distance, because a cover tree only relies on the triangle inequality.
+
+  Distances are converted using the traits of the distance functor, so
+  for example the squared distances of the Euclidean distance functor
+  are turned into proper distances before being used in the tree.
+
+  The container is required to store its points contiguously, and to
+  provide access to them via `data()`.
+*/
+
+template <class Container, class DistanceFunctor>
+class CoverTreeNeighbours : public NearestNeighbours< CoverTreeNeighbours<Container, DistanceFunctor>, std::size_t, typename Container::ElementType >
+{
+public:
+  using IndexType       = std::size_t;
+  using ElementType     = typename Container::ElementType;
+  using Traits          = aleph::geometry::distances::Traits<DistanceFunctor>;
+  using Distance        = DistanceFunctor;
+  using NeighbourList   = aleph::geometry::NeighbourList<IndexType, ElementType>;
+
+  /**
+    Metric between the indices of points of the container. This is the
+    metric that is used by the cover tree.
+  */
+
+  class Metric
+  {
+  public:
+    Metric( const ElementType* points, std::size_t dimension )
+      : _points( points )
+      , _dimension( dimension )
+    {
+    }
+
+    ElementType operator()( IndexType i, IndexType j ) const
+    {
+      return static_cast<ElementType>( _traits.from( _distance( _points + i * _dimension,
+                                                                _points + j * _dimension,
+                                                                _dimension ) ) );
+    }
+
+  private:
+    const ElementType* _points;
+    std::size_t _dimension;
+
+    DistanceFunctor _distance;
+    Traits _traits;
+  };
+
+  explicit CoverTreeNeighbours( const Container& container )
+    : _container( container )
+    , _tree( container.size(), Metric( container.data(), container.dimension() ) )
+  {
+  }
+
+  /**
+    Determines all neighbours of every point whose distance is strictly
+    less than the specified radius. Neighbours are reported in ascending
+    order of their indices.
+  */
+
+  void radiusSearch( ElementType radius, NeighbourList& result ) const
+  {
+    std::vector< std::vector< std::pair<IndexType, ElementType> > > neighbours( this->size() );
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for( long t = 0; t < static_cast<long>( this->size() ); t++ )
+    {
+      auto i = static_cast<IndexType>( t );
+
+      _tree.radiusSearch( i, radius, std::back_inserter( neighbours[i] ) );
+      std::sort( neighbours[i].begin(), neighbours[i].end() );
+    }
+
+    this->pack( neighbours, result );
+  }
+
+  /** @overload radiusSearch() */
+  void radiusSearch( ElementType radius,
+                     std::vector< std::vector<IndexType> >& indices,
+                     std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->radiusSearch( radius, result );
+    result.unpack( indices, distances );
+  }
+
+  /**
+    Determines the \f$k\f$ nearest neighbours of every point, including
+    the point itself. Neighbours are reported in ascending order of their
+    distances. If \f$k\f$ exceeds the number of points, all points will
+    be reported.
+  */
+
+  void neighbourSearch( unsigned k, NeighbourList& result ) const
+  {
+    std::vector< std::vector< std::pair<IndexType, ElementType> > > neighbours( this->size() );
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for( long t = 0; t < static_cast<long>( this->size() ); t++ )
+    {
+      auto i = static_cast<IndexType>( t );
+      _tree.neighbourSearch( i, k, std::back_inserter( neighbours[i] ) );
+    }
+
+    this->pack( neighbours, result );
+  }
+
+  /** @overload neighbourSearch() */
+  void neighbourSearch( unsigned k,
+                        std::vector< std::vector<IndexType> >& indices,
+                        std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->neighbourSearch( k, result );
+    result.unpack( indices, distances );
+  }
+
+  std::size_t size() const noexcept
+  {
+    return _container.size();
+  }
+
+private:
+
+  /** Stores the neighbours of every point in a neighbour list */
+  static void pack( const std::vector< std::vector< std::pair<IndexType, ElementType> > >& neighbours,
+                    NeighbourList& result )
+  {
+    result.offsets.assign( neighbours.size() + 1, 0 );
+
+    for( std::size_t i = 0; i < neighbours.size(); i++ )
+      result.offsets[i+1] = result.offsets[i] + neighbours[i].size();
+
+    result.indices.resize( result.offsets.back() );
+    result.distances.resize( result.offsets.back() );
+
+    for( std::size_t i = 0; i < neighbours.size(); i++ )
+    {
+      auto offset = result.offsets[i];
+
+      for( auto&& neighbour : neighbours[i] )
+      {
+        result.indices[offset]     = neighbour.first;
+        result.distances[offset++] = neighbour.second;
+      }
+    }
+  }
+
+  /** Reference to the original container */
+  const Container& _container;
+
+  /** Cover tree of the indices of all points */
+  FlatCoverTree<Metric, IndexType> _tree;
+};
+
+} // namespace geometry
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef ALEPH_GEOMETRY_EDGE_COLLAPSE_HH__
+#define ALEPH_GEOMETRY_EDGE_COLLAPSE_HH__
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  Collapses the edges of a weighted graph, such as the 1-skeleton of
+  a Vietoris--Rips complex, without changing the persistent homology of
+  its flag complex. The result is a smaller weighted graph, so that an
+  expansion of the graph results in fewer higher-dimensional simplices.
+
+  The implementation follows the papers:
+
+  > Edge Collapse and Persistence of Flag Complexes
+  > Jean-Daniel Boissonnat and Siddharth Pritam
+  > Proceedings of the 36th International Symposium on Computational Geometry
+
+  > Swap, Shift and Trim to Edge Collapse a Filtration
+  > Marc Glisse and Siddharth Pritam
+  > Proceedings of the 38th International Symposium on Computational Geometry
+
+  An edge \f$\{u,v\}\f$ is *dominated* by a vertex \f$w\f$ if every
+  common neighbour of \f$u\f$ and \f$v\f$ is adjacent to \f$w\f$. Edges
+  are traversed in reverse filtration order. An edge is delayed to the
+  first time at which it is no longer dominated, or removed if it stays
+  dominated. Since the set of common neighbours of an edge only changes
+  when an edge to a new common neighbour appears, only these times have
+  to be checked.
+
+  Edges are ordered by their weights; ties are broken like in the data
+  filtration. The weights of vertices are assumed not to exceed the
+  weights of their edges, which is the case for Vietoris--Rips complexes.
+
+  @param K Simplicial complex; only its 0-simplices and 1-simplices are
+           used
+
+  @returns Simplicial complex containing all 0-simplices of the input
+  complex, and the remaining edges along with their new weights. The
+  persistent homology of the flag complex is the same as for the input
+  complex, up to points on the diagonal of the persistence diagrams.
+*/
+
+template <class SimplicialComplex> SimplicialComplex collapseEdges( const SimplicialComplex& K )
+{
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using VertexType = typename Simplex::VertexType;
+
+  std::vector<Simplex> edges;
+
+  {
+    auto&& pair = K.range(1);
+    edges.assign( pair.first, pair.second );
+  }
+
+  std::sort( edges.begin(), edges.end(), topology::filtrations::Data<Simplex>() );
+
+  // Assign dense indices to all vertices and store the neighbours of
+  // every vertex along with the current time of the corresponding edge,
+  // i.e. its index in the filtration order.
+
+  std::vector<VertexType> vertices;
+
+  for( auto&& edge : edges )
+    vertices.insert( vertices.end(), edge.begin(), edge.end() );
+
+  std::sort( vertices.begin(), vertices.end() );
+  vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+  auto indexOf = [&vertices] ( VertexType v )
+  {
+    return static_cast<std::size_t>( std::lower_bound( vertices.begin(), vertices.end(), v ) - vertices.begin() );
+  };
+
+  auto m = edges.size();
+
+  std::vector<std::size_t> us( m );
+  std::vector<std::size_t> vs( m );
+  std::vector<std::size_t> times( m );
+  std::vector<bool> removed( m );
+
+  std::vector< std::unordered_map<std::size_t, std::size_t> > neighbours( vertices.size() );
+
+  for( std::size_t i = 0; i < m; i++ )
+  {
+    us[i]    = indexOf( *( edges[i].begin()     ) );
+    vs[i]    = indexOf( *( edges[i].begin() + 1 ) );
+    times[i] = i;
+
+    neighbours[ us[i] ][ vs[i] ] = i;
+    neighbours[ vs[i] ][ us[i] ] = i;
+  }
+
+  constexpr auto never = std::numeric_limits<std::size_t>::max();
+
+  auto timeOf = [&neighbours, &never] ( std::size_t u, std::size_t v )
+  {
+    auto it = neighbours[u].find( v );
+    return it != neighbours[u].end() ? it->second : never;
+  };
+
+  // Common neighbours of the current edge, along with the time at which
+  // they become common neighbours, and the time at which they dominate
+  // all previous common neighbours.
+  std::vector< std::pair<std::size_t, std::size_t> > common;
+  std::vector<std::size_t> dominationTimes;
+
+  for( std::size_t i = m; i-- > 0; )
+  {
+    auto u = us[i];
+    auto v = vs[i];
+
+    common.clear();
+
+    {
+      auto x = neighbours[u].size() <= neighbours[v].size() ? u : v;
+      auto y = x == u ? v : u;
+
+      for( auto&& pair : neighbours[x] )
+      {
+        auto w = pair.first;
+
+        if( w == y )
+          continue;
+
+        auto t = timeOf( y, w );
+
+        if( t != never )
+          common.push_back( std::make_pair( std::max( pair.second, t ), w ) );
+      }
+    }
+
+    std::sort( common.begin(), common.end() );
+    dominationTimes.clear();
+
+    auto time      = times[i];
+    auto dominated = true;
+    std::size_t k  = 0;
+
+    // Minimum domination time of all common neighbours that have been
+    // processed so far.
+    auto minimum = never;
+
+    while( dominated )
+    {
+      // Add all common neighbours that appear until the current time and
+      // update the times at which the common neighbours dominate.
+      for( ; k < common.size() && common[k].first <= time; k++ )
+      {
+        auto x = common[k].second;
+        auto t = common[k].first;
+
+        minimum = never;
+
+        for( std::size_t l = 0; l < k; l++ )
+        {
+          auto w = common[l].second;
+          auto s = timeOf( w, x );
+
+          dominationTimes[l] = std::max( dominationTimes[l], s );
+          t                  = std::max( t, s );
+          minimum            = std::min( minimum, dominationTimes[l] );
+        }
+
+        dominationTimes.push_back( t );
+        minimum = std::min( minimum, t );
+      }
+
+      dominated = minimum <= time;
+
+      if( !dominated )
+        break;
+
+      // The edge stays dominated until a new common neighbour appears,
+      // so this is the next time that needs to be checked.
+      if( k == common.size() )
+        break;
+
+      time = common[k].first;
+    }
+
+    if( dominated )
+    {
+      removed[i] = true;
+
+      neighbours[u].erase( v );
+      neighbours[v].erase( u );
+    }
+    else
+    {
+      times[i]         = time;
+      neighbours[u][v] = time;
+      neighbours[v][u] = time;
+    }
+  }
+
+  SimplicialComplex L;
+
+  {
+    auto&& pair = K.range(0);
+    for( auto it = pair.first; it != pair.second; ++it )
+      L.push_back( *it );
+  }
+
+  for( std::size_t i = 0; i < m; i++ )
+  {
+    if( !removed[i] )
+      L.push_back( Simplex( edges[i], edges[ times[i] ].data() ) );
+  }
+
+  return L;
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,573 @@
+#ifndef ALEPH_GEOMETRY_FLAT_COVER_TREE_HH__
+#define ALEPH_GEOMETRY_FLAT_COVER_TREE_HH__
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class FlatCoverTree
+  @brief Cover tree over point indices with batch construction
+
+  This class models the same simplified cover tree as `CoverTree`, but
+  it is built for a fixed set of points at once instead of inserting
+  them one at a time. The tree only stores the indices of points; all
+  distances are calculated by a metric on indices. Nodes are stored in
+  a flat array in breadth-first order, so the children of every node
+  are contiguous.
+
+  The tree is built top-down. For every node, the points in its subtree
+  are covered greedily by balls whose radius is half of the covering
+  distance of the node: the point that is farthest away from the node
+  becomes a new child, which receives all remaining points within the
+  radius. Every child is then processed recursively. All nodes of one
+  level of the tree are processed in parallel, and large point sets are
+  additionally split among multiple threads. During construction, the
+  points of every subtree are kept in a contiguous range of one index
+  array, so no points are ever copied.
+
+  The resulting tree satisfies the covering invariant and the separating
+  invariant of `CoverTree`. Levels of children may be smaller than the
+  level of their parent minus one, though, because every node is given
+  the smallest level that covers its subtree.
+
+  @tparam Metric Metric functor that calculates the distance between two
+                 indices; it must be safe to call from multiple threads
+  @tparam Index  Index type
+*/
+
+template <class Metric, class Index = std::size_t> class FlatCoverTree
+{
+public:
+  using IndexType    = Index;
+  using DistanceType = typename std::decay<
+    decltype( std::declval<const Metric&>()( std::declval<Index>(), std::declval<Index>() ) )
+  >::type;
+
+  /** Covering constant of the tree; identical to the one of `CoverTree` */
+  constexpr static const double coveringConstant = 2.0;
+
+  /**
+    Builds a cover tree over a range of indices. The first index becomes
+    the root of the tree.
+
+    @param begin  Iterator to begin of index range
+    @param end    Iterator to end of index range
+    @param metric Metric functor
+  */
+
+  template <class InputIterator> FlatCoverTree( InputIterator begin, InputIterator end, const Metric& metric = Metric() )
+    : _metric( metric )
+  {
+    std::vector<Index> indices( begin, end );
+    this->build( indices );
+  }
+
+  /**
+    Builds a cover tree over the indices \f$0, \dots, n-1\f$.
+
+    @param n      Number of indices
+    @param metric Metric functor
+  */
+
+  explicit FlatCoverTree( std::size_t n, const Metric& metric = Metric() )
+    : _metric( metric )
+  {
+    std::vector<Index> indices( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+      indices[i] = static_cast<Index>( i );
+
+    this->build( indices );
+  }
+
+  // Queries -----------------------------------------------------------
+
+  /**
+    Reports all indices whose distance to a query index is strictly less
+    than a given radius. Results are reported as pairs of an index and
+    its distance via an output iterator; their order is unspecified.
+
+    @param q      Query index; does not have to be part of the tree, but
+                  it has to be understood by the metric
+    @param radius Radius for the query
+    @param result Output iterator for `std::pair<Index, DistanceType>`
+  */
+
+  template <class OutputIterator> void radiusSearch( Index q, DistanceType radius, OutputIterator result ) const
+  {
+    if( _nodes.empty() )
+      return;
+
+    std::vector< std::pair<std::size_t, DistanceType> > nodes;
+    nodes.push_back( std::make_pair( 0, _metric( q, _nodes.front().point ) ) );
+
+    while( !nodes.empty() )
+    {
+      auto&& node = _nodes[ nodes.back().first ];
+      auto d      = nodes.back().second;
+
+      nodes.pop_back();
+
+      if( d < radius )
+        *result++ = std::make_pair( node.point, d );
+
+      for( auto c = node.firstChild; c < node.firstChild + node.numChildren; c++ )
+      {
+        auto e = _metric( q, _nodes[c].point );
+
+        // The subtree of the child cannot contain any points within the
+        // radius if its bounding ball is too far away from the query.
+        if( static_cast<double>( e ) - _nodes[c].maxDistance < static_cast<double>( radius ) )
+          nodes.push_back( std::make_pair( c, e ) );
+      }
+    }
+  }
+
+  /**
+    Reports the \f$k\f$ nearest neighbours of a query index, sorted by
+    their distance to the query. Results are reported as pairs of an
+    index and its distance via an output iterator. If the tree contains
+    fewer than \f$k\f$ indices, all of them will be reported.
+
+    @param q      Query index; does not have to be part of the tree, but
+                  it has to be understood by the metric
+    @param k      Number of neighbours to report
+    @param result Output iterator for `std::pair<Index, DistanceType>`
+  */
+
+  template <class OutputIterator> void neighbourSearch( Index q, std::size_t k, OutputIterator result ) const
+  {
+    if( _nodes.empty() || k == 0 )
+      return;
+
+    struct Candidate
+    {
+      double       bound;
+      DistanceType d;
+      std::size_t  node;
+
+      bool operator<( const Candidate& other ) const noexcept
+      {
+        // Reversed in order to obtain a min-heap of the lower bounds
+        return bound > other.bound;
+      }
+    };
+
+    // Max-heap of the best neighbours found so far, sorted by distance
+    std::vector< std::pair<DistanceType, Index> > neighbours;
+
+    std::priority_queue<Candidate> candidates;
+
+    {
+      auto d = _metric( q, _nodes.front().point );
+      candidates.push( { static_cast<double>( d ) - _nodes.front().maxDistance, d, 0 } );
+    }
+
+    while( !candidates.empty() )
+    {
+      auto candidate = candidates.top();
+      candidates.pop();
+
+      // Subtrees whose lower bound coincides with the current maximum
+      // distance may still contain points with smaller indices, so ties
+      // are resolved consistently.
+      if( neighbours.size() == k && candidate.bound > static_cast<double>( neighbours.front().first ) )
+        break;
+
+      auto&& node = _nodes[candidate.node];
+
+      if( neighbours.size() < k )
+      {
+        neighbours.push_back( std::make_pair( candidate.d, node.point ) );
+        std::push_heap( neighbours.begin(), neighbours.end() );
+      }
+      else if( std::make_pair( candidate.d, node.point ) < neighbours.front() )
+      {
+        std::pop_heap( neighbours.begin(), neighbours.end() );
+        neighbours.back() = std::make_pair( candidate.d, node.point );
+        std::push_heap( neighbours.begin(), neighbours.end() );
+      }
+
+      for( auto c = node.firstChild; c < node.firstChild + node.numChildren; c++ )
+      {
+        auto d     = _metric( q, _nodes[c].point );
+        auto bound = static_cast<double>( d ) - _nodes[c].maxDistance;
+
+        if( neighbours.size() < k || bound <= static_cast<double>( neighbours.front().first ) )
+          candidates.push( { bound, d, c } );
+      }
+    }
+
+    std::sort_heap( neighbours.begin(), neighbours.end() );
+
+    for( auto&& neighbour : neighbours )
+      *result++ = std::make_pair( neighbour.second, neighbour.first );
+  }
+
+  // Tree attributes ---------------------------------------------------
+
+  /** @returns Number of indices in the tree */
+  std::size_t size() const noexcept
+  {
+    return _nodes.size();
+  }
+
+  /** @returns true if the tree does not contain any indices */
+  bool empty() const noexcept
+  {
+    return _nodes.empty();
+  }
+
+  /**
+    @returns Level of the tree, i.e. the level of the root node. If no root
+    node exists, a level of zero is returned. This is *not* the depth.
+  */
+
+  long level() const noexcept
+  {
+    if( _nodes.empty() )
+      return 0;
+    else
+      return _nodes.front().level;
+  }
+
+  // Validity checks ---------------------------------------------------
+  //
+  // These are called by debug code and tests to ensure that the cover
+  // tree is correct.
+
+  /**
+    Checks the covering invariant, i.e. whether the distance between a
+    child and its parent is bounded by the covering distance of the
+    parent.
+  */
+
+  bool checkCoveringInvariant() const
+  {
+    for( auto&& node : _nodes )
+    {
+      for( auto c = node.firstChild; c < node.firstChild + node.numChildren; c++ )
+      {
+        if( _nodes[c].level >= node.level )
+          return false;
+
+        if( static_cast<double>( _metric( node.point, _nodes[c].point ) ) > coveringDistance( node.level ) )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+    Checks the separating invariant, i.e. whether the distance between
+    two children of a node exceeds the separating distance of the node.
+  */
+
+  bool checkSeparatingInvariant() const
+  {
+    for( auto&& node : _nodes )
+    {
+      for( auto c1 = node.firstChild; c1 < node.firstChild + node.numChildren; c1++ )
+      {
+        for( auto c2 = c1 + 1; c2 < node.firstChild + node.numChildren; c2++ )
+        {
+          auto d = static_cast<double>( _metric( _nodes[c1].point, _nodes[c2].point ) );
+
+          // Duplicate points are permitted to violate the separation;
+          // they are always stored as leaves of the same node.
+          if( d > 0 && d <= coveringDistance( node.level - 1 ) )
+            return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+    Checks whether the maximum distance that is stored for every node is
+    an upper bound of the distances to all of its descendants. This is
+    required for the correctness of all queries.
+  */
+
+  bool checkDistanceBounds() const
+  {
+    for( std::size_t i = 0; i < _nodes.size(); i++ )
+    {
+      std::vector<std::size_t> descendants( 1, i );
+
+      while( !descendants.empty() )
+      {
+        auto&& node = _nodes[ descendants.back() ];
+        descendants.pop_back();
+
+        if( static_cast<double>( _metric( _nodes[i].point, node.point ) ) > _nodes[i].maxDistance )
+          return false;
+
+        for( auto c = node.firstChild; c < node.firstChild + node.numChildren; c++ )
+          descendants.push_back( c );
+      }
+    }
+
+    return true;
+  }
+
+  /** Combines all validity checks of the tree */
+  bool isValid() const
+  {
+    return    this->checkCoveringInvariant()
+           && this->checkSeparatingInvariant()
+           && this->checkDistanceBounds();
+  }
+
+private:
+
+  struct Node
+  {
+    Index       point;            //< Index stored in the node
+    long        level;            //< Level of the node
+    double      maxDistance;      //< Maximum distance to all descendants
+    std::size_t firstChild;       //< Position of first child in node array
+    std::size_t numChildren;      //< Number of children
+  };
+
+  /**
+    Node whose children still have to be determined, along with the
+    range of indices that form its subtree, excluding the node itself.
+  */
+
+  struct Task
+  {
+    std::size_t node;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /** Child of a node, as determined during construction */
+  struct Child
+  {
+    Index       point;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /** Minimum number of indices for splitting a single task among threads */
+  static constexpr std::size_t parallelThreshold = 4096;
+
+  /** Calculates covering distance of a given level */
+  static double coveringDistance( long level ) noexcept
+  {
+    return std::pow( coveringConstant, static_cast<double>( level ) );
+  }
+
+  /** @returns Smallest level whose covering distance is at least the given distance */
+  static long levelOf( double distance ) noexcept
+  {
+    auto level = static_cast<long>( std::ceil( std::log( distance ) / std::log( coveringConstant ) ) );
+
+    // Correct rounding errors of the logarithm
+    while( coveringDistance( level ) < distance )
+      ++level;
+
+    while( coveringDistance( level - 1 ) >= distance )
+      --level;
+
+    return level;
+  }
+
+  void build( std::vector<Index>& indices )
+  {
+    _nodes.clear();
+
+    if( indices.empty() )
+      return;
+
+    _nodes.reserve( indices.size() );
+    _nodes.push_back( { indices.front(), 0, 0.0, 0, 0 } );
+
+    // The indices of every subtree are stored in a contiguous range of
+    // this array, along with their distance to the root of the subtree.
+    std::vector<Index> points( indices.begin() + 1, indices.end() );
+    std::vector<double> distances( points.size() );
+
+    {
+      auto root = indices.front();
+
+      #pragma omp parallel for schedule(static) if( points.size() >= parallelThreshold )
+      for( long i = 0; i < static_cast<long>( points.size() ); i++ )
+      {
+        auto j       = static_cast<std::size_t>( i );
+        distances[j] = static_cast<double>( _metric( root, points[j] ) );
+      }
+    }
+
+    std::vector<Task> tasks( 1, { 0, 0, points.size() } );
+
+    while( !tasks.empty() )
+    {
+      std::vector< std::vector<Child> > children( tasks.size() );
+
+      #pragma omp parallel for schedule(dynamic) if( tasks.size() > 1 )
+      for( long t = 0; t < static_cast<long>( tasks.size() ); t++ )
+      {
+        auto i = static_cast<std::size_t>( t );
+        this->split( tasks[i], points, distances, children[i] );
+      }
+
+      // Create nodes for all children; the children of every node are
+      // stored contiguously.
+      std::vector<Task> nextTasks;
+
+      for( std::size_t i = 0; i < tasks.size(); i++ )
+      {
+        auto&& node      = _nodes[ tasks[i].node ];
+        node.firstChild  = _nodes.size();
+        node.numChildren = children[i].size();
+
+        auto level = node.level;
+
+        for( auto&& child : children[i] )
+        {
+          if( child.begin != child.end )
+            nextTasks.push_back( { _nodes.size(), child.begin, child.end } );
+
+          _nodes.push_back( { child.point, level - 1, 0.0, 0, 0 } );
+        }
+      }
+
+      tasks.swap( nextTasks );
+    }
+  }
+
+  /**
+    Determines the children of a node and partitions the range of indices
+    of its subtree such that the indices of every child are contiguous.
+    On return, the distances of the indices refer to their new parent.
+  */
+
+  void split( const Task& task,
+              std::vector<Index>& points,
+              std::vector<double>& distances,
+              std::vector<Child>& children )
+  {
+    auto&& node = _nodes[ task.node ];
+
+    auto begin = task.begin;
+    auto end   = task.end;
+
+    auto farthest = static_cast<std::size_t>(
+      std::max_element( distances.begin() + static_cast<std::ptrdiff_t>( begin ),
+                        distances.begin() + static_cast<std::ptrdiff_t>( end ) ) - distances.begin() );
+
+    node.maxDistance = distances[farthest];
+
+    // All remaining points are duplicates of the node, so they are being
+    // stored as leaves.
+    if( node.maxDistance <= 0.0 )
+    {
+      for( auto i = begin; i < end; i++ )
+        children.push_back( { points[i], i, i } );
+
+      return;
+    }
+
+    node.level  = levelOf( node.maxDistance );
+    auto radius = coveringDistance( node.level - 1 );
+
+    std::vector<double> childDistances;
+
+    while( begin != end )
+    {
+      // Use the point that is farthest away from the node as the next
+      // child. This keeps the number of children small.
+      std::swap( points[begin], points[farthest] );
+      std::swap( distances[begin], distances[farthest] );
+
+      auto child         = points[begin];
+      auto childDistance = distances[begin];
+      auto first         = begin + 1;
+      auto size          = end - first;
+
+      childDistances.resize( size );
+
+      #pragma omp parallel for schedule(static) if( size >= parallelThreshold )
+      for( long i = 0; i < static_cast<long>( size ); i++ )
+      {
+        auto j = static_cast<std::size_t>( i );
+
+        // By the triangle inequality, the distance between the child and
+        // a point is at least the difference of their distances to the
+        // node. This avoids most evaluations of the metric.
+        if( std::abs( distances[first + j] - childDistance ) > radius )
+          childDistances[j] = std::numeric_limits<double>::infinity();
+        else
+          childDistances[j] = static_cast<double>( _metric( child, points[first + j] ) );
+      }
+
+      // Move all points that are covered by the child to the front of
+      // the remaining range, and replace their distances. The farthest
+      // point that remains uncovered becomes the next child.
+      auto last = first;
+      farthest  = end;
+
+      for( std::size_t j = 0; j < size; j++ )
+      {
+        if( childDistances[j] <= radius )
+        {
+          std::swap( points[first + j], points[last] );
+          std::swap( distances[first + j], distances[last] );
+
+          distances[last] = childDistances[j];
+
+          if( farthest == last )
+            farthest = first + j;
+
+          ++last;
+        }
+        else if( farthest == end || distances[first + j] > distances[farthest] )
+          farthest = first + j;
+      }
+
+      children.push_back( { child, first, last } );
+      begin = last;
+    }
+  }
+
+  /** Metric for distance calculations */
+  Metric _metric;
+
+  /** Nodes of the tree in breadth-first order; the first node is the root */
+  std::vector<Node> _nodes;
+};
+
+template <class Metric, class Index> constexpr const double FlatCoverTree<Metric, Index>::coveringConstant;
+template <class Metric, class Index> constexpr std::size_t FlatCoverTree<Metric, Index>::parallelThreshold;
+
+} // namespace geometry
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -0,0 +1,490 @@
+#ifndef ALEPH_GEOMETRY_KD_TREE_HH__
+#define ALEPH_GEOMETRY_KD_TREE_HH__
+
+#include <aleph/geometry/NearestNeighbours.hh>
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class KDTree
+  @brief Built-in kd-tree for nearest neighbour calculations
+
+  This class provides a kd-tree that does not require any external
+  libraries. It is the default choice for nearest neighbour queries
+  if FLANN is not available.
+
+  The tree is built in bulk over the points of a container, which are
+  neither copied nor reordered: the tree only stores a permutation of
+  their indices. Every inner node splits its points at the median of
+  the coordinate with the largest spread. All nodes of one level of
+  the tree are built in parallel.
+
+  Queries use the incremental distance calculation by Arya and Mount,
+  which requires the distance functor to be *additive*, i.e. it has to
+  be a sum of the contributions of individual coordinates, and to mark
+  itself as suitable for kd-trees in the same way FLANN does, using the
+  `is_kdtree_distance` tag and the `accum_dist` function. Queries are
+  performed in the internal representation of the distance functor, so
+  for example the Euclidean distance functor never calculates a square
+  root during a query. Distances are only converted using the traits of
+  the functor when being reported.
+
+  The container is required to store its points contiguously, and to
+  provide access to them via `data()`.
+*/
+
+template <class Container, class DistanceFunctor>
+class KDTree : public NearestNeighbours< KDTree<Container, DistanceFunctor>, std::size_t, typename Container::ElementType >
+{
+public:
+  using IndexType       = std::size_t;
+  using ElementType     = typename Container::ElementType;
+  using Traits          = aleph::geometry::distances::Traits<DistanceFunctor>;
+  using Distance        = DistanceFunctor;
+  using NeighbourList   = aleph::geometry::NeighbourList<IndexType, ElementType>;
+
+  // This fails to compile if the distance functor is not suitable for
+  // a kd-tree.
+  using IsKDTreeDistance = typename DistanceFunctor::is_kdtree_distance;
+
+  explicit KDTree( const Container& container, std::size_t leafSize = 16 )
+    : _container( container )
+    , _points( container.data() )
+    , _dimension( container.dimension() )
+    , _leafSize( std::max( leafSize, std::size_t(1) ) )
+  {
+    this->build();
+  }
+
+  /**
+    Determines all neighbours of every point whose distance is strictly
+    less than the specified radius. Neighbours are reported in ascending
+    order of their distances; ties are broken by index.
+  */
+
+  void radiusSearch( ElementType radius, NeighbourList& result ) const
+  {
+    auto n = this->size();
+
+    std::vector< std::vector< std::pair<ResultType, IndexType> > > neighbours( n );
+
+    #pragma omp parallel
+    {
+      std::vector<ResultType> offsets( _dimension );
+
+      #pragma omp for schedule(dynamic, 64)
+      for( long t = 0; t < static_cast<long>( n ); t++ )
+      {
+        auto i = static_cast<std::size_t>( t );
+
+        this->radiusSearch( _points + i * _dimension, radius, offsets, neighbours[i] );
+        std::sort( neighbours[i].begin(), neighbours[i].end() );
+      }
+    }
+
+    this->pack( neighbours, result );
+  }
+
+  /** @overload radiusSearch() */
+  void radiusSearch( ElementType radius,
+                     std::vector< std::vector<IndexType> >& indices,
+                     std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->radiusSearch( radius, result );
+    result.unpack( indices, distances );
+  }
+
+  /**
+    Determines the \f$k\f$ nearest neighbours of every point, including
+    the point itself. Neighbours are reported in ascending order of their
+    distances; ties are broken by index. If \f$k\f$ exceeds the number of
+    points, all points will be reported.
+  */
+
+  void neighbourSearch( unsigned k, NeighbourList& result ) const
+  {
+    auto n = this->size();
+    auto m = std::min( std::size_t( k ), n );
+
+    std::vector< std::vector< std::pair<ResultType, IndexType> > > neighbours( n );
+
+    #pragma omp parallel
+    {
+      std::vector<ResultType> offsets( _dimension );
+
+      #pragma omp for schedule(dynamic, 64)
+      for( long t = 0; t < static_cast<long>( n ); t++ )
+      {
+        auto i = static_cast<std::size_t>( t );
+
+        this->neighbourSearch( _points + i * _dimension, m, offsets, neighbours[i] );
+        std::sort_heap( neighbours[i].begin(), neighbours[i].end() );
+      }
+    }
+
+    this->pack( neighbours, result );
+  }
+
+  /** @overload neighbourSearch() */
+  void neighbourSearch( unsigned k,
+                        std::vector< std::vector<IndexType> >& indices,
+                        std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->neighbourSearch( k, result );
+    result.unpack( indices, distances );
+  }
+
+  std::size_t size() const noexcept
+  {
+    return _container.size();
+  }
+
+private:
+  using ResultType = typename DistanceFunctor::ResultType;
+
+  struct Node
+  {
+    std::size_t begin;      //< Begin of the range of indices of the node
+    std::size_t end;        //< End of the range of indices of the node
+    std::size_t dimension;  //< Split dimension
+    ElementType split;      //< Split value
+    std::size_t left;       //< Left child; zero for leaves
+    std::size_t right;      //< Right child; zero for leaves
+  };
+
+  /** Marker for leaves, which never have the root as a child */
+  static constexpr std::size_t leaf = 0;
+
+  /** Builds the tree over all points of the container */
+  void build()
+  {
+    auto n = this->size();
+
+    _indices.resize( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+      _indices[i] = i;
+
+    _nodes.clear();
+    _nodes.push_back( { 0, n, 0, ElementType(), leaf, leaf } );
+
+    std::vector<std::size_t> tasks( 1, 0 );
+
+    while( !tasks.empty() )
+    {
+      #pragma omp parallel for schedule(dynamic) if( tasks.size() > 1 )
+      for( long t = 0; t < static_cast<long>( tasks.size() ); t++ )
+        this->split( _nodes[ tasks[ static_cast<std::size_t>( t ) ] ] );
+
+      // Create the children of all nodes that have been split; their
+      // ranges are given by the split position.
+      std::vector<std::size_t> nextTasks;
+
+      for( auto&& task : tasks )
+      {
+        auto&& node = _nodes[task];
+
+        if( node.left == leaf )
+          continue;
+
+        auto middle = node.left;
+
+        node.left  = _nodes.size();
+        node.right = _nodes.size() + 1;
+
+        nextTasks.push_back( node.left );
+        nextTasks.push_back( node.right );
+
+        // Copy the range because the reference is invalidated once new
+        // nodes are being added.
+        auto begin = node.begin;
+        auto end   = node.end;
+
+        _nodes.push_back( { begin,  middle, 0, ElementType(), leaf, leaf } );
+        _nodes.push_back( { middle, end,    0, ElementType(), leaf, leaf } );
+      }
+
+      tasks.swap( nextTasks );
+    }
+  }
+
+  /**
+    Splits the range of indices of a node at the median of the coordinate
+    with the largest spread. Instead of a child, the left child of a node
+    temporarily stores the split position, or `leaf` if the node is not
+    being split.
+  */
+
+  void split( Node& node )
+  {
+    if( node.end - node.begin <= _leafSize )
+      return;
+
+    std::size_t dimension = 0;
+    ElementType spread    = ElementType();
+
+    for( std::size_t d = 0; d < _dimension; d++ )
+    {
+      auto minimum = std::numeric_limits<ElementType>::max();
+      auto maximum = std::numeric_limits<ElementType>::lowest();
+
+      for( auto i = node.begin; i < node.end; i++ )
+      {
+        auto x  = _points[ _indices[i] * _dimension + d ];
+        minimum = std::min( minimum, x );
+        maximum = std::max( maximum, x );
+      }
+
+      if( maximum - minimum > spread )
+      {
+        spread    = maximum - minimum;
+        dimension = d;
+      }
+    }
+
+    // All points coincide, so there is no way to split them
+    if( spread <= ElementType() )
+      return;
+
+    auto first  = _indices.begin() + static_cast<std::ptrdiff_t>( node.begin );
+    auto last   = _indices.begin() + static_cast<std::ptrdiff_t>( node.end );
+    auto middle = first + ( last - first ) / 2;
+
+    std::nth_element( first, middle, last,
+                      [this, &dimension] ( std::size_t i, std::size_t j )
+                      {
+                        return _points[ i * _dimension + dimension ] < _points[ j * _dimension + dimension ];
+                      } );
+
+    node.dimension = dimension;
+    node.split     = _points[ *middle * _dimension + dimension ];
+    node.left      = static_cast<std::size_t>( middle - _indices.begin() );
+  }
+
+  /**
+    Reports all points whose distance to a query point is strictly less
+    than the specified radius. Like for `BruteForce`, converted distances
+    are compared to the radius, so the results do not depend on rounding
+    the radius to the internal representation of the distance functor.
+  */
+
+  void radiusSearch( const ElementType* query,
+                     ElementType radius,
+                     std::vector<ResultType>& offsets,
+                     std::vector< std::pair<ResultType, IndexType> >& result ) const
+  {
+    if( _nodes.front().begin == _nodes.front().end )
+      return;
+
+    std::fill( offsets.begin(), offsets.end(), ResultType() );
+
+    auto threshold = _traits.to( radius );
+
+    auto report = [this, &result, &radius] ( ResultType d, IndexType i )
+    {
+      if( static_cast<ElementType>( _traits.from( d ) ) < radius )
+        result.push_back( std::make_pair( d, i ) );
+    };
+
+    auto visit = [&threshold] ( ResultType bound )
+    {
+      return relax( bound ) <= threshold + ( threshold - relax( threshold ) );
+    };
+
+    this->traverse( 0, query, ResultType(), offsets, report, visit );
+  }
+
+  /**
+    Determines the \f$k\f$ nearest neighbours of a query point and stores
+    them as a max-heap of pairs of distances and indices.
+  */
+
+  void neighbourSearch( const ElementType* query,
+                        std::size_t k,
+                        std::vector<ResultType>& offsets,
+                        std::vector< std::pair<ResultType, IndexType> >& result ) const
+  {
+    if( k == 0 || _nodes.front().begin == _nodes.front().end )
+      return;
+
+    std::fill( offsets.begin(), offsets.end(), ResultType() );
+
+    result.reserve( k );
+
+    auto report = [&result, &k] ( ResultType d, IndexType i )
+    {
+      auto candidate = std::make_pair( d, i );
+
+      if( result.size() < k )
+      {
+        result.push_back( candidate );
+        std::push_heap( result.begin(), result.end() );
+      }
+      else if( candidate < result.front() )
+      {
+        std::pop_heap( result.begin(), result.end() );
+        result.back() = candidate;
+        std::push_heap( result.begin(), result.end() );
+      }
+    };
+
+    auto visit = [&result, &k] ( ResultType bound )
+    {
+      // Subtrees whose bound coincides with the current maximum distance
+      // may still contain points with smaller indices, so they have to
+      // be visited.
+      return result.size() < k || relax( bound ) <= result.front().first;
+    };
+
+    this->traverse( 0, query, ResultType(), offsets, report, visit );
+  }
+
+  /**
+    Traverses the tree, starting from a given node, and reports all
+    points to a functor whose subtrees cannot be pruned.
+
+    @param node    Current node
+    @param query   Query point
+    @param bound   Lower bound of the distance between the query point
+                   and the cell of the node
+    @param offsets Offsets between the query point and the cell of the
+                   node along every coordinate
+    @param report  Functor for reporting a point and its distance
+    @param visit   Predicate for checking whether a cell with a given
+                   lower bound needs to be visited
+  */
+
+  template <class Report, class Visit> void traverse( std::size_t node,
+                                                      const ElementType* query,
+                                                      ResultType bound,
+                                                      std::vector<ResultType>& offsets,
+                                                      Report& report,
+                                                      Visit& visit ) const
+  {
+    auto&& current = _nodes[node];
+
+    if( current.left == leaf )
+    {
+      for( auto i = current.begin; i < current.end; i++ )
+      {
+        auto index = _indices[i];
+        report( _distance( query, _points + index * _dimension, _dimension ), index );
+      }
+
+      return;
+    }
+
+    auto dimension = current.dimension;
+    auto offset    = ResultType( query[dimension] - current.split );
+
+    auto near = offset < ResultType() ? current.left  : current.right;
+    auto far  = offset < ResultType() ? current.right : current.left;
+
+    this->traverse( near, query, bound, offsets, report, visit );
+
+    // Update the lower bound incrementally by replacing the contribution
+    // of the split coordinate.
+    auto previous = offsets[dimension];
+    auto farBound = bound
+                  - _distance.accum_dist( previous, ResultType(), 0 )
+                  + _distance.accum_dist( offset,   ResultType(), 0 );
+
+    if( visit( farBound ) )
+    {
+      offsets[dimension] = offset;
+      this->traverse( far, query, farBound, offsets, report, visit );
+      offsets[dimension] = previous;
+    }
+  }
+
+  /**
+    Decreases a lower bound slightly in order to account for rounding
+    errors of its incremental updates. Without this, a cell may be pruned
+    even though it contains a point whose distance is equal to the bound,
+    which changes the results in case of ties.
+  */
+
+  static ResultType relax( ResultType bound ) noexcept
+  {
+    return bound - bound * 16 * std::numeric_limits<ResultType>::epsilon();
+  }
+
+  /** Stores the neighbours of every point in a neighbour list */
+  void pack( const std::vector< std::vector< std::pair<ResultType, IndexType> > >& neighbours,
+             NeighbourList& result ) const
+  {
+    result.offsets.assign( neighbours.size() + 1, 0 );
+
+    for( std::size_t i = 0; i < neighbours.size(); i++ )
+      result.offsets[i+1] = result.offsets[i] + neighbours[i].size();
+
+    result.indices.resize( result.offsets.back() );
+    result.distances.resize( result.offsets.back() );
+
+    for( std::size_t i = 0; i < neighbours.size(); i++ )
+    {
+      auto offset = result.offsets[i];
+
+      for( auto&& neighbour : neighbours[i] )
+      {
+        result.indices[offset]     = neighbour.second;
+        result.distances[offset++] = static_cast<ElementType>( _traits.from( neighbour.first ) );
+      }
+    }
+  }
+
+  /** Reference to the original container */
+  const Container& _container;
+
+  /** Coordinates of all points of the container */
+  const ElementType* _points;
+
+  /** Dimension of all points */
+  std::size_t _dimension;
+
+  /** Maximum number of points in a leaf */
+  std::size_t _leafSize;
+
+  /** Permutation of the indices of all points; every node owns a range */
+  std::vector<IndexType> _indices;
+
+  /** Nodes of the tree; the first node is the root */
+  std::vector<Node> _nodes;
+
+  /** Distance functor */
+  DistanceFunctor _distance;
+
+  /** Required for optional distance functor conversions */
+  Traits _traits;
+};
+
+template <class Container, class DistanceFunctor> constexpr std::size_t KDTree<Container, DistanceFunctor>::leaf;
+
+} // namespace geometry
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
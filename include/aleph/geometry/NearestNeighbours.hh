@@ -3,12 +3,72 @@
 
 #include <vector>
 
+#include <cstddef>
+
 namespace aleph
 {
 
 namespace geometry
 {
 
+/**
+  @class NeighbourList
+  @brief Flat storage of the neighbours of all points
+
+  Stores the neighbours of every point, along with their distances, in
+  a compressed sparse row layout. The neighbours of the \f$i\f$th point
+  are stored in the range given by `offsets[i]` and `offsets[i+1]` of the
+  `indices` and `distances` vectors, respectively.
+*/
+
+template <class IndexType, class ElementType> struct NeighbourList
+{
+  /** Offsets of the neighbours of every point, plus one end offset */
+  std::vector<std::size_t> offsets;
+
+  /** Indices of all neighbours */
+  std::vector<IndexType> indices;
+
+  /** Distances of all neighbours */
+  std::vector<ElementType> distances;
+
+  /** @returns Number of points */
+  std::size_t size() const noexcept
+  {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+
+  /** @returns Number of neighbours of the \f$i\f$th point */
+  std::size_t degree( std::size_t i ) const noexcept
+  {
+    return offsets[i+1] - offsets[i];
+  }
+
+  /**
+    Converts the neighbour list into the nested representation that is
+    used by the nearest neighbour wrappers.
+  */
+
+  void unpack( std::vector< std::vector<IndexType> >& nestedIndices,
+               std::vector< std::vector<ElementType> >& nestedDistances ) const
+  {
+    nestedIndices.clear();
+    nestedDistances.clear();
+
+    nestedIndices.resize( this->size() );
+    nestedDistances.resize( this->size() );
+
+    for( std::size_t i = 0; i < this->size(); i++ )
+    {
+      nestedIndices[i].assign( indices.begin() + static_cast<std::ptrdiff_t>( offsets[i] ),
+                               indices.begin() + static_cast<std::ptrdiff_t>( offsets[i+1] ) );
+
+      nestedDistances[i].assign( distances.begin() + static_cast<std::ptrdiff_t>( offsets[i] ),
+                                 distances.begin() + static_cast<std::ptrdiff_t>( offsets[i+1] ) );
+    }
+  }
+};
+
 template <class Wrapper, class ElementType, class IndexType> class NearestNeighbours
 {
 public:
@@ -0,0 +1,589 @@
+#ifndef ALEPH_GEOMETRY_RANDOM_PROJECTION_FOREST_HH__
+#define ALEPH_GEOMETRY_RANDOM_PROJECTION_FOREST_HH__
+
+#include <aleph/geometry/NearestNeighbours.hh>
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class RandomProjectionForest
+  @brief Approximate nearest neighbour calculation for high dimensions
+
+  Partitions the points of a container using a forest of random
+  projection trees. Every inner node of a tree splits its points at the
+  median of their projections onto the difference vector of two random
+  points. Points that share a leaf in any of the trees are considered as
+  candidates for being neighbours. Afterwards, the neighbours of every
+  point are refined by also considering the neighbours of its current
+  neighbours, which quickly improves the quality of the result.
+
+  In contrast to kd-trees, the random projections do not degrade in
+  high dimensions, but the results are only *approximate*: some of the
+  true neighbours of a point may be missing. The trade-off between the
+  quality of the results and the speed is controlled by the number of
+  trees, the size of their leaves, and the number of refinement
+  iterations; larger values result in a better recall. All trees are
+  built in parallel, and all queries are performed in parallel.
+
+  The container is required to store its points contiguously, and to
+  provide access to them via `data()`.
+*/
+
+template <class Container, class DistanceFunctor>
+class RandomProjectionForest : public NearestNeighbours< RandomProjectionForest<Container, DistanceFunctor>, std::size_t, typename Container::ElementType >
+{
+public:
+  using IndexType       = std::size_t;
+  using ElementType     = typename Container::ElementType;
+  using Traits          = aleph::geometry::distances::Traits<DistanceFunctor>;
+  using Distance        = DistanceFunctor;
+  using NeighbourList   = aleph::geometry::NeighbourList<IndexType, ElementType>;
+
+  /**
+    Builds a random projection forest over all points of a container.
+
+    @param container  Container of points
+    @param trees      Number of trees
+    @param leafSize   Maximum number of points in a leaf
+    @param iterations Number of refinement iterations
+    @param seed       Seed for the random number generator; every tree
+                      uses its own generator, so the forest does not
+                      depend on the number of threads
+  */
+
+  explicit RandomProjectionForest( const Container& container,
+                                   unsigned trees        = 8,
+                                   std::size_t leafSize  = 32,
+                                   unsigned iterations   = 1,
+                                   unsigned seed         = 42 )
+    : _container( container )
+    , _points( container.data() )
+    , _dimension( container.dimension() )
+    , _leafSize( std::max( leafSize, std::size_t(1) ) )
+    , _iterations( iterations )
+    , _trees( std::max( trees, 1u ) )
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for( long t = 0; t < static_cast<long>( _trees.size() ); t++ )
+    {
+      auto i = static_cast<std::size_t>( t );
+
+      std::mt19937 rng( static_cast<std::mt19937::result_type>( seed + i ) );
+      this->build( _trees[i], rng );
+    }
+  }
+
+  /**
+    Determines neighbours of every point whose distance is strictly less
+    than the specified radius. Neighbours are reported in ascending order
+    of their indices. Since the neighbourhood relation is symmetric, the
+    results are symmetrized: if a point is reported as a neighbour of
+    another point, the converse holds as well.
+  */
+
+  void radiusSearch( ElementType radius, NeighbourList& result ) const
+  {
+    auto n = this->size();
+
+    std::vector< std::vector<IndexType> > neighbours( n );
+
+    #pragma omp parallel
+    {
+      std::vector<IndexType> candidates;
+
+      #pragma omp for schedule(dynamic, 64)
+      for( long t = 0; t < static_cast<long>( n ); t++ )
+      {
+        auto i = static_cast<IndexType>( t );
+
+        candidates.clear();
+        this->leafCandidates( i, 0, candidates );
+        this->filter( i, radius, candidates, neighbours[i] );
+      }
+    }
+
+    for( unsigned iteration = 0; iteration < _iterations; iteration++ )
+    {
+      auto previous = neighbours;
+
+      #pragma omp parallel
+      {
+        std::vector<IndexType> candidates;
+
+        #pragma omp for schedule(dynamic, 64)
+        for( long t = 0; t < static_cast<long>( n ); t++ )
+        {
+          auto i = static_cast<IndexType>( t );
+
+          candidates.clear();
+
+          for( auto&& j : previous[i] )
+            candidates.insert( candidates.end(), previous[j].begin(), previous[j].end() );
+
+          candidates.insert( candidates.end(), previous[i].begin(), previous[i].end() );
+
+          neighbours[i].clear();
+          this->filter( i, radius, candidates, neighbours[i] );
+        }
+      }
+    }
+
+    // Symmetrize the neighbourhoods -----------------------------------
+
+    result.offsets.assign( n + 1, 0 );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      for( auto&& j : neighbours[i] )
+      {
+        ++result.offsets[i+1];
+
+        if( i != j )
+          ++result.offsets[j+1];
+      }
+    }
+
+    for( std::size_t i = 0; i < n; i++ )
+      result.offsets[i+1] += result.offsets[i];
+
+    result.indices.resize( result.offsets.back() );
+
+    {
+      std::vector<std::size_t> cursors( result.offsets.begin(), result.offsets.end() - 1 );
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        for( auto&& j : neighbours[i] )
+        {
+          result.indices[ cursors[i]++ ] = j;
+
+          if( i != j )
+            result.indices[ cursors[j]++ ] = i;
+        }
+      }
+    }
+
+    std::vector< std::vector<IndexType> >().swap( neighbours );
+
+    // Remove duplicates and calculate distances -----------------------
+
+    std::vector<std::size_t> sizes( n );
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for( long t = 0; t < static_cast<long>( n ); t++ )
+    {
+      auto i     = static_cast<std::size_t>( t );
+      auto begin = result.indices.begin() + static_cast<std::ptrdiff_t>( result.offsets[i] );
+      auto end   = result.indices.begin() + static_cast<std::ptrdiff_t>( result.offsets[i+1] );
+
+      std::sort( begin, end );
+      sizes[i] = static_cast<std::size_t>( std::unique( begin, end ) - begin );
+    }
+
+    {
+      std::size_t offset = 0;
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        auto begin = result.offsets[i];
+
+        std::copy( result.indices.begin() + static_cast<std::ptrdiff_t>( begin ),
+                   result.indices.begin() + static_cast<std::ptrdiff_t>( begin + sizes[i] ),
+                   result.indices.begin() + static_cast<std::ptrdiff_t>( offset ) );
+
+        result.offsets[i] = offset;
+        offset           += sizes[i];
+      }
+
+      result.offsets[n] = offset;
+      result.indices.resize( offset );
+    }
+
+    result.distances.resize( result.indices.size() );
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for( long t = 0; t < static_cast<long>( n ); t++ )
+    {
+      auto i = static_cast<std::size_t>( t );
+
+      for( auto l = result.offsets[i]; l < result.offsets[i+1]; l++ )
+        result.distances[l] = this->distance( i, result.indices[l] );
+    }
+  }
+
+  /** @overload radiusSearch() */
+  void radiusSearch( ElementType radius,
+                     std::vector< std::vector<IndexType> >& indices,
+                     std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->radiusSearch( radius, result );
+    result.unpack( indices, distances );
+  }
+
+  /**
+    Determines approximate \f$k\f$ nearest neighbours of every point,
+    including the point itself. Neighbours are reported in ascending
+    order of their distances; ties are broken by index. Every point is
+    guaranteed to have \f$k\f$ neighbours, unless \f$k\f$ exceeds the
+    number of points, in which case all points will be reported.
+  */
+
+  void neighbourSearch( unsigned k, NeighbourList& result ) const
+  {
+    using Neighbour = std::pair<ElementType, IndexType>;
+
+    auto n = this->size();
+    auto m = std::min( std::size_t( k ), n );
+
+    result.offsets.resize( n + 1 );
+
+    for( std::size_t i = 0; i <= n; i++ )
+      result.offsets[i] = i * m;
+
+    result.indices.resize( n * m );
+    result.distances.resize( n * m );
+
+    if( m == 0 )
+      return;
+
+    // Stores the current neighbours of every point, sorted by their
+    // distance. Every row has exactly `m` entries.
+    std::vector<Neighbour> neighbours( n * m );
+
+    #pragma omp parallel
+    {
+      std::vector<IndexType> candidates;
+      std::vector<Neighbour> selection;
+
+      #pragma omp for schedule(dynamic, 64)
+      for( long t = 0; t < static_cast<long>( n ); t++ )
+      {
+        auto i = static_cast<IndexType>( t );
+
+        candidates.clear();
+        this->leafCandidates( i, m, candidates );
+        this->select( i, m, candidates, selection );
+
+        std::copy( selection.begin(), selection.end(), neighbours.begin() + static_cast<std::ptrdiff_t>( i * m ) );
+      }
+    }
+
+    // Only the closest neighbours of every point are explored, so the
+    // costs of an iteration do not grow quadratically with `k`.
+    auto explored = std::min( m, exploration );
+
+    for( unsigned iteration = 0; iteration < _iterations; iteration++ )
+    {
+      auto previous = neighbours;
+
+      // The neighbourhood graph that is being explored contains the
+      // closest neighbours of every point as well as the *reverse*
+      // neighbours, i.e. the points that consider a point to be one of
+      // their closest neighbours. Without the reverse neighbours, the
+      // refinement would be unable to leave the leaves of the trees.
+      std::vector< std::vector<IndexType> > graph( n );
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        for( std::size_t a = 0; a < explored; a++ )
+        {
+          auto j = previous[i * m + a].second;
+
+          graph[i].push_back( j );
+
+          if( j != i && graph[j].size() < 2 * explored )
+            graph[j].push_back( i );
+        }
+      }
+
+      #pragma omp parallel
+      {
+        std::vector<IndexType> candidates;
+        std::vector<Neighbour> selection;
+
+        #pragma omp for schedule(dynamic, 64)
+        for( long t = 0; t < static_cast<long>( n ); t++ )
+        {
+          auto i = static_cast<IndexType>( t );
+
+          candidates.clear();
+
+          for( std::size_t a = 0; a < m; a++ )
+            candidates.push_back( previous[i * m + a].second );
+
+          for( auto&& j : graph[i] )
+            candidates.insert( candidates.end(), graph[j].begin(), graph[j].end() );
+
+          this->select( i, m, candidates, selection );
+
+          std::copy( selection.begin(), selection.end(), neighbours.begin() + static_cast<std::ptrdiff_t>( i * m ) );
+        }
+      }
+    }
+
+    for( std::size_t l = 0; l < n * m; l++ )
+    {
+      result.distances[l] = neighbours[l].first;
+      result.indices[l]   = neighbours[l].second;
+    }
+  }
+
+  /** @overload neighbourSearch() */
+  void neighbourSearch( unsigned k,
+                        std::vector< std::vector<IndexType> >& indices,
+                        std::vector< std::vector<ElementType> >& distances ) const
+  {
+    NeighbourList result;
+
+    this->neighbourSearch( k, result );
+    result.unpack( indices, distances );
+  }
+
+  std::size_t size() const noexcept
+  {
+    return _container.size();
+  }
+
+private:
+
+  /** Maximum number of neighbours that are explored during refinement */
+  static constexpr std::size_t exploration = 16;
+
+  /**
+    A single random projection tree. Only its leaves are stored, because
+    queries are only ever performed for the points of the container: the
+    leaves partition a permutation of the indices of all points.
+  */
+
+  struct Tree
+  {
+    std::vector<IndexType> indices;     //< Permutation of all indices
+    std::vector<std::size_t> positions; //< Position of every index in the permutation
+    std::vector<std::size_t> offsets;   //< Offsets of all leaves, plus one end offset
+  };
+
+  /** Builds a random projection tree over all points */
+  void build( Tree& tree, std::mt19937& rng ) const
+  {
+    auto n = this->size();
+
+    tree.indices.resize( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+      tree.indices[i] = i;
+
+    std::vector< std::pair<std::size_t, std::size_t> > ranges( 1, std::make_pair( std::size_t(0), n ) );
+    std::vector< std::pair<ElementType, IndexType> > projections;
+    std::vector<ElementType> direction( _dimension );
+    std::vector<ElementType> centre( _dimension );
+
+    tree.offsets.clear();
+
+    while( !ranges.empty() )
+    {
+      auto begin = ranges.back().first;
+      auto end   = ranges.back().second;
+
+      ranges.pop_back();
+
+      if( end - begin <= _leafSize )
+      {
+        tree.offsets.push_back( begin );
+        continue;
+      }
+
+      // Choose two distinct points of the range, whose difference vector
+      // is used as the direction of the projection.
+      std::uniform_int_distribution<std::size_t> distribution( begin, end - 1 );
+
+      auto p = distribution( rng );
+      auto q = distribution( rng );
+
+      if( p == q )
+        q = p + 1 < end ? p + 1 : begin;
+
+      auto x = _points + tree.indices[p] * _dimension;
+      auto y = _points + tree.indices[q] * _dimension;
+
+      for( std::size_t d = 0; d < _dimension; d++ )
+      {
+        direction[d] = x[d] - y[d];
+        centre[d]    = ( x[d] + y[d] ) / 2;
+      }
+
+      projections.clear();
+
+      for( auto i = begin; i < end; i++ )
+      {
+        auto z = _points + tree.indices[i] * _dimension;
+        auto s = ElementType();
+
+        for( std::size_t d = 0; d < _dimension; d++ )
+          s += ( z[d] - centre[d] ) * direction[d];
+
+        projections.push_back( std::make_pair( s, tree.indices[i] ) );
+      }
+
+      // Splitting at the median keeps the tree balanced, even if the two
+      // points happen to be coincident; ties are broken by index.
+      auto middle = projections.begin() + static_cast<std::ptrdiff_t>( ( end - begin ) / 2 );
+
+      std::nth_element( projections.begin(), middle, projections.end() );
+
+      for( auto i = begin; i < end; i++ )
+        tree.indices[i] = projections[i - begin].second;
+
+      auto split = begin + ( end - begin ) / 2;
+
+      ranges.push_back( std::make_pair( split, end ) );
+      ranges.push_back( std::make_pair( begin, split ) );
+    }
+
+    // Ranges are processed depth-first, starting with the left range, so
+    // the offsets of the leaves are already sorted.
+    tree.offsets.push_back( n );
+
+    tree.positions.resize( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+      tree.positions[ tree.indices[i] ] = i;
+  }
+
+  /**
+    Collects the points that share a leaf with a given point in any of
+    the trees. For every tree, at least `minimum` points are collected,
+    taking the points that are adjacent to the leaf if necessary. Since
+    sibling leaves are stored next to each other, these are also close
+    in space.
+  */
+
+  void leafCandidates( IndexType i, std::size_t minimum, std::vector<IndexType>& candidates ) const
+  {
+    auto n = this->size();
+
+    for( auto&& tree : _trees )
+    {
+      auto position = tree.positions[i];
+      auto leaf     = std::upper_bound( tree.offsets.begin(), tree.offsets.end(), position ) - 1;
+      auto begin    = *leaf;
+      auto end      = *( leaf + 1 );
+
+      if( end - begin < minimum )
+      {
+        begin = position >= minimum / 2 ? position - minimum / 2 : 0;
+        end   = std::min( n, begin + minimum );
+        begin = end - minimum;
+      }
+
+      candidates.insert( candidates.end(),
+                         tree.indices.begin() + static_cast<std::ptrdiff_t>( begin ),
+                         tree.indices.begin() + static_cast<std::ptrdiff_t>( end ) );
+    }
+  }
+
+  /**
+    Selects the \f$m\f$ closest candidates of a point, sorted by their
+    distance. Candidates may contain duplicates.
+  */
+
+  void select( IndexType i,
+               std::size_t m,
+               std::vector<IndexType>& candidates,
+               std::vector< std::pair<ElementType, IndexType> >& selection ) const
+  {
+    std::sort( candidates.begin(), candidates.end() );
+    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+    selection.clear();
+
+    for( auto&& j : candidates )
+      selection.push_back( std::make_pair( this->distance( i, j ), j ) );
+
+    auto middle = selection.begin() + static_cast<std::ptrdiff_t>( m );
+
+    std::partial_sort( selection.begin(), middle, selection.end() );
+    selection.erase( middle, selection.end() );
+  }
+
+  /**
+    Stores all candidates of a point whose distance is strictly less than
+    the specified radius, sorted by index. Candidates may contain
+    duplicates.
+  */
+
+  void filter( IndexType i,
+               ElementType radius,
+               std::vector<IndexType>& candidates,
+               std::vector<IndexType>& neighbours ) const
+  {
+    std::sort( candidates.begin(), candidates.end() );
+    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+    for( auto&& j : candidates )
+    {
+      if( this->distance( i, j ) < radius )
+        neighbours.push_back( j );
+    }
+  }
+
+  /** Calculates the converted distance between two points */
+  ElementType distance( IndexType i, IndexType j ) const
+  {
+    return static_cast<ElementType>( _traits.from( _distance( _points + i * _dimension,
+                                                              _points + j * _dimension,
+                                                              _dimension ) ) );
+  }
+
+  /** Reference to the original container */
+  const Container& _container;
+
+  /** Coordinates of all points of the container */
+  const ElementType* _points;
+
+  /** Dimension of all points */
+  std::size_t _dimension;
+
+  /** Maximum number of points in a leaf */
+  std::size_t _leafSize;
+
+  /** Number of refinement iterations */
+  unsigned _iterations;
+
+  /** Trees of the forest */
+  std::vector<Tree> _trees;
+
+  /** Distance functor */
+  DistanceFunctor _distance;
+
+  /** Required for optional distance functor conversions */
+  Traits _traits;
+};
+
+template <class Container, class DistanceFunctor> constexpr std::size_t RandomProjectionForest<Container, DistanceFunctor>::exploration;
+
+} // namespace geometry
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
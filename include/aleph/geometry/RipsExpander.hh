@@ -6,11 +6,20 @@
 #include <list>
 #include <limits>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <cstddef>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
 namespace aleph
 {
 
@@ -98,6 +107,187 @@ public:
     return SimplicialComplex( simplices.begin(), simplices.end() );
   }
 
+  /**
+    Parallel variant of the expansion. The lower neighbours of every
+    vertex are stored as sorted arrays in a compressed sparse row layout,
+    so co-faces are found by merging sorted arrays. Every block of top
+    vertices, i.e. the largest vertices of the simplices, is expanded
+    independently into its own contiguous buffer. Buffers are merged in
+    the order of their top vertices, so the result does not depend on
+    the number of threads.
+
+    Like `operator()`, which expands the vertices reported by
+    `K.vertices()`, only the vertices of 0-simplices are expanded. An
+    edge whose larger vertex is not a 0-simplex is therefore not part
+    of the result, although it may still be used for expanding larger
+    vertices. With this, the simplices are the same as for
+    `operator()`, and so are their weights: vertices and edges keep
+    their weights from the original complex, which are assigned during
+    the expansion. Higher-dimensional simplices get a default weight,
+    unless `maximumWeight` is set. In this case, they get the maximum
+    weight of their edges, which gives the same result as calling
+    `assignMaximumWeight()` afterwards.
+
+    @param K             Simplicial complex; only its 0-simplices and
+                         1-simplices are used
+    @param dimension     Maximum dimension of the expansion
+    @param maximumWeight Flag indicating whether the maximum weight of
+                         their edges is assigned to simplices
+  */
+
+  SimplicialComplex expand( const SimplicialComplex& K, unsigned dimension, bool maximumWeight = false ) const
+  {
+    // Vertices -------------------------------------------------------
+    //
+    // Only the 0-simplices are expanded, matching `K.vertices()` in
+    // `operator()`, but edges may refer to other vertices as well, so
+    // all of them are assigned a dense index.
+
+    std::vector<VertexType> vertices;
+    std::vector<VertexType> topVertices;
+    std::vector<DataType> vertexWeights;
+
+    {
+      auto&& pair = K.range(0);
+      for( auto it = pair.first; it != pair.second; ++it )
+        topVertices.push_back( *( it->begin() ) );
+    }
+
+    {
+      auto&& pair = K.range(1);
+      for( auto it = pair.first; it != pair.second; ++it )
+      {
+        vertices.push_back( *( it->begin()     ) );
+        vertices.push_back( *( it->begin() + 1 ) );
+      }
+    }
+
+    vertices.insert( vertices.end(), topVertices.begin(), topVertices.end() );
+
+    std::sort( vertices.begin(), vertices.end() );
+    vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+    auto indexOf = [&vertices] ( VertexType v )
+    {
+      return static_cast<std::size_t>( std::lower_bound( vertices.begin(), vertices.end(), v ) - vertices.begin() );
+    };
+
+    // Like for `find()`, the first occurrence of a simplex determines
+    // its weight.
+    {
+      std::vector<bool> seen( vertices.size() );
+
+      vertexWeights.resize( vertices.size() );
+
+      auto&& pair = K.range(0);
+      for( auto it = pair.first; it != pair.second; ++it )
+      {
+        auto u = indexOf( *( it->begin() ) );
+
+        if( !seen[u] )
+        {
+          vertexWeights[u] = it->data();
+          seen[u]          = true;
+        }
+      }
+    }
+
+    std::sort( topVertices.begin(), topVertices.end() );
+    topVertices.erase( std::unique( topVertices.begin(), topVertices.end() ), topVertices.end() );
+
+    // Lower neighbours -----------------------------------------------
+
+    FlatGraph G;
+
+    {
+      std::vector< std::tuple<std::size_t, std::size_t, DataType> > edges;
+
+      auto&& pair = K.range(1);
+      for( auto it = pair.first; it != pair.second; ++it )
+      {
+        auto u = indexOf( *( it->begin()     ) );
+        auto v = indexOf( *( it->begin() + 1 ) );
+
+        if( u != v )
+          edges.emplace_back( std::max( u, v ), std::min( u, v ), it->data() );
+      }
+
+      std::stable_sort( edges.begin(), edges.end(),
+                        [] ( const std::tuple<std::size_t, std::size_t, DataType>& e,
+                             const std::tuple<std::size_t, std::size_t, DataType>& f )
+                        {
+                          return std::make_pair( std::get<0>( e ), std::get<1>( e ) ) < std::make_pair( std::get<0>( f ), std::get<1>( f ) );
+                        } );
+
+      G.offsets.assign( vertices.size() + 1, 0 );
+
+      for( std::size_t i = 0; i < edges.size(); i++ )
+      {
+        auto u = std::get<0>( edges[i] );
+        auto v = std::get<1>( edges[i] );
+
+        if( i > 0 && u == std::get<0>( edges[i-1] ) && v == std::get<1>( edges[i-1] ) )
+          continue;
+
+        ++G.offsets[u+1];
+        G.neighbours.push_back( v );
+        G.weights.push_back( std::get<2>( edges[i] ) );
+      }
+
+      for( std::size_t u = 0; u < vertices.size(); u++ )
+        G.offsets[u+1] += G.offsets[u];
+    }
+
+    // Expansion ------------------------------------------------------
+
+    auto numBlocks = ( topVertices.size() + blockSize - 1 ) / blockSize;
+
+    std::vector< std::vector<Simplex> > buffers( numBlocks );
+
+    #pragma omp parallel
+    {
+      std::vector< std::vector<Candidate> > candidates( dimension + 1 );
+      std::vector<std::size_t> simplex;
+
+      #pragma omp for schedule(dynamic)
+      for( long t = 0; t < static_cast<long>( numBlocks ); t++ )
+      {
+        auto block    = static_cast<std::size_t>( t );
+        auto&& buffer = buffers[block];
+        auto end      = std::min( topVertices.size(), ( block + 1 ) * blockSize );
+
+        for( auto i = block * blockSize; i < end; i++ )
+        {
+          auto u = indexOf( topVertices[i] );
+
+          buffer.push_back( Simplex( vertices[u], vertexWeights[u] ) );
+
+          if( dimension == 0 )
+            continue;
+
+          candidates.front().clear();
+
+          for( auto l = G.offsets[u]; l < G.offsets[u+1]; l++ )
+            candidates.front().push_back( std::make_pair( G.neighbours[l], G.weights[l] ) );
+
+          simplex.assign( 1, u );
+
+          addCofaces( G, vertices, simplex, DataType(), 0, candidates, dimension, maximumWeight, buffer );
+        }
+      }
+    }
+
+    SimplicialComplex L;
+
+    for( auto&& buffer : buffers )
+    {
+      L.insert( buffer.begin(), buffer.end() );
+      std::vector<Simplex>().swap( buffer );
+    }
+
+    return L;
+  }
+
   // Weight assignment -------------------------------------------------
 
   SimplicialComplex assignMaximumWeight( const SimplicialComplex& K, unsigned minDimension = 1 )
@@ -201,6 +391,106 @@ private:
   using VertexContainer    = std::unordered_set<VertexType>;
   using LowerNeighboursMap = std::unordered_map<VertexType, VertexContainer>;
 
+  /** Number of top vertices that are expanded into the same buffer */
+  static constexpr std::size_t blockSize = 64;
+
+  /**
+    Lower neighbours of all vertices, using dense vertex indices. The
+    lower neighbours of a vertex are sorted, and every neighbour stores
+    the weight of the corresponding edge.
+  */
+
+  struct FlatGraph
+  {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> neighbours;
+    std::vector<DataType> weights;
+  };
+
+  /**
+    Candidate vertex for extending a simplex, along with the maximum
+    weight of all edges between the candidate and the simplex.
+  */
+
+  using Candidate = std::pair<std::size_t, DataType>;
+
+  /**
+    Adds all co-faces of a simplex, given by dense vertex indices, whose
+    candidates for additional vertices are stored at a given depth.
+
+    @param G             Lower neighbours of all vertices
+    @param vertices      Vertices of the complex, i.e. the inverse of the
+                         dense indices
+    @param simplex       Current simplex
+    @param weight        Maximum weight of the edges of the current simplex
+    @param depth         Depth of the candidates of the current simplex
+    @param candidates    Candidates of all depths
+    @param dimension     Maximum dimension of the expansion
+    @param maximumWeight Flag indicating whether weights are assigned to
+                         higher-dimensional simplices
+    @param buffer        Output buffer
+  */
+
+  static void addCofaces( const FlatGraph& G,
+                          const std::vector<VertexType>& vertices,
+                          std::vector<std::size_t>& simplex,
+                          DataType weight,
+                          std::size_t depth,
+                          std::vector< std::vector<Candidate> >& candidates,
+                          unsigned dimension,
+                          bool maximumWeight,
+                          std::vector<Simplex>& buffer )
+  {
+    std::vector<VertexType> coface;
+
+    for( auto&& candidate : candidates[depth] )
+    {
+      auto u            = candidate.first;
+      auto cofaceWeight = depth == 0 ? candidate.second : std::max( weight, candidate.second );
+
+      simplex.push_back( u );
+
+      coface.clear();
+      for( auto&& v : simplex )
+        coface.push_back( vertices[v] );
+
+      // Edges keep their original weight, whereas the weight of higher-
+      // dimensional simplices is calculated like in
+      // `assignMaximumWeight()`, which includes the default weight.
+      auto data = depth == 0 ? cofaceWeight
+                             : maximumWeight ? std::max( DataType(), cofaceWeight ) : DataType();
+
+      buffer.push_back( Simplex( coface.begin(), coface.end(), data ) );
+
+      if( simplex.size() <= dimension )
+      {
+        auto&& next = candidates[depth+1];
+        next.clear();
+
+        // Intersect the lower neighbours of the new vertex with the
+        // current candidates; both of them are sorted.
+        auto it  = candidates[depth].begin();
+        auto end = candidates[depth].end();
+
+        for( auto l = G.offsets[u]; l < G.offsets[u+1] && it != end; l++ )
+        {
+          auto v = G.neighbours[l];
+
+          while( it != end && it->first < v )
+            ++it;
+
+          if( it != end && it->first == v )
+            next.push_back( std::make_pair( v, std::max( it->second, G.weights[l] ) ) );
+        }
+
+        if( !next.empty() )
+          addCofaces( G, vertices, simplex, cofaceWeight, depth + 1, candidates, dimension, maximumWeight, buffer );
+      }
+
+      simplex.pop_back();
+    }
+  }
+
   static void addCofaces( const Simplex& s,
                           const LowerNeighboursMap& lowerNeighboursMap,
                           const VertexContainer& neighbours,
@@ -277,8 +567,12 @@ private:
   }
 };
 
+template <class SimplicialComplex> constexpr std::size_t RipsExpander<SimplicialComplex>::blockSize;
+
 } // namespace geometry
 
 } // namespace aleph
 
+#pragma GCC diagnostic pop
+
 #endif
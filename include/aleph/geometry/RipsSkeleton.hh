@@ -12,13 +12,26 @@ namespace aleph
 namespace geometry
 {
 
-template <class NearestNeighbours> class RipsSkeleton
+/**
+  @class RipsSkeleton
+  @brief Calculates the 1-skeleton of a Vietoris--Rips complex
+
+  @tparam NearestNeighbours Nearest neighbour search structure
+  @tparam S                 Simplex type; can be changed to a simplex with
+                            inline vertex storage, for example
+*/
+
+template <
+  class NearestNeighbours,
+  class S = topology::Simplex<typename NearestNeighbours::ElementType,
+                              typename NearestNeighbours::IndexType>
+> class RipsSkeleton
 {
 public:
   using ElementType       = typename NearestNeighbours::ElementType;
   using IndexType         = typename NearestNeighbours::IndexType;
 
-  using Simplex           = topology::Simplex<ElementType, IndexType>;
+  using Simplex           = S;
   using SimplicialComplex = topology::SimplicialComplex<Simplex>;
 
   SimplicialComplex operator()( const NearestNeighbours& nn, ElementType epsilon ) const
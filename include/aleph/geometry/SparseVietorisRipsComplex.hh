@@ -0,0 +1,427 @@
+#ifndef ALEPH_GEOMETRY_SPARSE_VIETORIS_RIPS_COMPLEX_HH__
+#define ALEPH_GEOMETRY_SPARSE_VIETORIS_RIPS_COMPLEX_HH__
+
+#include <aleph/geometry/CoverTree.hh>
+#include <aleph/geometry/CoverTreeNeighbours.hh>
+#include <aleph/geometry/RipsExpander.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  Calculates a greedy permutation, i.e. a farthest point ordering, of
+  a container. The first point of the permutation is the first point of
+  the container. Every subsequent point is the one with the largest
+  distance to all previous points; ties are broken by choosing the
+  point with the smallest index.
+
+  Every point is assigned to its nearest previous point, resulting in a
+  Voronoi partition of the points. The farthest point of each cell is
+  kept in a priority queue. Inserting a new point only affects the cells
+  whose centres are sufficiently close to it; these are found by means
+  of a cover tree that contains all previous points.
+
+  @param container Container whose points are permuted
+  @param radii     Output vector for the insertion radii of all points,
+                   indexed by the points of the container. The insertion
+                   radius of a point is its distance to all points that
+                   come before it in the permutation. The first point has
+                   an infinite insertion radius.
+
+  @returns Indices of the points of the container in the order of the
+  greedy permutation. Duplicate points appear at the end of the order,
+  with an insertion radius of zero.
+*/
+
+template <class Distance, class Container> std::vector<std::size_t> greedyPermutation(
+  const Container& container,
+  std::vector<typename Container::ElementType>& radii,
+  Distance /* distance */ = Distance() )
+{
+  using ElementType = typename Container::ElementType;
+  using Metric      = typename CoverTreeNeighbours<Container, Distance>::Metric;
+
+  auto n = container.size();
+
+  std::vector<std::size_t> order;
+  radii.assign( n, ElementType() );
+
+  if( n == 0 )
+    return order;
+
+  order.reserve( n );
+
+  Metric metric( container.data(), container.dimension() );
+  CoverTree<std::size_t, Metric> tree( metric );
+
+  // Distance of every point to its nearest previous point, i.e. the
+  // centre of its Voronoi cell
+  std::vector<ElementType> distances( n );
+  std::vector<bool> inserted( n );
+
+  // Points in the Voronoi cells of all centres, excluding the centres
+  // themselves, as well as the farthest point of every cell.
+  std::vector< std::vector<std::size_t> > cells( n );
+  std::vector<std::size_t> farthest( n );
+  std::vector<ElementType> cellRadii( n );
+
+  struct Entry
+  {
+    ElementType distance;
+    std::size_t point;
+    std::size_t centre;
+  };
+
+  auto compare = [] ( const Entry& a, const Entry& b )
+  {
+    return a.distance < b.distance || ( a.distance == b.distance && a.point > b.point );
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, decltype(compare)> queue( compare );
+
+  auto update = [&] ( std::size_t y )
+  {
+    cellRadii[y] = ElementType();
+
+    if( cells[y].empty() )
+      return;
+
+    auto p = cells[y].front();
+
+    for( auto&& q : cells[y] )
+    {
+      if( distances[q] > distances[p] || ( distances[q] == distances[p] && q < p ) )
+        p = q;
+    }
+
+    farthest[y]  = p;
+    cellRadii[y] = distances[p];
+
+    queue.push( { distances[p], p, y } );
+  };
+
+  order.push_back( 0 );
+  radii.front()    = std::numeric_limits<ElementType>::infinity();
+  inserted.front() = true;
+
+  for( std::size_t i = 1; i < n; i++ )
+  {
+    distances[i] = metric( 0, i );
+    cells.front().push_back( i );
+  }
+
+  update( 0 );
+  tree.insert( 0 );
+
+  std::vector< std::pair<std::size_t, ElementType> > neighbours;
+  std::vector<std::size_t> cell;
+
+  while( !queue.empty() )
+  {
+    auto entry = queue.top();
+    queue.pop();
+
+    // Entries are not removed from the queue when a cell changes, so
+    // outdated entries have to be skipped here.
+    if( inserted[ entry.point ] || farthest[ entry.centre ] != entry.point || cellRadii[ entry.centre ] != entry.distance )
+      continue;
+
+    // Only duplicate points are left
+    if( entry.distance <= ElementType() )
+      break;
+
+    auto c      = entry.point;
+    auto lambda = entry.distance;
+
+    order.push_back( c );
+    radii[c]    = lambda;
+    inserted[c] = true;
+
+    neighbours.clear();
+    tree.radiusSearch( c, 2 * lambda, std::back_inserter( neighbours ) );
+
+    // A point of the cell of y can only be closer to c than to y if the
+    // distance between y and c is less than twice the cell radius.
+    for( auto&& pair : neighbours )
+    {
+      auto y = pair.first;
+
+      if( pair.second >= 2 * cellRadii[y] )
+        continue;
+
+      cell.clear();
+
+      for( auto&& p : cells[y] )
+      {
+        if( p == c )
+          continue;
+
+        auto d = metric( c, p );
+
+        if( d < distances[p] )
+        {
+          distances[p] = d;
+          cells[c].push_back( p );
+        }
+        else
+          cell.push_back( p );
+      }
+
+      cells[y].swap( cell );
+      update( y );
+    }
+
+    update( c );
+    tree.insert( c );
+  }
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    if( !inserted[i] )
+      order.push_back( i );
+  }
+
+  return order;
+}
+
+namespace detail
+{
+
+/**
+  Weight of a point with insertion radius \p lambda at scale \p alpha
+  in the relaxed Vietoris--Rips filtration.
+*/
+
+template <class T> T sparseRipsWeight( T lambda, T epsilon, T alpha )
+{
+  if( alpha <= lambda / epsilon )
+    return T();
+  else if( alpha <= lambda / ( epsilon * ( 1 - epsilon ) ) )
+    return alpha - lambda / epsilon;
+  else
+    return epsilon * alpha;
+}
+
+/**
+  Calculates the scale at which an edge between two points at distance
+  \p d with insertion radii \p lambdaP and \p lambdaQ appears in the
+  sparse Vietoris--Rips filtration. The first point is assumed to have
+  the larger insertion radius.
+
+  @returns Smallest scale \f$\alpha\f$ with
+  \f$d + w_p(\alpha) + w_q(\alpha) \leq 2\alpha\f$, or infinity if
+  the edge does not appear before the second point is removed
+*/
+
+template <class T> T sparseRipsEdgeScale( T d, T lambdaP, T lambdaQ, T epsilon )
+{
+  auto death = lambdaQ / ( epsilon * ( 1 - epsilon ) );
+
+  auto f = [&] ( T alpha )
+  {
+    return 2 * alpha - sparseRipsWeight( lambdaP, epsilon, alpha ) - sparseRipsWeight( lambdaQ, epsilon, alpha );
+  };
+
+  if( f( death ) < d )
+    return std::numeric_limits<T>::infinity();
+
+  // The function is non-decreasing and linear between these points, so
+  // it suffices to find the first interval that contains the solution.
+  T breakpoints[] = { T(), lambdaQ / epsilon, lambdaP / epsilon, death };
+
+  std::sort( std::begin( breakpoints ), std::end( breakpoints ) );
+
+  auto a = T();
+
+  for( auto&& b : breakpoints )
+  {
+    if( b > death )
+      break;
+
+    auto fb = f( b );
+
+    if( fb >= d )
+    {
+      auto fa = f( a );
+
+      if( fb <= fa )
+        return b;
+
+      return std::min( b, a + ( d - fa ) * ( b - a ) / ( fb - fa ) );
+    }
+
+    a = b;
+  }
+
+  return death;
+}
+
+} // namespace detail
+
+/**
+  Builds a sparse Vietoris--Rips complex of a container. The size of
+  the complex is linear in the number of points for data of bounded
+  doubling dimension, so it can be calculated for large point clouds
+  for which the Vietoris--Rips complex would be prohibitively large.
+
+  The construction follows the papers:
+
+  > Linear-Size Approximations to the Vietoris--Rips Filtration\n
+  > Donald R. Sheehy\n
+  > Discrete & Computational Geometry 49(4), 2013
+
+  > A Geometric Perspective on Sparse Filtrations\n
+  > Nicholas J. Cavanna, Mahmoodreza Jahanseir, and Donald R. Sheehy\n
+  > Proceedings of the 27th Canadian Conference on Computational Geometry
+
+  Points are ordered by a greedy permutation. Every point is removed
+  from the complex once the scale exceeds a multiple of its insertion
+  radius, after which its simplices stop growing. Distances between
+  the remaining points are perturbed by weights that depend on their
+  insertion radii, which makes it possible to remove points without
+  changing the topology too much.
+
+  The persistence diagrams of the resulting filtration are
+  multiplicatively \f$(1+\epsilon)\f$-interleaved with the ones of the
+  Vietoris--Rips filtration: every simplex appears no earlier than in
+  the Vietoris--Rips filtration, and the homology of the Vietoris--Rips
+  complex at scale \f$t\f$ is captured at scale \f$(1+\epsilon)t\f$ at
+  the latest. In particular, the bottleneck distance between the
+  logarithms of the diagrams is at most \f$\log(1+\epsilon)\f$.
+
+  @param container Container for which to calculate the complex
+  @param epsilon   Approximation factor; larger values result in fewer
+                   simplices
+  @param dimension Maximum dimension of the simplices
+  @param threshold Maximum scale of the simplices; the complex contains
+                   all simplices up to this scale by default
+
+  @returns Sparse Vietoris--Rips complex whose simplices use the scale
+  at which they appear as their data, sorted according to this value.
+  The scale is given in units of the distance function, just like for
+  a Vietoris--Rips complex.
+*/
+
+template <class Distance, class Container> auto buildSparseVietorisRipsComplex(
+  const Container& container,
+  typename Container::ElementType epsilon,
+  unsigned dimension,
+  typename Container::ElementType threshold = std::numeric_limits<typename Container::ElementType>::infinity(),
+  Distance distance = Distance() ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, std::size_t> >
+{
+  using ElementType       = typename Container::ElementType;
+  using Metric            = typename CoverTreeNeighbours<Container, Distance>::Metric;
+  using Simplex           = topology::Simplex<ElementType, std::size_t>;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  if( !( epsilon > ElementType() ) )
+    throw std::runtime_error( "Approximation factor must be positive" );
+
+  // The relaxed filtration is interleaved with the Vietoris--Rips
+  // filtration by a factor of $1/(1-\delta)$, which is turned into the
+  // requested factor.
+  auto delta = epsilon / ( 1 + epsilon );
+  auto n     = container.size();
+
+  std::vector<Simplex> simplices;
+  simplices.reserve( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+    simplices.push_back( Simplex( i ) );
+
+  // Without any edges, the complex only consists of the vertices
+  if( dimension == 0 )
+    return SimplicialComplex( simplices.begin(), simplices.end() );
+
+  std::vector<ElementType> radii;
+  auto order = greedyPermutation( container, radii, distance );
+
+  // Scale, in units of the distance function, at which every point is
+  // removed from the complex
+  std::vector<ElementType> deaths( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+    deaths[i] = 2 * radii[i] / ( delta * ( 1 - delta ) );
+
+  Metric metric( container.data(), container.dimension() );
+  CoverTree<std::size_t, Metric> tree( metric );
+
+  std::vector< std::pair<std::size_t, ElementType> > neighbours;
+
+  for( auto&& q : order )
+  {
+    // All previous points have larger insertion radii, so the edges are
+    // limited by the removal of the current point. Duplicate points are
+    // only connected to their copies.
+    auto radius = std::min( deaths[q], threshold );
+
+    neighbours.clear();
+    tree.radiusSearch( q, std::nextafter( radius, std::numeric_limits<ElementType>::infinity() ), std::back_inserter( neighbours ) );
+
+    for( auto&& pair : neighbours )
+    {
+      auto p     = pair.first;
+      auto alpha = detail::sparseRipsEdgeScale( pair.second, radii[p], radii[q], delta );
+      auto data  = std::max( pair.second, 2 * alpha );
+
+      if( alpha < std::numeric_limits<ElementType>::infinity() && data <= threshold )
+        simplices.push_back( Simplex( {p, q}, data ) );
+    }
+
+    tree.insert( q );
+  }
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+
+  if( dimension > 1 )
+  {
+    RipsExpander<SimplicialComplex> ripsExpander;
+    K = ripsExpander.expand( K, dimension, true );
+
+    // A simplex only appears if none of its vertices has been removed
+    // before all of its edges appear. Cofaces of a simplex that violates
+    // this condition also violate it, so the result is a complex.
+    simplices.clear();
+
+    for( auto&& simplex : K )
+    {
+      auto death = std::numeric_limits<ElementType>::infinity();
+
+      for( auto&& v : simplex )
+        death = std::min( death, deaths[v] );
+
+      if( simplex.dimension() <= 1 || simplex.data() <= death )
+        simplices.push_back( simplex );
+    }
+
+    K = SimplicialComplex( simplices.begin(), simplices.end() );
+  }
+
+  K.sort( topology::filtrations::Data<Simplex>() );
+  return K;
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
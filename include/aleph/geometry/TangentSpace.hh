@@ -3,7 +3,7 @@
 
 #include <aleph/config/Eigen.hh>
 
-#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/FLANN.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
@@ -120,7 +120,7 @@ private:
 #ifdef ALEPH_WITH_FLANN
     using NearestNeighbours = FLANN<Container, Distance>;
 #else
-    using NearestNeighbours = BruteForce<Container, Distance>;
+    using NearestNeighbours = KDTree<Container, Distance>;
 #endif
 
     NearestNeighbours nearestNeighbours( container );
@@ -48,8 +48,7 @@ template <class NearestNeighbours> auto buildVietorisRipsComplex(
 
   geometry::RipsExpander<SimplicialComplex> ripsExpander;
 
-  auto K = ripsExpander( skeleton, dimension );
-  K      = ripsExpander.assignMaximumWeight( K );
+  auto K = ripsExpander.expand( skeleton, dimension, true );
 
   K.sort( topology::filtrations::Data<Simplex>() );
 
@@ -87,7 +86,7 @@ auto buildVietorisRipsComplex(
 
   geometry::RipsExpander<SimplicialComplex> ripsExpander;
 
-  auto K = ripsExpander( skeleton, dimension );
+  auto K = ripsExpander.expand( skeleton, dimension );
   K      = ripsExpander.assignMaximumData( K, begin, end );
 
   K.sort( topology::filtrations::Data<Simplex>() );
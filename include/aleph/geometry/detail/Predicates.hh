@@ -0,0 +1,430 @@
+#ifndef ALEPH_GEOMETRY_DETAIL_PREDICATES_HH__
+#define ALEPH_GEOMETRY_DETAIL_PREDICATES_HH__
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+/**
+  @class Expansion
+  @brief Exact representation of a sum of floating-point numbers
+
+  An expansion stores a real number as an unevaluated sum of doubles
+  whose magnitudes are non-overlapping and sorted in increasing order.
+  Sums, differences, and products of expansions are exact, provided
+  that no overflow or underflow occurs. The sign of an expansion is the
+  sign of its largest component.
+
+  The implementation follows the algorithms described by Shewchuk:
+
+  > Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates
+  > Jonathan Richard Shewchuk
+  > Discrete & Computational Geometry, Volume 18, Issue 3, October 1997, Pages 305--363
+
+  They require IEEE 754 double precision with round-to-nearest. Hence,
+  the code must not be compiled with options such as `-ffast-math`.
+*/
+
+class Expansion
+{
+public:
+  Expansion()
+    : _components( 1, 0.0 )
+  {
+  }
+
+  explicit Expansion( double x )
+    : _components( 1, x )
+  {
+  }
+
+  /** Calculates the exact difference of two numbers */
+  static Expansion difference( double a, double b )
+  {
+    double x = a - b;
+    double v = a - x;
+    double y = ( a - ( x + v ) ) + ( v - b );
+
+    Expansion result( y );
+    result.grow( x );
+
+    return result;
+  }
+
+  Expansion operator+( const Expansion& other ) const
+  {
+    Expansion result = *this;
+
+    for( auto&& c : other._components )
+      result.grow( c );
+
+    return result;
+  }
+
+  Expansion operator-( const Expansion& other ) const
+  {
+    Expansion result = *this;
+
+    for( auto&& c : other._components )
+      result.grow( -c );
+
+    return result;
+  }
+
+  Expansion operator*( const Expansion& other ) const
+  {
+    Expansion result;
+
+    for( auto&& c : other._components )
+      result = result + this->scale( c );
+
+    return result;
+  }
+
+  /** @returns Sign of the represented number */
+  int sign() const
+  {
+    auto x = _components.back();
+    return ( x > 0 ) - ( x < 0 );
+  }
+
+private:
+
+  /** Calculates the sum of two numbers and its rounding error */
+  static void twoSum( double a, double b, double& x, double& y )
+  {
+    x        = a + b;
+    double v = x - a;
+    y        = ( a - ( x - v ) ) + ( b - v );
+  }
+
+  /** Calculates the product of two numbers and its rounding error */
+  static void twoProduct( double a, double b, double& x, double& y )
+  {
+    x = a * b;
+    y = std::fma( a, b, -x );
+  }
+
+  /** Adds a number to the expansion, removing zero components */
+  void grow( double b )
+  {
+    std::vector<double> components;
+    components.reserve( _components.size() + 1 );
+
+    double q = b;
+
+    for( auto&& c : _components )
+    {
+      double sum, error;
+      twoSum( q, c, sum, error );
+
+      q = sum;
+
+      if( error != 0.0 )
+        components.push_back( error );
+    }
+
+    if( q != 0.0 || components.empty() )
+      components.push_back( q );
+
+    _components.swap( components );
+  }
+
+  /** Multiplies the expansion by a number, removing zero components */
+  Expansion scale( double b ) const
+  {
+    Expansion result;
+    result._components.clear();
+
+    double q, error;
+    twoProduct( _components.front(), b, q, error );
+
+    if( error != 0.0 )
+      result._components.push_back( error );
+
+    for( std::size_t i = 1; i < _components.size(); i++ )
+    {
+      double product, productError, sum;
+
+      twoProduct( _components[i], b, product, productError );
+      twoSum( q, productError, sum, error );
+
+      if( error != 0.0 )
+        result._components.push_back( error );
+
+      // Since the magnitude of the product is larger than the magnitude
+      // of the sum, the error of their sum can be calculated quickly.
+      q     = product + sum;
+      error = sum - ( q - product );
+
+      if( error != 0.0 )
+        result._components.push_back( error );
+    }
+
+    if( q != 0.0 || result._components.empty() )
+      result._components.push_back( q );
+
+    return result;
+  }
+
+  std::vector<double> _components;
+};
+
+/**
+  @class Magnitude
+  @brief Upper bound for the magnitude of intermediate results
+
+  Evaluating an expression with this type instead of a floating-point
+  type results in the sum of the absolute values of all its terms, e.g.
+  the permanent instead of the determinant of a matrix. This quantity
+  bounds the rounding error of the floating-point evaluation.
+*/
+
+struct Magnitude
+{
+  double value;
+
+  Magnitude operator+( const Magnitude& other ) const { return { value + other.value }; }
+  Magnitude operator-( const Magnitude& other ) const { return { value + other.value }; }
+  Magnitude operator*( const Magnitude& other ) const { return { value * other.value }; }
+};
+
+/** Calculates the difference of two coordinates using a given number type */
+template <class T> T difference( double a, double b );
+
+template <> inline double difference<double>( double a, double b )
+{
+  return a - b;
+}
+
+template <> inline Magnitude difference<Magnitude>( double a, double b )
+{
+  return { std::abs( a - b ) };
+}
+
+template <> inline Expansion difference<Expansion>( double a, double b )
+{
+  return Expansion::difference( a, b );
+}
+
+/** Calculates the determinant of a small matrix by Laplace expansion */
+template <class T, std::size_t N> struct Determinant
+{
+  static T calculate( const std::array<std::array<T, N>, N>& M )
+  {
+    std::array<std::array<T, N - 1>, N - 1> minor;
+
+    auto cofactor = [&M, &minor] ( std::size_t j )
+    {
+      for( std::size_t i = 1; i < N; i++ )
+        for( std::size_t k = 0, l = 0; k < N; k++ )
+          if( k != j )
+            minor[i-1][l++] = M[i][k];
+
+      return M[0][j] * Determinant<T, N - 1>::calculate( minor );
+    };
+
+    T result = cofactor( 0 );
+
+    for( std::size_t j = 1; j < N; j++ )
+      result = j % 2 == 0 ? result + cofactor( j ) : result - cofactor( j );
+
+    return result;
+  }
+};
+
+template <class T> struct Determinant<T, 1>
+{
+  static T calculate( const std::array<std::array<T, 1>, 1>& M )
+  {
+    return M[0][0];
+  }
+};
+
+/**
+  Calculates the sign of a predicate, i.e. of a polynomial expression of
+  coordinate differences. The predicate is first evaluated with doubles.
+  If the result is too close to zero in comparison to the bound for its
+  rounding error, it is evaluated exactly.
+
+  The predicate must provide a function template `evaluate<T>()` that
+  evaluates the expression using a number type `T`. Every term of the
+  expression must be a product of at most eight coordinate differences,
+  and every path through the evaluation must involve at most 32 further
+  operations; the predicates below satisfy this with a large margin.
+*/
+
+template <class Predicate> int sign( const Predicate& predicate )
+{
+  // The rounding error of the evaluation is bounded by a multiple of
+  // the unit roundoff and the magnitude of the expression. The factor
+  // leaves some room for the rounding errors of the magnitude itself.
+  constexpr double bound = 64 * std::numeric_limits<double>::epsilon() / 2;
+
+  auto value     = predicate.template evaluate<double>();
+  auto magnitude = predicate.template evaluate<Magnitude>().value;
+
+  if( value > bound * magnitude )
+    return 1;
+  else if( value < -bound * magnitude )
+    return -1;
+
+  return predicate.template evaluate<Expansion>().sign();
+}
+
+/**
+  Orientation of a point with respect to a hyperplane through \f$D\f$
+  points in \f$D\f$ dimensions, i.e. the sign of the determinant of the
+  differences between the points and the query point.
+*/
+
+template <std::size_t D> struct Orientation
+{
+  const std::array<const std::array<double, D>*, D>& points;
+  const std::array<double, D>& p;
+
+  template <class T> T evaluate() const
+  {
+    std::array<std::array<T, D>, D> M;
+
+    for( std::size_t i = 0; i < D; i++ )
+      for( std::size_t j = 0; j < D; j++ )
+        M[i][j] = difference<T>( ( *points[i] )[j], p[j] );
+
+    return Determinant<T, D>::calculate( M );
+  }
+};
+
+/**
+  Position of a point with respect to the sphere through \f$D+1\f$
+  points in \f$D\f$ dimensions. The sign of the lifted determinant is
+  positive if the point is inside the sphere and the points are
+  oriented positively, i.e. the sign has to be multiplied with the
+  orientation of the points.
+*/
+
+template <std::size_t D> struct InSphere
+{
+  const std::array<const std::array<double, D>*, D + 1>& points;
+  const std::array<double, D>& p;
+
+  template <class T> T evaluate() const
+  {
+    std::array<std::array<T, D + 1>, D + 1> M;
+
+    for( std::size_t i = 0; i <= D; i++ )
+    {
+      for( std::size_t j = 0; j < D; j++ )
+      {
+        M[i][j] = difference<T>( ( *points[i] )[j], p[j] );
+        M[i][D] = j == 0 ? M[i][j] * M[i][j] : M[i][D] + M[i][j] * M[i][j];
+      }
+    }
+
+    return Determinant<T, D + 1>::calculate( M );
+  }
+};
+
+/**
+  Determinant of the matrix of inner products \f$\langle a_i - p, b_j
+  - q\rangle\f$ for \f$K\f$ pairs of points. This expresses predicates
+  for points in a \f$K\f$-dimensional affine subspace of \f$D\f$
+  dimensions without calculating coordinates in the subspace:
+
+  - If \f$a_i = b_i\f$ and \f$p = q\f$, the sign indicates whether the
+    points are affinely independent.
+
+  - If \f$a_i = b_i\f$, the sign indicates whether \f$p\f$ and \f$q\f$
+    lie on the same side of the hyperplane through the points of the
+    subspace, because the determinant is the product of the two
+    orientations with respect to an arbitrary basis of the subspace.
+*/
+
+template <std::size_t D, std::size_t K> struct InnerProducts
+{
+  const std::array<const std::array<double, D>*, K>& a;
+  const std::array<const std::array<double, D>*, K>& b;
+  const std::array<double, D>& p;
+  const std::array<double, D>& q;
+
+  template <class T> T evaluate() const
+  {
+    std::array<std::array<T, K>, K> M;
+
+    for( std::size_t i = 0; i < K; i++ )
+    {
+      for( std::size_t j = 0; j < K; j++ )
+      {
+        for( std::size_t l = 0; l < D; l++ )
+        {
+          auto x = difference<T>( ( *a[i] )[l], p[l] ) * difference<T>( ( *b[j] )[l], q[l] );
+          M[i][j] = l == 0 ? x : M[i][j] + x;
+        }
+      }
+    }
+
+    return Determinant<T, K>::calculate( M );
+  }
+};
+
+/**
+  Position of a point with respect to the smallest sphere through
+  \f$K+1\f$ points of a \f$K\f$-dimensional affine subspace, provided
+  that the query point lies in the subspace as well. With \f$v_i\f$
+  denoting the difference between the \f$i\f$th point and the query
+  point, the determinant of the matrix \f$\langle v_i, v_j\rangle +
+  \|v_i\|^2\f$ is the product of the lifted determinant and of the
+  orientation of the points with respect to an arbitrary basis of the
+  subspace. Hence, it is positive if and only if the point is inside
+  the sphere, regardless of the orientation of the points.
+*/
+
+template <std::size_t D, std::size_t K> struct InSubspaceSphere
+{
+  const std::array<const std::array<double, D>*, K + 1>& points;
+  const std::array<double, D>& p;
+
+  template <class T> T evaluate() const
+  {
+    std::array<std::array<T, D>, K + 1> V;
+    std::array<std::array<T, K + 1>, K + 1> M;
+
+    for( std::size_t i = 0; i <= K; i++ )
+      for( std::size_t l = 0; l < D; l++ )
+        V[i][l] = difference<T>( ( *points[i] )[l], p[l] );
+
+    for( std::size_t i = 0; i <= K; i++ )
+    {
+      for( std::size_t j = 0; j <= K; j++ )
+      {
+        for( std::size_t l = 0; l < D; l++ )
+        {
+          auto x  = V[i][l] * V[j][l] + V[i][l] * V[i][l];
+          M[i][j] = l == 0 ? x : M[i][j] + x;
+        }
+      }
+    }
+
+    return Determinant<T, K + 1>::calculate( M );
+  }
+};
+
+} // namespace detail
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
@@ -1,7 +1,14 @@
 #ifndef ALEPH_GEOMETRY_DISTANCES_INFINITY_HH__
 #define ALEPH_GEOMETRY_DISTANCES_INFINITY_HH__
 
+#include <aleph/geometry/distances/Kernels.hh>
+
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include <cmath>
+#include <cstddef>
 
 namespace aleph
 {
@@ -15,12 +22,16 @@ namespace distances
 /**
   Basic functor for calculating the infinity distance between two
   points. The point class needs to provide coordinate access. The
-  functor is mainly used for persistence diagram distances.
+  functor is mainly used for persistence diagram distances, but it
+  also handles ranges of coordinates.
 */
 
 template <class DataType> class InfinityDistance
 {
 public:
+  using ElementType = DataType;
+  using ResultType  = DataType;
+
   template <class Point> DataType operator()( const Point& p, const Point& q ) const
   {
     // This ensures that the values stay positive, regardless of the
@@ -30,6 +41,53 @@ public:
 
     return std::max( dx, dy );
   }
+
+  /**
+    Given two ranges of values, which are assumed to represent two
+    vectors, calculates the maximum difference between them.
+
+    @param a             Iterator describing first vector
+    @param b             Iterator describing second vector
+    @param size          Size of vectors a and b
+    @param worstDistance Ignored; provided for compatibility with the
+                         other distance functors
+  */
+
+  template <typename Iterator1, typename Iterator2>
+  ResultType operator()( Iterator1 a,
+                         Iterator2 b,
+                         std::size_t size,
+                         ElementType worstDistance = -1.0 ) const
+  {
+    (void) worstDistance;
+
+    return this->evaluate( a, b, size, kernels::IsVectorizable<DataType, Iterator1, Iterator2>() );
+  }
+
+private:
+
+  template <typename Iterator1, typename Iterator2>
+  ResultType evaluate( Iterator1 a, Iterator2 b, std::size_t size, std::true_type ) const
+  {
+    if( size >= kernels::minimumSize )
+      return kernels::infinity( &*a, &*b, size );
+    else
+      return this->evaluate( a, b, size, std::false_type() );
+  }
+
+  template <typename Iterator1, typename Iterator2>
+  ResultType evaluate( Iterator1 a, Iterator2 b, std::size_t size, std::false_type ) const
+  {
+    ResultType result = ResultType();
+
+    for( std::size_t i = 0; i < size; i++, ++a, ++b )
+    {
+      auto d = *a >= *b ? *a - *b : *b - *a;
+      result = std::max( result, ResultType( d ) );
+    }
+
+    return result;
+  }
 };
 
 } // namespace distances
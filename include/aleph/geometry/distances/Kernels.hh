@@ -0,0 +1,549 @@
+#ifndef ALEPH_GEOMETRY_DISTANCES_KERNELS_HH__
+#define ALEPH_GEOMETRY_DISTANCES_KERNELS_HH__
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+// Vectorized kernels are only provided for x86 processors. They are
+// compiled with function-specific target attributes, so no additional
+// compiler flags are required; the instruction set is selected at run
+// time.
+#if ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__)
+  #define ALEPH_DISTANCE_KERNELS_X86
+  #include <immintrin.h>
+#endif
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace distances
+{
+
+namespace kernels
+{
+
+/** Instruction sets for which distance kernels are available */
+enum class InstructionSet
+{
+  Scalar,
+  SSE2,
+  AVX2,
+  AVX512
+};
+
+namespace detail
+{
+
+inline InstructionSet detectInstructionSet()
+{
+#ifdef ALEPH_DISTANCE_KERNELS_X86
+  __builtin_cpu_init();
+
+  if( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "popcnt" ) )
+    return InstructionSet::AVX512;
+  else if( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "popcnt" ) )
+    return InstructionSet::AVX2;
+  else if( __builtin_cpu_supports( "sse2" ) )
+    return InstructionSet::SSE2;
+#endif
+
+  return InstructionSet::Scalar;
+}
+
+inline InstructionSet& currentInstructionSet()
+{
+  static InstructionSet instructionSet = detectInstructionSet();
+  return instructionSet;
+}
+
+} // namespace detail
+
+/** @returns Instruction set that is used by the kernels */
+inline InstructionSet instructionSet()
+{
+  return detail::currentInstructionSet();
+}
+
+/** @returns Best instruction set that is supported by the processor */
+inline InstructionSet supportedInstructionSet()
+{
+  static InstructionSet instructionSet = detail::detectInstructionSet();
+  return instructionSet;
+}
+
+/**
+  Changes the instruction set that is used by the kernels. This is
+  meant for testing and benchmarking. Instruction sets that are not
+  supported by the processor are replaced by the best supported one.
+  The function must not be called while kernels are being evaluated.
+*/
+
+inline void setInstructionSet( InstructionSet instructionSet )
+{
+  detail::currentInstructionSet() = std::min( instructionSet, supportedInstructionSet() );
+}
+
+/**
+  Minimum number of elements for which the vectorized kernels are used
+  by the distance functors. Shorter vectors are handled by the generic
+  implementation of every functor, which is just as fast for them.
+*/
+
+constexpr std::size_t minimumSize = 8;
+
+/**
+  Checks whether iterators of a distance functor refer to contiguous
+  storage of a floating-point type for which kernels are available.
+*/
+
+template <class T, class Iterator1, class Iterator2> struct IsVectorizable
+  : std::integral_constant<bool,
+         ( std::is_same<T, float>::value || std::is_same<T, double>::value )
+      && ( std::is_same<Iterator1, T*>::value
+        || std::is_same<Iterator1, const T*>::value
+        || std::is_same<Iterator1, typename std::vector<T>::iterator>::value
+        || std::is_same<Iterator1, typename std::vector<T>::const_iterator>::value )
+      && ( std::is_same<Iterator2, T*>::value
+        || std::is_same<Iterator2, const T*>::value
+        || std::is_same<Iterator2, typename std::vector<T>::iterator>::value
+        || std::is_same<Iterator2, typename std::vector<T>::const_iterator>::value )
+    >
+{
+};
+
+// Scalar kernels ------------------------------------------------------
+
+namespace scalar
+{
+
+template <class T> T squaredEuclidean( const T* a, const T* b, std::size_t n )
+{
+  T result = T();
+
+  for( std::size_t i = 0; i < n; i++ )
+    result += ( a[i] - b[i] ) * ( a[i] - b[i] );
+
+  return result;
+}
+
+template <class T> T manhattan( const T* a, const T* b, std::size_t n )
+{
+  T result = T();
+
+  for( std::size_t i = 0; i < n; i++ )
+    result += std::abs( a[i] - b[i] );
+
+  return result;
+}
+
+template <class T> T infinity( const T* a, const T* b, std::size_t n )
+{
+  T result = T();
+
+  for( std::size_t i = 0; i < n; i++ )
+    result = std::max( result, std::abs( a[i] - b[i] ) );
+
+  return result;
+}
+
+template <class T> T hamming( const T* a, const T* b, std::size_t n )
+{
+  std::size_t result = 0;
+
+  for( std::size_t i = 0; i < n; i++ )
+    result += a[i] != b[i];
+
+  return static_cast<T>( result );
+}
+
+} // namespace scalar
+
+#ifdef ALEPH_DISTANCE_KERNELS_X86
+
+// Every instruction set provides the same set of primitive operations
+// for float and double vectors. The kernels are formulated in terms of
+// these operations, so they only differ in their target attribute.
+
+#define ALEPH_DISTANCE_KERNELS_DEFINE( TARGET )                                               \
+                                                                                              \
+template <class T> TARGET T squaredEuclidean( const T* a, const T* b, std::size_t n )         \
+{                                                                                             \
+  constexpr std::size_t width = sizeof( Vector<T> ) / sizeof( T );                            \
+                                                                                              \
+  auto sum      = zero( T() );                                                                \
+  std::size_t i = 0;                                                                          \
+                                                                                              \
+  for( ; i + width <= n; i += width )                                                         \
+  {                                                                                           \
+    auto d = sub( load( a + i ), load( b + i ) );                                             \
+    sum    = add( sum, mul( d, d ) );                                                         \
+  }                                                                                           \
+                                                                                              \
+  return sumLanes( sum ) + scalar::squaredEuclidean( a + i, b + i, n - i );                   \
+}                                                                                             \
+                                                                                              \
+template <class T> TARGET T manhattan( const T* a, const T* b, std::size_t n )                \
+{                                                                                             \
+  constexpr std::size_t width = sizeof( Vector<T> ) / sizeof( T );                            \
+                                                                                              \
+  auto sum      = zero( T() );                                                                \
+  std::size_t i = 0;                                                                          \
+                                                                                              \
+  for( ; i + width <= n; i += width )                                                         \
+    sum = add( sum, abs( sub( load( a + i ), load( b + i ) ) ) );                             \
+                                                                                              \
+  return sumLanes( sum ) + scalar::manhattan( a + i, b + i, n - i );                          \
+}                                                                                             \
+                                                                                              \
+template <class T> TARGET T infinity( const T* a, const T* b, std::size_t n )                 \
+{                                                                                             \
+  constexpr std::size_t width = sizeof( Vector<T> ) / sizeof( T );                            \
+                                                                                              \
+  auto result   = zero( T() );                                                                \
+  std::size_t i = 0;                                                                          \
+                                                                                              \
+  for( ; i + width <= n; i += width )                                                         \
+    result = max( result, abs( sub( load( a + i ), load( b + i ) ) ) );                       \
+                                                                                              \
+  return std::max( maxLanes( result ), scalar::infinity( a + i, b + i, n - i ) );             \
+}                                                                                             \
+                                                                                              \
+template <class T> TARGET T hamming( const T* a, const T* b, std::size_t n )                  \
+{                                                                                             \
+  constexpr std::size_t width = sizeof( Vector<T> ) / sizeof( T );                            \
+                                                                                              \
+  std::size_t result = 0;                                                                     \
+  std::size_t i      = 0;                                                                     \
+                                                                                              \
+  for( ; i + width <= n; i += width )                                                         \
+    result += countBits( notEqual( load( a + i ), load( b + i ) ) );                         \
+                                                                                              \
+  return static_cast<T>( result ) + scalar::hamming( a + i, b + i, n - i );                   \
+}
+
+namespace sse2
+{
+
+#define ALEPH_TARGET __attribute__(( target( "sse2" ) ))
+
+template <class T> struct VectorType;
+template <> struct VectorType<float>  { using Type = __m128;  };
+template <> struct VectorType<double> { using Type = __m128d; };
+
+template <class T> using Vector = typename VectorType<T>::Type;
+
+ALEPH_TARGET inline __m128  zero( float  )                  { return _mm_setzero_ps(); }
+ALEPH_TARGET inline __m128d zero( double )                  { return _mm_setzero_pd(); }
+ALEPH_TARGET inline __m128  load( const float*  p )         { return _mm_loadu_ps( p ); }
+ALEPH_TARGET inline __m128d load( const double* p )         { return _mm_loadu_pd( p ); }
+ALEPH_TARGET inline __m128  add( __m128  a, __m128  b )     { return _mm_add_ps( a, b ); }
+ALEPH_TARGET inline __m128d add( __m128d a, __m128d b )     { return _mm_add_pd( a, b ); }
+ALEPH_TARGET inline __m128  sub( __m128  a, __m128  b )     { return _mm_sub_ps( a, b ); }
+ALEPH_TARGET inline __m128d sub( __m128d a, __m128d b )     { return _mm_sub_pd( a, b ); }
+ALEPH_TARGET inline __m128  mul( __m128  a, __m128  b )     { return _mm_mul_ps( a, b ); }
+ALEPH_TARGET inline __m128d mul( __m128d a, __m128d b )     { return _mm_mul_pd( a, b ); }
+ALEPH_TARGET inline __m128  max( __m128  a, __m128  b )     { return _mm_max_ps( a, b ); }
+ALEPH_TARGET inline __m128d max( __m128d a, __m128d b )     { return _mm_max_pd( a, b ); }
+ALEPH_TARGET inline __m128  abs( __m128  a )                { return _mm_andnot_ps( _mm_set1_ps( -0.0f ), a ); }
+ALEPH_TARGET inline __m128d abs( __m128d a )                { return _mm_andnot_pd( _mm_set1_pd( -0.0 ), a ); }
+ALEPH_TARGET inline int     notEqual( __m128  a, __m128  b ) { return _mm_movemask_ps( _mm_cmpneq_ps( a, b ) ); }
+ALEPH_TARGET inline int     notEqual( __m128d a, __m128d b ) { return _mm_movemask_pd( _mm_cmpneq_pd( a, b ) ); }
+
+// The population count instruction is not part of SSE2, but masks are
+// sufficiently short for a lookup table.
+ALEPH_TARGET inline std::size_t countBits( int mask )
+{
+  static const std::size_t bits[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+  return bits[mask & 15];
+}
+
+ALEPH_TARGET inline float sumLanes( __m128 a )
+{
+  float lanes[4];
+  _mm_storeu_ps( lanes, a );
+
+  return ( lanes[0] + lanes[1] ) + ( lanes[2] + lanes[3] );
+}
+
+ALEPH_TARGET inline double sumLanes( __m128d a )
+{
+  double lanes[2];
+  _mm_storeu_pd( lanes, a );
+
+  return lanes[0] + lanes[1];
+}
+
+ALEPH_TARGET inline float maxLanes( __m128 a )
+{
+  float lanes[4];
+  _mm_storeu_ps( lanes, a );
+
+  return std::max( std::max( lanes[0], lanes[1] ), std::max( lanes[2], lanes[3] ) );
+}
+
+ALEPH_TARGET inline double maxLanes( __m128d a )
+{
+  double lanes[2];
+  _mm_storeu_pd( lanes, a );
+
+  return std::max( lanes[0], lanes[1] );
+}
+
+ALEPH_DISTANCE_KERNELS_DEFINE( ALEPH_TARGET )
+
+#undef ALEPH_TARGET
+
+} // namespace sse2
+
+namespace avx2
+{
+
+#define ALEPH_TARGET __attribute__(( target( "avx2,popcnt" ) ))
+
+template <class T> struct VectorType;
+template <> struct VectorType<float>  { using Type = __m256;  };
+template <> struct VectorType<double> { using Type = __m256d; };
+
+template <class T> using Vector = typename VectorType<T>::Type;
+
+ALEPH_TARGET inline __m256  zero( float  )                  { return _mm256_setzero_ps(); }
+ALEPH_TARGET inline __m256d zero( double )                  { return _mm256_setzero_pd(); }
+ALEPH_TARGET inline __m256  load( const float*  p )         { return _mm256_loadu_ps( p ); }
+ALEPH_TARGET inline __m256d load( const double* p )         { return _mm256_loadu_pd( p ); }
+ALEPH_TARGET inline __m256  add( __m256  a, __m256  b )     { return _mm256_add_ps( a, b ); }
+ALEPH_TARGET inline __m256d add( __m256d a, __m256d b )     { return _mm256_add_pd( a, b ); }
+ALEPH_TARGET inline __m256  sub( __m256  a, __m256  b )     { return _mm256_sub_ps( a, b ); }
+ALEPH_TARGET inline __m256d sub( __m256d a, __m256d b )     { return _mm256_sub_pd( a, b ); }
+ALEPH_TARGET inline __m256  mul( __m256  a, __m256  b )     { return _mm256_mul_ps( a, b ); }
+ALEPH_TARGET inline __m256d mul( __m256d a, __m256d b )     { return _mm256_mul_pd( a, b ); }
+ALEPH_TARGET inline __m256  max( __m256  a, __m256  b )     { return _mm256_max_ps( a, b ); }
+ALEPH_TARGET inline __m256d max( __m256d a, __m256d b )     { return _mm256_max_pd( a, b ); }
+ALEPH_TARGET inline __m256  abs( __m256  a )                { return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a ); }
+ALEPH_TARGET inline __m256d abs( __m256d a )                { return _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), a ); }
+ALEPH_TARGET inline int     notEqual( __m256  a, __m256  b ) { return _mm256_movemask_ps( _mm256_cmp_ps( a, b, _CMP_NEQ_UQ ) ); }
+ALEPH_TARGET inline int     notEqual( __m256d a, __m256d b ) { return _mm256_movemask_pd( _mm256_cmp_pd( a, b, _CMP_NEQ_UQ ) ); }
+
+ALEPH_TARGET inline std::size_t countBits( int mask )
+{
+  return static_cast<std::size_t>( __builtin_popcount( static_cast<unsigned>( mask ) ) );
+}
+
+ALEPH_TARGET inline float sumLanes( __m256 a )
+{
+  float lanes[8];
+  _mm256_storeu_ps( lanes, a );
+
+  float result = 0.0f;
+  for( auto lane : lanes )
+    result += lane;
+
+  return result;
+}
+
+ALEPH_TARGET inline double sumLanes( __m256d a )
+{
+  double lanes[4];
+  _mm256_storeu_pd( lanes, a );
+
+  return ( lanes[0] + lanes[1] ) + ( lanes[2] + lanes[3] );
+}
+
+ALEPH_TARGET inline float maxLanes( __m256 a )
+{
+  float lanes[8];
+  _mm256_storeu_ps( lanes, a );
+
+  return *std::max_element( lanes, lanes + 8 );
+}
+
+ALEPH_TARGET inline double maxLanes( __m256d a )
+{
+  double lanes[4];
+  _mm256_storeu_pd( lanes, a );
+
+  return *std::max_element( lanes, lanes + 4 );
+}
+
+ALEPH_DISTANCE_KERNELS_DEFINE( ALEPH_TARGET )
+
+#undef ALEPH_TARGET
+
+} // namespace avx2
+
+namespace avx512
+{
+
+#define ALEPH_TARGET __attribute__(( target( "avx512f,popcnt" ) ))
+
+template <class T> struct VectorType;
+template <> struct VectorType<float>  { using Type = __m512;  };
+template <> struct VectorType<double> { using Type = __m512d; };
+
+template <class T> using Vector = typename VectorType<T>::Type;
+
+ALEPH_TARGET inline __m512  zero( float  )                  { return _mm512_setzero_ps(); }
+ALEPH_TARGET inline __m512d zero( double )                  { return _mm512_setzero_pd(); }
+ALEPH_TARGET inline __m512  load( const float*  p )         { return _mm512_loadu_ps( p ); }
+ALEPH_TARGET inline __m512d load( const double* p )         { return _mm512_loadu_pd( p ); }
+ALEPH_TARGET inline __m512  add( __m512  a, __m512  b )     { return _mm512_add_ps( a, b ); }
+ALEPH_TARGET inline __m512d add( __m512d a, __m512d b )     { return _mm512_add_pd( a, b ); }
+ALEPH_TARGET inline __m512  sub( __m512  a, __m512  b )     { return _mm512_sub_ps( a, b ); }
+ALEPH_TARGET inline __m512d sub( __m512d a, __m512d b )     { return _mm512_sub_pd( a, b ); }
+ALEPH_TARGET inline __m512  mul( __m512  a, __m512  b )     { return _mm512_mul_ps( a, b ); }
+ALEPH_TARGET inline __m512d mul( __m512d a, __m512d b )     { return _mm512_mul_pd( a, b ); }
+// The maximum is calculated by blending because the intrinsic triggers
+// spurious warnings about uninitialized values.
+ALEPH_TARGET inline __m512  max( __m512  a, __m512  b )     { return _mm512_mask_blend_ps( _mm512_cmp_ps_mask( a, b, _CMP_LT_OQ ), a, b ); }
+ALEPH_TARGET inline __m512d max( __m512d a, __m512d b )     { return _mm512_mask_blend_pd( _mm512_cmp_pd_mask( a, b, _CMP_LT_OQ ), a, b ); }
+ALEPH_TARGET inline __m512  abs( __m512  a )                { return _mm512_abs_ps( a ); }
+ALEPH_TARGET inline __m512d abs( __m512d a )                { return _mm512_abs_pd( a ); }
+ALEPH_TARGET inline int     notEqual( __m512  a, __m512  b ) { return static_cast<int>( _mm512_cmp_ps_mask( a, b, _CMP_NEQ_UQ ) ); }
+ALEPH_TARGET inline int     notEqual( __m512d a, __m512d b ) { return static_cast<int>( _mm512_cmp_pd_mask( a, b, _CMP_NEQ_UQ ) ); }
+
+ALEPH_TARGET inline std::size_t countBits( int mask )
+{
+  return static_cast<std::size_t>( __builtin_popcount( static_cast<unsigned>( mask ) ) );
+}
+
+ALEPH_TARGET inline float sumLanes( __m512 a )
+{
+  float lanes[16];
+  _mm512_storeu_ps( lanes, a );
+
+  float result = 0.0f;
+  for( auto lane : lanes )
+    result += lane;
+
+  return result;
+}
+
+ALEPH_TARGET inline double sumLanes( __m512d a )
+{
+  double lanes[8];
+  _mm512_storeu_pd( lanes, a );
+
+  double result = 0.0;
+  for( auto lane : lanes )
+    result += lane;
+
+  return result;
+}
+
+ALEPH_TARGET inline float maxLanes( __m512 a )
+{
+  float lanes[16];
+  _mm512_storeu_ps( lanes, a );
+
+  return *std::max_element( lanes, lanes + 16 );
+}
+
+ALEPH_TARGET inline double maxLanes( __m512d a )
+{
+  double lanes[8];
+  _mm512_storeu_pd( lanes, a );
+
+  return *std::max_element( lanes, lanes + 8 );
+}
+
+ALEPH_DISTANCE_KERNELS_DEFINE( ALEPH_TARGET )
+
+#undef ALEPH_TARGET
+
+} // namespace avx512
+
+#undef ALEPH_DISTANCE_KERNELS_DEFINE
+
+#endif
+
+// Dispatch ------------------------------------------------------------
+
+#ifdef ALEPH_DISTANCE_KERNELS_X86
+  #define ALEPH_DISTANCE_KERNELS_DISPATCH( KERNEL, T )                 \
+  switch( instructionSet() )                                           \
+  {                                                                    \
+  case InstructionSet::AVX512:                                         \
+    return avx512::KERNEL<T>( a, b, n );                               \
+  case InstructionSet::AVX2:                                           \
+    return avx2::KERNEL<T>( a, b, n );                                 \
+  case InstructionSet::SSE2:                                           \
+    return sse2::KERNEL<T>( a, b, n );                                 \
+  case InstructionSet::Scalar:                                         \
+    break;                                                             \
+  }                                                                    \
+                                                                       \
+  return scalar::KERNEL<T>( a, b, n );
+#else
+  #define ALEPH_DISTANCE_KERNELS_DISPATCH( KERNEL, T )                 \
+  return scalar::KERNEL<T>( a, b, n );
+#endif
+
+/** @returns Squared Euclidean distance between two vectors */
+inline float  squaredEuclidean( const float*  a, const float*  b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( squaredEuclidean, float  ) }
+inline double squaredEuclidean( const double* a, const double* b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( squaredEuclidean, double ) }
+
+/** @returns Manhattan distance between two vectors */
+inline float  manhattan( const float*  a, const float*  b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( manhattan, float  ) }
+inline double manhattan( const double* a, const double* b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( manhattan, double ) }
+
+/** @returns Infinity distance, i.e. the maximum coordinate difference, between two vectors */
+inline float  infinity( const float*  a, const float*  b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( infinity, float  ) }
+inline double infinity( const double* a, const double* b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( infinity, double ) }
+
+/** @returns Hamming distance, i.e. the number of differing coordinates, between two vectors */
+inline float  hamming( const float*  a, const float*  b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( hamming, float  ) }
+inline double hamming( const double* a, const double* b, std::size_t n ) { ALEPH_DISTANCE_KERNELS_DISPATCH( hamming, double ) }
+
+#undef ALEPH_DISTANCE_KERNELS_DISPATCH
+
+} // namespace kernels
+
+/**
+  Calculates the distances between a query point and a set of points
+  in row-major order, i.e. the coordinates of every point are stored
+  contiguously. The distances are stored in the raw form of the functor,
+  so the traits of the functor may be used to convert them.
+
+  @param distance  Distance functor
+  @param query     Coordinates of the query point
+  @param points    Coordinates of all points
+  @param n         Number of points
+  @param dimension Dimension of the query point and of all points
+  @param result    Output array that is able to hold n distances
+*/
+
+template <class Distance, class T> void oneToMany( const Distance& distance,
+                                                   const T* query,
+                                                   const T* points,
+                                                   std::size_t n,
+                                                   std::size_t dimension,
+                                                   typename Distance::ResultType* result )
+{
+  #pragma omp parallel for schedule(static) if( n * dimension >= 65536 )
+  for( long i = 0; i < static_cast<long>( n ); i++ )
+  {
+    auto index    = static_cast<std::size_t>( i );
+    result[index] = distance( query, points + index * dimension, dimension );
+  }
+}
+
+} // namespace distances
+
+} // namespace geometry
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -1,11 +1,14 @@
 #ifndef ALEPH_GEOMETRY_DISTANCES_MANHATTAN_HH__
 #define ALEPH_GEOMETRY_DISTANCES_MANHATTAN_HH__
 
+#include <aleph/geometry/distances/Kernels.hh>
+
 #include <cstddef>
 #include <cmath>
 
 #include <iterator>
 #include <string>
+#include <type_traits>
 
 namespace aleph
 {
@@ -58,6 +61,62 @@ public:
                          Iterator2 b,
                          std::size_t size,
                          ElementType worstDistance = -1.0 ) const
+  {
+    return this->evaluate( a, b, size, worstDistance, kernels::IsVectorizable<T, Iterator1, Iterator2>() );
+  }
+
+  /**
+    Partial distance calculation, used by FLANN for fast kd-tree calculations.
+    This function exploits that the Manhattan distance can be evaluated
+    component-wise.
+
+    @param a First component
+    @param b Second component
+
+    @returns Partial distance between those two components
+  */
+
+  template <typename U, typename V>
+  ResultType accum_dist( const U& a,
+                         const V& b,
+                         int __attribute__((unused)) ) const
+  {
+    return std::abs( a - b );
+  }
+
+  /** @returns Name of functor */
+  static std::string name()
+  {
+    return "Manhattan distance";
+  }
+
+private:
+
+  /**
+    Evaluates the distance with a vectorized kernel if the vectors are
+    sufficiently long. The kernel always calculates the full distance.
+  */
+
+  template <typename Iterator1, typename Iterator2>
+  ResultType evaluate( Iterator1 a,
+                       Iterator2 b,
+                       std::size_t size,
+                       ElementType worstDistance,
+                       std::true_type ) const
+  {
+    if( size >= kernels::minimumSize )
+      return kernels::manhattan( &*a, &*b, size );
+    else
+      return this->evaluate( a, b, size, worstDistance, std::false_type() );
+  }
+
+  /** Generic implementation for arbitrary iterators */
+  template <typename Iterator1, typename Iterator2>
+  ResultType evaluate( Iterator1 a,
+                       Iterator2 b,
+                       std::size_t size,
+                       ElementType worstDistance,
+                       std::false_type ) const
   {
     // Fixes warnings about unused parameters. This parameter is
     // provided for compatibility reasons with FLANN only.
@@ -103,31 +162,6 @@ public:
 
     return result;
   }
-
-  /**
-    Partial distance calculation, used by FLANN for fast kd-tree calculations.
-    This function exploits that the Manhattan distance can be evaluated
-    component-wise.
-
-    @param a First component
-    @param b Second component
-
-    @returns Partial distance between those two components
-  */
-
-  template <typename U, typename V>
-  ResultType accum_dist( const U& a,
-                         const V& b,
-                         int __attribute__((unused)) ) const
-  {
-    return std::abs( a - b );
-  }
-
-  /** @returns Name of functor */
-  static std::string name()
-  {
-    return "Manhattan distance";
-  }
 };
 
 } // namespace distances
@@ -3,7 +3,7 @@
 
 #include <aleph/containers/PointCloud.hh>
 
-#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/FLANN.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
@@ -204,7 +204,7 @@ template <class T> T nearestNeighbourAreaEntropy( const aleph::PersistenceDiagra
 #ifdef ALEPH_WITH_FLANN
   using NearestNeighbours = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+  using NearestNeighbours = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
   auto pc = detail::makePointCloud( diagram );
@@ -7,7 +7,7 @@
 
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 
-#include <aleph/persistenceDiagrams/distances/detail/Munkres.hh>
+#include <aleph/persistenceDiagrams/distances/detail/JonkerVolgenant.hh>
 #include <aleph/persistenceDiagrams/distances/detail/Orthogonal.hh>
 
 #include <algorithm>
@@ -145,25 +145,19 @@ template <
 
   // Assignment problem solving ----------------------------------------
 
-  distances::detail::Munkres<DataType> solver( costs );
+  distances::detail::JonkerVolgenant<DataType> solver( costs );
 
-  auto M                                           = solver();
+  auto&& assignment                                = solver.assignment();
   aleph::math::KahanSummation<DataType> totalCosts = DataType();
 
   Pairing pairing;
 
-  for( row = IndexType(); row < M.n(); row++ )
+  // This ensures that pairs are returned in the order dictated by the
+  // first persistence diagram.
+  for( row = IndexType(); row < assignment.size(); row++ )
   {
-    for( col = IndexType(); col < M.n(); col++ )
-    {
-      if( M( row, col ) == IndexType() )
-      {
-        // This ensures that pairs are returned in the order dictated by
-        // the first persistence diagram.
-        pairing.pairs.push_back( std::make_pair( row, col ) );
-        totalCosts += costs( row, col );
-      }
-    }
+    pairing.pairs.push_back( std::make_pair( row, assignment[row] ) );
+    totalCosts += costs( row, assignment[row] );
   }
 
   pairing.cost = totalCosts;
@@ -0,0 +1,392 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_PAIRWISE_MATRIX_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_PAIRWISE_MATRIX_HH__
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace detail
+{
+
+/** Uses the preprocessing function of a functor, if it has one */
+template <class Functor, class T> auto prepareItem( const Functor& f, const T& x, int ) -> decltype( f.prepare( x ) )
+{
+  return f.prepare( x );
+}
+
+/** Fallback for functors without preprocessing, which use the item itself */
+template <class Functor, class T> const T& prepareItem( const Functor&, const T& x, long )
+{
+  return x;
+}
+
+/**
+  Describes the types involved in calculating a pairwise matrix, i.e.
+  the type of the preprocessed items and the type of the values.
+*/
+
+template <class T, class Functor> struct PairwiseMatrixTraits
+{
+  using PrepareResult = decltype( prepareItem( std::declval<const Functor&>(), std::declval<const T&>(), 0 ) );
+  using Prepared      = typename std::decay<PrepareResult>::type;
+  using Value         = typename std::decay< decltype( std::declval<const Functor&>()( std::declval<const Prepared&>(), std::declval<const Prepared&>() ) ) >::type;
+
+  /** Checks whether the functor preprocesses items, as opposed to using them directly */
+  static constexpr bool hasPreparation = !std::is_same<PrepareResult, const T&>::value;
+};
+
+/**
+  Stores the preprocessed items for calculating a pairwise matrix. Every
+  item is preprocessed exactly once, in parallel. If the functor does not
+  support any preprocessing, the items are referenced directly.
+*/
+
+template <class T, class Functor, bool = PairwiseMatrixTraits<T, Functor>::hasPreparation> class PreparedItems
+{
+public:
+  using Prepared = typename PairwiseMatrixTraits<T, Functor>::Prepared;
+
+  PreparedItems( const std::vector<T>& items, const Functor& f )
+    : _items( items.size() )
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for( long i = 0; i < static_cast<long>( items.size() ); i++ )
+      _items[ static_cast<std::size_t>( i ) ] = prepareItem( f, items[ static_cast<std::size_t>( i ) ], 0 );
+  }
+
+  const Prepared& operator[]( std::size_t i ) const
+  {
+    return _items[i];
+  }
+
+private:
+  std::vector<Prepared> _items;
+};
+
+template <class T, class Functor> class PreparedItems<T, Functor, false>
+{
+public:
+  PreparedItems( const std::vector<T>& items, const Functor& )
+    : _items( items )
+  {
+  }
+
+  const T& operator[]( std::size_t i ) const
+  {
+    return _items[i];
+  }
+
+private:
+  const std::vector<T>& _items;
+};
+
+/**
+  @class PairwiseMatrixCheckpoint
+  @brief Binary checkpoint of a partially-calculated pairwise matrix
+
+  The file stores a header with the number of items and the tile size,
+  followed by one record per tile of the upper triangle. Every record
+  consists of a flag that indicates whether the tile is complete and,
+  if so, the values of the tile in row-major order. Files are written
+  to a temporary file first and renamed afterwards, so an interrupted
+  write never destroys the previous checkpoint.
+*/
+
+template <class Value> class PairwiseMatrixCheckpoint
+{
+public:
+  using Tile = std::pair<std::size_t, std::size_t>;
+
+  static_assert( std::is_arithmetic<Value>::value, "Checkpoints require an arithmetic value type" );
+
+  PairwiseMatrixCheckpoint( const std::string& filename, std::size_t n, std::size_t tileSize )
+    : _filename( filename )
+    , _n( n )
+    , _tileSize( tileSize )
+  {
+  }
+
+  /**
+    Loads a checkpoint (if the file exists) and stores the values of all
+    complete tiles in the matrix.
+
+    @returns Flags of complete tiles; all flags are false if there is no
+    checkpoint file
+
+    @throws std::runtime_error if the file does not belong to a matrix of
+    the same size and tile size
+  */
+
+  std::vector<bool> load( const std::vector<Tile>& tiles, math::SymmetricMatrix<Value>& M ) const
+  {
+    std::vector<bool> complete( tiles.size(), false );
+    std::ifstream in( _filename, std::ios::binary );
+
+    if( !in )
+      return complete;
+
+    char magic[sizeof(Magic)] = {};
+    std::uint64_t n           = 0;
+    std::uint64_t tileSize    = 0;
+    std::uint64_t numTiles    = 0;
+
+    in.read( magic, sizeof(magic) );
+    read( in, n );
+    read( in, tileSize );
+    read( in, numTiles );
+
+    if( !in || !std::equal( magic, magic + sizeof(magic), Magic ) )
+      throw std::runtime_error( "Invalid checkpoint file" );
+
+    if( n != _n || tileSize != _tileSize || numTiles != tiles.size() )
+      throw std::runtime_error( "Checkpoint file belongs to a different matrix" );
+
+    for( std::size_t t = 0; t < tiles.size(); t++ )
+    {
+      std::uint8_t flag = 0;
+      read( in, flag );
+
+      if( flag )
+      {
+        this->traverse( tiles[t], [&in, &M] ( std::size_t i, std::size_t j )
+                                  {
+                                    read( in, M( i, j ) );
+                                  } );
+
+        complete[t] = true;
+      }
+
+      if( !in )
+        throw std::runtime_error( "Truncated checkpoint file" );
+    }
+
+    return complete;
+  }
+
+  /**
+    Saves a checkpoint. Only the values of complete tiles are accessed,
+    so other tiles may be calculated concurrently.
+
+    @returns true if the checkpoint could be written
+  */
+
+  bool save( const std::vector<Tile>& tiles, const std::vector<bool>& complete, const math::SymmetricMatrix<Value>& M ) const
+  {
+    auto temporary = _filename + ".tmp";
+
+    {
+      std::ofstream out( temporary, std::ios::binary | std::ios::trunc );
+
+      if( !out )
+        return false;
+
+      out.write( Magic, sizeof(Magic) );
+      write( out, static_cast<std::uint64_t>( _n ) );
+      write( out, static_cast<std::uint64_t>( _tileSize ) );
+      write( out, static_cast<std::uint64_t>( tiles.size() ) );
+
+      for( std::size_t t = 0; t < tiles.size(); t++ )
+      {
+        write( out, static_cast<std::uint8_t>( complete[t] ) );
+
+        if( complete[t] )
+        {
+          this->traverse( tiles[t], [&out, &M] ( std::size_t i, std::size_t j )
+                                    {
+                                      write( out, M( i, j ) );
+                                    } );
+        }
+      }
+
+      if( !out )
+        return false;
+    }
+
+    return std::rename( temporary.c_str(), _filename.c_str() ) == 0;
+  }
+
+  /** Calls a functor for every entry of a tile, using row-major order */
+  template <class Functor> void traverse( const Tile& tile, Functor f ) const
+  {
+    auto rowBegin = tile.first  * _tileSize;
+    auto colBegin = tile.second * _tileSize;
+    auto rowEnd   = std::min( rowBegin + _tileSize, _n );
+    auto colEnd   = std::min( colBegin + _tileSize, _n );
+
+    for( auto i = rowBegin; i < rowEnd; i++ )
+    {
+      // Tiles on the diagonal only contribute their upper triangle
+      for( auto j = std::max( colBegin, i ); j < colEnd; j++ )
+        f( i, j );
+    }
+  }
+
+private:
+  template <class U> static void read( std::istream& in, U& value )
+  {
+    in.read( reinterpret_cast<char*>( &value ), sizeof(U) );
+  }
+
+  template <class U> static void write( std::ostream& out, const U& value )
+  {
+    out.write( reinterpret_cast<const char*>( &value ), sizeof(U) );
+  }
+
+  static constexpr char Magic[8] = { 'A', 'L', 'E', 'P', 'H', 'P', 'W', 'M' };
+
+  std::string _filename;
+  std::size_t _n;
+  std::size_t _tileSize;
+};
+
+template <class Value> constexpr char PairwiseMatrixCheckpoint<Value>::Magic[8];
+
+} // namespace detail
+
+/**
+  Calculates a symmetric matrix of pairwise values, such as distances or
+  kernel values, for a collection of items, which are usually persistence
+  diagrams. The functor is evaluated exactly once for every pair, i.e. for
+  every entry of the upper triangle (including the diagonal). It must be
+  symmetric and safe to call concurrently.
+
+  The upper triangle is partitioned into tiles of consecutive rows and
+  columns. Tiles are distributed dynamically among all threads, so that
+  idle threads pick up the remaining tiles irrespective of how expensive
+  individual tiles turn out to be.
+
+  If the functor has a member function `prepare()`, it is called once per
+  item, and the functor is subsequently called with the preprocessed items
+  instead of the original ones. This permits caching data that does not
+  depend on the other item of a pair, e.g. sorted coordinates or spatial
+  indices. The functors `distances::BottleneckDistance`,
+  `distances::WassersteinDistance`, and `SlicedWasserstein` make use of
+  this.
+
+  @param items      Items for which to calculate pairwise values
+  @param f          Symmetric functor that calculates the value of a pair
+  @param checkpoint Optional filename of a checkpoint. If the file exists,
+                    complete tiles are loaded from it instead of being
+                    calculated again. During the calculation, the file is
+                    updated regularly with all complete tiles. The file
+                    is written once before any value is calculated, so
+                    an unusable checkpoint is detected immediately. If
+                    a later update fails, e.g. because the disk is full,
+                    no further updates are attempted, but the matrix is
+                    calculated and returned nonetheless.
+  @param tileSize   Number of rows and columns of every tile
+
+  @returns Symmetric matrix of pairwise values
+
+  @throws std::runtime_error if the checkpoint file cannot be read or
+  written, or if the tile size is zero
+*/
+
+template <class T, class Functor> math::SymmetricMatrix<typename detail::PairwiseMatrixTraits<T, Functor>::Value>
+  pairwiseMatrix( const std::vector<T>& items,
+                  Functor f,
+                  const std::string& checkpoint = std::string(),
+                  std::size_t tileSize = 16 )
+{
+  using Value      = typename detail::PairwiseMatrixTraits<T, Functor>::Value;
+  using Checkpoint = detail::PairwiseMatrixCheckpoint<Value>;
+  using Tile       = typename Checkpoint::Tile;
+
+  if( tileSize == 0 )
+    throw std::runtime_error( "Tile size must be positive" );
+
+  auto n        = items.size();
+  auto numTiles = ( n + tileSize - 1 ) / tileSize;
+
+  math::SymmetricMatrix<Value> M( n );
+
+  std::vector<Tile> tiles;
+  tiles.reserve( numTiles * ( numTiles + 1 ) / 2 );
+
+  for( std::size_t I = 0; I < numTiles; I++ )
+    for( std::size_t J = I; J < numTiles; J++ )
+      tiles.push_back( std::make_pair( I, J ) );
+
+  Checkpoint storage( checkpoint, n, tileSize );
+
+  std::vector<bool> complete( tiles.size(), false );
+
+  if( !checkpoint.empty() )
+    complete = storage.load( tiles, M );
+
+  std::vector<Tile> remaining;
+
+  for( std::size_t t = 0; t < tiles.size(); t++ )
+    if( !complete[t] )
+      remaining.push_back( tiles[t] );
+
+  if( remaining.empty() )
+    return M;
+
+  if( !checkpoint.empty() && !storage.save( tiles, complete, M ) )
+    throw std::runtime_error( "Unable to write checkpoint file" );
+
+  // Only preprocess items if there is something left to calculate
+  detail::PreparedItems<T, Functor> prepared( items, f );
+
+  // Save about one hundred checkpoints in total, which keeps the costs
+  // of writing the file small in comparison to the calculation.
+  auto interval       = std::max( std::size_t( 1 ), remaining.size() / 100 );
+  std::size_t unsaved = 0;
+  bool saved          = true;
+
+  #pragma omp parallel for schedule(dynamic, 1)
+  for( long t = 0; t < static_cast<long>( remaining.size() ); t++ )
+  {
+    auto&& tile = remaining[ static_cast<std::size_t>( t ) ];
+
+    storage.traverse( tile, [&M, &f, &prepared] ( std::size_t i, std::size_t j )
+                            {
+                              M( i, j ) = f( prepared[i], prepared[j] );
+                            } );
+
+    if( !checkpoint.empty() )
+    {
+      #pragma omp critical
+      {
+        auto index      = static_cast<std::size_t>( std::lower_bound( tiles.begin(), tiles.end(), tile ) - tiles.begin() );
+        complete[index] = true;
+
+        if( saved && ++unsaved >= interval )
+        {
+          saved   = storage.save( tiles, complete, M );
+          unsaved = 0;
+        }
+      }
+    }
+  }
+
+  if( !checkpoint.empty() && saved && unsaved > 0 )
+    storage.save( tiles, complete, M );
+
+  return M;
+}
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -4,13 +4,22 @@
 #include <aleph/geometry/distances/Infinity.hh>
 
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+#include <aleph/persistenceDiagrams/distances/detail/BottleneckMatching.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Essential.hh>
 #include <aleph/persistenceDiagrams/distances/detail/Orthogonal.hh>
+#include <aleph/persistenceDiagrams/distances/detail/PreparedDiagram.hh>
 
 #include <boost/iterator/counting_iterator.hpp>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/max_cardinality_matching.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 namespace aleph
 {
 
@@ -98,35 +107,15 @@ template <class T> struct CheckMatchingCardinality
   MatchingVectorType _mates; // Edges of the matching
 };
 
-} // namespace detail
-
 /**
-  Calculates the Bottleneck distance between two persistence diagrams.
-  The algorithm used for this involves checking a (complete) bipartite
-  graph for perfect matchings.
-
-  A brief description of the algoritmh is given in
-
-    Computational Topology
-    Herbert Edelsbrunner and John Harer
-
-  on page 191.
-
-  The implementation has been inspired by Dmitriy Morozov's "Dionysus"
-  framework.
-
-  @param D1 First persistence diagram
-  @param D2 Second persistence diagram
-
-  @returns Bottleneck distance between the two persistence diagrams
+  Calculates the Bottleneck distance for an arbitrary distance between
+  points by checking a complete bipartite graph for perfect matchings.
+  This is the fallback for distances other than the infinity distance.
 */
 
-
-template <
-  class DataType,
-  class Distance = aleph::geometry::distances::InfinityDistance<DataType>
-> DataType bottleneckDistance( const PersistenceDiagram<DataType>& D1,
-                               const PersistenceDiagram<DataType>& D2 )
+template <class DataType, class Distance> DataType bottleneckDistance( const PersistenceDiagram<DataType>& D1,
+                                                                        const PersistenceDiagram<DataType>& D2,
+                                                                        std::false_type )
 {
   auto n           = D1.size();
   auto m           = D2.size();
@@ -135,12 +124,15 @@ template <
   using SizeType = decltype(n);
   using Edge     = detail::Edge<DataType>;
 
+  if( maximumSize == 0 )
+    return DataType();
+
   std::vector<Edge> edges;
 
   // Diagonal edges ----------------------------------------------------
 
   for( SizeType i = n; i < maximumSize; i++ )
-    for( SizeType j = maximumSize + i; j < 2 * maximumSize; j++ )
+    for( SizeType j = maximumSize + m; j < 2 * maximumSize; j++ )
       edges.push_back( Edge( static_cast<std::size_t>(i), static_cast<std::size_t>(j), DataType() ) );
 
   SizeType i = 0;
@@ -173,7 +165,7 @@ template <
   for( auto it1 = D1.begin(); it1 != D1.end(); ++it1 )
   {
     edges.push_back( Edge( static_cast<std::size_t>(i), static_cast<std::size_t>(maximumSize + m + i),
-                           aleph::distances::detail::orthogonalDistance<Distance>( *it1 ) ) );
+                           orthogonalDistance<Distance>( *it1 ) ) );
 
     ++i;
   }
@@ -183,7 +175,9 @@ template <
   for( auto it2 = D2.begin(); it2 != D2.end(); ++it2 )
   {
     edges.push_back( Edge( static_cast<std::size_t>(n + i - maximumSize), static_cast<std::size_t>(i),
-                           aleph::distances::detail::orthogonalDistance<Distance>( *it2 ) ) );
+                           orthogonalDistance<Distance>( *it2 ) ) );
+
+    ++i;
   }
 
   // Identify matchings ------------------------------------------------
@@ -200,11 +194,275 @@ template <
   auto itEdge = std::upper_bound( CountingIteratorType( edges.begin() ),
                                   CountingIteratorType( edges.end() ),
                                   edges.begin(),
-                                  detail::CheckMatchingCardinality<DataType>( maximumSize, edges.begin() ) );
+                                  CheckMatchingCardinality<DataType>( maximumSize, edges.begin() ) );
 
   return (*itEdge)->weight;
 }
 
+/**
+  Calculates the Bottleneck distance in the infinity distance using the
+  geometric Hopcroft--Karp matching. Points with infinite coordinates,
+  i.e. essential classes, can only be matched to points with the same
+  type of infinite coordinates; they are matched optimally by sorting
+  their finite coordinates.
+
+  @param P             First prepared persistence diagram
+  @param Q             Second prepared persistence diagram
+  @param relativeError Relative error; if zero, the exact distance is
+                       calculated
+*/
+
+template <class DataType> DataType geometricBottleneckDistance( const typename BottleneckMatching<DataType>::Prepared& P,
+                                                                const typename BottleneckMatching<DataType>::Prepared& Q,
+                                                                double relativeError )
+{
+  using Matching = BottleneckMatching<DataType>;
+  using Point    = typename Matching::Point;
+
+  auto&& A         = P.points;
+  auto&& diagonalA = P.diagonal;
+  auto&& diagonalB = Q.diagonal;
+
+  // Essential points --------------------------------------------------
+
+  DataType result = DataType();
+
+  bool matched = matchEssentialPoints( P.essential, Q.essential,
+                                       [&result] ( DataType x, DataType y )
+                                       {
+                                         result = std::max( result, x >= y ? x - y : y - x );
+                                       } );
+
+  if( !matched )
+    return infinity<DataType>();
+
+  // Finite points -----------------------------------------------------
+  //
+  // Matching all points to the diagonal yields an upper bound for the
+  // distance. A binary search then shrinks the interval that contains
+  // the distance until its bounds are within the relative error.
+
+  DataType upper = DataType();
+
+  for( auto&& d : diagonalA )
+    upper = std::max( upper, d );
+
+  for( auto&& d : diagonalB )
+    upper = std::max( upper, d );
+
+  if( upper == DataType() )
+    return result;
+
+  Matching matching( P, Q );
+
+  if( matching.isPerfect( DataType() ) )
+    return result;
+
+  // The exact distance is determined among the pairwise distances in
+  // the final interval, which is small for a moderate relative error.
+  double epsilon = relativeError > 0 ? relativeError : 0.01;
+  DataType lower = DataType();
+
+  while( static_cast<double>( upper ) > static_cast<double>( lower ) * ( 1.0 + epsilon ) )
+  {
+    auto mid = lower + ( upper - lower ) / 2;
+
+    if( !( lower < mid && mid < upper ) )
+      break;
+
+    if( matching.isPerfect( mid ) )
+      upper = mid;
+    else
+      lower = mid;
+  }
+
+  if( relativeError > 0 )
+    return std::max( result, upper );
+
+  std::vector<DataType> candidates;
+
+  for( auto&& d : diagonalA )
+    if( lower < d && d <= upper )
+      candidates.push_back( d );
+
+  for( auto&& d : diagonalB )
+    if( lower < d && d <= upper )
+      candidates.push_back( d );
+
+  for( auto&& p : A )
+  {
+    Q.index.query( p.x, p.y, upper,
+                   [&] ( const Point& q )
+                   {
+                     auto d = std::max( p.x >= q.x ? p.x - q.x : q.x - p.x,
+                                        p.y >= q.y ? p.y - q.y : q.y - p.y );
+
+                     if( lower < d )
+                       candidates.push_back( d );
+                   } );
+  }
+
+  std::sort( candidates.begin(), candidates.end() );
+  candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+  // The largest candidate is at least as large as the distance, so it
+  // is guaranteed to admit a perfect matching.
+  std::size_t first = 0;
+  std::size_t last  = candidates.size();
+
+  while( first + 1 < last )
+  {
+    auto mid = first + ( last - first ) / 2;
+
+    if( matching.isPerfect( candidates[mid - 1] ) )
+      last = mid;
+    else
+      first = mid;
+  }
+
+  if( last == 0 )
+    return std::max( result, upper );
+
+  return std::max( result, candidates[last - 1] );
+}
+
+/**
+  Calculates the Bottleneck distance in the infinity distance. This
+  overload uses the geometric matching.
+*/
+
+template <class DataType, class Distance> DataType bottleneckDistance( const PersistenceDiagram<DataType>& D1,
+                                                                        const PersistenceDiagram<DataType>& D2,
+                                                                        std::true_type )
+{
+  using Index = PointIndex<DataType>;
+
+  return geometricBottleneckDistance<DataType>( prepareDiagram<DataType, Index>( D1 ),
+                                                prepareDiagram<DataType, Index>( D2 ),
+                                                0.0 );
+}
+
+} // namespace detail
+
+/**
+  Calculates the Bottleneck distance between two persistence diagrams.
+  The algorithm used for this involves checking a bipartite graph for
+  perfect matchings.
+
+  A brief description of the algoritmh is given in
+
+    Computational Topology
+    Herbert Edelsbrunner and John Harer
+
+  on page 191.
+
+  For the default infinity distance, the perfect matchings are found
+  by a variant of the Hopcroft--Karp algorithm that uses range queries
+  instead of storing the graph, following
+
+    Geometry Helps to Compare Persistence Diagrams
+    Michael Kerber, Dmitriy Morozov, and Arnur Nigmetov
+    Journal of Experimental Algorithmics 22, 2017
+
+  For other distances, the complete bipartite graph is checked using
+  Edmonds' algorithm. This has been inspired by Dmitriy Morozov's
+  "Dionysus" framework.
+
+  @param D1 First persistence diagram
+  @param D2 Second persistence diagram
+
+  @returns Bottleneck distance between the two persistence diagrams
+*/
+
+template <
+  class DataType,
+  class Distance = aleph::geometry::distances::InfinityDistance<DataType>
+> DataType bottleneckDistance( const PersistenceDiagram<DataType>& D1,
+                               const PersistenceDiagram<DataType>& D2 )
+{
+  return detail::bottleneckDistance<DataType, Distance>( D1, D2, std::is_same< Distance, aleph::geometry::distances::InfinityDistance<DataType> >() );
+}
+
+/**
+  Approximates the Bottleneck distance between two persistence diagrams
+  up to a relative error. The result \f$d'\f$ satisfies \f$d \leq d'
+  \leq (1+\epsilon) d\f$, where \f$d\f$ is the exact distance. This
+  is faster than calculating the exact distance for large diagrams.
+
+  @param D1            First persistence diagram
+  @param D2            Second persistence diagram
+  @param relativeError Relative error \f$\epsilon\f$; if zero, the exact
+                       distance is calculated
+
+  @returns Bottleneck distance between the two persistence diagrams
+*/
+
+template <class DataType> DataType bottleneckDistance( const PersistenceDiagram<DataType>& D1,
+                                                       const PersistenceDiagram<DataType>& D2,
+                                                       double relativeError )
+{
+  if( relativeError < 0 )
+    throw std::runtime_error( "Relative error must be non-negative" );
+
+  using Index = detail::PointIndex<DataType>;
+
+  return detail::geometricBottleneckDistance<DataType>( detail::prepareDiagram<DataType, Index>( D1 ),
+                                                        detail::prepareDiagram<DataType, Index>( D2 ),
+                                                        relativeError );
+}
+
+/**
+  @class BottleneckDistance
+  @brief Functor for the Bottleneck distance in the infinity distance
+
+  Calculates the same distance as bottleneckDistance() with the default
+  infinity distance between points. The finite points of a persistence
+  diagram and their kd-tree do not depend on the other diagram, so they
+  are calculated once by prepare(). The class may be used as a functor
+  for pairwiseMatrix().
+*/
+
+template <class T> class BottleneckDistance
+{
+public:
+  using Prepared = typename detail::BottleneckMatching<T>::Prepared;
+
+  /**
+    Creates the functor for a given relative error; if zero, the exact
+    distance is calculated.
+
+    @throws std::runtime_error if the relative error is negative
+  */
+
+  explicit BottleneckDistance( double relativeError = 0.0 )
+    : _relativeError( relativeError )
+  {
+    if( relativeError < 0 )
+      throw std::runtime_error( "Relative error must be non-negative" );
+  }
+
+  /** Calculates the finite points and the kd-tree of a persistence diagram */
+  Prepared prepare( const PersistenceDiagram<T>& D ) const
+  {
+    return detail::prepareDiagram<T, typename detail::BottleneckMatching<T>::Index>( D );
+  }
+
+  /** Calculates the Bottleneck distance between two prepared diagrams */
+  T operator()( const Prepared& P, const Prepared& Q ) const
+  {
+    return detail::geometricBottleneckDistance<T>( P, Q, _relativeError );
+  }
+
+  /** Calculates the Bottleneck distance between two persistence diagrams */
+  T operator()( const PersistenceDiagram<T>& D1, const PersistenceDiagram<T>& D2 ) const
+  {
+    return this->operator()( this->prepare( D1 ), this->prepare( D2 ) );
+  }
+
+private:
+  double _relativeError;
+};
+
 } // namespace distances
 
 } // namespace aleph
@@ -4,12 +4,16 @@
 #include <aleph/geometry/distances/Infinity.hh>
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 
-#include <aleph/persistenceDiagrams/distances/detail/Munkres.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Auction.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Essential.hh>
+#include <aleph/persistenceDiagrams/distances/detail/JonkerVolgenant.hh>
 #include <aleph/persistenceDiagrams/distances/detail/Orthogonal.hh>
+#include <aleph/persistenceDiagrams/distances/detail/PreparedDiagram.hh>
 
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
 #include <cmath>
 
@@ -19,6 +23,21 @@ namespace aleph
 namespace distances
 {
 
+/**
+  Calculates the Wasserstein distance between two persistence diagrams
+  by solving the assignment problem of their points and their diagonal
+  projections with the shortest augmenting path method by Jonker and
+  Volgenant. This requires a dense cost matrix, so it is only suitable
+  for small diagrams. It serves as the exact reference for the auction
+  algorithm.
+
+  @param D1    First persistence diagram
+  @param D2    Second persistence diagram
+  @param power Exponent of the distance
+
+  @returns Wasserstein distance between the two persistence diagrams
+*/
+
 template <
   class DataType,
   class Distance = aleph::geometry::distances::InfinityDistance<DataType>
@@ -119,21 +138,119 @@ template <
 
   // Assignment problem solving ----------------------------------------
 
-  detail::Munkres<DataType> solver( costs );
+  detail::JonkerVolgenant<DataType> solver( costs );
 
-  auto M              = solver();
+  auto&& assignment   = solver.assignment();
   DataType totalCosts = DataType();
 
-  for( row = IndexType(); row < M.n(); row++ )
+  for( row = IndexType(); row < assignment.size(); row++ )
+    totalCosts += costs( row, assignment[row] );
+
+  return std::pow( totalCosts, 1 / power );
+}
+
+/**
+  @class WassersteinDistance
+  @brief Functor for approximating the Wasserstein distance
+
+  Calculates the same distance as the approximate variant of
+  wassersteinDistance(). The finite points of a persistence diagram and
+  their kd-tree do not depend on the other diagram, so they are
+  calculated once by prepare(). The class may be used as a functor for
+  pairwiseMatrix().
+
+  The exact variant of wassersteinDistance() requires a dense cost
+  matrix of every pair, so it does not benefit from any preparation.
+*/
+
+template <class T> class WassersteinDistance
+{
+public:
+  using Prepared = typename detail::Auction<T>::Prepared;
+
+  /**
+    Creates the functor for a given exponent and relative error.
+
+    @throws std::runtime_error if the relative error is not positive
+  */
+
+  explicit WassersteinDistance( T power = T( 1 ), double relativeError = 0.01 )
+    : _power( power )
+    , _relativeError( relativeError )
   {
-    for( col = IndexType(); col < M.n(); col++ )
-    {
-      if( M( row, col ) == IndexType() )
-        totalCosts += costs( row, col );
-    }
+    if( relativeError <= 0 )
+      throw std::runtime_error( "Relative error must be positive" );
   }
 
-  return std::pow( totalCosts, 1 / power );
+  /** Calculates the finite points and the kd-tree of a persistence diagram */
+  Prepared prepare( const PersistenceDiagram<T>& D ) const
+  {
+    return detail::prepareDiagram<T, typename detail::Auction<T>::Index>( D );
+  }
+
+  /** Approximates the Wasserstein distance between two prepared diagrams */
+  T operator()( const Prepared& P, const Prepared& Q ) const
+  {
+    if( P.essential.dimension() != Q.essential.dimension() )
+      throw std::runtime_error( "Dimensions do not coincide" );
+
+    auto power      = _power;
+    auto totalCosts = T();
+
+    bool matched = detail::matchEssentialPoints( P.essential, Q.essential,
+                                                 [&totalCosts, &power] ( T x, T y )
+                                                 {
+                                                   totalCosts += std::pow( x >= y ? x - y : y - x, power );
+                                                 } );
+
+    if( !matched )
+      return detail::infinity<T>();
+
+    detail::Auction<T> auction( P, Q, power );
+    totalCosts += auction( _relativeError );
+
+    return std::pow( totalCosts, 1 / power );
+  }
+
+  /** Approximates the Wasserstein distance between two persistence diagrams */
+  T operator()( const PersistenceDiagram<T>& D1, const PersistenceDiagram<T>& D2 ) const
+  {
+    return this->operator()( this->prepare( D1 ), this->prepare( D2 ) );
+  }
+
+private:
+  T _power;
+  double _relativeError;
+};
+
+/**
+  Approximates the Wasserstein distance between two persistence diagrams
+  with the infinity distance between points up to a relative error. The
+  result \f$d'\f$ satisfies \f$d \leq d' \leq (1+\epsilon) d\f$, where
+  \f$d\f$ is the exact distance.
+
+  In contrast to the exact calculation, neither the cost matrix nor the
+  diagonal are stored explicitly. The assignment problem is solved with
+  an auction algorithm, using a kd-tree to determine the bids. This is
+  suitable for diagrams with many thousands of points.
+
+  Points with infinite coordinates, i.e. essential classes, can only be
+  matched to points with the same type of infinite coordinates.
+
+  @param D1            First persistence diagram
+  @param D2            Second persistence diagram
+  @param power         Exponent of the distance
+  @param relativeError Relative error \f$\epsilon\f$
+
+  @returns Wasserstein distance between the two persistence diagrams
+*/
+
+template <class DataType> DataType wassersteinDistance( const PersistenceDiagram<DataType>& D1,
+                                                        const PersistenceDiagram<DataType>& D2,
+                                                        DataType power,
+                                                        double relativeError )
+{
+  return WassersteinDistance<DataType>( power, relativeError )( D1, D2 );
 }
 
 } // namespace distances
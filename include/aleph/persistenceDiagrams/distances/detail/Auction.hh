@@ -0,0 +1,715 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_AUCTION_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_AUCTION_HH__
+
+#include <aleph/persistenceDiagrams/distances/detail/PreparedDiagram.hh>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace distances
+{
+
+namespace detail
+{
+
+/**
+  Stores the two smallest values found by a query along with the index
+  of the smallest one.
+*/
+
+template <class T> struct BestCandidates
+{
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  std::size_t first  = npos;
+  T firstValue       = std::numeric_limits<T>::max();
+  T secondValue      = std::numeric_limits<T>::max();
+
+  void update( std::size_t index, T value )
+  {
+    if( value < firstValue )
+    {
+      secondValue = firstValue;
+      firstValue  = value;
+      first       = index;
+    }
+    else if( value < secondValue )
+      secondValue = value;
+  }
+};
+
+template <class T> constexpr std::size_t BestCandidates<T>::npos;
+
+/**
+  @class WeightedPointIndex
+  @brief Planar kd-tree for weighted nearest neighbour queries
+
+  Stores a set of weighted planar points in an implicit kd-tree, i.e. a
+  sorted array in which the median of every range is the root of the
+  subtree of this range. A query finds the two points that minimize
+  \f$f(d(p,q)) + w(p)\f$, where \f$d\f$ is the infinity distance and
+  \f$f\f$ is a monotonically increasing function. Every node stores the
+  bounding box and the minimum weight of its subtree; the latter is
+  updated whenever the weight of a point changes.
+*/
+
+template <class T> class WeightedPointIndex
+{
+public:
+  struct Point
+  {
+    T x;
+    T y;
+
+    std::size_t id;
+  };
+
+  WeightedPointIndex() = default;
+
+  explicit WeightedPointIndex( std::vector<Point> points )
+    : _points( std::move( points ) )
+    , _positions( _points.size() )
+    , _weights( _points.size() )
+    , _minimumWeights( _points.size() )
+    , _boxes( _points.size() )
+  {
+    if( !_points.empty() )
+      this->build( 0, _points.size(), 0 );
+
+    for( std::size_t i = 0; i < _points.size(); i++ )
+      _positions[ _points[i].id ] = i;
+  }
+
+  /** @returns Weight of a point, identified by its ID */
+  T weight( std::size_t id ) const
+  {
+    return _weights[ _positions[id] ];
+  }
+
+  /** Changes the weight of a point, identified by its ID */
+  void setWeight( std::size_t id, T weight )
+  {
+    auto position = _positions[id];
+
+    _weights[position] = weight;
+
+    this->updateMinimumWeight( 0, _points.size(), position );
+  }
+
+  /**
+    Finds the two points that minimize the sum of a function of their
+    distance to the query point and their weight.
+
+    @param x          First coordinate of query point
+    @param y          Second coordinate of query point
+    @param f          Monotonically increasing function of the distance
+    @param candidates Current candidates; their values are used to prune
+                      the search and they are updated with the IDs of the
+                      points that have been found
+  */
+
+  template <class Function> void query( T x, T y, Function f, BestCandidates<T>& candidates ) const
+  {
+    if( !_points.empty() )
+      this->query( 0, _points.size(), this->bound( 0, _points.size(), x, y, f ), x, y, f, candidates );
+  }
+
+private:
+  struct Box
+  {
+    T x0;
+    T x1;
+    T y0;
+    T y1;
+  };
+
+  Box build( std::size_t lo, std::size_t hi, std::size_t depth )
+  {
+    auto mid = lo + ( hi - lo ) / 2;
+
+    std::nth_element( _points.begin() + static_cast<std::ptrdiff_t>( lo ),
+                      _points.begin() + static_cast<std::ptrdiff_t>( mid ),
+                      _points.begin() + static_cast<std::ptrdiff_t>( hi ),
+                      [depth] ( const Point& p, const Point& q )
+                      {
+                        return depth % 2 == 0 ? p.x < q.x : p.y < q.y;
+                      } );
+
+    auto&& p = _points[mid];
+    Box box  = { p.x, p.x, p.y, p.y };
+
+    for( auto&& range : { std::make_pair( lo, mid ), std::make_pair( mid + 1, hi ) } )
+    {
+      if( range.first >= range.second )
+        continue;
+
+      auto child = this->build( range.first, range.second, depth + 1 );
+
+      box.x0 = std::min( box.x0, child.x0 );
+      box.x1 = std::max( box.x1, child.x1 );
+      box.y0 = std::min( box.y0, child.y0 );
+      box.y1 = std::max( box.y1, child.y1 );
+    }
+
+    _boxes[mid] = box;
+    return box;
+  }
+
+  /**
+    Updates the minimum weights of all subtrees that contain a given
+    position, starting from the subtree of the range.
+  */
+
+  void updateMinimumWeight( std::size_t lo, std::size_t hi, std::size_t position )
+  {
+    auto mid = lo + ( hi - lo ) / 2;
+
+    if( position < mid )
+      this->updateMinimumWeight( lo, mid, position );
+    else if( position > mid )
+      this->updateMinimumWeight( mid + 1, hi, position );
+
+    auto weight = _weights[mid];
+
+    if( lo < mid )
+      weight = std::min( weight, _minimumWeights[ lo + ( mid - lo ) / 2 ] );
+
+    if( mid + 1 < hi )
+      weight = std::min( weight, _minimumWeights[ mid + 1 + ( hi - mid - 1 ) / 2 ] );
+
+    _minimumWeights[mid] = weight;
+  }
+
+  /** @returns Lower bound of the value of all points in a subtree */
+  template <class Function> T bound( std::size_t lo, std::size_t hi, T x, T y, Function& f ) const
+  {
+    auto mid = lo + ( hi - lo ) / 2;
+    auto&& b = _boxes[mid];
+
+    auto dx = std::max( std::max( b.x0 - x, x - b.x1 ), T() );
+    auto dy = std::max( std::max( b.y0 - y, y - b.y1 ), T() );
+
+    return f( std::max( dx, dy ) ) + _minimumWeights[mid];
+  }
+
+  /**
+    Searches the subtree of a range, whose lower bound has already been
+    calculated, for better candidates.
+  */
+
+  template <class Function> void query( std::size_t lo, std::size_t hi, T bound, T x, T y, Function& f, BestCandidates<T>& candidates ) const
+  {
+    if( bound >= candidates.secondValue )
+      return;
+
+    auto mid = lo + ( hi - lo ) / 2;
+    auto&& p = _points[mid];
+
+    auto dx = p.x >= x ? p.x - x : x - p.x;
+    auto dy = p.y >= y ? p.y - y : y - p.y;
+
+    candidates.update( p.id, f( std::max( dx, dy ) ) + _weights[mid] );
+
+    // Visit the more promising subtree first in order to improve the
+    // pruning of the other one.
+    auto left  = lo < mid     ? this->bound( lo, mid, x, y, f )     : std::numeric_limits<T>::max();
+    auto right = mid + 1 < hi ? this->bound( mid + 1, hi, x, y, f ) : std::numeric_limits<T>::max();
+
+    if( left <= right )
+    {
+      this->query( lo, mid, left, x, y, f, candidates );
+      this->query( mid + 1, hi, right, x, y, f, candidates );
+    }
+    else
+    {
+      this->query( mid + 1, hi, right, x, y, f, candidates );
+      this->query( lo, mid, left, x, y, f, candidates );
+    }
+  }
+
+  std::vector<Point>       _points;
+  std::vector<std::size_t> _positions;
+  std::vector<T>           _weights;
+  std::vector<T>           _minimumWeights;
+  std::vector<Box>         _boxes;
+};
+
+/**
+  @class AuctionSide
+  @brief One side of the assignment problem of two persistence diagrams
+
+  Consists of the points of one persistence diagram, followed by copies
+  of the diagonal, one for every point of the other diagram. Since all
+  copies of the diagonal are interchangeable, a point can be assigned to
+  any copy at the cost of its distance to the diagonal, and copies are
+  assigned to each other at no cost.
+
+  Every element carries a weight, i.e. its price or its profit in terms
+  of the auction algorithm. The side supports finding the two elements
+  that are the cheapest for an element of the other side, taking their
+  weights into account. Points are stored in a kd-tree, while ordered
+  sets keep track of the copies of the diagonal.
+*/
+
+template <class T> class AuctionSide
+{
+public:
+  using Index = WeightedPointIndex<T>;
+  using Point = typename Index::Point;
+
+  /**
+    Creates a new side from a set of points and their kd-tree, in which
+    all points have a weight of zero.
+  */
+
+  AuctionSide( std::vector<Point> points, Index index, std::vector<T> diagonalCosts, std::size_t numCopies )
+    : _points( std::move( points ) )
+    , _diagonalCosts( std::move( diagonalCosts ) )
+    , _numPoints( _points.size() )
+    , _weights( _numPoints + numCopies )
+    , _index( std::move( index ) )
+  {
+    for( std::size_t i = 0; i < _numPoints; i++ )
+      _diagonalOrder.insert( std::make_pair( _diagonalCosts[i], i ) );
+
+    for( std::size_t i = _numPoints; i < _weights.size(); i++ )
+      _copies.insert( std::make_pair( T(), i ) );
+  }
+
+  /** @returns Number of points and copies of the diagonal */
+  std::size_t size() const noexcept
+  {
+    return _weights.size();
+  }
+
+  bool isPoint( std::size_t i ) const noexcept
+  {
+    return i < _numPoints;
+  }
+
+  const Point& point( std::size_t i ) const
+  {
+    return _points[i];
+  }
+
+  /** @returns Cost of matching a point to the diagonal */
+  T diagonalCost( std::size_t i ) const
+  {
+    return _diagonalCosts[i];
+  }
+
+  T weight( std::size_t i ) const
+  {
+    return _weights[i];
+  }
+
+  void setWeight( std::size_t i, T weight )
+  {
+    if( this->isPoint( i ) )
+    {
+      _diagonalOrder.erase( std::make_pair( _diagonalCosts[i] + _weights[i], i ) );
+      _diagonalOrder.insert( std::make_pair( _diagonalCosts[i] + weight, i ) );
+      _index.setWeight( i, weight );
+    }
+    else
+    {
+      _copies.erase( std::make_pair( _weights[i], i ) );
+      _copies.insert( std::make_pair( weight, i ) );
+    }
+
+    _weights[i] = weight;
+  }
+
+  /**
+    Finds the two elements that minimize the sum of their cost and their
+    weight for an element of the other side.
+
+    @param other Other side
+    @param j     Index of element of the other side
+    @param f     Function for converting distances into costs
+  */
+
+  template <class Function> BestCandidates<T> best( const AuctionSide& other, std::size_t j, Function f ) const
+  {
+    BestCandidates<T> candidates;
+
+    if( other.isPoint( j ) )
+    {
+      auto&& p = other.point( j );
+      _index.query( p.x, p.y, f, candidates );
+
+      auto it = _copies.begin();
+      for( std::size_t k = 0; k < 2 && it != _copies.end(); k++, ++it )
+        candidates.update( it->second, other.diagonalCost( j ) + it->first );
+    }
+    else
+    {
+      auto it = _diagonalOrder.begin();
+      for( std::size_t k = 0; k < 2 && it != _diagonalOrder.end(); k++, ++it )
+        candidates.update( it->second, it->first );
+
+      it = _copies.begin();
+      for( std::size_t k = 0; k < 2 && it != _copies.end(); k++, ++it )
+        candidates.update( it->second, it->first );
+    }
+
+    return candidates;
+  }
+
+  /**
+    Calculates the cost of assigning an element of this side to an
+    element of the other side.
+  */
+
+  template <class Function> T cost( std::size_t i, const AuctionSide& other, std::size_t j, Function f ) const
+  {
+    bool pointI = this->isPoint( i );
+    bool pointJ = other.isPoint( j );
+
+    if( pointI && pointJ )
+    {
+      auto&& p = this->point( i );
+      auto&& q = other.point( j );
+
+      auto dx = p.x >= q.x ? p.x - q.x : q.x - p.x;
+      auto dy = p.y >= q.y ? p.y - q.y : q.y - p.y;
+
+      return f( std::max( dx, dy ) );
+    }
+    else if( pointI )
+      return this->diagonalCost( i );
+    else if( pointJ )
+      return other.diagonalCost( j );
+    else
+      return T();
+  }
+
+private:
+  std::vector<Point> _points;
+  std::vector<T>     _diagonalCosts;
+  std::size_t        _numPoints;
+  std::vector<T>     _weights;
+
+  Index _index;
+
+  std::set< std::pair<T, std::size_t> > _diagonalOrder;
+  std::set< std::pair<T, std::size_t> > _copies;
+};
+
+/**
+  @class Auction
+  @brief Forward--reverse auction for the Wasserstein distance
+
+  Solves the assignment problem between two persistence diagrams, whose
+  costs are powers of the infinity distance between points, without
+  storing the cost matrix. The diagonal is handled implicitly by the
+  sides of the problem.
+
+  The solver uses \f$\epsilon\f$-scaling and alternates between forward
+  phases, in which points of the first diagram bid for points of the
+  second diagram, and reverse phases, in which the roles are swapped.
+  Both maintain the \f$\epsilon\f$-complementary slackness conditions,
+  so the assignment is at most \f$N\epsilon\f$ more expensive than the
+  optimal one, where \f$N\f$ is the number of elements of every side.
+  The value of \f$\epsilon\f$ is decreased until a lower bound from the
+  dual problem guarantees that the relative error of the distance is
+  small enough. This follows
+
+    Geometry Helps to Compare Persistence Diagrams
+    Michael Kerber, Dmitriy Morozov, and Arnur Nigmetov
+    Journal of Experimental Algorithmics 22, 2017
+
+  as well as the description of the forward--reverse auction in
+
+    Network Optimization: Continuous and Discrete Models
+    Dimitri P. Bertsekas
+*/
+
+template <class T> class Auction
+{
+public:
+  using Side     = AuctionSide<T>;
+  using Index    = typename Side::Index;
+  using Point    = typename Side::Point;
+  using Prepared = PreparedDiagram<T, Index>;
+
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+    Creates a new auction for the finite points of two prepared
+    persistence diagrams. Their kd-trees are copied instead of being
+    built again.
+  */
+
+  Auction( const Prepared& P, const Prepared& Q, T power )
+    : _power( power )
+    , _A( P.points, P.index, this->costs( P.diagonal ), Q.points.size() )
+    , _B( Q.points, Q.index, this->costs( Q.diagonal ), P.points.size() )
+  {
+    auto&& A         = P.points;
+    auto&& B         = Q.points;
+    auto&& diagonalA = P.diagonal;
+    auto&& diagonalB = Q.diagonal;
+
+    _maximumCost = T();
+
+    if( A.empty() && B.empty() )
+      return;
+
+    auto&& p = A.empty() ? B.front() : A.front();
+
+    T x0 = p.x;
+    T x1 = p.x;
+    T y0 = p.y;
+    T y1 = p.y;
+
+    for( auto&& points : { &A, &B } )
+    {
+      for( auto&& q : *points )
+      {
+        x0 = std::min( x0, q.x );
+        x1 = std::max( x1, q.x );
+        y0 = std::min( y0, q.y );
+        y1 = std::max( y1, q.y );
+      }
+    }
+
+    // No cost can exceed the cost of the diameter of the bounding box of
+    // all points.
+    _maximumCost = this->cost( std::max( x1 - x0, y1 - y0 ) );
+
+    for( auto&& d : diagonalA )
+      _maximumCost = std::max( _maximumCost, this->cost( d ) );
+
+    for( auto&& d : diagonalB )
+      _maximumCost = std::max( _maximumCost, this->cost( d ) );
+  }
+
+  /**
+    Calculates an assignment whose total cost, raised to the power of
+    the inverse of the exponent, is within the given relative error of
+    the optimal one.
+
+    @returns Total cost of the assignment
+  */
+
+  T operator()( double relativeError )
+  {
+    auto N = _A.size();
+
+    if( N == 0 || _maximumCost == T() )
+      return T();
+
+    auto f = [this] ( T d ) { return this->cost( d ); };
+
+    T epsilon    = _maximumCost / 4;
+    T total      = T();
+    bool forward = true;
+
+    for( ;; )
+    {
+      // Reset profits such that the complementary slackness conditions
+      // are satisfied for the new value of epsilon. Pairs that satisfy
+      // the conditions remain assigned, which saves many bids in later
+      // phases of the scaling.
+      _matesA.resize( N, npos );
+      _matesB.resize( N, npos );
+
+      _unassignedA.clear();
+      _unassignedB.clear();
+
+      for( std::size_t i = N; i-- > 0; )
+      {
+        auto best = _B.best( _A, i, f ).firstValue;
+        auto j    = _matesA[i];
+
+        if( j != npos )
+        {
+          auto value = _A.cost( i, _B, j, f ) + _B.weight( j );
+
+          if( value <= best + epsilon )
+          {
+            _A.setWeight( i, -value );
+            continue;
+          }
+
+          _matesA[i] = npos;
+          _matesB[j] = npos;
+        }
+
+        _A.setWeight( i, -best );
+      }
+
+      for( std::size_t i = N; i-- > 0; )
+      {
+        if( _matesA[i] == npos )
+          _unassignedA.push_back( i );
+
+        if( _matesB[i] == npos )
+          _unassignedB.push_back( i );
+      }
+
+      _numUnassigned = _unassignedA.size();
+
+      // Forward and reverse phases alternate. Switching the direction
+      // within a phase preserves the complementary slackness conditions
+      // as well, but it results in many more bids in practice.
+      if( forward )
+        this->run( _A, _B, _matesA, _matesB, _unassignedA, epsilon, f );
+      else
+        this->run( _B, _A, _matesB, _matesA, _unassignedB, epsilon, f );
+
+      forward = !forward;
+
+      total = T();
+
+      for( std::size_t i = 0; i < N; i++ )
+        total += _A.cost( i, _B, _matesA[i], f );
+
+      if( total == T() )
+        return total;
+
+      // The prices of one side, along with the cheapest element for every
+      // element of the other side, form a feasible solution of the dual
+      // problem. Its value is a lower bound for the optimal costs, which
+      // is at least as tight as the bound of the complementary slackness
+      // conditions, i.e. the total costs minus N * epsilon.
+      auto lower = std::max( this->lowerBound( _A, _B, f ), this->lowerBound( _B, _A, f ) );
+
+      if( lower > 0 && std::pow( static_cast<double>( total ) / lower, 1.0 / static_cast<double>( _power ) ) <= 1.0 + relativeError )
+        return total;
+
+      epsilon /= 5;
+
+      if( epsilon <= _maximumCost * std::numeric_limits<T>::epsilon() )
+        return total;
+    }
+  }
+
+private:
+
+  /** Converts a distance into a cost */
+  T cost( T d ) const
+  {
+    if( _power == T(1) )
+      return d;
+    else if( _power == T(2) )
+      return d * d;
+    else
+      return std::pow( d, _power );
+  }
+
+  std::vector<T> costs( const std::vector<T>& distances ) const
+  {
+    std::vector<T> result;
+    result.reserve( distances.size() );
+
+    for( auto&& d : distances )
+      result.push_back( this->cost( d ) );
+
+    return result;
+  }
+
+  /**
+    Calculates the value of a feasible solution of the dual problem, in
+    which the prices of the items are fixed and every bidder is assigned
+    its cheapest item.
+  */
+
+  template <class Function> double lowerBound( const Side& bidders, const Side& items, Function f ) const
+  {
+    double lower = 0.0;
+
+    for( std::size_t i = 0; i < bidders.size(); i++ )
+      lower += static_cast<double>( items.best( bidders, i, f ).firstValue );
+
+    for( std::size_t j = 0; j < items.size(); j++ )
+      lower -= static_cast<double>( items.weight( j ) );
+
+    return lower;
+  }
+
+  /**
+    Performs bidding iterations, in which unassigned elements of the
+    bidding side bid for elements of the other side, until all elements
+    have been assigned.
+  */
+
+  template <class Function> void run( Side& bidders, Side& items,
+                                      std::vector<std::size_t>& matesBidders,
+                                      std::vector<std::size_t>& matesItems,
+                                      std::vector<std::size_t>& unassignedBidders,
+                                      T epsilon,
+                                      Function f )
+  {
+    while( _numUnassigned > 0 && !unassignedBidders.empty() )
+    {
+      auto i = unassignedBidders.back();
+      unassignedBidders.pop_back();
+
+      // Elements that have been assigned in the meantime are removed
+      // lazily from the list.
+      if( matesBidders[i] != npos )
+        continue;
+
+      auto candidates = items.best( bidders, i, f );
+      auto j          = candidates.first;
+      auto second     = candidates.secondValue;
+
+      if( second == std::numeric_limits<T>::max() )
+        second = candidates.firstValue;
+
+      auto c = bidders.cost( i, items, j, f );
+
+      items.setWeight( j, second - c + epsilon );
+      bidders.setWeight( i, -second - epsilon );
+
+      auto k = matesItems[j];
+
+      if( k != npos )
+      {
+        matesBidders[k] = npos;
+        unassignedBidders.push_back( k );
+      }
+      else
+        --_numUnassigned;
+
+      matesBidders[i] = j;
+      matesItems[j]   = i;
+    }
+  }
+
+  T _power;
+
+  Side _A;
+  Side _B;
+
+  T _maximumCost;
+
+  std::vector<std::size_t> _matesA;
+  std::vector<std::size_t> _matesB;
+
+  std::vector<std::size_t> _unassignedA;
+  std::vector<std::size_t> _unassignedB;
+
+  std::size_t _numUnassigned = 0;
+};
+
+template <class T> constexpr std::size_t Auction<T>::npos;
+
+} // namespace detail
+
+} // namespace distances
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,583 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_BOTTLENECK_MATCHING_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_BOTTLENECK_MATCHING_HH__
+
+#include <aleph/persistenceDiagrams/distances/detail/PreparedDiagram.hh>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace distances
+{
+
+namespace detail
+{
+
+/**
+  @class PointIndex
+  @brief Planar kd-tree for range queries in the infinity distance
+
+  Stores a set of planar points in an implicit kd-tree, i.e. a sorted
+  array in which the median of every range is the root of the subtree
+  of this range. Points may be removed while the tree is being queried.
+  Every node keeps track of the number of points remaining in its
+  subtree, so that empty subtrees are skipped. Removals are undone by
+  `reset()`, which does not require rebuilding the tree.
+*/
+
+template <class T> class PointIndex
+{
+public:
+  struct Point
+  {
+    T x;
+    T y;
+
+    std::size_t id;
+  };
+
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  PointIndex() = default;
+
+  explicit PointIndex( std::vector<Point> points )
+    : _points( std::move( points ) )
+    , _initialCounts( _points.size() )
+  {
+    this->build( 0, _points.size(), 0 );
+    this->reset();
+  }
+
+  /** @returns Number of points, regardless of whether they have been removed */
+  std::size_t size() const noexcept
+  {
+    return _points.size();
+  }
+
+  /** Restores all points that have been removed */
+  void reset()
+  {
+    _counts = _initialCounts;
+    _alive.assign( _points.size(), true );
+  }
+
+  /**
+    Finds a point whose infinity distance to the query point is at most
+    the given radius and removes it from the index.
+
+    @returns Identifier of the point, or `npos` if no such point exists
+  */
+
+  std::size_t extract( T x, T y, T r )
+  {
+    auto position = this->find( 0, _points.size(), 0, x - r, x + r, y - r, y + r );
+
+    if( position == npos )
+      return npos;
+
+    this->remove( position );
+    return _points[position].id;
+  }
+
+  /**
+    Enumerates all remaining points whose infinity distance to the query
+    point is at most the given radius. The functor receives the point.
+  */
+
+  template <class Functor> void query( T x, T y, T r, Functor f ) const
+  {
+    this->query( 0, _points.size(), 0, x - r, x + r, y - r, y + r, f );
+  }
+
+private:
+  void build( std::size_t lo, std::size_t hi, std::size_t depth )
+  {
+    if( lo >= hi )
+      return;
+
+    auto mid = lo + ( hi - lo ) / 2;
+
+    std::nth_element( _points.begin() + static_cast<std::ptrdiff_t>( lo ),
+                      _points.begin() + static_cast<std::ptrdiff_t>( mid ),
+                      _points.begin() + static_cast<std::ptrdiff_t>( hi ),
+                      [depth] ( const Point& p, const Point& q )
+                      {
+                        return depth % 2 == 0 ? p.x < q.x : p.y < q.y;
+                      } );
+
+    _initialCounts[mid] = hi - lo;
+
+    this->build( lo,      mid, depth + 1 );
+    this->build( mid + 1, hi,  depth + 1 );
+  }
+
+  std::size_t find( std::size_t lo, std::size_t hi, std::size_t depth, T x0, T x1, T y0, T y1 ) const
+  {
+    if( lo >= hi )
+      return npos;
+
+    auto mid = lo + ( hi - lo ) / 2;
+
+    if( _counts[mid] == 0 )
+      return npos;
+
+    auto&& p = _points[mid];
+
+    if( _alive[mid] && x0 <= p.x && p.x <= x1 && y0 <= p.y && p.y <= y1 )
+      return mid;
+
+    auto split = depth % 2 == 0 ? p.x : p.y;
+    auto lower = depth % 2 == 0 ? x0  : y0;
+    auto upper = depth % 2 == 0 ? x1  : y1;
+
+    if( lower <= split )
+    {
+      auto position = this->find( lo, mid, depth + 1, x0, x1, y0, y1 );
+      if( position != npos )
+        return position;
+    }
+
+    if( upper >= split )
+      return this->find( mid + 1, hi, depth + 1, x0, x1, y0, y1 );
+
+    return npos;
+  }
+
+  template <class Functor> void query( std::size_t lo, std::size_t hi, std::size_t depth, T x0, T x1, T y0, T y1, Functor& f ) const
+  {
+    if( lo >= hi )
+      return;
+
+    auto mid = lo + ( hi - lo ) / 2;
+
+    if( _counts[mid] == 0 )
+      return;
+
+    auto&& p = _points[mid];
+
+    if( _alive[mid] && x0 <= p.x && p.x <= x1 && y0 <= p.y && p.y <= y1 )
+      f( p );
+
+    auto split = depth % 2 == 0 ? p.x : p.y;
+    auto lower = depth % 2 == 0 ? x0  : y0;
+    auto upper = depth % 2 == 0 ? x1  : y1;
+
+    if( lower <= split )
+      this->query( lo, mid, depth + 1, x0, x1, y0, y1, f );
+
+    if( upper >= split )
+      this->query( mid + 1, hi, depth + 1, x0, x1, y0, y1, f );
+  }
+
+  void remove( std::size_t position )
+  {
+    std::size_t lo = 0;
+    std::size_t hi = _points.size();
+
+    while( lo < hi )
+    {
+      auto mid = lo + ( hi - lo ) / 2;
+
+      --_counts[mid];
+
+      if( position == mid )
+        break;
+      else if( position < mid )
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+
+    _alive[position] = false;
+  }
+
+  std::vector<Point> _points;
+
+  std::vector<std::size_t> _initialCounts;
+  std::vector<std::size_t> _counts;
+  std::vector<bool>        _alive;
+};
+
+template <class T> constexpr std::size_t PointIndex<T>::npos;
+
+/**
+  @class BottleneckMatching
+  @brief Geometric Hopcroft--Karp matching for the bottleneck distance
+
+  Decides whether two persistence diagrams admit a perfect matching in
+  which every pair of points is at most a given distance apart in the
+  infinity distance. Following the reduction to a bipartite graph, the
+  left side consists of the points of the first diagram and of the
+  diagonal projections of the points of the second diagram, while the
+  right side consists of the points of the second diagram and of the
+  diagonal projections of the points of the first diagram.
+
+  The graph is never stored explicitly. Edges between points of the two
+  diagrams are found by range queries in kd-trees, a point is connected
+  to its own projection only, and all projections are connected to each
+  other at zero cost. Every right vertex is retrieved at most once per
+  breadth-first and depth-first search, which is the approach described
+  in
+
+    Geometry Helps to Compare Persistence Diagrams
+    Michael Kerber, Dmitriy Morozov, and Arnur Nigmetov
+    Journal of Experimental Algorithmics 22, 2017
+
+  The matching is kept between subsequent queries. When the radius is
+  decreased, only those edges of the matching that are too long are
+  removed, so a binary search over the radius re-uses most of the work.
+*/
+
+template <class T> class BottleneckMatching
+{
+public:
+  using Index    = PointIndex<T>;
+  using Point    = typename Index::Point;
+  using Prepared = PreparedDiagram<T, Index>;
+
+  static constexpr std::size_t npos = Index::npos;
+
+  /**
+    Creates a new matching for the finite points of two prepared
+    persistence diagrams. The kd-tree of the second diagram is copied
+    instead of being built again.
+  */
+
+  BottleneckMatching( const Prepared& A, const Prepared& B )
+    : _A( A.points )
+    , _B( B.points )
+    , _diagonalA( A.diagonal )
+    , _diagonalB( B.diagonal )
+    , _n( _A.size() )
+    , _m( _B.size() )
+    , _mateLeft( _n + _m, npos )
+    , _mateRight( _n + _m, npos )
+    , _index( B.index )
+  {
+  }
+
+  /**
+    Checks whether a perfect matching exists in which no edge is longer
+    than the given radius.
+  */
+
+  bool isPerfect( T r )
+  {
+    auto N = _n + _m;
+
+    // Remove all edges that are too long for the new radius and keep the
+    // remainder of the matching. Since no other edges change, the new
+    // matching is still valid.
+    for( std::size_t u = 0; u < N; u++ )
+    {
+      auto v = _mateLeft[u];
+
+      if( v != npos && this->weight( u, v ) > r )
+      {
+        _mateLeft[u]  = npos;
+        _mateRight[v] = npos;
+      }
+    }
+
+    _r = r;
+
+    while( this->search() )
+      this->augment();
+
+    return std::find( _mateLeft.begin(), _mateLeft.end(), npos ) == _mateLeft.end();
+  }
+
+private:
+
+  /**
+    Calculates the weight of an edge between a left vertex and a right
+    vertex, i.e. their infinity distance. Vertices that are not adjacent
+    in the graph have a weight of infinity.
+  */
+
+  T weight( std::size_t u, std::size_t v ) const
+  {
+    bool diagonalU = u >= _n;
+    bool diagonalV = v >= _m;
+
+    if( !diagonalU && !diagonalV )
+    {
+      auto&& p = _A[u];
+      auto&& q = _B[v];
+
+      auto dx = p.x >= q.x ? p.x - q.x : q.x - p.x;
+      auto dy = p.y >= q.y ? p.y - q.y : q.y - p.y;
+
+      return std::max( dx, dy );
+    }
+    else if( !diagonalU && diagonalV )
+      return v - _m == u ? _diagonalA[u] : std::numeric_limits<T>::max();
+    else if( diagonalU && !diagonalV )
+      return u - _n == v ? _diagonalB[v] : std::numeric_limits<T>::max();
+    else
+      return T();
+  }
+
+  /**
+    Performs a breadth-first search from all unmatched left vertices and
+    assigns layers to the left and right vertices. The search stops at
+    the first layer containing an unmatched right vertex.
+
+    @returns true if an augmenting path exists
+  */
+
+  bool search()
+  {
+    auto N = _n + _m;
+
+    _layerLeft.assign( N, npos );
+    _layerRight.assign( N, npos );
+
+    std::vector<std::size_t> current;
+    std::vector<std::size_t> next;
+
+    for( std::size_t u = 0; u < N; u++ )
+    {
+      if( _mateLeft[u] == npos )
+      {
+        _layerLeft[u] = 0;
+        current.push_back( u );
+      }
+    }
+
+    if( current.empty() )
+      return false;
+
+    _index.reset();
+
+    // Projections of the first diagram that have not been visited yet;
+    // all of them are adjacent to every projection of the second one.
+    _unvisitedDiagonal.clear();
+
+    for( std::size_t v = _m; v < N; v++ )
+      _unvisitedDiagonal.push_back( v );
+
+    bool found = false;
+    _numLayers = 0;
+
+    for( std::size_t layer = 0; !current.empty() && !found; layer++ )
+    {
+      next.clear();
+
+      auto visit = [&] ( std::size_t v )
+      {
+        _layerRight[v] = layer;
+
+        auto w = _mateRight[v];
+
+        if( w == npos )
+          found = true;
+        else
+        {
+          _layerLeft[w] = layer + 1;
+          next.push_back( w );
+        }
+      };
+
+      for( auto&& u : current )
+      {
+        if( u < _n )
+        {
+          auto projection = _m + u;
+
+          if( _layerRight[projection] == npos && _diagonalA[u] <= _r )
+            visit( projection );
+
+          for( auto v = _index.extract( _A[u].x, _A[u].y, _r ); v != npos; v = _index.extract( _A[u].x, _A[u].y, _r ) )
+          {
+            if( _layerRight[v] == npos )
+              visit( v );
+          }
+        }
+        else
+        {
+          auto point = u - _n;
+
+          if( _layerRight[point] == npos && _diagonalB[point] <= _r )
+            visit( point );
+
+          while( !_unvisitedDiagonal.empty() )
+          {
+            auto v = _unvisitedDiagonal.back();
+            _unvisitedDiagonal.pop_back();
+
+            if( _layerRight[v] == npos )
+              visit( v );
+          }
+        }
+      }
+
+      _numLayers = layer + 1;
+      std::swap( current, next );
+    }
+
+    if( !found )
+      return false;
+
+    // Prepare the layered graph for the depth-first search: points and
+    // projections are sorted into the layers in which they have been
+    // discovered.
+    std::vector< std::vector<Point> > points( _numLayers );
+    _layerDiagonal.assign( _numLayers, std::vector<std::size_t>() );
+
+    for( std::size_t v = 0; v < N; v++ )
+    {
+      auto layer = _layerRight[v];
+
+      if( layer == npos )
+        continue;
+
+      if( v < _m )
+        points[layer].push_back( _B[v] );
+      else
+        _layerDiagonal[layer].push_back( v );
+    }
+
+    _layerIndices.clear();
+
+    for( auto&& P : points )
+      _layerIndices.emplace_back( std::move( P ) );
+
+    _used.assign( N, false );
+    return true;
+  }
+
+  /**
+    Augments the matching along a maximal set of vertex-disjoint shortest
+    augmenting paths in the layered graph.
+  */
+
+  void augment()
+  {
+    auto N = _n + _m;
+
+    for( std::size_t u = 0; u < N; u++ )
+    {
+      if( _mateLeft[u] == npos && _layerLeft[u] == 0 )
+        this->augment( u );
+    }
+  }
+
+  /** @returns Next unused right vertex of the layered graph adjacent to a left vertex */
+  std::size_t nextNeighbour( std::size_t u )
+  {
+    auto layer = _layerLeft[u];
+
+    // Vertices beyond the last layer cannot be part of a shortest path
+    if( layer >= _numLayers )
+      return npos;
+
+    // Own projection or own point
+    {
+      auto v = u < _n ? _m + u : u - _n;
+      auto d = u < _n ? _diagonalA[u] : _diagonalB[v];
+
+      if( !_used[v] && _layerRight[v] == layer && d <= _r )
+      {
+        _used[v] = true;
+        return v;
+      }
+    }
+
+    if( u < _n )
+    {
+      for( auto v = _layerIndices[layer].extract( _A[u].x, _A[u].y, _r ); v != npos; v = _layerIndices[layer].extract( _A[u].x, _A[u].y, _r ) )
+      {
+        if( !_used[v] )
+        {
+          _used[v] = true;
+          return v;
+        }
+      }
+    }
+    else
+    {
+      auto&& diagonal = _layerDiagonal[layer];
+
+      while( !diagonal.empty() )
+      {
+        auto v = diagonal.back();
+        diagonal.pop_back();
+
+        if( !_used[v] )
+        {
+          _used[v] = true;
+          return v;
+        }
+      }
+    }
+
+    return npos;
+  }
+
+  bool augment( std::size_t u )
+  {
+    for( auto v = this->nextNeighbour( u ); v != npos; v = this->nextNeighbour( u ) )
+    {
+      auto w = _mateRight[v];
+
+      if( ( w == npos && _layerRight[v] + 1 == _numLayers ) || ( w != npos && _layerLeft[w] == _layerLeft[u] + 1 && this->augment( w ) ) )
+      {
+        _mateLeft[u]  = v;
+        _mateRight[v] = u;
+
+        return true;
+      }
+    }
+
+    // Dead end; no other path needs to visit this vertex again
+    _layerLeft[u] = npos;
+    return false;
+  }
+
+  std::vector<Point> _A;
+  std::vector<Point> _B;
+
+  std::vector<T> _diagonalA;
+  std::vector<T> _diagonalB;
+
+  std::size_t _n;
+  std::size_t _m;
+
+  std::vector<std::size_t> _mateLeft;
+  std::vector<std::size_t> _mateRight;
+
+  /** Current radius, i.e. the maximum weight of an edge */
+  T _r = T();
+
+  // Layered graph -----------------------------------------------------
+
+  std::vector<std::size_t> _layerLeft;
+  std::vector<std::size_t> _layerRight;
+  std::size_t _numLayers = 0;
+
+  Index _index;
+
+  std::vector<std::size_t> _unvisitedDiagonal;
+
+  std::vector< Index >                    _layerIndices;
+  std::vector< std::vector<std::size_t> > _layerDiagonal;
+
+  std::vector<bool> _used;
+};
+
+template <class T> constexpr std::size_t BottleneckMatching<T>::npos;
+
+} // namespace detail
+
+} // namespace distances
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_ESSENTIAL_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_ESSENTIAL_HH__
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace aleph
+{
+
+namespace distances
+{
+
+namespace detail
+{
+
+/** @returns Positive infinity, or the maximum value if the data type does not support it */
+template <class DataType> DataType infinity()
+{
+  if( std::numeric_limits<DataType>::has_infinity )
+    return std::numeric_limits<DataType>::infinity();
+  else
+    return std::numeric_limits<DataType>::max();
+}
+
+/**
+  Classifies a coordinate of a point as either finite, positive infinite,
+  or negative infinite. The extreme values of data types that have no
+  infinity are treated as being infinite.
+*/
+
+template <class DataType> int classifyCoordinate( DataType x )
+{
+  if( ( std::numeric_limits<DataType>::has_infinity && x == std::numeric_limits<DataType>::infinity() ) || x == std::numeric_limits<DataType>::max() )
+    return 1;
+  else if( ( std::numeric_limits<DataType>::has_infinity && x == -std::numeric_limits<DataType>::infinity() ) || x == std::numeric_limits<DataType>::lowest() )
+    return -1;
+  else
+    return 0;
+}
+
+/** Checks whether both coordinates of a point are finite */
+template <class Point> bool isFinite( const Point& p )
+{
+  return classifyCoordinate( p.x() ) == 0 && classifyCoordinate( p.y() ) == 0;
+}
+
+/**
+  Matches the essential points of two persistence diagrams, i.e. points
+  with at least one infinite coordinate. Such points can only be matched
+  to points with the same type of infinite coordinates at finite costs.
+  Among them, sorting the finite coordinates yields an optimal matching
+  for the bottleneck distance and the Wasserstein distances alike.
+
+  @param D1 First persistence diagram
+  @param D2 Second persistence diagram
+  @param f  Functor that is called with the finite coordinates of every
+            matched pair of points; points whose coordinates are both
+            infinite are reported as a pair of zeroes
+
+  @returns false if the essential points cannot be matched, i.e. if the
+  matching distance is infinite
+*/
+
+template <class DataType, class Functor> bool matchEssentialPoints( const PersistenceDiagram<DataType>& D1,
+                                                                     const PersistenceDiagram<DataType>& D2,
+                                                                     Functor f )
+{
+  using Key = std::pair<int, int>;
+
+  auto collect = [] ( const PersistenceDiagram<DataType>& D )
+  {
+    std::map< Key, std::vector<DataType> > essential;
+
+    for( auto&& p : D )
+    {
+      auto key = std::make_pair( classifyCoordinate( p.x() ), classifyCoordinate( p.y() ) );
+
+      if( key.first == 0 && key.second == 0 )
+        continue;
+      else if( key.first != 0 && key.second != 0 )
+        essential[key].push_back( DataType() );
+      else
+        essential[key].push_back( key.first == 0 ? p.x() : p.y() );
+    }
+
+    for( auto&& pair : essential )
+      std::sort( pair.second.begin(), pair.second.end() );
+
+    return essential;
+  };
+
+  auto E1 = collect( D1 );
+  auto E2 = collect( D2 );
+
+  if( E1.size() != E2.size() )
+    return false;
+
+  for( auto it1 = E1.begin(), it2 = E2.begin(); it1 != E1.end(); ++it1, ++it2 )
+  {
+    if( it1->first != it2->first || it1->second.size() != it2->second.size() )
+      return false;
+  }
+
+  for( auto it1 = E1.begin(), it2 = E2.begin(); it1 != E1.end(); ++it1, ++it2 )
+  {
+    for( std::size_t i = 0; i < it1->second.size(); i++ )
+      f( it1->second[i], it2->second[i] );
+  }
+
+  return true;
+}
+
+} // namespace detail
+
+} // namespace distances
+
+} // namespace aleph
+
+#endif
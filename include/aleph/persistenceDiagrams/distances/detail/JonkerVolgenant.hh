@@ -0,0 +1,454 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_JONKER_VOLGENANT_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_JONKER_VOLGENANT_HH__
+
+#include <aleph/persistenceDiagrams/distances/detail/Matrix.hh>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+
+namespace aleph
+{
+
+namespace distances
+{
+
+namespace detail
+{
+
+/**
+  @class JonkerVolgenant
+  @brief Shortest augmenting path solver for the linear assignment problem
+
+  Solves the assignment problem of a square cost matrix with the method
+  by Jonker and Volgenant, i.e. column reduction, reduction transfer, and
+  augmenting row reduction, followed by Dijkstra-like shortest augmenting
+  paths with respect to the dual column prices. The solver requires \f$O(n^3)\f$
+  operations in the worst case but only traverses the rows of the cost
+  matrix linearly.
+
+  The interface of the class is compatible with the Munkres solver, so it
+  can be used as a drop-in replacement. The assignment is also available
+  directly, which avoids traversing a reduced matrix.
+
+  Forbidden assignments may be marked by the maximum value of the data
+  type (or by infinity). Internally, they are replaced by a penalty that
+  exceeds the costs of any assignment of finite entries, such that they
+  do not deteriorate the precision of the dual prices. Costs are stored
+  with at least double precision; for integral data types, a floating
+  point type is used in order to support unsigned costs.
+*/
+
+template <class T> class JonkerVolgenant
+{
+public:
+  using Index = std::size_t;
+
+  /** Value type for the dual prices and the reduced costs */
+  using Value = typename std::conditional< std::is_floating_point<T>::value,
+                                           typename std::common_type<T, double>::type,
+                                           long double >::type;
+
+  // Constructor -------------------------------------------------------
+
+  explicit JonkerVolgenant( const Matrix<T>& matrix )
+    : _matrix( matrix.n() )
+  {
+    auto n = matrix.n();
+
+    auto isForbidden = [] ( T x )
+    {
+      return x == std::numeric_limits<T>::max() || ( std::numeric_limits<T>::has_infinity && x == std::numeric_limits<T>::infinity() );
+    };
+
+    Value maximum = Value();
+
+    for( Index row = 0; row < n; row++ )
+    {
+      for( Index col = 0; col < n; col++ )
+      {
+        if( !isForbidden( matrix( row, col ) ) )
+          maximum = std::max( maximum, std::abs( static_cast<Value>( matrix( row, col ) ) ) );
+      }
+    }
+
+    auto penalty = 2 * static_cast<Value>( n ) * maximum + 1;
+
+    for( Index row = 0; row < n; row++ )
+    {
+      for( Index col = 0; col < n; col++ )
+        _matrix( row, col ) = isForbidden( matrix( row, col ) ) ? penalty : static_cast<Value>( matrix( row, col ) );
+    }
+  }
+
+  // Solver ------------------------------------------------------------
+
+  /**
+    Solves the assignment problem and returns a matrix in which assigned
+    entries are zero, whereas all other entries are set to the maximum
+    value of the data type. This mirrors the reduced matrix returned by
+    the Munkres solver.
+  */
+
+  Matrix<T> operator()()
+  {
+    this->solve();
+
+    auto n = _matrix.n();
+
+    Matrix<T> result( n );
+
+    for( Index row = 0; row < n; row++ )
+    {
+      for( Index col = 0; col < n; col++ )
+        result( row, col ) = col == _rowSolution[row] ? T( 0 ) : std::numeric_limits<T>::max();
+    }
+
+    return result;
+  }
+
+  /**
+    Solves the assignment problem (if this has not been done already) and
+    returns the assigned column of every row.
+  */
+
+  const std::vector<Index>& assignment()
+  {
+    if( _rowSolution.size() != _matrix.n() )
+      this->solve();
+
+    return _rowSolution;
+  }
+
+  /**
+    Calculates the costs of the assignment with respect to a matrix of
+    costs, which is usually the matrix the solver has been created with.
+  */
+
+  T cost( const Matrix<T>& costs ) const noexcept
+  {
+    if( costs.n() != _rowSolution.size() )
+    {
+      if( std::numeric_limits<T>::has_quiet_NaN )
+        return std::numeric_limits<T>::quiet_NaN();
+      else
+        return std::numeric_limits<T>::max();
+    }
+
+    T result = T();
+
+    for( Index row = 0; row < _rowSolution.size(); row++ )
+      result += costs( row, _rowSolution[row] );
+
+    return result;
+  }
+
+  /**
+    Stores the matching in an output iterator. The output iterator needs
+    to be able to handle pairs of indices. Pairs are ordered by row.
+  */
+
+  template <class OutputIterator> void matching( OutputIterator result ) const noexcept
+  {
+    for( Index row = 0; row < _rowSolution.size(); row++ )
+      *result++ = std::make_pair( row, _rowSolution[row] );
+  }
+
+private:
+
+  Value c( Index row, Index col ) const noexcept
+  {
+    return _matrix( row, col );
+  }
+
+  void solve()
+  {
+    auto n = _matrix.n();
+
+    _rowSolution.assign( n, npos );
+
+    if( n == 0 )
+      return;
+    else if( n == 1 )
+    {
+      _rowSolution.front() = 0;
+      return;
+    }
+
+    std::vector<Index> colSolution( n, npos );
+    std::vector<Value> v( n );
+
+    // Column reduction ------------------------------------------------
+    //
+    // Every column is assigned to the row that contains its minimum,
+    // unless said row has been assigned already. Columns are traversed
+    // in reverse order, as suggested by Jonker and Volgenant.
+
+    {
+      std::vector<Value> minimum( n, std::numeric_limits<Value>::max() );
+      std::vector<Index> argmin( n, 0 );
+
+      for( Index row = 0; row < n; row++ )
+      {
+        auto costs = _matrix.row( row );
+
+        for( Index col = 0; col < n; col++ )
+        {
+          auto value = costs[col];
+          if( value < minimum[col] )
+          {
+            minimum[col] = value;
+            argmin[col]  = row;
+          }
+        }
+      }
+
+      std::vector<unsigned> matches( n, 0 );
+
+      for( Index k = n; k-- > 0; )
+      {
+        auto row = argmin[k];
+        v[k]     = minimum[k];
+
+        if( ++matches[row] == 1 )
+        {
+          _rowSolution[row] = k;
+          colSolution[k]    = row;
+        }
+      }
+
+      // Reduction transfer --------------------------------------------
+      //
+      // Rows that have been assigned exactly once transfer their slack
+      // to the price of their column. Rows without any assignment are
+      // the free rows for the remaining phases.
+
+      _free.clear();
+
+      for( Index row = 0; row < n; row++ )
+      {
+        if( matches[row] == 0 )
+          _free.push_back( row );
+        else if( matches[row] == 1 )
+        {
+          auto j1  = _rowSolution[row];
+          auto min = std::numeric_limits<Value>::max();
+
+          for( Index col = 0; col < n; col++ )
+          {
+            if( col != j1 && c( row, col ) - v[col] < min )
+              min = c( row, col ) - v[col];
+          }
+
+          v[j1] -= min;
+        }
+      }
+    }
+
+    // Augmenting row reduction ----------------------------------------
+    //
+    // Free rows are assigned to the column with the minimum reduced cost
+    // and the price of the column is decreased as far as possible. This
+    // may evict another row, which is processed immediately if the price
+    // decreased strictly.
+
+    for( unsigned pass = 0; pass < 2; pass++ )
+    {
+      std::vector<Index> previous;
+      previous.swap( _free );
+
+      Index k = 0;
+
+      while( k < previous.size() )
+      {
+        auto row = previous[k++];
+
+        auto umin    = c( row, 0 ) - v[0];
+        auto usubmin = std::numeric_limits<Value>::max();
+        Index j1     = 0;
+        Index j2     = 0;
+
+        for( Index col = 1; col < n; col++ )
+        {
+          auto h = c( row, col ) - v[col];
+          if( h < usubmin )
+          {
+            if( h >= umin )
+            {
+              usubmin = h;
+              j2      = col;
+            }
+            else
+            {
+              usubmin = umin;
+              umin    = h;
+              j2      = j1;
+              j1      = col;
+            }
+          }
+        }
+
+        auto i0 = colSolution[j1];
+
+        if( umin < usubmin )
+          v[j1] -= usubmin - umin;
+        else if( i0 != npos )
+        {
+          j1 = j2;
+          i0 = colSolution[j2];
+        }
+
+        _rowSolution[row] = j1;
+        colSolution[j1]   = row;
+
+        if( i0 != npos )
+        {
+          _rowSolution[i0] = npos;
+
+          if( umin < usubmin )
+            previous[--k] = i0;
+          else
+            _free.push_back( i0 );
+        }
+      }
+    }
+
+    // Augmentation ----------------------------------------------------
+    //
+    // Every remaining free row is assigned by a shortest augmenting path
+    // with respect to the reduced costs. Columns are partitioned into a
+    // list of scanned columns, columns at the current minimum distance,
+    // and all remaining columns.
+
+    std::vector<Value> d( n );
+    std::vector<Index> predecessor( n );
+    std::vector<Index> columns( n );
+
+    for( auto freeRow : _free )
+    {
+      for( Index col = 0; col < n; col++ )
+      {
+        d[col]           = c( freeRow, col ) - v[col];
+        predecessor[col] = freeRow;
+        columns[col]     = col;
+      }
+
+      Index low  = 0;
+      Index up   = 0;
+      Index last = 0;
+      Index end  = npos;
+      Value min  = Value();
+
+      while( end == npos )
+      {
+        if( up == low )
+        {
+          last = low;
+          min  = d[columns[up++]];
+
+          for( Index k = up; k < n; k++ )
+          {
+            auto col = columns[k];
+            auto h   = d[col];
+
+            if( h <= min )
+            {
+              if( h < min )
+              {
+                up  = low;
+                min = h;
+              }
+
+              columns[k]    = columns[up];
+              columns[up++] = col;
+            }
+          }
+
+          for( Index k = low; k < up; k++ )
+          {
+            if( colSolution[columns[k]] == npos )
+            {
+              end = columns[k];
+              break;
+            }
+          }
+        }
+
+        if( end == npos )
+        {
+          auto j1  = columns[low++];
+          auto row = colSolution[j1];
+          auto h   = c( row, j1 ) - v[j1] - min;
+
+          auto costs = _matrix.row( row );
+
+          for( Index k = up; k < n; k++ )
+          {
+            auto col = columns[k];
+            auto v2  = costs[col] - v[col] - h;
+
+            if( v2 < d[col] )
+            {
+              predecessor[col] = row;
+
+              if( v2 == min )
+              {
+                if( colSolution[col] == npos )
+                {
+                  end = col;
+                  break;
+                }
+
+                columns[k]    = columns[up];
+                columns[up++] = col;
+              }
+
+              d[col] = v2;
+            }
+          }
+        }
+      }
+
+      // Update the prices of all columns that have been scanned, i.e.
+      // whose distance is final and smaller than the minimum.
+      for( Index k = 0; k < last; k++ )
+      {
+        auto col = columns[k];
+        v[col]  += d[col] - min;
+      }
+
+      // Augment the assignment along the alternating path
+      Index row = npos;
+
+      do
+      {
+        row                = predecessor[end];
+        colSolution[end]   = row;
+        std::swap( end, _rowSolution[row] );
+      }
+      while( row != freeRow );
+    }
+  }
+
+  static constexpr Index npos = std::numeric_limits<Index>::max();
+
+  /** Costs with forbidden assignments replaced by a finite penalty */
+  Matrix<Value> _matrix;
+
+  std::vector<Index> _rowSolution;
+  std::vector<Index> _free;
+};
+
+template <class T> constexpr typename JonkerVolgenant<T>::Index JonkerVolgenant<T>::npos;
+
+} // namespace detail
+
+} // namespace distances
+
+} // namespace aleph
+
+#endif
@@ -17,40 +17,35 @@ namespace distances
 namespace detail
 {
 
+/**
+  @class Matrix
+  @brief Square matrix for assignment problems
+
+  Stores the entries in a single contiguous array in row-major order,
+  such that every row can be traversed linearly by the solvers.
+*/
+
 template <class T> class Matrix
 {
 public:
 
   explicit Matrix( std::size_t n )
     : _n( n )
-    , _data( new T*[_n] )
+    , _data( new T[_n * _n] )
   {
-    for( std::size_t row = 0; row < _n; row ++ )
-    {
-      _data[row] = new T[_n];
-
-      std::fill( _data[row], _data[row] + _n, T() );
-    }
+    std::fill( _data, _data + _n * _n, T() );
   }
 
   ~Matrix()
   {
-    for( std::size_t row = 0; row < _n; row++ )
-      delete[] _data[row];
-
     delete[] _data;
   }
 
   Matrix( const Matrix& other )
     : _n( other._n )
-    , _data( new T*[_n] )
+    , _data( new T[_n * _n] )
   {
-    for( std::size_t row = 0; row < _n; row ++ )
-    {
-      _data[row] = new T[_n];
-
-      std::copy( other._data[row], other._data[row] + _n, _data[row] );
-    }
+    std::copy( other._data, other._data + _n * _n, _data );
   }
 
   Matrix( Matrix&& other )
@@ -88,13 +83,21 @@ public:
     assert( row    < _n );
     assert( column < _n );
 
-    return _data[row][column];
+    return _data[row * _n + column];
+  }
+
+  /** @returns Pointer to the first entry of a row */
+  const T* row( std::size_t row ) const
+  {
+    assert( row < _n );
+
+    return _data + row * _n;
   }
 
 private:
 
   std::size_t _n = 0;
-  T** _data      = nullptr;
+  T* _data       = nullptr;
 };
 
 template <class T> std::ostream& operator<<( std::ostream& o, const Matrix<T>& m )
@@ -0,0 +1,78 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_PREPARED_DIAGRAM_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_DISTANCES_DETAIL_PREPARED_DIAGRAM_HH__
+
+#include <aleph/geometry/distances/Infinity.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/detail/Essential.hh>
+#include <aleph/persistenceDiagrams/distances/detail/Orthogonal.hh>
+
+#include <vector>
+
+namespace aleph
+{
+
+namespace distances
+{
+
+namespace detail
+{
+
+/**
+  @class PreparedDiagram
+  @brief Persistence diagram prepared for geometric matchings
+
+  Stores the finite points of a persistence diagram along with their
+  infinity distance to the diagonal and a kd-tree of the points. The
+  essential points are kept in a separate persistence diagram of the
+  same dimension. None of this depends on the diagram to which the
+  diagram is compared, so it only has to be calculated once when many
+  pairs of diagrams are compared.
+
+  @tparam T     Data type of the persistence diagram
+  @tparam Index kd-tree of the finite points, e.g. a `PointIndex`
+*/
+
+template <class T, class Index> struct PreparedDiagram
+{
+  using Point = typename Index::Point;
+
+  std::vector<Point> points;
+  std::vector<T>     diagonal;
+
+  Index index;
+
+  PersistenceDiagram<T> essential;
+};
+
+/** Prepares a persistence diagram for geometric matchings */
+template <class T, class Index> PreparedDiagram<T, Index> prepareDiagram( const PersistenceDiagram<T>& D )
+{
+  using Distance = aleph::geometry::distances::InfinityDistance<T>;
+
+  PreparedDiagram<T, Index> result;
+  result.essential.setDimension( D.dimension() );
+
+  for( auto&& p : D )
+  {
+    if( isFinite( p ) )
+    {
+      result.points.push_back( { p.x(), p.y(), result.points.size() } );
+      result.diagonal.push_back( orthogonalDistance<Distance>( p ) );
+    }
+    else
+      result.essential.add( p.x(), p.y() );
+  }
+
+  result.index = Index( result.points );
+  return result;
+}
+
+} // namespace detail
+
+} // namespace distances
+
+} // namespace aleph
+
+#endif
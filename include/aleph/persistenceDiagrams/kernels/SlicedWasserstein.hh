@@ -0,0 +1,265 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_KERNELS_SLICED_WASSERSTEIN_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_KERNELS_SLICED_WASSERSTEIN_HH__
+
+#include <aleph/geometry/distances/Kernels.hh>
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <aleph/persistenceDiagrams/PairwiseMatrix.hh>
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/detail/Essential.hh>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cmath>
+
+namespace aleph
+{
+
+/**
+  @class SlicedWasserstein
+  @brief Sliced Wasserstein distance and kernel for persistence diagrams
+
+  The sliced Wasserstein distance projects the points of two persistence
+  diagrams, together with the diagonal projections of the points of the
+  respective other diagram, onto a set of lines through the origin. For
+  every line, the 1-Wasserstein distance of the projected point sets is
+  calculated by matching sorted values. The distance is the average over
+  all directions, which are spaced uniformly in \f$[-\pi/2, \pi/2)\f$.
+  The kernel is defined as \f$\exp(-SW(D_1, D_2) / (2\sigma^2))\f$.
+
+  Since the projections of a diagram do not depend on the other diagram,
+  they are calculated and sorted once by prepare(). Afterwards, every pair
+  of diagrams only requires merging sorted lists for every direction. The
+  class may be used as a functor for pairwiseMatrix().
+
+  Points with infinite coordinates are ignored.
+
+  @see https://arxiv.org/abs/1706.03358 (the original paper by Carrière et al.)
+*/
+
+template <class T> class SlicedWasserstein
+{
+public:
+
+  /**
+    Sorted projections of a persistence diagram onto all directions. The
+    values are stored contiguously, direction by direction.
+  */
+
+  struct Projections
+  {
+    /** Number of points of the persistence diagram */
+    std::size_t size = 0;
+
+    /** Projections of the points */
+    std::vector<double> points;
+
+    /** Projections of the diagonal projections of the points */
+    std::vector<double> diagonal;
+  };
+
+  /**
+    Creates the functor for a given number of directions and a smoothing
+    parameter of the kernel. More directions yield a better approximation
+    of the integral over all directions, at linear costs.
+
+    @throws std::runtime_error if the number of directions is zero or the
+    smoothing parameter is not positive
+  */
+
+  explicit SlicedWasserstein( unsigned directions = 10, double sigma = 1.0 )
+    : _sigma( sigma )
+  {
+    if( directions == 0 )
+      throw std::runtime_error( "Number of directions must be positive" );
+
+    if( !( sigma > 0.0 ) )
+      throw std::runtime_error( "Smoothing parameter must be positive" );
+
+    _cos.reserve( directions );
+    _sin.reserve( directions );
+
+    for( unsigned k = 0; k < directions; k++ )
+    {
+      auto theta = -M_PI / 2 + M_PI * k / directions;
+
+      _cos.push_back( std::cos( theta ) );
+      _sin.push_back( std::sin( theta ) );
+    }
+  }
+
+  /** Calculates the sorted projections of a persistence diagram */
+  Projections prepare( const PersistenceDiagram<T>& D ) const
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+
+    for( auto&& p : D )
+    {
+      if( distances::detail::isFinite( p ) )
+      {
+        x.push_back( static_cast<double>( p.x() ) );
+        y.push_back( static_cast<double>( p.y() ) );
+      }
+    }
+
+    Projections result;
+    result.size = x.size();
+    result.points.reserve( x.size() * _cos.size() );
+    result.diagonal.reserve( x.size() * _cos.size() );
+
+    for( std::size_t k = 0; k < _cos.size(); k++ )
+    {
+      auto pointsBegin   = result.points.size();
+      auto diagonalBegin = result.diagonal.size();
+
+      for( std::size_t i = 0; i < x.size(); i++ )
+      {
+        result.points.push_back( _cos[k] * x[i] + _sin[k] * y[i] );
+        result.diagonal.push_back( ( _cos[k] + _sin[k] ) * ( x[i] + y[i] ) / 2 );
+      }
+
+      std::sort( result.points.begin()   + static_cast<long>( pointsBegin ),   result.points.end() );
+      std::sort( result.diagonal.begin() + static_cast<long>( diagonalBegin ), result.diagonal.end() );
+    }
+
+    return result;
+  }
+
+  /**
+    Calculates the sliced Wasserstein distance between two prepared
+    diagrams. The merged projections are stored in buffers that every
+    thread allocates only once, and their differences are summed by the
+    vectorized Manhattan distance kernel.
+  */
+
+  double distance( const Projections& P, const Projections& Q ) const
+  {
+    auto n = P.size + Q.size;
+
+    static thread_local std::vector<double> a;
+    static thread_local std::vector<double> b;
+
+    if( a.size() < n )
+    {
+      a.resize( n );
+      b.resize( n );
+    }
+
+    double result = 0.0;
+
+    for( std::size_t k = 0; k < _cos.size(); k++ )
+    {
+      auto p  = P.points.begin()   + static_cast<long>( k * P.size );
+      auto q  = Q.points.begin()   + static_cast<long>( k * Q.size );
+      auto dp = P.diagonal.begin() + static_cast<long>( k * P.size );
+      auto dq = Q.diagonal.begin() + static_cast<long>( k * Q.size );
+
+      // Every diagram is extended by the diagonal projections of the
+      // other diagram, which results in point sets of equal size.
+      std::merge( p, p + static_cast<long>( P.size ), dq, dq + static_cast<long>( Q.size ), a.begin() );
+      std::merge( q, q + static_cast<long>( Q.size ), dp, dp + static_cast<long>( P.size ), b.begin() );
+
+      result += geometry::distances::kernels::manhattan( a.data(), b.data(), n );
+    }
+
+    return result / static_cast<double>( _cos.size() );
+  }
+
+  /** Calculates the sliced Wasserstein distance between two persistence diagrams */
+  double distance( const PersistenceDiagram<T>& D1, const PersistenceDiagram<T>& D2 ) const
+  {
+    return this->distance( this->prepare( D1 ), this->prepare( D2 ) );
+  }
+
+  /** Calculates the sliced Wasserstein kernel between two prepared diagrams */
+  double operator()( const Projections& P, const Projections& Q ) const
+  {
+    return std::exp( -this->distance( P, Q ) / ( 2 * _sigma * _sigma ) );
+  }
+
+  /** Calculates the sliced Wasserstein kernel between two persistence diagrams */
+  double operator()( const PersistenceDiagram<T>& D1, const PersistenceDiagram<T>& D2 ) const
+  {
+    return this->operator()( this->prepare( D1 ), this->prepare( D2 ) );
+  }
+
+private:
+
+  /** Smoothing parameter of the kernel */
+  double _sigma;
+
+  /** Cosines of all directions */
+  std::vector<double> _cos;
+
+  /** Sines of all directions */
+  std::vector<double> _sin;
+};
+
+/**
+  Calculates the sliced Wasserstein distance between two persistence
+  diagrams.
+
+  @param D1         First persistence diagram
+  @param D2         Second persistence diagram
+  @param directions Number of directions for approximating the integral
+
+  @returns Sliced Wasserstein distance
+*/
+
+template <class T> double slicedWassersteinDistance( const PersistenceDiagram<T>& D1,
+                                                     const PersistenceDiagram<T>& D2,
+                                                     unsigned directions = 10 )
+{
+  return SlicedWasserstein<T>( directions ).distance( D1, D2 );
+}
+
+/**
+  Calculates the sliced Wasserstein kernel between two persistence
+  diagrams.
+
+  @param D1         First persistence diagram
+  @param D2         Second persistence diagram
+  @param sigma      Smoothing parameter
+  @param directions Number of directions for approximating the integral
+
+  @returns Kernel value
+*/
+
+template <class T> double slicedWassersteinKernel( const PersistenceDiagram<T>& D1,
+                                                   const PersistenceDiagram<T>& D2,
+                                                   double sigma,
+                                                   unsigned directions = 10 )
+{
+  return SlicedWasserstein<T>( directions, sigma )( D1, D2 );
+}
+
+/**
+  Calculates the Gram matrix of the sliced Wasserstein kernel for a set
+  of persistence diagrams. The projections of every diagram are sorted
+  once, and all pairs are evaluated in parallel.
+
+  @param diagrams   Persistence diagrams
+  @param sigma      Smoothing parameter
+  @param directions Number of directions for approximating the integral
+  @param checkpoint Optional checkpoint file (see pairwiseMatrix())
+
+  @returns Gram matrix
+*/
+
+template <class T> math::SymmetricMatrix<double> slicedWassersteinKernelMatrix( const std::vector< PersistenceDiagram<T> >& diagrams,
+                                                                                double sigma,
+                                                                                unsigned directions = 10,
+                                                                                const std::string& checkpoint = std::string() )
+{
+  return pairwiseMatrix( diagrams, SlicedWasserstein<T>( directions, sigma ), checkpoint );
+}
+
+} // namespace aleph
+
+#endif
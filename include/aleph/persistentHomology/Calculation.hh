@@ -9,6 +9,7 @@
 #include <aleph/persistentHomology/PersistencePairing.hh>
 
 #include <aleph/topology/Conversions.hh>
+#include <aleph/topology/FlatSimplicialComplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
 #include <algorithm>
@@ -145,6 +146,31 @@ template <
   return pairing;
 }
 
+namespace detail
+{
+
+/**
+  Calculates a set of persistence diagrams from any simplicial complex
+  that supports the conversion to a boundary matrix. This contains the
+  shared implementation of all public overloads.
+*/
+
+template <
+  class ReductionAlgorithm,
+  class Representation,
+  class Complex
+> std::vector< PersistenceDiagram<typename Complex::ValueType::DataType> > calculatePersistenceDiagrams( const Complex& K, bool dualize, bool includeAllUnpairedCreators )
+{
+  using namespace topology;
+
+  auto boundaryMatrix = makeBoundaryMatrix<Representation>( K );
+  auto pairing        = calculatePersistencePairing<ReductionAlgorithm>( dualize ? boundaryMatrix.dualize() : boundaryMatrix, includeAllUnpairedCreators );
+
+  return makePersistenceDiagrams( pairing, K );
+}
+
+} // namespace detail
+
 /**
   Calculates a set of persistence diagrams from a simplicial complex in
   filtration order, while permitting some additional parameters. Notice
@@ -170,12 +196,22 @@ template <
   class Simplex
 > std::vector< PersistenceDiagram<typename Simplex::DataType> > calculatePersistenceDiagrams( const topology::SimplicialComplex<Simplex>& K, bool dualize = true, bool includeAllUnpairedCreators = false )
 {
-  using namespace topology;
+  return detail::calculatePersistenceDiagrams<ReductionAlgorithm, Representation>( K, dualize, includeAllUnpairedCreators );
+}
 
-  auto boundaryMatrix = makeBoundaryMatrix<Representation>( K );
-  auto pairing        = calculatePersistencePairing<ReductionAlgorithm>( dualize ? boundaryMatrix.dualize() : boundaryMatrix, includeAllUnpairedCreators );
+/**
+  Calculates a set of persistence diagrams from a flat simplicial
+  complex in filtration order. The parameters are the same as for the
+  default simplicial complex.
+*/
 
-  return makePersistenceDiagrams( pairing, K );
+template <
+  class ReductionAlgorithm = defaults::ReductionAlgorithm,
+  class Representation     = defaults::Representation,
+  class Simplex
+> std::vector< PersistenceDiagram<typename Simplex::DataType> > calculatePersistenceDiagrams( const topology::FlatSimplicialComplex<Simplex>& K, bool dualize = true, bool includeAllUnpairedCreators = false )
+{
+  return detail::calculatePersistenceDiagrams<ReductionAlgorithm, Representation>( K, dualize, includeAllUnpairedCreators );
 }
 
 /**
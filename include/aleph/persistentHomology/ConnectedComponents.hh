@@ -5,15 +5,26 @@
 
 #include <aleph/persistentHomology/PersistencePairing.hh>
 
+#include <aleph/topology/DenseUnionFind.hh>
 #include <aleph/topology/SimplicialComplex.hh>
-#include <aleph/topology/UnionFind.hh>
 
 #include <aleph/utilities/EmptyFunctor.hh>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
 namespace aleph
 {
 
@@ -88,121 +99,401 @@ public:
 
 } // namespace traits
 
+namespace detail
+{
+
 /**
-  Calculates zero-dimensional persistent homology, i.e. tracking of connected
-  components, for a given simplicial complex. This is highly-efficient, as it
-  only requires a suitable 'Union--Find' data structure.
+  Maps vertices of a simplicial complex to consecutive positions. If the
+  vertices are sufficiently dense, a lookup table is used. Otherwise, the
+  vertices are searched in a sorted array.
+*/
 
-  As usual, the function assumes that the simplicial complex is in filtration
-  order, meaning that faces are preceded by their cofaces. The function won't
-  check this, though!
+template <class VertexType> class VertexPositions
+{
+public:
+
+  /** Marker for unknown vertices */
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  explicit VertexPositions( const std::vector<VertexType>& vertices )
+  {
+    std::size_t maximum = 0;
+
+    // Negative vertices are converted to large values, so they will
+    // always be handled by the sorted array.
+    for( auto&& vertex : vertices )
+      maximum = std::max( maximum, static_cast<std::size_t>( vertex ) );
+
+    if( maximum < 8 * vertices.size() + 1024 )
+    {
+      _table.assign( maximum + 1, npos );
+
+      for( std::size_t i = 0; i < vertices.size(); i++ )
+        _table[ static_cast<std::size_t>( vertices[i] ) ] = i;
+    }
+    else
+    {
+      _sorted.reserve( vertices.size() );
+
+      for( std::size_t i = 0; i < vertices.size(); i++ )
+        _sorted.push_back( std::make_pair( vertices[i], i ) );
+
+      std::sort( _sorted.begin(), _sorted.end() );
+    }
+  }
+
+  /** @returns Position of a vertex, or npos if the vertex is unknown */
+  std::size_t operator()( VertexType vertex ) const
+  {
+    if( !_table.empty() )
+    {
+      auto index = static_cast<std::size_t>( vertex );
+      return index < _table.size() ? _table[index] : npos;
+    }
+
+    auto it = std::lower_bound( _sorted.begin(), _sorted.end(), std::make_pair( vertex, std::size_t(0) ) );
+
+    if( it != _sorted.end() && it->first == vertex )
+      return it->second;
+    else
+      return npos;
+  }
+
+private:
+  std::vector<std::size_t> _table;
+  std::vector< std::pair<VertexType, std::size_t> > _sorted;
+};
+
+template <class VertexType> constexpr std::size_t VertexPositions<VertexType>::npos;
+
+/**
+  Selects the edges of the minimum spanning forest of a graph, using the
+  order of the edges as their weights. These are exactly the edges that
+  merge two connected components when the edges are traversed in order.
+
+  The forest is calculated in parallel by Borůvka's algorithm: in every
+  round, all edges are scanned concurrently in order to find the first
+  edge leaving each component, after which these edges are merged.
+
+  @param n     Number of vertices
+  @param edges Edges, described by the positions of their vertices
+
+  @returns Flags indicating which edges belong to the forest
+*/
+
+inline std::vector<char> minimumSpanningForest( std::size_t n, const std::vector< std::pair<std::size_t, std::size_t> >& edges )
+{
+  constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  topology::DenseUnionFind<std::size_t> uf( n );
+
+  std::vector<char> forest( edges.size() );
+  std::vector<std::size_t> components( n );
+  std::vector< std::atomic<std::size_t> > cheapest( n );
+
+  auto numEdges = static_cast<long>( edges.size() );
+  bool merged   = true;
+
+  while( merged )
+  {
+    merged = false;
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      components[i] = uf.find( i );
+      cheapest[i].store( npos, std::memory_order_relaxed );
+    }
+
+    #pragma omp parallel for schedule(static)
+    for( long e = 0; e < numEdges; e++ )
+    {
+      auto edge = static_cast<std::size_t>( e );
+      auto cu   = components[ edges[edge].first ];
+      auto cv   = components[ edges[edge].second ];
+
+      if( cu == cv )
+        continue;
+
+      for( auto c : { cu, cv } )
+      {
+        auto current = cheapest[c].load( std::memory_order_relaxed );
+
+        while( edge < current && !cheapest[c].compare_exchange_weak( current, edge, std::memory_order_relaxed ) )
+        {
+        }
+      }
+    }
+
+    for( std::size_t c = 0; c < n; c++ )
+    {
+      auto edge = cheapest[c].load( std::memory_order_relaxed );
+
+      if( edge == npos )
+        continue;
+
+      auto u = uf.find( edges[edge].first );
+      auto v = uf.find( edges[edge].second );
+
+      // Two components may select the same edge
+      if( u != v )
+      {
+        uf.merge( u, v );
+
+        forest[edge] = true;
+        merged       = true;
+      }
+    }
+  }
+
+  return forest;
+}
+
+/**
+  Implementation of zero-dimensional persistent homology calculations.
+  Vertices are mapped to consecutive positions in order to use a dense
+  Union--Find data structure. Since the structure does not merge sets
+  in a directional manner, the oldest vertex of every set is tracked
+  separately.
+
+  @param K        Simplicial complex in filtration order
+  @param functor  Functor for reporting merges
+  @param parallel Flag indicating whether the edges that merge components
+                  should be determined in parallel
 */
 
 template <
   class Simplex,
-  class PairingCalculationTraits = traits::NoPersistencePairingCalculation< PersistencePairing<typename Simplex::VertexType> >,
-  class ElementCalculationTraits = traits::NoDiagonalElementCalculation,
-  class Functor = aleph::utilities::EmptyFunctor
+  class PairingCalculationTraits,
+  class ElementCalculationTraits,
+  class Functor
 >
   std::tuple<
     PersistenceDiagram<typename Simplex::DataType>,
     PersistencePairing<typename Simplex::VertexType>
   >
-calculateZeroDimensionalPersistenceDiagram( const topology::SimplicialComplex<Simplex>& K, Functor&& functor = Functor() )
+calculateZeroDimensionalPersistenceDiagram( const topology::SimplicialComplex<Simplex>& K, Functor&& functor, bool parallel )
 {
   using DataType   = typename Simplex::DataType;
   using VertexType = typename Simplex::VertexType;
 
-  using namespace topology;
-
-  std::vector<VertexType> vertices;
-  K.vertices( std::back_inserter( vertices ) );
-
-  UnionFind<VertexType> uf( vertices.begin(), vertices.end() );
   PersistenceDiagram<DataType> pd;                               // Persistence diagram
   PersistencePairing<VertexType> pp;                             // Persistence pairing
 
   PairingCalculationTraits ct( pp );
   ElementCalculationTraits et;
 
-  for( auto&& vertex : vertices )
-    functor.initialize( vertex );
+  // Vertices of the complex in filtration order, along with their index
+  // in the filtration
+  std::vector<VertexType> vertices;
+  std::vector<std::size_t> indices;
 
-  for( auto&& simplex : K )
   {
-    // Only edges can destroy a component; we may safely skip any other
-    // simplex with a different dimension.
-    if( simplex.dimension() != 1 )
-      continue;
+    std::size_t index = 0;
+
+    for( auto&& simplex : K )
+    {
+      if( simplex.dimension() == 0 )
+      {
+        vertices.push_back( *simplex.begin() );
+        indices.push_back( index );
+      }
+
+      ++index;
+    }
+  }
 
-    // Prepare component destruction -----------------------------------
+  {
+    auto sortedVertices = vertices;
+    std::sort( sortedVertices.begin(), sortedVertices.end() );
 
-    VertexType u = *( simplex.begin() );
-    VertexType v = *( simplex.begin() + 1 );
+    for( auto&& vertex : sortedVertices )
+      functor.initialize( vertex );
+  }
 
-    auto youngerComponent = uf.find( u );
-    auto olderComponent   = uf.find( v );
+  VertexPositions<VertexType> positions( vertices );
+
+  auto getPosition = [&positions] ( VertexType vertex )
+  {
+    auto position = positions( vertex );
+
+    if( position == VertexPositions<VertexType>::npos )
+      throw std::runtime_error( "Edge vertex is not part of the simplicial complex" );
+
+    return position;
+  };
+
+  topology::DenseUnionFind<std::size_t> uf( vertices.size() );
+
+  // Oldest vertex, i.e. the creator, of every set, which is only valid
+  // for the root of each set.
+  std::vector<std::size_t> oldest( vertices.size() );
+  std::iota( oldest.begin(), oldest.end(), std::size_t(0) );
+
+  auto processEdge = [&] ( std::size_t pu, std::size_t pv, const Simplex& edge, std::size_t index )
+  {
+    auto ru = uf.find( pu );
+    auto rv = uf.find( pv );
 
     // If the component has already been merged by some other edge, we are
     // not interested in it any longer.
-    if( youngerComponent == olderComponent )
-      continue;
+    if( ru == rv )
+      return;
 
-    // Ensures that the younger component is always the first component. A
-    // component is younger if it its parent vertex precedes the other one
-    // in the current filtration.
-    auto uIndex = K.index( Simplex( youngerComponent ) );
-    auto vIndex = K.index( Simplex( olderComponent ) );
+    auto younger = oldest[ru];
+    auto older   = oldest[rv];
 
     // The younger component must have the _larger_ index as it is born
     // _later_ in the filtration.
-    if( uIndex < vIndex )
-    {
-      std::swap( youngerComponent, olderComponent );
-      std::swap( uIndex, vIndex );
-    }
+    if( indices[younger] < indices[older] )
+      std::swap( younger, older );
 
-    auto creation    = K[uIndex].data();
-    auto destruction = simplex.data();
+    auto creation    = K[ indices[younger] ].data();
+    auto destruction = edge.data();
 
-    uf.merge( youngerComponent, olderComponent );
+    oldest[ uf.merge( ru, rv ) ] = older;
 
-    functor( youngerComponent,
-             olderComponent,
+    functor( vertices[younger],
+             vertices[older],
              creation,
              destruction,
-             u,
-             v );
+             vertices[pu],
+             vertices[pv] );
 
     if( et( creation, destruction ) )
     {
-      pd.add( creation                         , destruction                                   );
-      ct.add( static_cast<VertexType>( uIndex ), static_cast<VertexType>( K.index( simplex ) ) );
+      pd.add( creation                                   , destruction                      );
+      ct.add( static_cast<VertexType>( indices[younger] ), static_cast<VertexType>( index ) );
+    }
+  };
+
+  if( !parallel )
+  {
+    std::size_t index = 0;
+
+    for( auto&& simplex : K )
+    {
+      // Only edges can destroy a component; we may safely skip any other
+      // simplex with a different dimension.
+      if( simplex.dimension() == 1 )
+        processEdge( getPosition( *( simplex.begin() ) ), getPosition( *( simplex.begin() + 1 ) ), simplex, index );
+
+      ++index;
     }
   }
+  else
+  {
+    std::vector< std::pair<std::size_t, std::size_t> > edges;
+    std::vector<std::size_t> edgeIndices;
+
+    {
+      std::size_t index = 0;
+
+      for( auto&& simplex : K )
+      {
+        if( simplex.dimension() == 1 )
+        {
+          edges.push_back( std::make_pair( getPosition( *( simplex.begin() ) ), getPosition( *( simplex.begin() + 1 ) ) ) );
+          edgeIndices.push_back( index );
+        }
+
+        ++index;
+      }
+    }
+
+    // Only the edges of the forest merge components, so the remaining
+    // edges may be skipped.
+    auto forest = minimumSpanningForest( vertices.size(), edges );
+
+    for( std::size_t e = 0; e < edges.size(); e++ )
+      if( forest[e] )
+        processEdge( edges[e].first, edges[e].second, K[ edgeIndices[e] ], edgeIndices[e] );
+  }
 
   // Store information about unpaired simplices ------------------------
   //
   // All components in the Union--Find data structure now correspond to
   // essential 0-dimensional homology classes of the input complex.
 
-  std::vector<VertexType> roots;
+  std::vector<std::size_t> roots;
   uf.roots( std::back_inserter( roots ) );
 
+  // The roots are enumerated by their position, which need not coincide
+  // with the filtration order of the creators of their components.
+  std::sort( roots.begin(), roots.end(),
+             [&indices, &oldest] ( std::size_t r, std::size_t s )
+             {
+               return indices[ oldest[r] ] < indices[ oldest[s] ];
+             } );
+
   for( auto&& root : roots )
   {
-    auto creator = *K.find( Simplex( root ) );
+    auto creator = oldest[root];
+    auto data    = K[ indices[creator] ].data();
 
-    pd.add( creator.data()                                );
-    ct.add( static_cast<VertexType>( K.index( creator ) ) );
+    pd.add( data                                       );
+    ct.add( static_cast<VertexType>( indices[creator] ) );
 
-    functor( root,
-             creator.data() );
+    functor( vertices[creator],
+             data );
   }
 
   return std::make_tuple( pd, pp );
 }
 
+} // namespace detail
+
+/**
+  Calculates zero-dimensional persistent homology, i.e. tracking of connected
+  components, for a given simplicial complex. This is highly-efficient, as it
+  only requires a suitable 'Union--Find' data structure.
+
+  As usual, the function assumes that the simplicial complex is in filtration
+  order, meaning that faces are preceded by their cofaces. The function won't
+  check this, though!
+
+  Essential classes are reported in the filtration order of their creators.
+*/
+
+template <
+  class Simplex,
+  class PairingCalculationTraits = traits::NoPersistencePairingCalculation< PersistencePairing<typename Simplex::VertexType> >,
+  class ElementCalculationTraits = traits::NoDiagonalElementCalculation,
+  class Functor = aleph::utilities::EmptyFunctor
+>
+  std::tuple<
+    PersistenceDiagram<typename Simplex::DataType>,
+    PersistencePairing<typename Simplex::VertexType>
+  >
+calculateZeroDimensionalPersistenceDiagram( const topology::SimplicialComplex<Simplex>& K, Functor&& functor = Functor() )
+{
+  return detail::calculateZeroDimensionalPersistenceDiagram<Simplex, PairingCalculationTraits, ElementCalculationTraits>( K, std::forward<Functor>( functor ), false );
+}
+
+/**
+  Parallel variant of zero-dimensional persistent homology calculations.
+  The edges that merge two components are determined in parallel by
+  calculating a minimum spanning forest. Afterwards, only these edges
+  are processed sequentially, resulting in the same diagram, pairing,
+  and sequence of functor calls as the sequential variant.
+*/
+
+template <
+  class Simplex,
+  class PairingCalculationTraits = traits::NoPersistencePairingCalculation< PersistencePairing<typename Simplex::VertexType> >,
+  class ElementCalculationTraits = traits::NoDiagonalElementCalculation,
+  class Functor = aleph::utilities::EmptyFunctor
+>
+  std::tuple<
+    PersistenceDiagram<typename Simplex::DataType>,
+    PersistencePairing<typename Simplex::VertexType>
+  >
+calculateZeroDimensionalPersistenceDiagramParallel( const topology::SimplicialComplex<Simplex>& K, Functor&& functor = Functor() )
+{
+  return detail::calculateZeroDimensionalPersistenceDiagram<Simplex, PairingCalculationTraits, ElementCalculationTraits>( K, std::forward<Functor>( functor ), true );
+}
+
 } // namespace aleph
 
+#pragma GCC diagnostic pop
+
 #endif
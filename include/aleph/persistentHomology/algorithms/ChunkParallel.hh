@@ -0,0 +1,300 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_CHUNK_PARALLEL_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_CHUNK_PARALLEL_HH__
+
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace persistentHomology
+{
+
+namespace algorithms
+{
+
+/**
+  @class ChunkParallel
+  @brief Multi-threaded boundary matrix reduction
+
+  Splits the columns of a boundary matrix into contiguous chunks and
+  reduces every chunk locally and in parallel, processing dimensions in
+  decreasing order as in the `Twist` algorithm. A column is reduced
+  locally as long as its pivot lies within its own chunk. Since pivots
+  of a boundary matrix always precede their columns, such a pivot can
+  only be shared with another column of the same chunk, so the pivot is
+  final. A sequential pass afterwards finishes all remaining columns.
+
+  The algorithm only ever adds columns to columns on their right, so the
+  pivots of the reduced matrix, and hence the persistence pairing, are
+  identical to the ones obtained by `Twist`. Matrices whose pivots do
+  not precede their columns are reduced by `Twist` directly.
+
+  The local phase operates on copies of the columns, so every boundary
+  matrix representation may be used, regardless of whether it permits
+  concurrent modifications.
+
+  The approach follows the chunk algorithm that is described in:
+
+  > Clear and Compress: Computing Persistent Homology in Chunks
+  > Ulrich Bauer, Michael Kerber, Jan Reininghaus
+  > Topological Methods in Data Analysis and Visualization III, 2014
+*/
+
+class ChunkParallel
+{
+public:
+
+  /**
+    Creates a new instance of the reduction algorithm.
+
+    @param numChunks Number of chunks for the local reduction phase. If
+                     set to zero, four chunks per available thread will
+                     be used.
+  */
+
+  explicit ChunkParallel( std::size_t numChunks = 0 )
+    : _numChunks( numChunks )
+  {
+  }
+
+  template <class Representation> void operator()( topology::BoundaryMatrix<Representation>& M )
+  {
+    using Index = typename Representation::Index;
+
+    auto dimension  = M.getDimension();
+    auto numColumns = M.getNumColumns();
+    auto n          = static_cast<std::size_t>( numColumns );
+
+    for( Index j = 0; j < numColumns; j++ )
+    {
+      Index i;
+      bool valid = false;
+
+      std::tie( i, valid ) = M.getMaximumIndex( j );
+
+      if( valid && i >= j )
+      {
+        Twist twist;
+        twist( M );
+        return;
+      }
+    }
+
+    auto boundaries = this->getChunkBoundaries( n );
+    auto numChunks  = boundaries.size() - 1;
+
+    std::vector< std::pair<Index, bool> > lut( n, std::make_pair(0, false) );
+
+    // Local copies of columns that are being reduced in the local phase;
+    // modified columns are stored back afterwards.
+    std::vector< std::vector<Index> > columns( n );
+    std::vector<char> modified( n );
+    std::vector<char> reduced( n );
+
+    // Columns that may be cleared because their index is a pivot; this
+    // is stored per chunk in order to avoid synchronization.
+    std::vector< std::vector<Index> > cleared( numChunks );
+
+    for( Index d = dimension; d >= 1; d-- )
+    {
+      #pragma omp parallel for schedule(dynamic)
+      for( long c = 0; c < static_cast<long>( numChunks ); c++ )
+      {
+        auto chunk = static_cast<std::size_t>( c );
+
+        this->reduceChunk( M, d,
+                           static_cast<Index>( boundaries[chunk] ),
+                           static_cast<Index>( boundaries[chunk+1] ),
+                           lut,
+                           columns,
+                           modified,
+                           reduced,
+                           cleared[chunk] );
+      }
+
+      for( std::size_t j = 0; j < n; j++ )
+      {
+        if( modified[j] )
+        {
+          M.setColumn( Index(j), columns[j].begin(), columns[j].end() );
+          M.setDimension( Index(j), d );
+        }
+
+        if( !columns[j].empty() )
+          std::vector<Index>().swap( columns[j] );
+
+        modified[j] = false;
+      }
+
+      for( auto&& indices : cleared )
+      {
+        for( auto&& i : indices )
+          M.clearColumn( i );
+
+        indices.clear();
+      }
+
+      // Global phase ------------------------------------------------
+      //
+      // Reduces all remaining columns of the current dimension with a
+      // regular sequential pass. Pivots that have been found during the
+      // local phase are already stored in the lookup table.
+
+      for( Index j = 0; j < numColumns; j++ )
+      {
+        if( M.getDimension( j ) == d && !reduced[ std::size_t(j) ] )
+        {
+          Index i;
+          bool valid = false;
+
+          std::tie( i, valid ) = M.getMaximumIndex( j );
+          while( valid && lut[ std::size_t(i) ].second )
+          {
+            M.addColumns( lut[ std::size_t(i) ].first, j );
+            std::tie( i, valid ) = M.getMaximumIndex( j );
+          }
+
+          if( valid )
+          {
+            lut[ std::size_t(i) ] = std::make_pair( j, true );
+            M.clearColumn( i );
+          }
+        }
+      }
+    }
+  }
+
+private:
+
+  /** @returns Boundaries of chunks for a given number of columns */
+  std::vector<std::size_t> getChunkBoundaries( std::size_t n ) const
+  {
+    auto numChunks = _numChunks;
+
+    if( numChunks == 0 )
+    {
+#ifdef _OPENMP
+      numChunks = 4 * static_cast<std::size_t>( omp_get_max_threads() );
+#else
+      numChunks = 1;
+#endif
+    }
+
+    numChunks = std::max( std::size_t(1), std::min( numChunks, n ) );
+
+    std::vector<std::size_t> boundaries;
+    boundaries.reserve( numChunks + 1 );
+
+    for( std::size_t c = 0; c <= numChunks; c++ )
+      boundaries.push_back( c * n / numChunks );
+
+    return boundaries;
+  }
+
+  /**
+    Reduces all columns of a given dimension in a chunk, using only
+    pivots within the chunk. Only entries of the auxiliary vectors that
+    belong to the chunk are modified, and the boundary matrix itself is
+    only queried.
+  */
+
+  template <class Representation, class Index> void reduceChunk( const topology::BoundaryMatrix<Representation>& M,
+                                                                 Index d,
+                                                                 Index begin, Index end,
+                                                                 std::vector< std::pair<Index, bool> >& lut,
+                                                                 std::vector< std::vector<Index> >& columns,
+                                                                 std::vector<char>& modified,
+                                                                 std::vector<char>& reduced,
+                                                                 std::vector<Index>& cleared ) const
+  {
+    std::vector<Index> scratch;
+
+    for( Index j = begin; j < end; j++ )
+    {
+      if( M.getDimension( j ) != d )
+        continue;
+
+      Index i;
+      bool valid = false;
+
+      std::tie( i, valid ) = M.getMaximumIndex( j );
+
+      // The column cannot be reduced locally, so there is no need to
+      // copy it.
+      if( !valid || i < begin )
+        continue;
+
+      // The pivot of the column is final already, so there is no need
+      // to copy it either. This is the usual case for dualized matrices.
+      if( !lut[ std::size_t(i) ].second )
+      {
+        lut[ std::size_t(i) ]     = std::make_pair( j, true );
+        reduced[ std::size_t(j) ] = true;
+
+        cleared.push_back( i );
+        continue;
+      }
+
+      auto&& column = columns[ std::size_t(j) ];
+      column        = M.getColumn( j );
+
+      while( !column.empty() && column.back() >= begin && lut[ std::size_t( column.back() ) ].second )
+      {
+        auto&& source = columns[ std::size_t( lut[ std::size_t( column.back() ) ].first ) ];
+
+        // Columns are only copied on demand; a column that is reduced
+        // locally is never modified afterwards.
+        if( source.empty() )
+          source = M.getColumn( lut[ std::size_t( column.back() ) ].first );
+
+        scratch.clear();
+
+        std::set_symmetric_difference( source.begin(), source.end(),
+                                       column.begin(), column.end(),
+                                       std::back_inserter( scratch ) );
+
+        column.swap( scratch );
+        modified[ std::size_t(j) ] = true;
+      }
+
+      if( !column.empty() && column.back() >= begin )
+      {
+        i = column.back();
+
+        lut[ std::size_t(i) ]     = std::make_pair( j, true );
+        reduced[ std::size_t(j) ] = true;
+
+        cleared.push_back( i );
+      }
+    }
+  }
+
+  std::size_t _numChunks;
+};
+
+} // namespace algorithms
+
+} // namespace persistentHomology
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
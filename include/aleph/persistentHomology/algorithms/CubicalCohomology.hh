@@ -0,0 +1,1652 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_CUBICAL_COHOMOLOGY_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_CUBICAL_COHOMOLOGY_HH__
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/topology/CubicalComplex.hh>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+
+namespace aleph
+{
+
+namespace persistentHomology
+{
+
+namespace algorithms
+{
+
+/**
+  @class CubicalCohomology
+  @brief Implicit persistent cohomology of cubical complexes
+
+  Calculates the persistence diagrams of the lower-star or upper-star
+  filtration of a cubical complex, i.e. of an image or a volume, without
+  materializing its cells or its boundary matrix. Apart from the vertex
+  values, only the filtration order of the vertices and a few arrays of
+  per-vertex or per-cell size are kept in memory.
+
+  Cells are ordered by the position of their *last* vertex in the
+  filtration, followed by their dimension and their index. The cells
+  of the lower star of a vertex thus follow the vertex directly, and
+  cells can be enumerated in filtration order without sorting them.
+
+  The implementation follows the paper:
+
+  > Cubical Ripser: Software for computing persistent homology of image and volume data
+  > Shizuo Kaji, Takeki Sudo, and Kazushi Ahara
+  > arXiv:2005.12692
+
+  Zero-dimensional pairs are calculated with a union--find data structure
+  on the vertices. By Alexander duality, the pairs of dimension \f$d-1\f$
+  of a grid of dimension \f$d\f$ are obtained from a union--find data
+  structure on the top-dimensional cells, processed in reverse order,
+  in which the outside of the grid forms an additional component. Only
+  the dimensions in between require a reduction of the coboundary
+  matrix. Their cells are traversed in the order of the grid first.
+  This skips the columns that have been paired in the previous
+  dimension (*clearing*) and pairs every cell whose first co-face has
+  the cell as its last face (*apparent pairs*). For the edges of the
+  volumes we tested, less than a tenth of all columns remain; only
+  these are sorted and reduced in filtration order.
+
+  If OpenMP is available, the vertices are sorted in parallel, and the
+  pairs of dimension \f$d-1\f$ are calculated concurrently with the pairs
+  of all other dimensions.
+
+  Apart from the apparent pairs, all dimensions visit the cells in the
+  order of the filtration, which results in random memory accesses and
+  dominates the running time of large grids. On a single core, an image
+  of \f$4096^2\f$ vertices takes about 13 s, and a volume of \f$256^3\f$
+  vertices about 30 s. A volume of \f$512^3\f$ vertices still takes
+  about 7 minutes and 4.3 GiB of memory, so persistence diagrams of
+  volumes of this size are *not* available within seconds.
+
+  With 32-bit indices, the filtration order requires 8 bytes per vertex.
+  The union--find data structures require 4 bytes per vertex and 8 bytes
+  per top-dimensional cell, respectively. For grids of dimension \f$d
+  \geq 3\f$, the reduction stores half a byte per cell in addition, or
+  a byte per cell if \f$d > 6\f$, as well as 8 bytes per column that is
+  not part of an apparent pair. Columns whose pivot is not one of their
+  co-faces, as well as the columns of the reduction matrix, are stored
+  in hash tables; for the volumes we tested, they amount to less than
+  10 bytes per vertex, including the resulting diagram.
+
+  The resulting persistence diagrams are the same as the ones of the
+  explicit cubical complex, except that pairs of zero persistence are
+  not reported.
+
+  @tparam T Data type of the vertex values, e.g. `float`
+  @tparam I Index type of cells; the number of cells of the complex must
+            be representable by this type. Using a 32-bit type reduces the
+            memory requirements for grids of less than \f$2^{32}\f$ cells.
+*/
+
+template <class T, class I = std::uint64_t> class CubicalCohomology
+{
+public:
+  using DataType           = T;
+  using IndexType          = I;
+  using CubicalComplex     = topology::CubicalComplex<DataType>;
+  using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+  /**
+    Maximum memory of the tables that describe the neighbourhood and the
+    lower star of a vertex. Every vertex has \f$3^d-1\f$ neighbours, and
+    the cells of its lower star have \f$5^d-3^d\f$ further vertices in
+    total, all of which are visited for every vertex. The limit permits
+    grids of dimension 10 or less.
+  */
+
+  static constexpr std::size_t maximumPatternMemory = std::size_t(64) << 20;
+
+  /**
+    Creates a new instance from a cubical complex. The vertices of the
+    complex are sorted in filtration order, but their values are not
+    copied, so the complex must outlive this instance.
+
+    @param K Cubical complex
+  */
+
+  explicit CubicalCohomology( const CubicalComplex& K )
+    : _K( K )
+  {
+    if( K.size() - 1 > static_cast<std::size_t>( std::numeric_limits<IndexType>::max() ) )
+      throw std::overflow_error( "Number of cells exceeds range of index type" );
+
+    this->makePatterns();
+
+    auto&& values = K.values();
+    auto n        = K.numVertices();
+
+    // Sorting pairs of values and indices avoids an indirect access to
+    // the values for every comparison.
+    {
+      std::vector< std::pair<DataType, IndexType> > pairs( n );
+
+      #pragma omp parallel for schedule(static)
+      for( long v = 0; v < static_cast<long>( n ); v++ )
+        pairs[ static_cast<std::size_t>( v ) ] = std::make_pair( values[ static_cast<std::size_t>( v ) ], static_cast<IndexType>( v ) );
+
+      sortPairs( pairs, K.filtration() == CubicalComplex::Filtration::UpperStar );
+
+      _order.resize( n );
+
+      #pragma omp parallel for schedule(static)
+      for( long r = 0; r < static_cast<long>( n ); r++ )
+        _order[ static_cast<std::size_t>( r ) ] = pairs[ static_cast<std::size_t>( r ) ].second;
+    }
+
+    _ranks.resize( n );
+
+    #pragma omp parallel for schedule(static)
+    for( long r = 0; r < static_cast<long>( n ); r++ )
+      _ranks[ static_cast<std::size_t>( _order[ static_cast<std::size_t>( r ) ] ) ] = static_cast<IndexType>( r );
+  }
+
+  /**
+    Calculates all persistence diagrams of the cubical complex. Since
+    the top-dimensional cells cannot create any features, the diagrams
+    range from dimension 0 to the dimension of the grid minus one.
+
+    @returns Persistence diagrams, sorted by dimension
+  */
+
+  std::vector<PersistenceDiagram> operator()() const
+  {
+    auto d = _K.dimension();
+
+    std::vector<PersistenceDiagram> diagrams( d );
+
+    // The pairs of the second-highest dimension do not depend on any of
+    // the other dimensions, so both parts are calculated concurrently.
+    // Exceptions must not leave a parallel region; they are re-thrown
+    // afterwards.
+    std::vector<std::exception_ptr> exceptions( 2 );
+
+    #pragma omp parallel sections
+    {
+      #pragma omp section
+      {
+        try
+        {
+          // Pivot codes of all cells; only required if there are
+          // dimensions that have to be reduced explicitly.
+          PivotCodes pivots( d >= 3 ? _K.size() : 0, d );
+
+          diagrams[0] = this->computeZeroDimensionalPairs( pivots );
+
+          for( unsigned k = 1; k + 2 <= d; k++ )
+            diagrams[k] = this->computePairs( pivots, k );
+        }
+        catch( ... )
+        {
+          exceptions[0] = std::current_exception();
+        }
+      }
+
+      #pragma omp section
+      {
+        try
+        {
+          if( d >= 2 )
+            diagrams[d-1] = this->computeTopDimensionalPairs();
+        }
+        catch( ... )
+        {
+          exceptions[1] = std::current_exception();
+        }
+      }
+    }
+
+    for( auto&& exception : exceptions )
+      if( exception )
+        std::rethrow_exception( exception );
+
+    return diagrams;
+  }
+
+  /** @returns Cubical complex */
+  const CubicalComplex& complex() const noexcept
+  {
+    return _K;
+  }
+
+private:
+
+  /**
+    Cell of the complex along with the rank of its last vertex in the
+    filtration order. Within a single dimension, this is the order of
+    the filtration.
+  */
+
+  struct Entry
+  {
+    IndexType rank;
+    IndexType index;
+  };
+
+  /**
+    Describes a neighbour of a vertex, i.e. another vertex of a cell that
+    contains the vertex. Offsets are stored modulo the range of the index
+    type, so they can be added to indices regardless of their sign.
+  */
+
+  struct Neighbour
+  {
+    IndexType offset;     // Offset of the vertex index
+    std::size_t negative; // Axes along which the neighbour lies in negative direction
+    std::size_t positive; // Axes along which the neighbour lies in positive direction
+  };
+
+  /**
+    Describes a cell of the lower star of a vertex relative to the vertex.
+    The other vertices of the cell are stored as a range of positions in
+    the table of neighbours.
+  */
+
+  struct Pattern
+  {
+    IndexType cellOffset; // Offset of the cell index
+    std::size_t negative; // Axes along which the cell extends in negative direction
+    std::size_t positive; // Axes along which the cell extends in positive direction
+    std::size_t begin;    // First position of the other vertices in `_patternVertices`
+    std::size_t end;      // Last position of the other vertices in `_patternVertices`
+  };
+
+  /**
+    Scratch space for the neighbourhood of the vertex that is currently
+    being processed. Neighbours outside of the grid have the largest
+    possible rank, so they never precede the vertex.
+  */
+
+  struct Neighbourhood
+  {
+    IndexType rank;                     // Rank of the vertex
+    IndexType cell;                     // Index of the vertex in the cell grid
+    std::vector<IndexType> coordinates; // Coordinates of the vertex in the vertex grid
+    std::vector<IndexType> ranks;       // Ranks of the neighbours, ordered as in `_neighbours`
+  };
+
+  /**
+    Stores a pivot code for every cell. The code \f$2i+1\f$ refers to the
+    co-face of a column in negative direction of axis \f$i\f$, while the
+    code \f$2i+2\f$ refers to the positive direction. The largest two
+    codes mark cleared cells and non-local pivots, respectively. Codes
+    are packed into four bits per cell if the dimension permits it, and
+    into one byte per cell otherwise.
+  */
+
+  class PivotCodes
+  {
+  public:
+    PivotCodes( std::size_t numCells, std::size_t dimension )
+      : _bits( 2 * dimension + 2 < 16 ? 4 : 8 )
+      , _codes( ( numCells * _bits + 7 ) / 8 )
+    {
+    }
+
+    bool empty() const noexcept
+    {
+      return _codes.empty();
+    }
+
+    /** @returns Code of cells that are paired without being a pivot of a column */
+    unsigned char cleared() const noexcept
+    {
+      return static_cast<unsigned char>( this->mask() - 1 );
+    }
+
+    /** @returns Code of pivots whose columns are not among their faces */
+    unsigned char nonlocal() const noexcept
+    {
+      return this->mask();
+    }
+
+    unsigned char get( IndexType c ) const noexcept
+    {
+      auto bit = static_cast<std::size_t>( c ) * _bits;
+      return static_cast<unsigned char>( ( _codes[ bit / 8 ] >> ( bit % 8 ) ) & this->mask() );
+    }
+
+    void set( IndexType c, unsigned char code ) noexcept
+    {
+      auto bit    = static_cast<std::size_t>( c ) * _bits;
+      auto&& byte = _codes[ bit / 8 ];
+      byte        = static_cast<unsigned char>( ( byte & ~( this->mask() << ( bit % 8 ) ) ) | ( code << ( bit % 8 ) ) );
+    }
+
+  private:
+    unsigned char mask() const noexcept
+    {
+      return static_cast<unsigned char>( ( 1u << _bits ) - 1 );
+    }
+
+    std::size_t _bits;
+    std::vector<unsigned char> _codes;
+  };
+
+  /**
+    Hash table with open addressing that maps cells to values. Compared
+    to `std::unordered_map`, no memory is allocated per entry, which
+    matters because the number of entries grows with the size of the
+    grid. Linear probing keeps the table compact, so it is only grown
+    once it is three quarters full. Since the last cell of a grid is
+    always a vertex, which never is a column or a pivot, the largest
+    index marks empty slots.
+  */
+
+  template <class Value> class CellMap
+  {
+  public:
+    CellMap()
+      : _bits( 4 )
+      , _size( 0 )
+      , _keys( std::size_t(1) << _bits, empty() )
+      , _values( std::size_t(1) << _bits )
+    {
+    }
+
+    /** @returns Value of a cell, or `nullptr` if the cell is not stored */
+    const Value* find( IndexType key ) const noexcept
+    {
+      for( auto slot = this->getSlot( key ); ; slot = ( slot + 1 ) & ( _keys.size() - 1 ) )
+      {
+        if( _keys[slot] == key )
+          return &_values[slot];
+        else if( _keys[slot] == empty() )
+          return nullptr;
+      }
+    }
+
+    /** Stores the value of a cell, replacing any previous value */
+    void insert( IndexType key, const Value& value )
+    {
+      if( 4 * ( _size + 1 ) > 3 * _keys.size() )
+        this->grow();
+
+      auto slot = this->getSlot( key );
+
+      while( _keys[slot] != empty() && _keys[slot] != key )
+        slot = ( slot + 1 ) & ( _keys.size() - 1 );
+
+      if( _keys[slot] == empty() )
+        ++_size;
+
+      _keys[slot]   = key;
+      _values[slot] = value;
+    }
+
+  private:
+    static IndexType empty() noexcept
+    {
+      return std::numeric_limits<IndexType>::max();
+    }
+
+    /** @returns First slot of a key, using Fibonacci hashing */
+    std::size_t getSlot( IndexType key ) const noexcept
+    {
+      auto hash = static_cast<std::uint64_t>( key ) * 0x9E3779B97F4A7C15ull;
+      return static_cast<std::size_t>( hash >> ( 64 - _bits ) );
+    }
+
+    /** Doubles the number of slots and inserts all entries again */
+    void grow()
+    {
+      std::vector<IndexType> keys( 2 * _keys.size(), empty() );
+      std::vector<Value> values( 2 * _values.size() );
+
+      keys.swap( _keys );
+      values.swap( _values );
+
+      ++_bits;
+      _size = 0;
+
+      for( std::size_t i = 0; i < keys.size(); i++ )
+        if( keys[i] != empty() )
+          this->insert( keys[i], values[i] );
+    }
+
+    unsigned _bits;
+    std::size_t _size;
+    std::vector<IndexType> _keys;
+    std::vector<Value> _values;
+  };
+
+  /**
+    As a heap comparator, this order ensures that the top element is the
+    first entry in filtration order, i.e. the pivot of a column.
+  */
+
+  static bool greaterRankOrIndex( const Entry& a, const Entry& b ) noexcept
+  {
+    return a.rank > b.rank || ( a.rank == b.rank && a.index > b.index );
+  }
+
+  static bool smallerRankOrIndex( const Entry& a, const Entry& b ) noexcept
+  {
+    return greaterRankOrIndex( b, a );
+  }
+
+  /**
+    Sorts pairs of values and vertex indices in filtration order, i.e. by
+    increasing or decreasing value and by increasing index. This is the
+    general version for all data types that only provide a comparison.
+  */
+
+  template <class U> static void sortPairs( std::vector< std::pair<U, IndexType> >& pairs, bool descending )
+  {
+    if( !descending )
+    {
+      parallelSort( pairs.begin(), pairs.end(),
+                    [] ( const std::pair<U, IndexType>& a, const std::pair<U, IndexType>& b )
+                    {
+                      return a.first < b.first || ( !( b.first < a.first ) && a.second < b.second );
+                    } );
+    }
+    else
+    {
+      parallelSort( pairs.begin(), pairs.end(),
+                    [] ( const std::pair<U, IndexType>& a, const std::pair<U, IndexType>& b )
+                    {
+                      return b.first < a.first || ( !( a.first < b.first ) && a.second < b.second );
+                    } );
+    }
+  }
+
+  static void sortPairs( std::vector< std::pair<float, IndexType> >& pairs, bool descending )
+  {
+    radixSort<std::uint32_t>( pairs, descending );
+  }
+
+  static void sortPairs( std::vector< std::pair<double, IndexType> >& pairs, bool descending )
+  {
+    radixSort<std::uint64_t>( pairs, descending );
+  }
+
+  /**
+    Maps a floating-point value to an unsigned integer of the same size
+    such that the order of values is preserved. Both zeros are mapped to
+    the same integer because they compare equal.
+  */
+
+  template <class Key, class U> static Key getKey( U x ) noexcept
+  {
+    static_assert( sizeof(Key) == sizeof(U), "Key type must have the size of the value type" );
+
+    constexpr Key sign = Key(1) << ( 8 * sizeof(Key) - 1 );
+
+    if( x == U(0) )
+      x = U(0);
+
+    Key key;
+    std::memcpy( &key, &x, sizeof(Key) );
+
+    return ( key & sign ) ? Key( ~key ) : Key( key | sign );
+  }
+
+  /**
+    Sorts pairs of floating-point values and vertex indices by a stable
+    least-significant digit radix sort of the values. Since the pairs are
+    sorted by index initially, ties remain sorted by index. Every thread
+    counts and distributes a contiguous block of pairs. Digits that are
+    the same for all values are skipped.
+  */
+
+  template <class Key, class U> static void radixSort( std::vector< std::pair<U, IndexType> >& pairs, bool descending )
+  {
+    constexpr unsigned bits       = 8;
+    constexpr std::size_t buckets = std::size_t(1) << bits;
+
+    auto n                = pairs.size();
+    std::size_t numBlocks = 1;
+
+#ifdef _OPENMP
+    numBlocks = static_cast<std::size_t>( omp_get_max_threads() );
+#endif
+
+    numBlocks = std::max( std::size_t(1), std::min( numBlocks, n ) );
+
+    Key flip = descending ? Key( ~Key(0) ) : Key(0);
+
+    auto getDigit = [flip] ( const std::pair<U, IndexType>& pair, unsigned shift )
+    {
+      return static_cast<std::size_t>( ( ( getKey<Key>( pair.first ) ^ flip ) >> shift ) & Key( buckets - 1 ) );
+    };
+
+    std::vector< std::pair<U, IndexType> > buffer( n );
+    std::vector<std::size_t> offsets( numBlocks * buckets );
+
+    for( unsigned shift = 0; shift < 8 * sizeof(Key); shift += bits )
+    {
+      std::fill( offsets.begin(), offsets.end(), std::size_t(0) );
+
+      #pragma omp parallel for schedule(static)
+      for( long b = 0; b < static_cast<long>( numBlocks ); b++ )
+      {
+        auto block = static_cast<std::size_t>( b );
+        auto count = offsets.begin() + static_cast<std::ptrdiff_t>( block * buckets );
+
+        for( std::size_t i = block * n / numBlocks; i < ( block + 1 ) * n / numBlocks; i++ )
+          ++count[ static_cast<std::ptrdiff_t>( getDigit( pairs[i], shift ) ) ];
+      }
+
+      // Calculate the first output position of every bucket of every
+      // block. Blocks of the same bucket are stored in order, so equal
+      // digits keep their relative order.
+      std::size_t position = 0;
+      bool trivial         = false;
+
+      for( std::size_t bucket = 0; bucket < buckets; bucket++ )
+      {
+        std::size_t total = 0;
+
+        for( std::size_t block = 0; block < numBlocks; block++ )
+        {
+          auto&& offset = offsets[ block * buckets + bucket ];
+          auto count    = offset;
+          offset        = position;
+          position     += count;
+          total        += count;
+        }
+
+        trivial = trivial || total == n;
+      }
+
+      if( trivial )
+        continue;
+
+      #pragma omp parallel for schedule(static)
+      for( long b = 0; b < static_cast<long>( numBlocks ); b++ )
+      {
+        auto block  = static_cast<std::size_t>( b );
+        auto offset = offsets.begin() + static_cast<std::ptrdiff_t>( block * buckets );
+
+        for( std::size_t i = block * n / numBlocks; i < ( block + 1 ) * n / numBlocks; i++ )
+          buffer[ offset[ static_cast<std::ptrdiff_t>( getDigit( pairs[i], shift ) ) ]++ ] = pairs[i];
+      }
+
+      pairs.swap( buffer );
+    }
+  }
+
+  /**
+    Sorts a range by sorting contiguous chunks in parallel and merging
+    adjacent chunks afterwards.
+  */
+
+  template <class RandomAccessIterator, class Compare> static void parallelSort( RandomAccessIterator begin, RandomAccessIterator end, Compare compare )
+  {
+    auto n                = static_cast<std::size_t>( std::distance( begin, end ) );
+    std::size_t numChunks = 1;
+
+#ifdef _OPENMP
+    numChunks = static_cast<std::size_t>( omp_get_max_threads() );
+#endif
+
+    numChunks = std::max( std::size_t(1), std::min( numChunks, n ) );
+
+    std::vector<RandomAccessIterator> boundaries;
+    boundaries.reserve( numChunks + 1 );
+
+    for( std::size_t c = 0; c <= numChunks; c++ )
+      boundaries.push_back( begin + static_cast<std::ptrdiff_t>( c * n / numChunks ) );
+
+    #pragma omp parallel for schedule(static)
+    for( long c = 0; c < static_cast<long>( numChunks ); c++ )
+      std::sort( boundaries[ static_cast<std::size_t>( c ) ], boundaries[ static_cast<std::size_t>( c ) + 1 ], compare );
+
+    for( std::size_t width = 1; width < numChunks; width *= 2 )
+    {
+      #pragma omp parallel for schedule(static)
+      for( long c = 0; c < static_cast<long>( numChunks ); c += static_cast<long>( 2 * width ) )
+      {
+        auto first  = static_cast<std::size_t>( c );
+        auto middle = std::min( first +     width, numChunks );
+        auto last   = std::min( first + 2 * width, numChunks );
+
+        std::inplace_merge( boundaries[first], boundaries[middle], boundaries[last], compare );
+      }
+    }
+  }
+
+  /**
+    Creates the table of neighbours of a vertex, sorted by the number of
+    axes along which they differ from the vertex, and the patterns of all
+    cells in the lower star of a vertex, sorted by dimension and by their
+    offset. For a given vertex, this is the filtration order of the cells
+    of its lower star.
+  */
+
+  void makePatterns()
+  {
+    auto d = _K.dimension();
+
+    auto&& cellStrides   = _K.cellStrides();
+    auto&& vertexStrides = _K.vertexStrides();
+
+    // Since every iteration increases the memory, the loop terminates
+    // before any of the counts can overflow.
+    std::size_t numCodes = 1;
+
+    {
+      std::size_t numVertices = 1;
+
+      for( std::size_t i = 0; i < d; i++ )
+      {
+        numCodes    *= 3;
+        numVertices *= 5;
+
+        auto memory = numCodes    * ( sizeof(Neighbour) + sizeof(Pattern) + sizeof(IndexType) )
+                    + numVertices * sizeof(std::size_t);
+
+        if( memory > maximumPatternMemory )
+          throw std::runtime_error( "Lower-star patterns of cubical complex exceed memory limit" );
+      }
+    }
+
+    // Every neighbour, including the vertex itself, is identified by a
+    // code whose digits in base 3 are its directions along every axis,
+    // shifted by one.
+    std::vector<Neighbour> neighbours( numCodes );
+    std::vector<std::ptrdiff_t> cellOffsets( numCodes );
+    std::vector<std::size_t> weights( numCodes );
+
+    for( std::size_t p = 0; p < numCodes; p++ )
+    {
+      std::ptrdiff_t vertexOffset = 0;
+      std::ptrdiff_t cellOffset   = 0;
+
+      Neighbour neighbour = { 0, 0, 0 };
+
+      auto q = p;
+
+      for( std::size_t i = 0; i < d; i++ )
+      {
+        auto direction = static_cast<int>( q % 3 ) - 1;
+        q             /= 3;
+
+        vertexOffset += direction * static_cast<std::ptrdiff_t>( vertexStrides[i] );
+        cellOffset   += direction * static_cast<std::ptrdiff_t>( cellStrides[i] );
+
+        if( direction < 0 )
+          neighbour.negative |= std::size_t(1) << i;
+        else if( direction > 0 )
+          neighbour.positive |= std::size_t(1) << i;
+
+        weights[p] += direction != 0;
+      }
+
+      neighbour.offset = static_cast<IndexType>( vertexOffset );
+      neighbours[p]    = neighbour;
+      cellOffsets[p]   = cellOffset;
+    }
+
+    // Sort all neighbours, except for the vertex itself, by their weight.
+    // The neighbours of a cell of dimension k thus form a prefix of the
+    // table, which is all that has to be evaluated for this dimension.
+    std::vector<std::size_t> codes;
+    std::vector<std::size_t> positions( numCodes );
+
+    for( std::size_t p = 0; p < numCodes; p++ )
+      if( weights[p] > 0 )
+        codes.push_back( p );
+
+    std::stable_sort( codes.begin(), codes.end(),
+                      [&weights] ( std::size_t p, std::size_t q )
+                      {
+                        return weights[p] < weights[q];
+                      } );
+
+    _neighbours.clear();
+    _numNeighbours.assign( d + 1, 0 );
+
+    for( auto&& p : codes )
+    {
+      positions[p] = _neighbours.size();
+
+      _neighbours.push_back( neighbours[p] );
+      _numNeighbours[ weights[p] ] = _neighbours.size();
+    }
+
+    for( std::size_t k = 1; k <= d; k++ )
+      _numNeighbours[k] = std::max( _numNeighbours[k], _numNeighbours[k-1] );
+
+    std::vector< std::vector< std::pair<std::ptrdiff_t, Pattern> > > patterns( d + 1 );
+
+    _patternVertices.clear();
+
+    for( std::size_t p = 0; p < numCodes; p++ )
+    {
+      auto&& neighbour = neighbours[p];
+
+      Pattern pattern;
+      pattern.cellOffset = static_cast<IndexType>( cellOffsets[p] );
+      pattern.negative   = neighbour.negative;
+      pattern.positive   = neighbour.positive;
+      pattern.begin      = _patternVertices.size();
+
+      // The other vertices of the cell are the neighbours along all
+      // non-empty subsets of the axes of the cell.
+      std::vector<std::ptrdiff_t> axisCodes;
+      std::size_t centre = 0;
+      std::size_t power  = 1;
+
+      for( std::size_t i = 0; i < d; i++ )
+      {
+        if( neighbour.negative & ( std::size_t(1) << i ) )
+          axisCodes.push_back( -static_cast<std::ptrdiff_t>( power ) );
+        else if( neighbour.positive & ( std::size_t(1) << i ) )
+          axisCodes.push_back( static_cast<std::ptrdiff_t>( power ) );
+
+        centre += power;
+        power  *= 3;
+      }
+
+      for( std::size_t mask = 1; mask < ( std::size_t(1) << axisCodes.size() ); mask++ )
+      {
+        auto code = static_cast<std::ptrdiff_t>( centre );
+
+        for( std::size_t j = 0; j < axisCodes.size(); j++ )
+          if( mask & ( std::size_t(1) << j ) )
+            code += axisCodes[j];
+
+        _patternVertices.push_back( positions[ static_cast<std::size_t>( code ) ] );
+      }
+
+      pattern.end = _patternVertices.size();
+      patterns[ weights[p] ].push_back( std::make_pair( cellOffsets[p], pattern ) );
+    }
+
+    _patterns.resize( d + 1 );
+
+    for( std::size_t k = 0; k <= d; k++ )
+    {
+      std::sort( patterns[k].begin(), patterns[k].end(),
+                 [] ( const std::pair<std::ptrdiff_t, Pattern>& a, const std::pair<std::ptrdiff_t, Pattern>& b )
+                 {
+                   return a.first < b.first;
+                 } );
+
+      _patterns[k].clear();
+
+      for( auto&& pair : patterns[k] )
+        _patterns[k].push_back( pair.second );
+    }
+  }
+
+  DataType valueOfRank( IndexType r ) const noexcept
+  {
+    return _K.values()[ static_cast<std::size_t>( _order[ static_cast<std::size_t>( r ) ] ) ];
+  }
+
+  IndexType rankOf( IndexType v ) const noexcept
+  {
+    return _ranks[ static_cast<std::size_t>( v ) ];
+  }
+
+  /**
+    Evaluates the neighbourhood of a vertex, i.e. its coordinates, its
+    index in the cell grid, and the ranks of all neighbours that belong
+    to cells of dimension \f$k\f$ or less. Only vertices on the boundary
+    of the grid require checking whether a neighbour exists.
+  */
+
+  void getNeighbourhood( IndexType v, std::size_t k, Neighbourhood& N ) const
+  {
+    auto&& shape         = _K.shape();
+    auto&& vertexStrides = _K.vertexStrides();
+    auto&& cellStrides   = _K.cellStrides();
+
+    auto d = shape.size();
+
+    N.rank = this->rankOf( v );
+    N.cell = 0;
+
+    N.coordinates.resize( d );
+    N.ranks.resize( _neighbours.size() );
+
+    // Axes along which the vertex lies on the lower or on the upper
+    // boundary of the grid, respectively
+    std::size_t lower = 0;
+    std::size_t upper = 0;
+
+    auto u = v;
+
+    for( std::size_t i = 0; i < d; i++ )
+    {
+      // The stride of the last axis is always one, so its division can
+      // be skipped.
+      auto x = u;
+
+      if( i + 1 < d )
+      {
+        x  = u / static_cast<IndexType>( vertexStrides[i] );
+        u %= static_cast<IndexType>( vertexStrides[i] );
+      }
+
+      N.coordinates[i] = x;
+      N.cell          += 2 * x * static_cast<IndexType>( cellStrides[i] );
+
+      if( x == 0 )
+        lower |= std::size_t(1) << i;
+
+      if( static_cast<std::size_t>( x ) + 1 == shape[i] )
+        upper |= std::size_t(1) << i;
+    }
+
+    auto end = _numNeighbours[k];
+
+    if( lower == 0 && upper == 0 )
+    {
+      for( std::size_t j = 0; j < end; j++ )
+        N.ranks[j] = this->rankOf( v + _neighbours[j].offset );
+    }
+    else
+    {
+      for( std::size_t j = 0; j < end; j++ )
+      {
+        auto&& neighbour = _neighbours[j];
+
+        if( ( neighbour.negative & lower ) || ( neighbour.positive & upper ) )
+          N.ranks[j] = std::numeric_limits<IndexType>::max();
+        else
+          N.ranks[j] = this->rankOf( v + neighbour.offset );
+      }
+    }
+  }
+
+  /**
+    Enumerates the cells of a given dimension in the lower star of a
+    vertex, i.e. the cells whose last vertex in the filtration order is
+    the given vertex. Cells are reported in filtration order along with
+    the index of their pattern. The neighbourhood of the vertex must have
+    been evaluated for this dimension.
+  */
+
+  void getLowerStar( const Neighbourhood& N,
+                     std::size_t dimension,
+                     std::vector< std::pair<IndexType, std::size_t> >& cells ) const
+  {
+    cells.clear();
+
+    auto&& patterns = _patterns[dimension];
+
+    for( std::size_t p = 0; p < patterns.size(); p++ )
+    {
+      auto&& pattern = patterns[p];
+      bool valid     = true;
+
+      for( std::size_t j = pattern.begin; j < pattern.end && valid; j++ )
+        valid = N.ranks[ _patternVertices[j] ] < N.rank;
+
+      if( valid )
+        cells.push_back( std::make_pair( N.cell + pattern.cellOffset, p ) );
+    }
+  }
+
+  /** Calculates the coordinates of a cell in the cell grid */
+
+  void getCellCoordinates( IndexType c, std::vector<IndexType>& coordinates ) const
+  {
+    auto&& strides = _K.cellStrides();
+
+    coordinates.resize( strides.size() );
+
+    for( std::size_t i = 0; i < strides.size(); i++ )
+    {
+      coordinates[i] = c / static_cast<IndexType>( strides[i] );
+      c             %= static_cast<IndexType>( strides[i] );
+    }
+  }
+
+  /**
+    Enumerates all co-faces of a cell. For every co-face, its pivot code
+    relative to the cell is stored in `codes`. Since a co-face consists
+    of the vertices of the cell and of their translates along one axis,
+    only the ranks of the translated vertices are required in addition
+    to the rank of the cell.
+  */
+
+  void getCofaces( IndexType c,
+                   std::vector<Entry>& cofaces,
+                   std::vector<unsigned char>& codes,
+                   std::vector<IndexType>& coordinates,
+                   std::vector<IndexType>& vertices ) const
+  {
+    auto&& cellStrides   = _K.cellStrides();
+    auto&& vertexStrides = _K.vertexStrides();
+    auto&& shape         = _K.shape();
+
+    cofaces.clear();
+    codes.clear();
+
+    this->getCellCoordinates( c, coordinates );
+
+    IndexType base = 0;
+
+    for( std::size_t i = 0; i < coordinates.size(); i++ )
+      base += ( coordinates[i] / 2 ) * static_cast<IndexType>( vertexStrides[i] );
+
+    vertices.assign( 1, base );
+
+    for( std::size_t i = 0; i < coordinates.size(); i++ )
+    {
+      if( coordinates[i] % 2 == 0 )
+        continue;
+
+      auto m = vertices.size();
+
+      for( std::size_t j = 0; j < m; j++ )
+        vertices.push_back( vertices[j] + static_cast<IndexType>( vertexStrides[i] ) );
+    }
+
+    IndexType rank = 0;
+
+    for( auto&& v : vertices )
+      rank = std::max( rank, this->rankOf( v ) );
+
+    for( std::size_t i = 0; i < coordinates.size(); i++ )
+    {
+      if( coordinates[i] % 2 == 1 )
+        continue;
+
+      auto cellStride   = static_cast<IndexType>( cellStrides[i] );
+      auto vertexStride = static_cast<IndexType>( vertexStrides[i] );
+
+      if( coordinates[i] > 0 )
+      {
+        auto cofaceRank = rank;
+
+        for( auto&& v : vertices )
+          cofaceRank = std::max( cofaceRank, this->rankOf( v - vertexStride ) );
+
+        cofaces.push_back( { cofaceRank, c - cellStride } );
+        codes.push_back( static_cast<unsigned char>( 2 * i + 1 ) );
+      }
+
+      if( static_cast<std::size_t>( coordinates[i] ) + 1 < 2 * shape[i] - 1 )
+      {
+        auto cofaceRank = rank;
+
+        for( auto&& v : vertices )
+          cofaceRank = std::max( cofaceRank, this->rankOf( v + vertexStride ) );
+
+        cofaces.push_back( { cofaceRank, c + cellStride } );
+        codes.push_back( static_cast<unsigned char>( 2 * i + 2 ) );
+      }
+    }
+  }
+
+  /**
+    Removes the pivot of a working column that is stored as a heap. Since
+    coefficients are in Z/2, entries that occur an even number of times
+    cancel each other out.
+  */
+
+  static std::pair<Entry, bool> popPivot( std::vector<Entry>& heap )
+  {
+    while( !heap.empty() )
+    {
+      std::pop_heap( heap.begin(), heap.end(), greaterRankOrIndex );
+
+      auto pivot = heap.back();
+      heap.pop_back();
+
+      if( !heap.empty() && heap.front().index == pivot.index )
+      {
+        std::pop_heap( heap.begin(), heap.end(), greaterRankOrIndex );
+        heap.pop_back();
+      }
+      else
+        return std::make_pair( pivot, true );
+    }
+
+    return std::make_pair( Entry(), false );
+  }
+
+  static std::pair<Entry, bool> getPivot( std::vector<Entry>& heap )
+  {
+    auto result = popPivot( heap );
+
+    if( result.second )
+    {
+      heap.push_back( result.first );
+      std::push_heap( heap.begin(), heap.end(), greaterRankOrIndex );
+    }
+
+    return result;
+  }
+
+  /**
+    Calculates zero-dimensional persistence pairs using a union--find
+    data structure on the ranks of the vertices. The root of every set
+    is its oldest vertex, i.e. the one with the smallest rank. Edges that
+    merge two sets are marked as cleared if pivot codes are required.
+  */
+
+  PersistenceDiagram computeZeroDimensionalPairs( PivotCodes& pivots ) const
+  {
+    auto n = _K.numVertices();
+
+    std::vector<IndexType> parent( n );
+
+    #pragma omp parallel for schedule(static)
+    for( long r = 0; r < static_cast<long>( n ); r++ )
+      parent[ static_cast<std::size_t>( r ) ] = static_cast<IndexType>( r );
+
+    auto find = [&parent] ( IndexType u )
+    {
+      while( parent[ static_cast<std::size_t>( u ) ] != u )
+      {
+        parent[ static_cast<std::size_t>( u ) ] = parent[ static_cast<std::size_t>( parent[ static_cast<std::size_t>( u ) ] ) ];
+        u                                       = parent[ static_cast<std::size_t>( u ) ];
+      }
+
+      return u;
+    };
+
+    PersistenceDiagram D;
+    D.setDimension( 0 );
+
+    Neighbourhood N;
+    std::vector< std::pair<IndexType, std::size_t> > cells;
+
+    for( std::size_t r = 0; r < n; r++ )
+    {
+      this->getNeighbourhood( _order[r], 1, N );
+      this->getLowerStar( N, 1, cells );
+
+      for( auto&& cell : cells )
+      {
+        auto&& pattern = _patterns[1][ cell.second ];
+
+        auto a = find( N.ranks[ _patternVertices[ pattern.begin ] ] );
+        auto b = find( static_cast<IndexType>( r ) );
+
+        if( a == b )
+          continue;
+
+        // The younger set, i.e. the one with the later root, dies
+        if( a > b )
+          std::swap( a, b );
+
+        parent[ static_cast<std::size_t>( b ) ] = a;
+
+        auto birth = this->valueOfRank( b );
+        auto death = this->valueOfRank( static_cast<IndexType>( r ) );
+
+        if( birth != death )
+          D.add( birth, death );
+
+        if( !pivots.empty() )
+          pivots.set( cell.first, pivots.cleared() );
+      }
+    }
+
+    if( n > 0 )
+      D.add( this->valueOfRank( 0 ) );
+
+    return D;
+  }
+
+  /**
+    Enumerates the columns of the coboundary matrix of a given dimension
+    that require a reduction. Cells are traversed in the order of the
+    grid, so that the ranks of their vertices are accessed sequentially
+    instead of randomly, and cleared cells are skipped.
+
+    A cell whose first co-face has the cell as its last face forms an
+    *apparent pair* with this co-face. Its column does not require any
+    reduction, and no other column can have the co-face as its pivot,
+    so the pivot is marked right away. Since the cell and its co-face
+    share their last vertex, the pair has zero persistence and is not
+    reported.
+
+    @returns Remaining columns in the order of the reduction, i.e. in
+             reverse filtration order
+  */
+
+  std::vector<Entry> getColumns( PivotCodes& pivots, unsigned dimension ) const
+  {
+    auto&& shape         = _K.shape();
+    auto&& vertexStrides = _K.vertexStrides();
+    auto&& cellStrides   = _K.cellStrides();
+
+    auto d = shape.size();
+    auto n = _K.numVertices();
+
+    // Every cell of the given dimension is described by its first vertex
+    // and by the axes along which it extends. For every set of axes, the
+    // offsets of the vertices of the cell relative to its first vertex,
+    // along with the axes along which they are translated, are stored.
+    std::vector<std::size_t> axes;
+    std::vector< std::vector<IndexType> > corners;
+    std::vector< std::vector<std::size_t> > cornerAxes;
+    std::vector<IndexType> cellOffsets;
+
+    for( std::size_t mask = 0; mask < ( std::size_t(1) << d ); mask++ )
+    {
+      std::vector<IndexType> offsets( 1, 0 );
+      std::vector<std::size_t> translations( 1, 0 );
+      IndexType cellOffset = 0;
+
+      for( std::size_t i = 0; i < d; i++ )
+      {
+        if( !( mask & ( std::size_t(1) << i ) ) )
+          continue;
+
+        auto m = offsets.size();
+
+        for( std::size_t j = 0; j < m; j++ )
+        {
+          offsets.push_back( offsets[j] + static_cast<IndexType>( vertexStrides[i] ) );
+          translations.push_back( translations[j] | ( std::size_t(1) << i ) );
+        }
+
+        cellOffset += static_cast<IndexType>( cellStrides[i] );
+      }
+
+      if( offsets.size() != ( std::size_t(1) << dimension ) )
+        continue;
+
+      axes.push_back( mask );
+      corners.push_back( offsets );
+      cornerAxes.push_back( translations );
+      cellOffsets.push_back( cellOffset );
+    }
+
+    std::vector<Entry> columns;
+
+    // Coordinates of the current vertex, its index in the cell grid, and
+    // the axes along which it lies on the lower or on the upper boundary
+    // of the grid, respectively
+    std::vector<std::size_t> coordinates( d );
+    IndexType cell    = 0;
+    std::size_t lower = ( std::size_t(1) << d ) - 1;
+    std::size_t upper = 0;
+
+    for( std::size_t i = 0; i < d; i++ )
+      if( shape[i] == 1 )
+        upper |= std::size_t(1) << i;
+
+    for( std::size_t v = 0; v < n; v++ )
+    {
+      auto vertex = static_cast<IndexType>( v );
+
+      for( std::size_t o = 0; o < axes.size(); o++ )
+      {
+        if( axes[o] & upper )
+          continue;
+
+        auto c = cell + cellOffsets[o];
+
+        if( pivots.get( c ) != 0 )
+          continue;
+
+        // Rank of the cell and the corner that is its last vertex
+        IndexType rank    = 0;
+        std::size_t last  = 0;
+
+        for( std::size_t j = 0; j < corners[o].size(); j++ )
+        {
+          auto r = this->rankOf( vertex + corners[o][j] );
+
+          if( j == 0 || r > rank )
+          {
+            rank = r;
+            last = j;
+          }
+        }
+
+        // The first co-face of the cell is the one with the smallest index
+        // among all co-faces whose additional vertices precede the last
+        // vertex of the cell. If there is no such co-face, the first one
+        // comes later in the filtration, and the pair is not apparent.
+        bool found            = false;
+        std::ptrdiff_t offset = 0;
+        std::size_t axis      = 0;
+
+        for( std::size_t i = 0; i < d; i++ )
+        {
+          if( axes[o] & ( std::size_t(1) << i ) )
+            continue;
+
+          auto vertexStride = static_cast<IndexType>( vertexStrides[i] );
+          auto cellStride   = static_cast<std::ptrdiff_t>( cellStrides[i] );
+
+          for( int direction : { -1, 1 } )
+          {
+            if( direction < 0 ? ( lower & ( std::size_t(1) << i ) ) != 0
+                              : ( upper & ( std::size_t(1) << i ) ) != 0 )
+              continue;
+
+            if( found && direction * cellStride > offset )
+              continue;
+
+            bool precedes = true;
+
+            for( std::size_t j = 0; j < corners[o].size() && precedes; j++ )
+            {
+              auto u   = vertex + corners[o][j];
+              precedes = this->rankOf( direction < 0 ? u - vertexStride : u + vertexStride ) < rank;
+            }
+
+            if( precedes )
+            {
+              found  = true;
+              offset = direction * cellStride;
+              axis   = 2 * i + ( direction < 0 ? 1 : 2 );
+            }
+          }
+        }
+
+        // The co-face has the cell as its last face if all other faces that
+        // contain the last vertex have a smaller index. These faces are the
+        // translates of the co-face along the axes of the cell, towards the
+        // last vertex.
+        bool apparent = found;
+
+        for( std::size_t i = 0; i < d && apparent; i++ )
+        {
+          if( !( axes[o] & ( std::size_t(1) << i ) ) )
+            continue;
+
+          auto cellStride = static_cast<std::ptrdiff_t>( cellStrides[i] );
+          apparent        = offset + ( ( cornerAxes[o][last] & ( std::size_t(1) << i ) ) ? cellStride : -cellStride ) < 0;
+        }
+
+        if( apparent )
+          pivots.set( static_cast<IndexType>( static_cast<std::ptrdiff_t>( c ) + offset ), static_cast<unsigned char>( axis ) );
+        else
+          columns.push_back( { rank, c } );
+      }
+
+      // Advance to the next vertex, using the order of the grid
+      for( std::size_t i = d; i-- > 0; )
+      {
+        auto bit = std::size_t(1) << i;
+
+        if( ++coordinates[i] < shape[i] )
+        {
+          cell  += 2 * static_cast<IndexType>( cellStrides[i] );
+          lower &= ~bit;
+
+          if( coordinates[i] + 1 == shape[i] )
+            upper |= bit;
+
+          break;
+        }
+
+        cell          -= 2 * static_cast<IndexType>( ( shape[i] - 1 ) * cellStrides[i] );
+        coordinates[i] = 0;
+        lower         |= bit;
+
+        if( shape[i] > 1 )
+          upper &= ~bit;
+      }
+    }
+
+    parallelSort( columns.begin(), columns.end(), greaterRankOrIndex );
+    return columns;
+  }
+
+  /**
+    Reduces the coboundary matrix of a given dimension. Columns are
+    processed in reverse filtration order. The pivot of every column is
+    marked with a code in `pivots`, which is used to find the column of
+    a pivot and to clear the columns of the next dimension. If the pivot
+    is a co-face of its column, the code describes its position relative
+    to the column. Otherwise, the column is stored separately.
+  */
+
+  PersistenceDiagram computePairs( PivotCodes& pivots, unsigned dimension ) const
+  {
+    PersistenceDiagram D;
+    D.setDimension( dimension );
+
+    auto&& strides = _K.cellStrides();
+
+    auto nonlocal = pivots.nonlocal();
+
+    CellMap<IndexType> nonlocalPivots;
+
+    // Sparse reduction matrix; only columns with additional entries are
+    // stored because the diagonal entry is implicit. Every column maps to
+    // the offset of its number of entries, followed by the entries.
+    CellMap<std::size_t> reductions;
+    std::vector<IndexType> reductionEntries;
+
+    std::vector<Entry> coboundary;
+    std::vector<Entry> cofaces;
+    std::vector<Entry> otherCofaces;
+    std::vector<IndexType> reduction;
+    std::vector<unsigned char> codes;
+    std::vector<unsigned char> otherCodes;
+
+    std::vector<IndexType> coordinates;
+    std::vector<IndexType> vertices;
+
+    auto getColumn = [&] ( IndexType pivot )
+    {
+      auto code = pivots.get( pivot );
+
+      if( code == nonlocal )
+        return *nonlocalPivots.find( pivot );
+
+      auto stride = static_cast<IndexType>( strides[ static_cast<std::size_t>( code - 1 ) / 2 ] );
+      return code % 2 == 1 ? pivot + stride : pivot - stride;
+    };
+
+    auto pushCoboundary = [&] ( IndexType column )
+    {
+      this->getCofaces( column, otherCofaces, otherCodes, coordinates, vertices );
+
+      for( auto&& coface : otherCofaces )
+      {
+        coboundary.push_back( coface );
+        std::push_heap( coboundary.begin(), coboundary.end(), greaterRankOrIndex );
+      }
+    };
+
+    for( auto&& entry : this->getColumns( pivots, dimension ) )
+    {
+      auto column = entry.index;
+
+      this->getCofaces( column, cofaces, codes, coordinates, vertices );
+
+      if( cofaces.empty() )
+      {
+        D.add( this->valueOfRank( entry.rank ) );
+        continue;
+      }
+
+      auto pivot = *std::min_element( cofaces.begin(), cofaces.end(), smallerRankOrIndex );
+      bool valid = true;
+
+      reduction.clear();
+
+      if( pivots.get( pivot.index ) != 0 )
+      {
+        coboundary.assign( cofaces.begin(), cofaces.end() );
+        std::make_heap( coboundary.begin(), coboundary.end(), greaterRankOrIndex );
+
+        std::tie( pivot, valid ) = getPivot( coboundary );
+
+        while( valid && pivots.get( pivot.index ) != 0 )
+        {
+          auto other = getColumn( pivot.index );
+
+          reduction.push_back( other );
+          pushCoboundary( other );
+
+          auto offset = reductions.find( other );
+
+          if( offset )
+          {
+            auto begin = *offset + 1;
+            auto end   = begin + reductionEntries[ *offset ];
+
+            for( auto l = begin; l < end; l++ )
+            {
+              reduction.push_back( reductionEntries[l] );
+              pushCoboundary( reductionEntries[l] );
+            }
+          }
+
+          std::tie( pivot, valid ) = getPivot( coboundary );
+        }
+      }
+
+      auto birth = this->valueOfRank( entry.rank );
+
+      if( !valid )
+      {
+        D.add( birth );
+        continue;
+      }
+
+      {
+        auto code = nonlocal;
+
+        for( std::size_t j = 0; j < cofaces.size(); j++ )
+          if( cofaces[j].index == pivot.index )
+            code = codes[j];
+
+        pivots.set( pivot.index, code );
+
+        if( code == nonlocal )
+          nonlocalPivots.insert( pivot.index, column );
+      }
+
+      auto death = this->valueOfRank( pivot.rank );
+
+      if( birth != death )
+        D.add( birth, death );
+
+      if( !reduction.empty() )
+      {
+        std::sort( reduction.begin(), reduction.end() );
+
+        auto offset = reductionEntries.size();
+        reductionEntries.push_back( 0 );
+
+        for( std::size_t j = 0; j < reduction.size(); )
+        {
+          if( j + 1 < reduction.size() && reduction[j] == reduction[j+1] )
+            j += 2;
+          else
+            reductionEntries.push_back( reduction[j++] );
+        }
+
+        auto count = reductionEntries.size() - offset - 1;
+
+        if( count > 0 )
+        {
+          reductionEntries[offset] = static_cast<IndexType>( count );
+          reductions.insert( column, offset );
+        }
+        else
+          reductionEntries.pop_back();
+      }
+    }
+
+    return D;
+  }
+
+  /**
+    Calculates the persistence pairs of the second-highest dimension by
+    means of a union--find data structure on the top-dimensional cells
+    and the outside of the grid. Cells are processed in reverse order,
+    so the root of every set is its *last* cell in filtration order.
+  */
+
+  PersistenceDiagram computeTopDimensionalPairs() const
+  {
+    auto&& shape         = _K.shape();
+    auto&& vertexStrides = _K.vertexStrides();
+
+    auto d = shape.size();
+
+    PersistenceDiagram D;
+    D.setDimension( d - 1 );
+
+    // Strides of the grid of top-dimensional cells
+    std::vector<IndexType> strides( d );
+    IndexType numCells = 1;
+
+    for( std::size_t i = d; i-- > 0; )
+    {
+      strides[i] = numCells;
+      numCells  *= static_cast<IndexType>( shape[i] - 1 );
+    }
+
+    auto outside = numCells;
+
+    // For every top-dimensional cell, the rank of its last vertex, i.e.
+    // the time at which the cell appears, is stored along with its parent
+    // in the union--find data structure. Both are required for every root
+    // that is found, so storing them next to each other saves a random
+    // memory access. The outside is the oldest set.
+    std::vector<Entry> sets( static_cast<std::size_t>( numCells ) + 1 );
+    sets.back() = { std::numeric_limits<IndexType>::max(), outside };
+
+    auto find = [&sets] ( IndexType u )
+    {
+      while( sets[ static_cast<std::size_t>( u ) ].index != u )
+      {
+        sets[ static_cast<std::size_t>( u ) ].index = sets[ static_cast<std::size_t>( sets[ static_cast<std::size_t>( u ) ].index ) ].index;
+        u                                           = sets[ static_cast<std::size_t>( u ) ].index;
+      }
+
+      return u;
+    };
+
+    // Offsets of the vertices of a top-dimensional cell relative to its
+    // first vertex
+    std::vector<IndexType> corners( 1, 0 );
+
+    for( std::size_t i = 0; i < d; i++ )
+    {
+      auto m = corners.size();
+
+      for( std::size_t j = 0; j < m; j++ )
+        corners.push_back( corners[j] + static_cast<IndexType>( vertexStrides[i] ) );
+    }
+
+    // Traversing the cells in the order of the grid keeps all accesses
+    // local, so this is considerably faster than enumerating the cells
+    // in the lower star of every vertex.
+    #pragma omp parallel for schedule(static)
+    for( long t = 0; t < static_cast<long>( numCells ); t++ )
+    {
+      auto u      = static_cast<IndexType>( t );
+      IndexType v = 0;
+
+      for( std::size_t i = 0; i < d; i++ )
+      {
+        v += ( u / strides[i] ) * static_cast<IndexType>( vertexStrides[i] );
+        u %= strides[i];
+      }
+
+      IndexType birth = 0;
+
+      for( auto&& corner : corners )
+        birth = std::max( birth, this->rankOf( v + corner ) );
+
+      sets[ static_cast<std::size_t>( t ) ] = { birth, static_cast<IndexType>( t ) };
+    }
+
+    auto n = _K.numVertices();
+
+    Neighbourhood N;
+    std::vector< std::pair<IndexType, std::size_t> > cells;
+
+    for( std::size_t r = n; r-- > 0; )
+    {
+      this->getNeighbourhood( _order[r], d - 1, N );
+      this->getLowerStar( N, d - 1, cells );
+
+      auto&& coordinates = N.coordinates;
+
+      for( auto it = cells.rbegin(); it != cells.rend(); ++it )
+      {
+        auto&& pattern = _patterns[d-1][ it->second ];
+
+        // Both co-faces of the cell are top-dimensional cells that are
+        // adjacent along the only axis in which the cell is closed.
+        IndexType base   = 0;
+        std::size_t axis = 0;
+
+        for( std::size_t i = 0; i < d; i++ )
+        {
+          if( pattern.negative & ( std::size_t(1) << i ) )
+            base += ( coordinates[i] - 1 ) * strides[i];
+          else if( pattern.positive & ( std::size_t(1) << i ) )
+            base += coordinates[i] * strides[i];
+          else
+            axis = i;
+        }
+
+        auto x = coordinates[axis];
+
+        auto a = find( x > 0 ? base + ( x - 1 ) * strides[axis] : outside );
+        auto b = find( static_cast<std::size_t>( x ) + 1 < shape[axis] ? base + x * strides[axis] : outside );
+
+        if( a == b )
+          continue;
+
+        // The younger set, i.e. the one whose root comes earlier in the
+        // filtration, dies.
+        Entry u = { sets[ static_cast<std::size_t>( a ) ].rank, a };
+        Entry w = { sets[ static_cast<std::size_t>( b ) ].rank, b };
+
+        if( smallerRankOrIndex( w, u ) )
+          std::swap( u, w );
+
+        sets[ static_cast<std::size_t>( u.index ) ].index = w.index;
+
+        auto birth = this->valueOfRank( static_cast<IndexType>( r ) );
+        auto death = this->valueOfRank( u.rank );
+
+        if( birth != death )
+          D.add( birth, death );
+      }
+    }
+
+    return D;
+  }
+
+  /** Cubical complex */
+  const CubicalComplex& _K;
+
+  /** Neighbours of a vertex, sorted by the number of axes in which they differ */
+  std::vector<Neighbour> _neighbours;
+
+  /** Number of neighbours that belong to cells of a given dimension or less */
+  std::vector<std::size_t> _numNeighbours;
+
+  /** Patterns of the lower star of a vertex, sorted by dimension */
+  std::vector< std::vector<Pattern> > _patterns;
+
+  /** Positions of the other vertices of all patterns in `_neighbours` */
+  std::vector<std::size_t> _patternVertices;
+
+  /** Vertices in filtration order */
+  std::vector<IndexType> _order;
+
+  /** Position of every vertex in the filtration order */
+  std::vector<IndexType> _ranks;
+};
+
+template <class T, class I> constexpr std::size_t CubicalCohomology<T, I>::maximumPatternMemory;
+
+} // namespace algorithms
+
+} // namespace persistentHomology
+
+} // namespace aleph
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -0,0 +1,855 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_RIPS_COHOMOLOGY_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_ALGORITHMS_RIPS_COHOMOLOGY_HH__
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace aleph
+{
+
+namespace persistentHomology
+{
+
+namespace algorithms
+{
+
+/**
+  @class RipsCohomology
+  @brief Implicit persistent cohomology of Vietoris--Rips complexes
+
+  Calculates the persistence diagrams of a Vietoris--Rips complex
+  without materializing the complex or its boundary matrix. Every
+  simplex is identified by its index in the combinatorial number
+  system, and co-faces are enumerated on the fly from the distances.
+  Apart from the distances, only the simplices of a single dimension
+  and a sparse reduction matrix are kept in memory.
+
+  If the threshold is finite, only the edges below the threshold are
+  stored, as sorted neighbour lists of every vertex in a compressed
+  sparse row layout. Co-faces are then enumerated by intersecting the
+  neighbour lists of the vertices of a simplex, so the memory usage
+  and the running time depend on the number of edges instead of the
+  number of pairs of points. Without a threshold, the lower triangular
+  distance matrix is stored instead.
+
+  The implementation follows the paper:
+
+  > Ripser: efficient computation of Vietoris--Rips persistence barcodes
+  > Ulrich Bauer
+  > arXiv:1908.02518
+
+  Persistent cohomology is calculated dimension by dimension. Columns
+  of simplices that have been paired in the previous dimension are
+  skipped (*clearing*), and a simplex is paired immediately with its
+  first co-face of the same diameter if that co-face is still free
+  (*apparent pairs*). In this case, no reduction is required at all.
+
+  The resulting persistence diagrams are the same as the ones from
+  `calculatePersistenceDiagrams()` for the complex that is built by
+  `buildVietorisRipsComplex()` with the same threshold and the same
+  dimension, except that pairs of zero persistence are not reported.
+  When comparing diagrams, use `PersistenceDiagram::removeDiagonal()`
+  for the diagrams of the explicit complex.
+
+  @tparam T Data type of distances, e.g. `double`
+  @tparam I Index type of simplices. Binomial coefficients of the number
+            of points and the number of vertices in the largest simplex
+            must be representable by this type.
+*/
+
+template <class T, class I = std::uint64_t> class RipsCohomology
+{
+public:
+  using DataType           = T;
+  using IndexType          = I;
+  using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+  /**
+    Creates a new instance from a distance matrix. Only distances that
+    are strictly smaller than the threshold give rise to edges.
+
+    @param D         Distance matrix
+    @param threshold Maximum distance for the expansion
+  */
+
+  template <class J> explicit RipsCohomology( const math::SymmetricMatrix<DataType, J>& D,
+                                              DataType threshold = infinity() )
+    : _numVertices( static_cast<IndexType>( D.numRows() ) )
+    , _threshold( threshold )
+  {
+    this->initialize( static_cast<std::size_t>( D.numRows() ),
+                      [&D] ( std::size_t i, std::size_t j )
+                      {
+                        return D( static_cast<J>( i ), static_cast<J>( j ) );
+                      } );
+  }
+
+  /**
+    Creates a new instance from a point cloud, using an arbitrary
+    distance functor. Any conversions that are defined in the traits
+    of the functor are applied automatically.
+
+    @param X         Point cloud
+    @param distance  Distance functor
+    @param threshold Maximum distance for the expansion
+  */
+
+  template <class Distance> RipsCohomology( const containers::PointCloud<DataType>& X,
+                                            Distance distance,
+                                            DataType threshold = infinity() )
+    : _numVertices( static_cast<IndexType>( X.size() ) )
+    , _threshold( threshold )
+  {
+    geometry::distances::Traits<Distance> traits;
+
+    auto d    = X.dimension();
+    auto data = X.data();
+
+    this->initialize( X.size(),
+                      [&traits, &distance, &d, &data] ( std::size_t i, std::size_t j )
+                      {
+                        return static_cast<DataType>( traits.from( distance( data + i * d,
+                                                                             data + j * d,
+                                                                             d ) ) );
+                      } );
+  }
+
+  /**
+    Calculates all persistence diagrams of the Vietoris--Rips complex
+    whose simplices have a dimension of at most `dimension`. Since the
+    top-dimensional simplices cannot create any features, the diagrams
+    range from dimension 0 to `dimension - 1`.
+
+    @param dimension Maximum dimension of simplices in the complex
+    @returns Persistence diagrams, sorted by dimension
+  */
+
+  std::vector<PersistenceDiagram> operator()( unsigned dimension ) const
+  {
+    std::vector<PersistenceDiagram> diagrams;
+
+    if( dimension == 0 || _numVertices == 0 )
+      return diagrams;
+
+    auto binomials = makeBinomialCoefficients( dimension + 1 );
+
+    std::vector<Entry> simplices;
+    std::vector<Entry> columns;
+
+    diagrams.push_back( this->computeZeroDimensionalPairs( binomials, simplices, columns ) );
+
+    bool haveSimplices = !simplices.empty();
+
+    for( unsigned d = 1; d < dimension && haveSimplices; d++ )
+    {
+      std::unordered_map<IndexType, std::size_t> pivots;
+      pivots.reserve( columns.size() );
+
+      diagrams.push_back( this->computePairs( binomials, columns, pivots, d ) );
+
+      // The simplices of the next dimension are only stored if they are
+      // required for enumerating another dimension. For the last one, a
+      // list of columns is sufficient.
+      if( d + 1 < dimension )
+      {
+        haveSimplices = this->assembleColumns( binomials, simplices, columns, pivots, d,
+                                               d + 2 < dimension );
+      }
+    }
+
+    return diagrams;
+  }
+
+  /** @returns Number of vertices, i.e. points */
+  IndexType size() const noexcept
+  {
+    return _numVertices;
+  }
+
+private:
+
+  /** Simplex in the combinatorial number system along with its diameter */
+  struct Entry
+  {
+    DataType  diameter;
+    IndexType index;
+  };
+
+  /** Neighbour of a vertex along with the length of their edge */
+  struct Neighbour
+  {
+    IndexType vertex;
+    DataType  distance;
+  };
+
+  /** Checks whether only the edges below the threshold are stored */
+  bool isSparse() const noexcept
+  {
+    return _threshold < infinity();
+  }
+
+  /**
+    Stores the distances of all pairs of vertices, which are given by
+    a functor. For a finite threshold, the neighbour lists are stored;
+    every list is sorted by decreasing vertex index. Else, the lower
+    triangular distance matrix is stored.
+  */
+
+  template <class Distance> void initialize( std::size_t n, Distance distance )
+  {
+    if( !this->isSparse() )
+    {
+      _distances.resize( n > 0 ? n * ( n - 1 ) / 2 : 0 );
+
+      // Rows of the lower triangular matrix have different lengths, so
+      // dynamic scheduling is required to balance the load.
+      #pragma omp parallel for schedule(dynamic)
+      for( std::ptrdiff_t i = 1; i < static_cast<std::ptrdiff_t>( n ); i++ )
+      {
+        auto offset = static_cast<std::size_t>( i * ( i - 1 ) / 2 );
+
+        for( std::ptrdiff_t j = 0; j < i; j++ )
+          _distances[ offset + static_cast<std::size_t>( j ) ] = distance( static_cast<std::size_t>( i ), static_cast<std::size_t>( j ) );
+      }
+
+      return;
+    }
+
+    std::vector< std::vector<Neighbour> > rows( n );
+
+    #pragma omp parallel for schedule(dynamic)
+    for( std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>( n ); i++ )
+    {
+      auto&& row = rows[ static_cast<std::size_t>( i ) ];
+
+      for( std::ptrdiff_t j = static_cast<std::ptrdiff_t>( n ) - 1; j >= 0; j-- )
+      {
+        if( i == j )
+          continue;
+
+        auto x = distance( static_cast<std::size_t>( std::max(i, j) ), static_cast<std::size_t>( std::min(i, j) ) );
+
+        if( x < _threshold )
+          row.push_back( { static_cast<IndexType>( j ), x } );
+      }
+    }
+
+    _offsets.reserve( n + 1 );
+    _offsets.push_back( 0 );
+
+    for( auto&& row : rows )
+      _offsets.push_back( _offsets.back() + row.size() );
+
+    _neighbours.reserve( _offsets.back() );
+
+    for( auto&& row : rows )
+    {
+      _neighbours.insert( _neighbours.end(), row.begin(), row.end() );
+
+      // Release the memory of the row as early as possible in order to
+      // keep the peak memory usage low.
+      std::vector<Neighbour>().swap( row );
+    }
+  }
+
+  /**
+    Orders entries by decreasing diameter, breaking ties by increasing
+    index. This is the order in which columns of the coboundary matrix
+    are processed. As a heap comparator, the order ensures that the top
+    element is the pivot of a column.
+  */
+
+  static bool greaterDiameterOrSmallerIndex( const Entry& a, const Entry& b ) noexcept
+  {
+    return a.diameter > b.diameter || ( a.diameter == b.diameter && a.index < b.index );
+  }
+
+  /** Table of binomial coefficients, stored in row-major order */
+  class BinomialCoefficients
+  {
+  public:
+    BinomialCoefficients( IndexType n, unsigned k )
+      : _k( k + 1 )
+      , _table( static_cast<std::size_t>( ( n + 1 ) * _k ), IndexType(0) )
+    {
+      for( IndexType i = 0; i <= n; i++ )
+      {
+        _table[ static_cast<std::size_t>( i * _k ) ] = IndexType(1);
+
+        for( IndexType j = 1; j < std::min( IndexType(i + 1), IndexType(_k) ); j++ )
+        {
+          auto a = (*this)( i - 1, j - 1 );
+          auto b = (*this)( i - 1, j );
+
+          if( a > std::numeric_limits<IndexType>::max() - b )
+            throw std::overflow_error( "Binomial coefficients exceed range of index type" );
+
+          _table[ static_cast<std::size_t>( i * _k + j ) ] = a + b;
+        }
+      }
+    }
+
+    IndexType operator()( IndexType n, IndexType k ) const noexcept
+    {
+      return _table[ static_cast<std::size_t>( n * _k + k ) ];
+    }
+
+  private:
+    IndexType _k;
+    std::vector<IndexType> _table;
+  };
+
+  static DataType infinity() noexcept
+  {
+    return std::numeric_limits<DataType>::has_infinity ? std::numeric_limits<DataType>::infinity()
+                                                       : std::numeric_limits<DataType>::max();
+  }
+
+  BinomialCoefficients makeBinomialCoefficients( unsigned k ) const
+  {
+    return BinomialCoefficients( _numVertices, k );
+  }
+
+  DataType distance( IndexType i, IndexType j ) const noexcept
+  {
+    if( i < j )
+      std::swap( i, j );
+
+    return _distances[ static_cast<std::size_t>( i * ( i - 1 ) / 2 + j ) ];
+  }
+
+  /**
+    Decodes the vertices of a simplex from its index in the combinatorial
+    number system. Vertices are reported in decreasing order.
+  */
+
+  void getVertices( const BinomialCoefficients& binomials,
+                    IndexType index,
+                    unsigned dimension,
+                    std::vector<IndexType>& vertices ) const
+  {
+    vertices.clear();
+
+    IndexType top = _numVertices - 1;
+
+    for( IndexType k = dimension + 1; k > 0; k-- )
+    {
+      // Binary search for the largest vertex v with binom(v,k) <= index;
+      // since binom(k-1,k) is zero, the search is always successful.
+      IndexType lo = k - 1;
+      IndexType hi = top;
+
+      while( lo < hi )
+      {
+        auto mid = lo + ( hi - lo + 1 ) / 2;
+
+        if( binomials( mid, k ) <= index )
+          lo = mid;
+        else
+          hi = mid - 1;
+      }
+
+      vertices.push_back( lo );
+      index -= binomials( lo, k );
+      top    = lo - ( lo > 0 );
+    }
+  }
+
+  /**
+    Enumerates the co-faces of a simplex in decreasing order of their
+    indices and reports those whose diameter does not exceed the threshold
+    to a callback. If `allCofaces` is not set, only co-faces whose new
+    vertex is larger than all vertices of the simplex are reported. This
+    enumerates every simplex of the next dimension exactly once.
+
+    The callback may return `false` to stop the enumeration.
+  */
+
+  template <class Callback> void enumerateCofaces( const BinomialCoefficients& binomials,
+                                                   const Entry& simplex,
+                                                   unsigned dimension,
+                                                   std::vector<IndexType>& vertices,
+                                                   bool allCofaces,
+                                                   Callback callback ) const
+  {
+    this->getVertices( binomials, simplex.index, dimension, vertices );
+
+    if( this->isSparse() )
+    {
+      this->enumerateSparseCofaces( binomials, simplex, dimension, vertices, allCofaces, callback );
+      return;
+    }
+
+    IndexType indexBelow = simplex.index;
+    IndexType indexAbove = IndexType(0);
+
+    std::ptrdiff_t v = static_cast<std::ptrdiff_t>( _numVertices ) - 1;
+    std::ptrdiff_t k = static_cast<std::ptrdiff_t>( dimension ) + 1;
+
+    auto binomial = [&binomials] ( std::ptrdiff_t n, std::ptrdiff_t m )
+    {
+      return binomials( static_cast<IndexType>( n ), static_cast<IndexType>( m ) );
+    };
+
+    while( v >= k )
+    {
+      if( !allCofaces && binomial( v, k ) <= indexBelow )
+        break;
+
+      // Skip all vertices that are already part of the simplex; this
+      // shifts their contribution from the lower part of the index to
+      // the upper part.
+      while( k > 0 && binomial( v, k ) <= indexBelow )
+      {
+        indexBelow -= binomial( v, k );
+        indexAbove += binomial( v, k + 1 );
+
+        --v;
+        --k;
+      }
+
+      auto diameter = simplex.diameter;
+
+      for( auto&& w : vertices )
+      {
+        diameter = std::max( diameter, this->distance( static_cast<IndexType>( v ), w ) );
+
+        if( !( diameter < _threshold ) )
+          break;
+      }
+
+      if( diameter < _threshold )
+      {
+        Entry coface = { diameter, indexAbove + binomial( v, k + 1 ) + indexBelow };
+
+        if( !callback( coface ) )
+          return;
+      }
+
+      --v;
+    }
+  }
+
+  /**
+    Enumerates the co-faces of a simplex whose vertices are given using
+    the neighbour lists. Every vertex of a co-face is a neighbour of all
+    vertices of the simplex, so the candidates are taken from the list
+    of the first vertex and looked up in the remaining lists. Since all
+    lists are sorted, this amounts to merging them. Co-faces are reported
+    in the same order as by the dense enumeration.
+  */
+
+  template <class Callback> void enumerateSparseCofaces( const BinomialCoefficients& binomials,
+                                                         const Entry& simplex,
+                                                         unsigned dimension,
+                                                         const std::vector<IndexType>& vertices,
+                                                         bool allCofaces,
+                                                         Callback& callback ) const
+  {
+    auto begin = [this] ( IndexType v ) { return _neighbours.begin() + static_cast<std::ptrdiff_t>( _offsets[ static_cast<std::size_t>( v )     ] ); };
+    auto end   = [this] ( IndexType v ) { return _neighbours.begin() + static_cast<std::ptrdiff_t>( _offsets[ static_cast<std::size_t>( v ) + 1 ] ); };
+
+    using Iterator = typename std::vector<Neighbour>::const_iterator;
+
+    std::vector<Iterator> cursors;
+    cursors.reserve( vertices.size() );
+
+    for( auto&& w : vertices )
+      cursors.push_back( begin( w ) );
+
+    IndexType indexBelow = simplex.index;
+    IndexType indexAbove = IndexType(0);
+    IndexType k          = static_cast<IndexType>( dimension ) + 1;
+    std::size_t position = 0;
+
+    for( auto it = begin( vertices.front() ); it != end( vertices.front() ); ++it )
+    {
+      auto v = it->vertex;
+
+      if( !allCofaces && v < vertices.front() )
+        break;
+
+      auto diameter = std::max( simplex.diameter, it->distance );
+      bool isCoface = true;
+
+      for( std::size_t i = 1; i < vertices.size() && isCoface; i++ )
+      {
+        auto&& cursor = cursors[i];
+        auto last     = end( vertices[i] );
+
+        while( cursor != last && cursor->vertex > v )
+          ++cursor;
+
+        if( cursor != last && cursor->vertex == v )
+          diameter = std::max( diameter, cursor->distance );
+        else
+          isCoface = false;
+      }
+
+      if( !isCoface )
+        continue;
+
+      // Shift the contribution of all vertices of the simplex that are
+      // larger than the new vertex from the lower part of the index to
+      // the upper part.
+      while( position < vertices.size() && vertices[position] > v )
+      {
+        indexBelow -= binomials( vertices[position], k );
+        indexAbove += binomials( vertices[position], k + 1 );
+
+        ++position;
+        --k;
+      }
+
+      Entry coface = { diameter, indexAbove + binomials( v, k + 1 ) + indexBelow };
+
+      if( !callback( coface ) )
+        return;
+    }
+  }
+
+  /**
+    Removes the pivot of a working column that is stored as a heap. Since
+    coefficients are in Z/2, entries that occur an even number of times
+    cancel each other out.
+  */
+
+  static std::pair<Entry, bool> popPivot( std::vector<Entry>& heap )
+  {
+    while( !heap.empty() )
+    {
+      std::pop_heap( heap.begin(), heap.end(), greaterDiameterOrSmallerIndex );
+
+      auto pivot = heap.back();
+      heap.pop_back();
+
+      if( !heap.empty() && heap.front().index == pivot.index )
+      {
+        std::pop_heap( heap.begin(), heap.end(), greaterDiameterOrSmallerIndex );
+        heap.pop_back();
+      }
+      else
+        return std::make_pair( pivot, true );
+    }
+
+    return std::make_pair( Entry(), false );
+  }
+
+  static std::pair<Entry, bool> getPivot( std::vector<Entry>& heap )
+  {
+    auto result = popPivot( heap );
+
+    if( result.second )
+    {
+      heap.push_back( result.first );
+      std::push_heap( heap.begin(), heap.end(), greaterDiameterOrSmallerIndex );
+    }
+
+    return result;
+  }
+
+  void pushCoboundary( const BinomialCoefficients& binomials,
+                       const Entry& simplex,
+                       unsigned dimension,
+                       std::vector<IndexType>& vertices,
+                       std::vector<Entry>& heap ) const
+  {
+    this->enumerateCofaces( binomials, simplex, dimension, vertices, true,
+                            [&heap] ( const Entry& coface )
+                            {
+                              heap.push_back( coface );
+                              std::push_heap( heap.begin(), heap.end(), greaterDiameterOrSmallerIndex );
+                              return true;
+                            } );
+  }
+
+  /**
+    Calculates zero-dimensional persistence pairs using a union--find
+    data structure on the edges. All edges that do not merge connected
+    components are stored as columns for the subsequent dimension. The
+    edges are also returned in `simplices`, as they are required for
+    enumerating the triangles.
+  */
+
+  PersistenceDiagram computeZeroDimensionalPairs( const BinomialCoefficients& binomials,
+                                                  std::vector<Entry>& simplices,
+                                                  std::vector<Entry>& columns ) const
+  {
+    simplices.clear();
+    columns.clear();
+
+    // The index of edge {j,i} with j < i in the combinatorial number
+    // system coincides with the offset in the distance matrix.
+    if( this->isSparse() )
+    {
+      for( IndexType i = 0; i < _numVertices; i++ )
+      {
+        for( auto k = _offsets[ static_cast<std::size_t>( i ) ]; k < _offsets[ static_cast<std::size_t>( i ) + 1 ]; k++ )
+        {
+          auto&& neighbour = _neighbours[k];
+
+          if( neighbour.vertex < i )
+            simplices.push_back( { neighbour.distance, binomials( i, 2 ) + neighbour.vertex } );
+        }
+      }
+    }
+    else
+    {
+      for( std::size_t index = 0; index < _distances.size(); index++ )
+      {
+        if( _distances[index] < _threshold )
+          simplices.push_back( { _distances[index], static_cast<IndexType>( index ) } );
+      }
+    }
+
+    std::sort( simplices.begin(), simplices.end(),
+               [] ( const Entry& a, const Entry& b )
+               {
+                 return greaterDiameterOrSmallerIndex( b, a );
+               } );
+
+    std::vector<IndexType> parent( static_cast<std::size_t>( _numVertices ) );
+    std::iota( parent.begin(), parent.end(), IndexType(0) );
+
+    auto find = [&parent] ( IndexType u )
+    {
+      while( parent[ static_cast<std::size_t>( u ) ] != u )
+      {
+        parent[ static_cast<std::size_t>( u ) ] = parent[ static_cast<std::size_t>( parent[ static_cast<std::size_t>( u ) ] ) ];
+        u                                       = parent[ static_cast<std::size_t>( u ) ];
+      }
+
+      return u;
+    };
+
+    PersistenceDiagram D;
+    D.setDimension( 0 );
+
+    std::vector<IndexType> vertices;
+
+    for( auto&& edge : simplices )
+    {
+      this->getVertices( binomials, edge.index, 1, vertices );
+
+      auto u = find( vertices[0] );
+      auto v = find( vertices[1] );
+
+      if( u != v )
+      {
+        parent[ static_cast<std::size_t>( std::max(u, v) ) ] = std::min(u, v);
+
+        if( edge.diameter > DataType() )
+          D.add( DataType(), edge.diameter );
+      }
+      else
+        columns.push_back( edge );
+    }
+
+    for( IndexType u = 0; u < _numVertices; u++ )
+      if( find(u) == u )
+        D.add( DataType() );
+
+    std::reverse( columns.begin(), columns.end() );
+    return D;
+  }
+
+  /**
+    Reduces the coboundary matrix of a given dimension. Columns are
+    processed in reverse filtration order. Every column that obtains
+    a pivot is stored in `pivots` so that the columns of the next
+    dimension can be cleared.
+  */
+
+  PersistenceDiagram computePairs( const BinomialCoefficients& binomials,
+                                   const std::vector<Entry>& columns,
+                                   std::unordered_map<IndexType, std::size_t>& pivots,
+                                   unsigned dimension ) const
+  {
+    PersistenceDiagram D;
+    D.setDimension( dimension );
+
+    // Sparse reduction matrix; only the additional entries of every
+    // column are stored because the diagonal entry is implicit.
+    std::vector<std::size_t> offsets( 1, 0 );
+    std::vector<Entry> reductionEntries;
+
+    std::vector<Entry> coboundary;
+    std::vector<Entry> reduction;
+    std::vector<Entry> cofaces;
+    std::vector<IndexType> vertices;
+
+    for( std::size_t j = 0; j < columns.size(); j++ )
+    {
+      auto&& column = columns[j];
+
+      coboundary.clear();
+      reduction.clear();
+      cofaces.clear();
+
+      Entry pivot        = Entry();
+      bool valid         = false;
+      bool apparent      = false;
+      bool checkApparent = true;
+
+      this->enumerateCofaces( binomials, column, dimension, vertices, true,
+                              [&] ( const Entry& coface )
+                              {
+                                cofaces.push_back( coface );
+
+                                if( checkApparent && coface.diameter == column.diameter )
+                                {
+                                  if( pivots.find( coface.index ) == pivots.end() )
+                                  {
+                                    pivot    = coface;
+                                    apparent = true;
+                                    return false;
+                                  }
+
+                                  checkApparent = false;
+                                }
+
+                                return true;
+                              } );
+
+      if( apparent )
+        valid = true;
+      else
+      {
+        for( auto&& coface : cofaces )
+        {
+          coboundary.push_back( coface );
+          std::push_heap( coboundary.begin(), coboundary.end(), greaterDiameterOrSmallerIndex );
+        }
+
+        std::tie( pivot, valid ) = getPivot( coboundary );
+      }
+
+      while( valid )
+      {
+        auto it = pivots.find( pivot.index );
+        if( it == pivots.end() )
+          break;
+
+        auto k = it->second;
+
+        reduction.push_back( columns[k] );
+        std::push_heap( reduction.begin(), reduction.end(), greaterDiameterOrSmallerIndex );
+
+        this->pushCoboundary( binomials, columns[k], dimension, vertices, coboundary );
+
+        for( std::size_t l = offsets[k]; l < offsets[k+1]; l++ )
+        {
+          reduction.push_back( reductionEntries[l] );
+          std::push_heap( reduction.begin(), reduction.end(), greaterDiameterOrSmallerIndex );
+
+          this->pushCoboundary( binomials, reductionEntries[l], dimension, vertices, coboundary );
+        }
+
+        std::tie( pivot, valid ) = getPivot( coboundary );
+      }
+
+      if( valid )
+      {
+        pivots[ pivot.index ] = j;
+
+        if( pivot.diameter > column.diameter )
+          D.add( column.diameter, pivot.diameter );
+      }
+      else
+        D.add( column.diameter );
+
+      for( auto entry = popPivot( reduction ); entry.second; entry = popPivot( reduction ) )
+        reductionEntries.push_back( entry.first );
+
+      offsets.push_back( reductionEntries.size() );
+    }
+
+    return D;
+  }
+
+  /**
+    Enumerates all simplices of the next dimension from the simplices
+    of the current dimension. Simplices that appear as a pivot in the
+    current dimension are not required as columns (clearing). If the
+    simplices are not required for any further dimension, they are
+    not stored.
+
+    @returns true if there is at least one simplex in the next dimension
+  */
+
+  bool assembleColumns( const BinomialCoefficients& binomials,
+                        std::vector<Entry>& simplices,
+                        std::vector<Entry>& columns,
+                        const std::unordered_map<IndexType, std::size_t>& pivots,
+                        unsigned dimension,
+                        bool keepSimplices ) const
+  {
+    std::vector<Entry> nextSimplices;
+    std::vector<IndexType> vertices;
+
+    bool haveSimplices = false;
+
+    columns.clear();
+
+    for( auto&& simplex : simplices )
+    {
+      this->enumerateCofaces( binomials, simplex, dimension, vertices, false,
+                              [&] ( const Entry& coface )
+                              {
+                                haveSimplices = true;
+
+                                if( keepSimplices )
+                                  nextSimplices.push_back( coface );
+
+                                if( pivots.find( coface.index ) == pivots.end() )
+                                  columns.push_back( coface );
+
+                                return true;
+                              } );
+    }
+
+    std::sort( columns.begin(), columns.end(), greaterDiameterOrSmallerIndex );
+
+    simplices.swap( nextSimplices );
+    return haveSimplices;
+  }
+
+  /** Number of vertices (points) */
+  IndexType _numVertices;
+
+  /** Distance threshold; only smaller distances result in edges */
+  DataType _threshold;
+
+  /** Lower triangular distance matrix without the diagonal */
+  std::vector<DataType> _distances;
+
+  /** Offsets of the neighbour lists of all vertices */
+  std::vector<std::size_t> _offsets;
+
+  /** Neighbour lists, sorted by decreasing vertex index */
+  std::vector<Neighbour> _neighbours;
+};
+
+} // namespace algorithms
+
+} // namespace persistentHomology
+
+} // namespace aleph
+
+#endif
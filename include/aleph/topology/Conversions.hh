@@ -6,7 +6,14 @@
 #include <aleph/topology/BoundaryMatrix.hh>
 
 #include <algorithm>
-#include <unordered_map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Ignore the OMP pragmas that are specified in this file. Depending on
+// the compiler configuration, they may not be available.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
 
 namespace aleph
 {
@@ -14,6 +21,154 @@ namespace aleph
 namespace topology
 {
 
+namespace detail
+{
+
+/**
+  @class SimplexTable
+  @brief Sorted table of the vertex tuples of all simplices of one dimension
+
+  Stores the vertices of all simplices of a given dimension contiguously
+  and keeps their indices sorted lexicographically by vertex tuple. This
+  permits looking up the faces of a simplex by binary search, without
+  creating a new simplex or hashing it.
+*/
+
+template <class VertexType, class Index> class SimplexTable
+{
+public:
+  explicit SimplexTable( std::size_t numVertices )
+    : _numVertices( numVertices )
+  {
+  }
+
+  template <class InputIterator> void add( InputIterator begin, InputIterator end, Index index )
+  {
+    _vertices.insert( _vertices.end(), begin, end );
+    _indices.push_back( index );
+  }
+
+  /**
+    Sorts the table and removes duplicate tuples. If a tuple occurs
+    more than once, the largest index is kept.
+  */
+
+  void sort()
+  {
+    std::vector<std::size_t> positions( _indices.size() );
+    std::iota( positions.begin(), positions.end(), std::size_t(0) );
+
+    std::sort( positions.begin(), positions.end(),
+               [this] ( std::size_t a, std::size_t b )
+               {
+                 auto itA = _vertices.begin() + static_cast<std::ptrdiff_t>( a * _numVertices );
+                 auto itB = _vertices.begin() + static_cast<std::ptrdiff_t>( b * _numVertices );
+
+                 if( std::equal( itA, itA + static_cast<std::ptrdiff_t>( _numVertices ), itB ) )
+                   return _indices[a] < _indices[b];
+
+                 return std::lexicographical_compare( itA, itA + static_cast<std::ptrdiff_t>( _numVertices ),
+                                                      itB, itB + static_cast<std::ptrdiff_t>( _numVertices ) );
+               } );
+
+    std::vector<VertexType> vertices;
+    std::vector<Index> indices;
+
+    vertices.reserve( _vertices.size() );
+    indices.reserve( _indices.size() );
+
+    for( std::size_t i = 0; i < positions.size(); i++ )
+    {
+      auto it = _vertices.begin() + static_cast<std::ptrdiff_t>( positions[i] * _numVertices );
+
+      // Duplicate tuples are adjacent and sorted by their index, so the
+      // last one of every run is kept.
+      if( i + 1 < positions.size() )
+      {
+        auto next = _vertices.begin() + static_cast<std::ptrdiff_t>( positions[i+1] * _numVertices );
+        if( std::equal( it, it + static_cast<std::ptrdiff_t>( _numVertices ), next ) )
+          continue;
+      }
+
+      vertices.insert( vertices.end(), it, it + static_cast<std::ptrdiff_t>( _numVertices ) );
+      indices.push_back( _indices[ positions[i] ] );
+    }
+
+    _vertices.swap( vertices );
+    _indices.swap( indices );
+  }
+
+  /**
+    Looks up the face of a simplex that is obtained by removing one of
+    its vertices. The vertices of the simplex must be sorted in the same
+    order as the ones of all other simplices.
+
+    @param begin Iterator to begin of vertex range of the simplex
+    @param skip  Offset of the vertex to remove
+
+    @returns Index of the face and a flag indicating whether the face
+    exists in the table
+  */
+
+  template <class RandomAccessIterator> std::pair<Index, bool> find( RandomAccessIterator begin, std::size_t skip ) const
+  {
+    std::size_t lower = 0;
+    std::size_t upper = _indices.size();
+
+    while( lower < upper )
+    {
+      auto middle = lower + ( upper - lower ) / 2;
+      auto result = this->compare( middle, begin, skip );
+
+      if( result == 0 )
+        return std::make_pair( _indices[middle], true );
+      else if( result < 0 )
+        lower = middle + 1;
+      else
+        upper = middle;
+    }
+
+    return std::make_pair( Index(0), false );
+  }
+
+private:
+
+  /**
+    Compares a tuple of the table to the face of a simplex, without
+    creating the face.
+
+    @returns A negative value if the tuple is smaller, zero if both are
+    equal, and a positive value if the tuple is larger than the face
+  */
+
+  template <class RandomAccessIterator> int compare( std::size_t position, RandomAccessIterator begin, std::size_t skip ) const
+  {
+    auto it = _vertices.begin() + static_cast<std::ptrdiff_t>( position * _numVertices );
+
+    for( std::size_t i = 0, k = 0; i < _numVertices; i++, k++ )
+    {
+      if( k == skip )
+        ++k;
+
+      auto u = *( it + static_cast<std::ptrdiff_t>( i ) );
+      auto v = *( begin + static_cast<std::ptrdiff_t>( k ) );
+
+      if( u < v )
+        return -1;
+      else if( v < u )
+        return 1;
+    }
+
+    return 0;
+  }
+
+  std::size_t _numVertices;
+  std::vector<VertexType> _vertices;
+  std::vector<Index> _indices;
+};
+
+} // namespace detail
+
 /**
   Converts a simplicial complex into its boundary matrix representation.
   An optional index may be used to stop converting simplices whose index
@@ -23,6 +178,11 @@ namespace topology
   function are suitable for (persistent) homology. If a maximum index is
   given, however, the matrices are particularly suitable for calculating
   (persistent) intersection homology.
+
+  Faces are looked up in sorted tables of vertex tuples, one for every
+  dimension, so no face simplices need to be created. The columns are
+  calculated in parallel if OpenMP is available. A face that does not
+  belong to the simplicial complex is mapped to index zero.
 */
 
 template <
@@ -30,48 +190,85 @@ template <
   class SimplicialComplex
 > BoundaryMatrix<Representation> makeBoundaryMatrix( const SimplicialComplex& K, std::size_t max = 0 )
 {
-  using Simplex = typename SimplicialComplex::ValueType;
-  using Index   = typename BoundaryMatrix<Representation>::Index;
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using Index      = typename BoundaryMatrix<Representation>::Index;
+  using VertexType = typename Simplex::VertexType;
+  using Table      = detail::SimplexTable<VertexType, Index>;
 
   BoundaryMatrix<Representation> M;
   M.setNumColumns( static_cast<Index>( K.size() ) );
 
-  // Prepare index map -------------------------------------------------
+  // Prepare lookup tables ---------------------------------------------
   //
   // The idea is to map simplices to their index within the filtration
-  // in order to speed up the conversion process.
+  // in order to speed up the conversion process. Since the faces of a
+  // simplex have one vertex less, only tables of simplices of the next
+  // lower dimension are consulted.
+
+  std::vector<const Simplex*> simplices;
+  simplices.reserve( K.size() );
 
-  std::unordered_map<Simplex, Index> simplex_to_index;
+  std::vector<Table> tables;
 
   {
     Index i = Index(0);
 
     for( auto&& simplex : K )
-      simplex_to_index[simplex] = i++;
+    {
+      auto numVertices = simplex.size();
+
+      while( tables.size() < numVertices + 1 )
+        tables.emplace_back( tables.size() );
+
+      tables[numVertices].add( simplex.begin(), simplex.end(), i++ );
+      simplices.push_back( &simplex );
+    }
+  }
+
+  for( auto&& table : tables )
+    table.sort();
+
+  // Calculate columns -------------------------------------------------
+  //
+  // Columns are stored contiguously in order to fill them in parallel.
+  // Every column of a simplex with k > 1 vertices has k entries.
+
+  std::size_t n = simplices.size();
+
+  std::vector<std::size_t> offsets( n + 1 );
+
+  for( std::size_t j = 0; j < n; j++ )
+  {
+    auto numVertices = simplices[j]->size();
+    auto numEntries  = ( !max || j < max ) && numVertices > 1 ? numVertices : 0;
+
+    offsets[j+1] = offsets[j] + numEntries;
   }
 
-  Index j = Index(0);
+  std::vector<Index> entries( offsets.back() );
+
+  #pragma omp parallel for schedule(static)
+  for( long j = 0; j < static_cast<long>( n ); j++ )
+  {
+    auto&& simplex  = *simplices[ std::size_t(j) ];
+    auto   offset   = offsets[ std::size_t(j) ];
+    auto   numFaces = offsets[ std::size_t(j) + 1 ] - offset;
+
+    for( std::size_t k = 0; k < numFaces; k++ )
+      entries[ offset + k ] = tables[ numFaces - 1 ].find( simplex.begin(), k ).first;
+  }
 
-  for( auto&& itSimplex = K.begin(); itSimplex != K.end(); ++itSimplex )
+  for( std::size_t j = 0; j < n; j++ )
   {
     if( !max || j < max )
     {
-      std::vector<Index> column;
-      column.reserve( itSimplex->size() );
+      auto begin = entries.begin() + static_cast<std::ptrdiff_t>( offsets[j] );
+      auto end   = entries.begin() + static_cast<std::ptrdiff_t>( offsets[j+1] );
 
-      for( auto&& itBoundary = itSimplex->begin_boundary();
-           itBoundary != itSimplex->end_boundary();
-           ++itBoundary )
-      {
-        column.push_back( simplex_to_index[ *itBoundary ] );
-      }
-
-      M.setColumn( j, column.begin(), column.end() );
+      M.setColumn( Index(j), begin, end );
     }
     else
-      M.setDimension( j, static_cast<Index>( itSimplex->dimension() ) );
-
-    ++j;
+      M.setDimension( Index(j), static_cast<Index>( simplices[j]->dimension() ) );
   }
 
   return M;
@@ -81,4 +278,6 @@ template <
 
 } // namespace aleph
 
+#pragma GCC diagnostic pop
+
 #endif
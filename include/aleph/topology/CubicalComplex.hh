@@ -0,0 +1,318 @@
+#ifndef ALEPH_TOPOLOGY_CUBICAL_COMPLEX_HH__
+#define ALEPH_TOPOLOGY_CUBICAL_COMPLEX_HH__
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/**
+  @class CubicalComplex
+  @brief Implicit cubical complex of a scalar field on a regular grid
+
+  Represents the cubical complex of a \f$d\f$-dimensional grid, such as
+  a grey-scale image or a volume, along with a scalar value for every
+  vertex, i.e. for every pixel or voxel. In contrast to a simplicial
+  complex, no cells are stored. Every cell is identified by its index
+  in a grid of \f$(2n_0-1) \times \dots \times (2n_{d-1}-1)\f$ cells,
+  in which vertices have even coordinates and a cell of dimension
+  \f$k\f$ has exactly \f$k\f$ odd coordinates. Faces, co-faces, and the
+  vertices of a cell are enumerated on the fly.
+
+  Values are stored in row-major order, i.e. the last axis varies the
+  fastest. For an image of height \f$h\f$ and width \f$w\f$, the shape
+  is \f$(h,w)\f$, and the value of the pixel \f$(y,x)\f$ is stored at
+  offset \f$w y + x\f$, which is the layout of `MatrixReader`.
+
+  The filtration of the complex is either the *lower-star* filtration,
+  in which every cell is assigned the maximum value of its vertices, or
+  the *upper-star* filtration, in which every cell is assigned the
+  minimum value of its vertices and larger values come first.
+
+  @see aleph::persistentHomology::algorithms::CubicalCohomology
+*/
+
+template <class T> class CubicalComplex
+{
+public:
+  using DataType  = T;
+  using IndexType = std::size_t;
+
+  /** Determines the values of cells and the order of the filtration */
+  enum class Filtration
+  {
+    LowerStar,
+    UpperStar
+  };
+
+  /**
+    Creates a new cubical complex from the shape of a grid and the values
+    of its vertices.
+
+    @param shape      Number of vertices along every axis
+    @param values     Vertex values in row-major order
+    @param filtration Type of filtration
+  */
+
+  CubicalComplex( std::vector<std::size_t> shape,
+                  std::vector<DataType> values,
+                  Filtration filtration = Filtration::LowerStar )
+    : _shape( std::move( shape ) )
+    , _values( std::move( values ) )
+    , _filtration( filtration )
+  {
+    if( _shape.empty() )
+      throw std::runtime_error( "Shape of cubical complex must not be empty" );
+
+    if( std::find( _shape.begin(), _shape.end(), std::size_t(0) ) != _shape.end() )
+      throw std::runtime_error( "Shape of cubical complex must not contain empty axes" );
+
+    auto n = std::accumulate( _shape.begin(), _shape.end(), std::size_t(1), std::multiplies<std::size_t>() );
+
+    if( n != _values.size() )
+      throw std::runtime_error( "Number of values does not match shape of cubical complex" );
+
+    auto d = _shape.size();
+
+    _vertexStrides.resize( d );
+    _cellStrides.resize( d );
+
+    std::size_t vertexStride = 1;
+    std::size_t cellStride   = 1;
+
+    for( std::size_t i = d; i-- > 0; )
+    {
+      _vertexStrides[i] = vertexStride;
+      _cellStrides[i]   = cellStride;
+
+      vertexStride *= _shape[i];
+      cellStride   *= 2 * _shape[i] - 1;
+    }
+
+    _numCells = cellStride;
+  }
+
+  /** @returns Dimension of the grid, i.e. the number of axes */
+  std::size_t dimension() const noexcept
+  {
+    return _shape.size();
+  }
+
+  /** @returns Number of vertices along every axis */
+  const std::vector<std::size_t>& shape() const noexcept
+  {
+    return _shape;
+  }
+
+  /** @returns Vertex values in row-major order */
+  const std::vector<DataType>& values() const noexcept
+  {
+    return _values;
+  }
+
+  /** @returns Type of filtration */
+  Filtration filtration() const noexcept
+  {
+    return _filtration;
+  }
+
+  /** @returns Number of vertices */
+  std::size_t numVertices() const noexcept
+  {
+    return _values.size();
+  }
+
+  /** @returns Number of cells of all dimensions */
+  std::size_t size() const noexcept
+  {
+    return _numCells;
+  }
+
+  /** @returns Offsets between adjacent vertices along every axis */
+  const std::vector<std::size_t>& vertexStrides() const noexcept
+  {
+    return _vertexStrides;
+  }
+
+  /** @returns Offsets between adjacent cells along every axis */
+  const std::vector<std::size_t>& cellStrides() const noexcept
+  {
+    return _cellStrides;
+  }
+
+  /**
+    Checks whether a value comes strictly before another value in the
+    filtration. This is the case if it is smaller for the lower-star
+    filtration, and if it is larger for the upper-star filtration.
+  */
+
+  bool precedes( DataType a, DataType b ) const noexcept
+  {
+    return _filtration == Filtration::LowerStar ? a < b : b < a;
+  }
+
+  /** @returns Index of the cell that corresponds to a vertex */
+  IndexType vertexToCell( IndexType v ) const noexcept
+  {
+    IndexType c = 0;
+
+    for( std::size_t i = 0; i < _shape.size(); i++ )
+    {
+      c += 2 * ( v / _vertexStrides[i] ) * _cellStrides[i];
+      v %= _vertexStrides[i];
+    }
+
+    return c;
+  }
+
+  /** @returns Dimension of a cell, i.e. the number of odd coordinates */
+  unsigned cellDimension( IndexType c ) const noexcept
+  {
+    unsigned k = 0;
+
+    for( std::size_t i = 0; i < _shape.size(); i++ )
+    {
+      k += ( c / _cellStrides[i] ) % 2 == 1;
+      c %= _cellStrides[i];
+    }
+
+    return k;
+  }
+
+  /**
+    Enumerates the vertices of a cell and stores them in an output
+    iterator. A cell of dimension \f$k\f$ has \f$2^k\f$ vertices.
+  */
+
+  template <class OutputIterator> void vertices( IndexType c, OutputIterator result ) const
+  {
+    IndexType base = 0;
+    std::vector<std::size_t> axes;
+
+    for( std::size_t i = 0; i < _shape.size(); i++ )
+    {
+      auto x = c / _cellStrides[i];
+      c     %= _cellStrides[i];
+
+      base += ( x / 2 ) * _vertexStrides[i];
+
+      if( x % 2 == 1 )
+        axes.push_back( i );
+    }
+
+    for( std::size_t mask = 0; mask < ( std::size_t(1) << axes.size() ); mask++ )
+    {
+      auto v = base;
+
+      for( std::size_t j = 0; j < axes.size(); j++ )
+        if( mask & ( std::size_t(1) << j ) )
+          v += _vertexStrides[ axes[j] ];
+
+      *result++ = v;
+    }
+  }
+
+  /**
+    Calculates the value of a cell in the filtration, i.e. the maximum
+    of its vertex values for the lower-star filtration and the minimum
+    of its vertex values for the upper-star filtration.
+  */
+
+  DataType value( IndexType c ) const
+  {
+    std::vector<IndexType> vertices;
+    this->vertices( c, std::back_inserter( vertices ) );
+
+    auto value = _values[ vertices.front() ];
+
+    for( auto&& v : vertices )
+      if( this->precedes( value, _values[v] ) )
+        value = _values[v];
+
+    return value;
+  }
+
+  /**
+    Enumerates the faces of co-dimension one of a cell and stores them
+    in an output iterator.
+  */
+
+  template <class OutputIterator> void boundary( IndexType c, OutputIterator result ) const
+  {
+    auto index = c;
+
+    for( std::size_t i = 0; i < _shape.size(); i++ )
+    {
+      auto x = index / _cellStrides[i];
+      index %= _cellStrides[i];
+
+      if( x % 2 == 1 )
+      {
+        *result++ = c - _cellStrides[i];
+        *result++ = c + _cellStrides[i];
+      }
+    }
+  }
+
+  /**
+    Enumerates the co-faces of co-dimension one of a cell and stores
+    them in an output iterator.
+  */
+
+  template <class OutputIterator> void coboundary( IndexType c, OutputIterator result ) const
+  {
+    auto index = c;
+
+    for( std::size_t i = 0; i < _shape.size(); i++ )
+    {
+      auto x = index / _cellStrides[i];
+      index %= _cellStrides[i];
+
+      if( x % 2 == 0 )
+      {
+        if( x > 0 )
+          *result++ = c - _cellStrides[i];
+
+        if( x + 1 < 2 * _shape[i] - 1 )
+          *result++ = c + _cellStrides[i];
+      }
+    }
+  }
+
+private:
+
+  /** Number of vertices along every axis */
+  std::vector<std::size_t> _shape;
+
+  /** Vertex values in row-major order */
+  std::vector<DataType> _values;
+
+  /** Type of filtration */
+  Filtration _filtration;
+
+  /** Strides of the vertex grid */
+  std::vector<std::size_t> _vertexStrides;
+
+  /** Strides of the cell grid */
+  std::vector<std::size_t> _cellStrides;
+
+  /** Number of cells of all dimensions */
+  std::size_t _numCells;
+};
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef ALEPH_TOPOLOGY_DENSE_UNION_FIND_HH__
+#define ALEPH_TOPOLOGY_DENSE_UNION_FIND_HH__
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/**
+  @class DenseUnionFind
+  @brief Union--Find data structure for consecutive indices
+
+  Stores the sets of the indices \f$0, \dots, n-1\f$ in contiguous
+  arrays. Sets are merged by rank, and queries use iterative path
+  halving, resulting in an almost-constant amortized complexity for
+  all operations.
+
+  In contrast to `UnionFind`, merging two sets is *not* directional,
+  i.e. the root of a merged set may be the root of either one of the
+  two sets. Clients that need to keep track of a representative of a
+  set, such as its oldest vertex, have to store it separately.
+
+  @tparam Index Index type
+*/
+
+template <class Index = std::size_t> class DenseUnionFind
+{
+public:
+
+  /**
+    Creates a new Union--Find data structure for a given number of
+    indices. Initially, every index forms a set of its own.
+  */
+
+  explicit DenseUnionFind( std::size_t n )
+    : _parent( n )
+    , _rank( n )
+  {
+    std::iota( _parent.begin(), _parent.end(), Index(0) );
+  }
+
+  /** @returns Root of the set that contains a given index */
+  Index find( Index u ) noexcept
+  {
+    while( _parent[ std::size_t(u) ] != u )
+    {
+      // Path halving: every other node along the path is moved closer
+      // to the root
+      auto&& parent = _parent[ std::size_t(u) ];
+
+      parent = _parent[ std::size_t( parent ) ];
+      u      = parent;
+    }
+
+    return u;
+  }
+
+  /**
+    Merges the sets of two indices.
+
+    @returns Root of the merged set
+  */
+
+  Index merge( Index u, Index v ) noexcept
+  {
+    u = this->find( u );
+    v = this->find( v );
+
+    if( u == v )
+      return u;
+
+    if( _rank[ std::size_t(u) ] < _rank[ std::size_t(v) ] )
+      std::swap( u, v );
+
+    _parent[ std::size_t(v) ] = u;
+
+    if( _rank[ std::size_t(u) ] == _rank[ std::size_t(v) ] )
+      ++_rank[ std::size_t(u) ];
+
+    return u;
+  }
+
+  /** @returns Number of indices in the data structure */
+  std::size_t size() const noexcept
+  {
+    return _parent.size();
+  }
+
+  /**
+    Enumerates all roots, i.e. all indices that have themselves as a
+    parent, and stores them using an output iterator. Roots are reported
+    in ascending order.
+  */
+
+  template <class OutputIterator> void roots( OutputIterator result ) const
+  {
+    for( std::size_t i = 0; i < _parent.size(); i++ )
+      if( _parent[i] == Index(i) )
+        *result++ = Index(i);
+  }
+
+private:
+
+  /** Parent of every index */
+  std::vector<Index> _parent;
+
+  /** Upper bound of the height of every tree; at most logarithmic */
+  std::vector<unsigned char> _rank;
+};
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,849 @@
+#ifndef ALEPH_TOPOLOGY_FLAT_SIMPLICIAL_COMPLEX_HH__
+#define ALEPH_TOPOLOGY_FLAT_SIMPLICIAL_COMPLEX_HH__
+
+#include <boost/iterator/permutation_iterator.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/**
+  @class FlatSimplicialComplex
+  @brief Simplicial complex with contiguous simplex storage
+
+  Provides the same interface as `SimplicialComplex` but stores all
+  simplices in a single vector, in their current filtration order. The
+  auxiliary structures for queries are only built when they are used
+  for the first time:
+
+  - A hash table of simplex indices for `find()`, `contains()`, and
+    `index()`, as well as for checking uniqueness in `push_back()`
+  - A sorted index array for traversing simplices lexicographically
+  - A sorted index array for traversing simplices by dimension and for
+    range queries
+
+  Operations that change the order of simplices, such as `sort()`, only
+  invalidate these structures. In contrast to `SimplicialComplex`, the
+  constructors do not check the input range for duplicates, which makes
+  bulk construction a linear-time operation. If a range contains the same
+  simplex multiple times, queries will refer to its first occurrence.
+  Single simplices that are added by `push_back()` or `insert()` are
+  checked, though, and ignored if they are part of the complex already.
+
+  Simplices within the same dimension are traversed in their filtration
+  order by the dimension iterators.
+*/
+
+template <class Simplex> class FlatSimplicialComplex
+{
+  using simplex_container_t = std::vector<Simplex>;
+  using index_container_t   = std::vector<std::size_t>;
+
+public:
+
+  // Typedefs ----------------------------------------------------------
+  //
+  // Simplices may only be changed through the complex in order to keep
+  // the lookup structures consistent, so all iterators are constant.
+
+  using const_iterator                 = typename simplex_container_t::const_iterator;
+  using iterator                       = const_iterator;
+
+  using const_lexicographical_iterator = boost::permutation_iterator<const_iterator, typename index_container_t::const_iterator>;
+  using lexicographical_iterator       = const_lexicographical_iterator;
+
+  using const_dimension_iterator       = boost::permutation_iterator<const_iterator, typename index_container_t::const_iterator>;
+  using dimension_iterator             = const_dimension_iterator;
+
+  // STL-like typedefs -------------------------------------------------
+
+  using value_type = Simplex;
+  using ValueType  = value_type;
+
+  // Constructors ------------------------------------------------------
+
+  /** Creates an empty simplicial complex. */
+  FlatSimplicialComplex()
+  {
+  }
+
+  /**
+    Creates a simplicial complex from an initializer list of simplices.
+
+    @param simplices Simplices to insert into the simplicial complex
+  */
+
+  FlatSimplicialComplex( std::initializer_list<Simplex> simplices )
+    : _simplices( simplices.begin(), simplices.end() )
+  {
+  }
+
+  /**
+    Creates a simplicial complex from a given range of simplices. The
+    range is not checked for duplicates.
+
+    @param begin  Iterator pointing to begin of range
+    @param end    Iterator pointing to end of range
+  */
+
+  template <class InputIterator> FlatSimplicialComplex( InputIterator begin, InputIterator end )
+    : _simplices( begin, end )
+  {
+  }
+
+  // Simplex container modification ------------------------------------
+
+  /** Clears the simplicial complex and removes all its simplices. */
+  void clear()
+  {
+    _simplices.clear();
+    this->invalidate();
+  }
+
+  /**
+    Given a range of simplices represented by two arbitrary input iterators,
+    inserts the simplices into the simplicial complex. Simplices that are
+    already part of the complex are ignored.
+
+    @param begin Iterator to begin of input range
+    @param end   Iterator to end of input range
+  */
+
+  template <class InputIterator> void insert( InputIterator begin, InputIterator end )
+  {
+    for( ; begin != end; ++begin )
+      this->push_back( *begin );
+  }
+
+  /**
+    Inserts a new simplex into the simplicial complex unless it is part
+    of the complex already. The simplex is appended to the current
+    filtration order, so the simplicial complex should be sorted again
+    afterwards.
+
+    @param simplex Simplex to insert into simplicial complex
+  */
+
+  void push_back( const Simplex& simplex )
+  {
+    if( this->lookup( simplex ) != npos )
+      return;
+
+    _simplices.push_back( simplex );
+
+    _lexicographicalValid = false;
+    _dimensionalValid     = false;
+
+    // Keeps the load factor of the hash table below one half; this
+    // only happens for a logarithmic number of insertions.
+    if( 2 * _simplices.size() > _table.size() )
+      _tableValid = false;
+    else
+      this->insertIntoTable( _simplices.size() - 1 );
+  }
+
+  /**
+    Rearranges the simplices in the simplicial complex using an external view
+    that contains each element exactly once. The view must refer to the
+    simplices that are stored in the complex, e.g. by containing references
+    to them.
+
+    @param first Input iterator to the beginning of the view
+  */
+
+  template <typename InputIterator> void rearrange( InputIterator first )
+  {
+    simplex_container_t simplices;
+    simplices.reserve( _simplices.size() );
+
+    for( std::size_t i = 0; i < _simplices.size(); i++, ++first )
+    {
+      const Simplex& simplex = *first;
+      simplices.push_back( simplex );
+    }
+
+    _simplices.swap( simplices );
+    this->invalidate();
+  }
+
+  /**
+    Replaces a simplex stored in the simplicial complex (described by an
+    iterator) by another simplex. The replacement fails if the new simplex
+    differs from the old one and is already part of the complex.
+
+    @param position Iterator describing the simplex that is to be replaced
+    @param simplex  Simplex to replace the simplex with
+
+    @returns true if the replacement took place, else false.
+  */
+
+  bool replace( iterator position, const Simplex& simplex )
+  {
+    auto index = static_cast<std::size_t>( std::distance( this->begin(), position ) );
+
+    // Only the data changes, so the lookup structures (which do not
+    // consider the data) remain valid.
+    if( _simplices[index] == simplex )
+    {
+      _simplices[index] = simplex;
+      return true;
+    }
+
+    if( this->lookup( simplex ) != npos )
+      return false;
+
+    _simplices[index] = simplex;
+    this->invalidate();
+
+    return true;
+  }
+
+  // Simplex container access ------------------------------------------
+
+  /** @returns Iterator to begin of simplices in current filtration order */
+  const_iterator begin() const
+  {
+    return _simplices.begin();
+  }
+
+  /** @returns Iterator to end of simplices in current filtration order */
+  const_iterator end() const
+  {
+    return _simplices.end();
+  }
+
+  /**
+    @param   index Simplex index
+    @returns Simplex at corresponding index position. Invalid indices will not
+    be caught.
+  */
+
+  const Simplex& operator[]( std::size_t index ) const
+  {
+    return _simplices[index];
+  }
+
+  /**
+    @param   index Simplex index
+    @returns Simplex at corresponding index position
+    @throws  std::out_of_range for invalid indices
+  */
+
+  const Simplex& at( std::size_t index ) const
+  {
+    return _simplices.at( index );
+  }
+
+  /** @returns Iterator to begin of simplices in lexicographical order. */
+  const_lexicographical_iterator begin_lexicographical() const
+  {
+    this->buildLexicographicalIndex();
+    return const_lexicographical_iterator( _simplices.begin(), _lexicographical.begin() );
+  }
+
+  /** @returns Iterator to end of simplices in lexicographical order. */
+  const_lexicographical_iterator end_lexicographical() const
+  {
+    this->buildLexicographicalIndex();
+    return const_lexicographical_iterator( _simplices.begin(), _lexicographical.end() );
+  }
+
+  /** @returns Iterator to begin of simplices in dimensional order. */
+  const_dimension_iterator begin_dimension() const
+  {
+    this->buildDimensionalIndex();
+    return const_dimension_iterator( _simplices.begin(), _dimensional.begin() );
+  }
+
+  /** @returns Iterator to end of simplices in dimensional order. */
+  const_dimension_iterator end_dimension() const
+  {
+    this->buildDimensionalIndex();
+    return const_dimension_iterator( _simplices.begin(), _dimensional.end() );
+  }
+
+  /**
+    Given an output iterator, calculates the vertex set of the simplicial
+    complex. The vertices are guaranteed to be reported in ascending order.
+
+    @param result Output iterator for storing the result
+  */
+
+  template <class OutputIterator> void vertices( OutputIterator result ) const
+  {
+    std::set<typename Simplex::vertex_type> vertices;
+
+    const_dimension_iterator d_it;
+    const_dimension_iterator d_it_end;
+
+    for( std::tie( d_it, d_it_end ) = this->range( 0 );
+         d_it != d_it_end;
+         ++d_it )
+    {
+      vertices.insert( *( d_it->begin() ) );
+    }
+
+    std::copy( vertices.begin(), vertices.end(), result );
+  }
+
+  /**
+    Checks whether the simplicial complex contains a given simplex. Only the
+    vertices of the simplex are taken into account.
+
+    @param simplex Simplex whose existence is checked
+    @returns true if the simplicial complex contains the simplex, else false.
+  */
+
+  bool contains( const Simplex& simplex ) const
+  {
+    return this->lookup( simplex ) != npos;
+  }
+
+  /**
+    Searches the simplicial complex for a given simplex and, if found, returns
+    an iterator to it. No user data is taken into account here.
+
+    @param simplex Simplex to query complex for
+
+    @returns Iterator to simplex, or an iterator to the end of the simplicial
+    complex if the complex does not contain the given simplex.
+  */
+
+  const_iterator find( const Simplex& simplex ) const
+  {
+    auto index = this->lookup( simplex );
+
+    if( index != npos )
+      return _simplices.begin() + static_cast<std::ptrdiff_t>( index );
+    else
+      return this->end();
+  }
+
+  /**
+    Given a simplex contained by the simplicial complex, looks up its index in
+    the current filtration order.
+
+    @param simplex Simplex
+
+    @returns Index of simplex in current filtration
+
+    @throws std::runtime_error if the simplex is not part of the simplicial
+    complex.
+  */
+
+  std::size_t index( const Simplex& simplex ) const
+  {
+    auto index = this->lookup( simplex );
+
+    if( index != npos )
+      return index;
+    else
+      throw std::runtime_error( "Queried simplex does not exist" );
+  }
+
+  /** @returns Number of simplices stored in simplicial complex */
+  std::size_t size() const
+  {
+    return _simplices.size();
+  }
+
+  /**
+    @returns true if the simplicial is empty, i.e. if it does not contain any
+    simplices.
+  */
+
+  bool empty() const
+  {
+    return _simplices.empty();
+  }
+
+  /** @returns Maximum dimension of simplices stored in simplicial complex */
+  std::size_t dimension() const
+  {
+    if( !this->empty() )
+    {
+      this->buildDimensionalIndex();
+      return _simplices[ _dimensional.back() ].dimension();
+    }
+    else
+      throw std::runtime_error( "Unable to query dimensionality of empty simplicial complex" );
+  }
+
+  // Range queries -----------------------------------------------------
+
+  /**
+    Given a dimension, extracts all simplices whose dimension matches the
+    user-specified one, and returns a pair of iterators for this range.
+
+    @param dimension Dimension to extract simplices from
+
+    @returns Pair of iterators describing the range of simplices matching the
+    dimension. Note that the range is allowed to be empty.
+  */
+
+  std::pair<const_dimension_iterator, const_dimension_iterator> range( std::size_t dimension ) const
+  {
+    return this->range( [&] ( std::size_t d ) { return d >= dimension; },
+                        [&] ( std::size_t d ) { return d <= dimension; } );
+  }
+
+  /**
+    Given predicates describing the lower and upper bounds of a range of
+    dimensions, returns a pair of iterators for this range.
+
+    @param lower Predicate describing lower bound of range
+    @param upper Predicate describing upper bound of range
+
+    @returns Pair of iterators describing the requested range.
+   */
+
+  template <typename LowerBounder, typename UpperBounder>
+  std::pair<const_dimension_iterator, const_dimension_iterator> range( LowerBounder lower,
+                                                                       UpperBounder upper ) const
+  {
+    this->buildDimensionalIndex();
+
+    auto first = std::partition_point( _dimensional.begin(), _dimensional.end(),
+                                       [&] ( std::size_t i )
+                                       {
+                                         return !lower( _simplices[i].dimension() );
+                                       } );
+
+    auto last = std::partition_point( first, _dimensional.end(),
+                                      [&] ( std::size_t i )
+                                      {
+                                        return upper( _simplices[i].dimension() );
+                                      } );
+
+    return std::make_pair( const_dimension_iterator( _simplices.begin(), first ),
+                           const_dimension_iterator( _simplices.begin(), last ) );
+  }
+
+  // Filtration modification -------------------------------------------
+
+  /**
+    Allows changing the current order of simplices, i.e. applying a certain
+    simplicial filtration. The sort is stable.
+
+    See the aleph::topology::filtrations namespace for admissible functors.
+
+    @param comparison Simplex comparison object (or function)
+  */
+
+  template <class Comparison> void sort( Comparison&& comparison )
+  {
+    std::stable_sort( _simplices.begin(), _simplices.end(), std::ref( comparison ) );
+    this->invalidate();
+  }
+
+  /** Sorts simplices according to their builtin comparison function */
+  void sort()
+  {
+    std::stable_sort( _simplices.begin(), _simplices.end() );
+    this->invalidate();
+  }
+
+  // -------------------------------------------------------------------
+
+  /**
+    Uses a range of vertex weights to recalculate all weights in the simplicial
+    complex. Each higher-dimensional simplex is assigned the maximum of the
+    weights of its lower-dimensional faces.
+
+    @param begin Input iterator to begin of range
+    @param end   Input iterator to end of range
+  */
+
+  template <class InputIterator> void recalculateWeights( InputIterator begin,
+                                                          InputIterator end )
+  {
+    using data_type_  = typename std::iterator_traits<InputIterator>::value_type;
+    using data_type   = typename Simplex::data_type;
+    using vertex_type = typename Simplex::vertex_type;
+
+    static_assert( std::is_same<data_type_, data_type>::value, "Data types must agree" );
+
+    std::vector<data_type> weights( begin, end );
+
+    for( auto&& simplex : _simplices )
+    {
+      if( simplex.dimension() == 0 )
+      {
+        vertex_type v = *( simplex.begin() );
+        simplex.setData( weights.at(v) );
+      }
+      else
+        simplex.setData( std::numeric_limits<data_type>::max() );
+    }
+
+    this->recalculateWeights();
+  }
+
+  // -------------------------------------------------------------------
+
+  /**
+    Recalculates simplex weights by assigning each simplex the maximum
+    or minimum weight of its faces. Note that 0-dimensional simplices,
+    i.e. vertices, are _always_ skipped by this function.
+
+    @param useMaximum If set, uses the maximum data assigned to a face of a
+    simplex in order to assign its final weight.
+
+    @param skipOneDimensionalSimplices If set, skips both 0-dimensional and
+    1-dimensional simplices and accepts their weights as the given truth.
+  */
+
+  void recalculateWeights( bool useMaximum = true, bool skipOneDimensionalSimplices = false )
+  {
+    using DataType = typename Simplex::DataType;
+
+    this->buildDimensionalIndex();
+
+    for( auto&& i : _dimensional )
+    {
+      auto&& simplex = _simplices[i];
+
+      if(    ( simplex.dimension() == 0 )
+          || ( skipOneDimensionalSimplices && simplex.dimension() == 1 ) )
+      {
+        continue;
+      }
+
+      DataType weight
+        = useMaximum ? std::numeric_limits<DataType>::lowest()
+                     : std::numeric_limits<DataType>::max();
+
+      for( auto itBoundary = simplex.begin_boundary();
+           itBoundary != simplex.end_boundary();
+           ++itBoundary )
+      {
+        auto index = this->lookup( *itBoundary );
+
+        // Missing faces are ignored. This is useful when a filtration is
+        // only partially defined.
+        if( index != npos )
+        {
+          weight = useMaximum ? std::max( weight, _simplices[index].data() )
+                              : std::min( weight, _simplices[index].data() );
+        }
+      }
+
+      // Changing the data does not affect any lookup structure.
+      simplex.setData( weight );
+    }
+  }
+
+  // Container modification --------------------------------------------
+
+  /**
+    Allows simplex removal by value. The simplicial complex will check whether
+    the given simplex exists. If so, it will be erased. Erasing a simplex also
+    removes all of its co-faces in order to remain valid.
+
+    @param simplex Simplex to remove
+  */
+
+  void remove( const Simplex& simplex )
+  {
+    this->remove_without_validation( simplex );
+
+    bool foundInvalidSimplex = false;
+
+    do
+    {
+      std::vector<char> invalid( _simplices.size() );
+
+      for( std::size_t i = 0; i < _simplices.size(); i++ )
+        invalid[i] = !this->checkValidity( _simplices[i] );
+
+      foundInvalidSimplex = std::find( invalid.begin(), invalid.end(), true ) != invalid.end();
+
+      if( foundInvalidSimplex )
+      {
+        std::size_t j = 0;
+
+        for( std::size_t i = 0; i < _simplices.size(); i++ )
+        {
+          if( !invalid[i] )
+          {
+            if( i != j )
+              _simplices[j] = std::move( _simplices[i] );
+
+            ++j;
+          }
+        }
+
+        _simplices.erase( _simplices.begin() + static_cast<std::ptrdiff_t>( j ), _simplices.end() );
+        this->invalidate();
+      }
+    }
+    while( foundInvalidSimplex );
+  }
+
+  /**
+    Permits simplex removal by value. The function does *not* check
+    whether additional co-faces will have to be removed. Hence, the
+    complex may be invalid afterwards.
+  */
+
+  void remove_without_validation( const Simplex& simplex )
+  {
+    _simplices.erase( std::remove( _simplices.begin(), _simplices.end(), simplex ),
+                      _simplices.end() );
+
+    this->invalidate();
+  }
+
+  /**
+    Creates all missing faces of the current simplicial complex. When
+    this function is finished, all of the faces for all simplices are
+    part of the simplicial complex.
+  */
+
+  void createMissingFaces()
+  {
+    // Newly-created faces are appended, so they are checked as well.
+    for( std::size_t i = 0; i < _simplices.size(); i++ )
+    {
+      // Copy required because adding faces may invalidate references
+      auto simplex = _simplices[i];
+
+      for( auto itFace = simplex.begin_boundary();
+           itFace != simplex.end_boundary();
+           ++itFace )
+      {
+        // The new simplex shall contain the same vertices as the "face
+        // simplex", but the data from its parent simplex.
+        this->push_back( Simplex( *itFace, simplex.data() ) );
+      }
+    }
+  }
+
+  // Comparison --------------------------------------------------------
+
+  /**
+    Checks two simplicial complexes for equality. This operator will
+    check simplicial complexes for equality but only with respect to
+    their current filtration order.
+  */
+
+  bool operator==( const FlatSimplicialComplex& other ) const
+  {
+    return _simplices == other._simplices;
+  }
+
+  /**
+    Checks whether two simplicial complexes differ by at least one
+    simplex with respect to their current filtration order.
+  */
+
+  bool operator!=( const FlatSimplicialComplex& other ) const
+  {
+    return !this->operator==( other );
+  }
+
+private:
+
+  /** Marker for empty slots of the hash table and for missing simplices */
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /** Invalidates all lookup structures */
+  void invalidate()
+  {
+    _tableValid           = false;
+    _lexicographicalValid = false;
+    _dimensionalValid     = false;
+  }
+
+  /** @returns Initial slot of a simplex in the hash table */
+  std::size_t slot( const Simplex& simplex ) const
+  {
+    // Fibonacci hashing spreads the hash values of simplices with small
+    // vertex indices over the whole table.
+    auto h = static_cast<std::uint64_t>( std::hash<Simplex>()( simplex ) );
+    h     *= UINT64_C(11400714819323198485);
+
+    return static_cast<std::size_t>( h >> 32 ) & ( _table.size() - 1 );
+  }
+
+  /**
+    Inserts the simplex at a given index into the hash table unless it
+    is already present.
+  */
+
+  void insertIntoTable( std::size_t index ) const
+  {
+    auto&& simplex = _simplices[index];
+    auto mask      = _table.size() - 1;
+
+    for( auto s = this->slot( simplex ); ; s = ( s + 1 ) & mask )
+    {
+      if( _table[s] == npos )
+      {
+        _table[s] = index;
+        return;
+      }
+      else if( _simplices[ _table[s] ] == simplex )
+        return;
+    }
+  }
+
+  /** Builds the hash table if it is not valid any more */
+  void buildTable() const
+  {
+    if( _tableValid )
+      return;
+
+    std::size_t size = 16;
+    while( size < 4 * _simplices.size() )
+      size *= 2;
+
+    _table.assign( size, npos );
+
+    for( std::size_t i = 0; i < _simplices.size(); i++ )
+      this->insertIntoTable( i );
+
+    _tableValid = true;
+  }
+
+  /** @returns Index of a simplex, or npos if it is not part of the complex */
+  std::size_t lookup( const Simplex& simplex ) const
+  {
+    this->buildTable();
+
+    auto mask = _table.size() - 1;
+
+    for( auto s = this->slot( simplex ); ; s = ( s + 1 ) & mask )
+    {
+      auto index = _table[s];
+
+      if( index == npos || _simplices[index] == simplex )
+        return index;
+    }
+  }
+
+  void buildLexicographicalIndex() const
+  {
+    if( _lexicographicalValid )
+      return;
+
+    _lexicographical.resize( _simplices.size() );
+    std::iota( _lexicographical.begin(), _lexicographical.end(), std::size_t(0) );
+
+    std::stable_sort( _lexicographical.begin(), _lexicographical.end(),
+                      [this] ( std::size_t i, std::size_t j )
+                      {
+                        return _simplices[i] < _simplices[j];
+                      } );
+
+    _lexicographicalValid = true;
+  }
+
+  void buildDimensionalIndex() const
+  {
+    if( _dimensionalValid )
+      return;
+
+    _dimensional.resize( _simplices.size() );
+    std::iota( _dimensional.begin(), _dimensional.end(), std::size_t(0) );
+
+    std::stable_sort( _dimensional.begin(), _dimensional.end(),
+                      [this] ( std::size_t i, std::size_t j )
+                      {
+                        return _simplices[i].dimension() < _simplices[j].dimension();
+                      } );
+
+    _dimensionalValid = true;
+  }
+
+  /**
+    Checks validity of a single simplex. A simplex in the simplicial complex is
+    deemed valid if all of its faces can be found in the complex.
+  */
+
+  bool checkValidity( const Simplex& simplex ) const
+  {
+    for( auto itFace = simplex.begin_boundary();
+         itFace != simplex.end_boundary();
+         ++itFace )
+    {
+      if( this->lookup( *itFace ) == npos )
+        return false;
+    }
+
+    return true;
+  }
+
+  /** Simplices in their current filtration order */
+  simplex_container_t _simplices;
+
+  /** Open-addressing hash table of simplex indices */
+  mutable index_container_t _table;
+
+  /** Simplex indices in lexicographical order */
+  mutable index_container_t _lexicographical;
+
+  /** Simplex indices in dimensional order */
+  mutable index_container_t _dimensional;
+
+  mutable bool _tableValid           = false;
+  mutable bool _lexicographicalValid = false;
+  mutable bool _dimensionalValid     = false;
+};
+
+template <class Simplex> constexpr std::size_t FlatSimplicialComplex<Simplex>::npos;
+
+// ---------------------------------------------------------------------
+
+/**
+  Adds information about a simplicial complex to an output stream. This
+  is useful for debugging purposes or intensive logging.
+
+  @param o ostream to add simplicial complex to
+  @param S Simplicial complex to stream to ostream
+
+  @returns ostream with information about simplicial complex
+*/
+
+template <class Simplex> std::ostream& operator<<( std::ostream& o,
+                                                   const topology::FlatSimplicialComplex<Simplex>& S )
+{
+  if( S.empty() )
+    return o;
+
+  o << std::string( 80, '-' ) << "\n";
+
+  for( auto it = S.begin(); it != S.end(); ++it )
+    o << *it << "\n";
+
+  o << std::string( 80, '-' ) << "\n";
+
+  return o;
+}
+
+// ---------------------------------------------------------------------
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
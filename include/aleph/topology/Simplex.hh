@@ -1,10 +1,11 @@
 #ifndef ALEPH_TOPOLOGY_SIMPLEX_HH__
 #define ALEPH_TOPOLOGY_SIMPLEX_HH__
 
+#include <aleph/containers/SmallVector.hh>
+
 #include <boost/functional/hash.hpp>
 
 #include <boost/iterator/iterator_adaptor.hpp>
-#include <boost/iterator/filter_iterator.hpp>
 
 #include <algorithm>
 #include <initializer_list>
@@ -30,11 +31,15 @@ namespace topology
   @tparam D Data (weight) type, e.g. `double`
   @tparam V Vertex type; usually, you do not have to change this type,
             except if you want to change the memory footprint.
+  @tparam C Container for storing vertices. The container must provide
+            a subset of the interface of `std::vector`. Use `InlineSimplex`
+            for storing the vertices of low-dimensional simplices inline.
 */
 
 template <
   class D,
-  class V = unsigned short
+  class V = unsigned short,
+  class C = std::vector<V>
 >
 class Simplex
 {
@@ -51,7 +56,7 @@ public:
   using data_type                     = DataType;   ///< Data type alias, STL-style
   using vertex_type                   = VertexType; ///< Vertex type alias, STL-style
 
-  using vertex_container_type         = std::vector<vertex_type>;
+  using vertex_container_type         = C;
   using vertex_iterator               = typename vertex_container_type::iterator;
   using const_vertex_iterator         = typename vertex_container_type::const_iterator;
   using reverse_vertex_iterator       = typename vertex_container_type::reverse_iterator;
@@ -92,7 +97,7 @@ public:
     @param data    Data to assign new simplex
   */
 
-  explicit Simplex( const Simplex<DataType, VertexType>& simplex, DataType data )
+  explicit Simplex( const Simplex& simplex, DataType data )
     : _vertices( simplex._vertices )
     , _data( data )
   {
@@ -327,8 +332,8 @@ public:
 
   // Convenience functions ---------------------------------------------
 
-  template <class DataType>                   friend std::size_t hash_value( const Simplex<DataType>& s );
-  template <class DataType, class VertexType> friend std::size_t hash_value( const Simplex<DataType, VertexType>& s );
+  template <class DataType>                                    friend std::size_t hash_value( const Simplex<DataType>& s );
+  template <class DataType, class VertexType, class Container> friend std::size_t hash_value( const Simplex<DataType, VertexType, Container>& s );
 
 private:
 
@@ -350,18 +355,38 @@ private:
   DataType _data;
 };
 
+/**
+  @typedef InlineSimplex
+
+  Simplex whose vertices are stored inline, i.e. without any allocations,
+  provided that its dimension does not exceed the specified maximum. The
+  vertices of higher-dimensional simplices are stored on the heap.
+
+  @tparam D            Data (weight) type
+  @tparam V            Vertex type
+  @tparam MaxDimension Maximum dimension of simplices with inline storage
+*/
+
+template <
+  class D,
+  class V = unsigned short,
+  std::size_t MaxDimension = 3
+>
+using InlineSimplex = Simplex<D, V, containers::SmallVector<V, MaxDimension + 1> >;
+
 // ---------------------------------------------------------------------
 
-template <class DataType, class VertexType>
-std::size_t hash_value( const Simplex<DataType, VertexType>& s )
+template <class DataType, class VertexType, class Container>
+std::size_t hash_value( const Simplex<DataType, VertexType, Container>& s )
 {
-  boost::hash< typename Simplex<DataType, VertexType>::vertex_container_type > hasher;
-  return hasher( s._vertices );
+  // Hashing the range of vertices directly gives the same values for all
+  // containers and does not require a copy of the vertices.
+  return boost::hash_range( s._vertices.begin(), s._vertices.end() );
 }
 
 template <class DataType> std::size_t hash_value( const Simplex<DataType>& s )
 {
-  return hash_value<DataType, typename Simplex<DataType>::vertex_type>( s );
+  return hash_value<DataType, typename Simplex<DataType>::vertex_type, typename Simplex<DataType>::vertex_container_type>( s );
 }
 
 // ---------------------------------------------------------------------
@@ -380,23 +405,24 @@ template <class DataType> std::size_t hash_value( const Simplex<DataType>& s )
 
 template <
     class DataType,
-    class VertexType
+    class VertexType,
+    class Container
 >
-class Simplex<DataType, VertexType>::boundary_iterator
+class Simplex<DataType, VertexType, Container>::boundary_iterator
   : public boost::iterator_adaptor<boundary_iterator,
                                    const_vertex_iterator,
-                                   Simplex<DataType, VertexType>,
+                                   Simplex<DataType, VertexType, Container>,
                                    boost::use_default,
-                                   Simplex<DataType, VertexType> >
+                                   Simplex<DataType, VertexType, Container> >
 {
 public:
 
   using Iterator = const_vertex_iterator ;
   using Parent   = boost::iterator_adaptor<boundary_iterator,
                                            Iterator,
-                                           Simplex<DataType, VertexType>,
+                                           Simplex<DataType, VertexType, Container>,
                                            boost::use_default,
-                                           Simplex<DataType, VertexType> >;
+                                           Simplex<DataType, VertexType, Container> >;
 
   /**
     Creates a new boundary iterator from a parent iterator (i.e. a simplex) and a
@@ -417,23 +443,22 @@ private:
   friend class boost::iterator_core_access;
 
   /** @returns Current boundary simplex */
-  Simplex<DataType, VertexType> dereference() const
+  Simplex<DataType, VertexType, Container> dereference() const
   {
-    // This returns a new simplex. The simplex is created from a set of
-    // vertices, which in turn is created by applying a filter to the set of
-    // vertices stored in this iterator: Namely, the filter iterator will
-    // return all vertices that are _not_ equal to its current position.
-
-    vertex_container_type vertices(
-          boost::make_filter_iterator( std::bind2nd( std::not_equal_to<vertex_type>(), *( this->base() ) ),
-                                                     _vertices.begin(),
-                                                     _vertices.end() ),
-          boost::make_filter_iterator( std::bind2nd( std::not_equal_to<vertex_type>(), *( this->base() ) ),
-                                                     _vertices.end(),
-                                                     _vertices.end() )
-          );
-
-    return Simplex<DataType, VertexType>( vertices.begin(), vertices.end() );
+    // This returns a new simplex that contains all vertices that are _not_
+    // equal to the current position. Since the vertices of the parent are
+    // sorted and unique already, they can be copied directly. No further
+    // copies are required, so this does not touch the heap for containers
+    // with inline storage.
+
+    Simplex<DataType, VertexType, Container> simplex;
+    simplex._vertices.reserve( _vertices.size() - 1 );
+
+    for( auto&& vertex : _vertices )
+      if( vertex != *( this->base() ) )
+        simplex._vertices.push_back( vertex );
+
+    return simplex;
   }
 
   /**
@@ -455,8 +480,8 @@ private:
   @returns Output stream with information about simplex s.
 */
 
-template <class DataType, class VertexType>
-std::ostream& operator<<( std::ostream& o, const topology::Simplex<DataType, VertexType>& s )
+template <class DataType, class VertexType, class Container>
+std::ostream& operator<<( std::ostream& o, const topology::Simplex<DataType, VertexType, Container>& s )
 {
   auto numVertices = s.size();
 
@@ -493,9 +518,9 @@ namespace std
   above.
 */
 
-template<class DataType, class VertexType> struct hash<aleph::topology::Simplex<DataType, VertexType> >
+template<class DataType, class VertexType, class Container> struct hash<aleph::topology::Simplex<DataType, VertexType, Container> >
 {
-  using argument_type = aleph::topology::Simplex<DataType, VertexType>;
+  using argument_type = aleph::topology::Simplex<DataType, VertexType, Container>;
   using result_type   = std::size_t;
 
   result_type operator()( const argument_type& simplex ) const noexcept
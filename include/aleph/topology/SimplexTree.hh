@@ -0,0 +1,440 @@
+#ifndef ALEPH_TOPOLOGY_SIMPLEX_TREE_HH__
+#define ALEPH_TOPOLOGY_SIMPLEX_TREE_HH__
+
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/**
+  @class SimplexTree
+  @brief Trie-based representation of a simplicial complex
+
+  Stores a simplicial complex as a trie over the vertex sequences of its
+  simplices, sorted in ascending order. Every node of the trie corresponds
+  to exactly one simplex, namely the one described by the path from the
+  root to the node, and stores the data, i.e. the filtration value, of
+  that simplex.
+
+  The children of a node are kept sorted by their vertex, so looking up a
+  simplex of dimension \f$d\f$ requires \f$d+1\f$ binary searches. Nodes
+  with the same vertex label are connected by sibling links, which makes
+  it possible to enumerate the cofaces of a simplex without traversing
+  the whole complex or hashing any simplices.
+
+  The simplex tree is always closed under taking faces: inserting a
+  simplex also inserts all of its missing faces.
+
+  The data structure is described in:
+
+  > The Simplex Tree: An Efficient Data Structure for General Simplicial Complexes
+  > Jean-Daniel Boissonnat, Clément Maria
+  > Algorithmica 70(3), pp. 406--427, 2014
+
+  @tparam Simplex Simplex class for insertion and queries; vertices are
+                  assumed to be non-negative integers
+*/
+
+template <class Simplex> class SimplexTree
+{
+public:
+  using DataType   = typename Simplex::DataType;
+  using VertexType = typename Simplex::VertexType;
+  using ValueType  = Simplex;
+  using value_type = ValueType;
+
+  /** Creates an empty simplex tree */
+  SimplexTree()
+    : _nodes( 1 )
+  {
+  }
+
+  /**
+    Creates a simplex tree from a range of simplices. If a simplex occurs
+    multiple times, the data of its first occurrence is used. The same
+    goes for faces that are created automatically.
+
+    @param begin Iterator to begin of range
+    @param end   Iterator to end of range
+  */
+
+  template <class InputIterator> SimplexTree( InputIterator begin, InputIterator end )
+    : _nodes( 1 )
+  {
+    for( ; begin != end; ++begin )
+      this->insert( *begin );
+  }
+
+  /**
+    Inserts a simplex into the simplex tree. Missing faces of the simplex
+    are inserted as well and are assigned the data of the simplex. If the
+    simplex is already present, its data will not be changed.
+
+    @param simplex Simplex to insert
+
+    @returns true if the simplex has been inserted, false if it has been
+    present already.
+  */
+
+  bool insert( const Simplex& simplex )
+  {
+    if( simplex.empty() )
+      return false;
+
+    // Vertices of the simplex in ascending order
+    std::vector<VertexType> vertices( simplex.rbegin(), simplex.rend() );
+
+    bool inserted = this->contains( simplex ) == false;
+
+    if( inserted )
+      this->insert( vertices, 0, 0, simplex.data() );
+
+    return inserted;
+  }
+
+  /** @returns true if the simplex tree contains the simplex */
+  bool contains( const Simplex& simplex ) const
+  {
+    return this->find( simplex ) != npos;
+  }
+
+  /**
+    @returns Data of a simplex in the simplex tree
+    @throws std::runtime_error if the simplex is not part of the tree
+  */
+
+  DataType data( const Simplex& simplex ) const
+  {
+    auto node = this->find( simplex );
+
+    if( node == npos )
+      throw std::runtime_error( "Queried simplex does not exist" );
+
+    return _nodes[node].data;
+  }
+
+  /**
+    Changes the data of a simplex in the simplex tree. No checks for the
+    consistency of the filtration are performed.
+
+    @throws std::runtime_error if the simplex is not part of the tree
+  */
+
+  void setData( const Simplex& simplex, DataType data )
+  {
+    auto node = this->find( simplex );
+
+    if( node == npos )
+      throw std::runtime_error( "Queried simplex does not exist" );
+
+    _nodes[node].data = data;
+  }
+
+  /**
+    Reports the cofaces of a simplex, i.e. all simplices that contain the
+    simplex as a proper face. The simplex itself does not have to be part
+    of the simplex tree.
+
+    @param simplex     Simplex whose cofaces are reported
+    @param result      Output iterator for storing the cofaces
+    @param codimension If non-zero, only cofaces whose dimension exceeds
+                       the dimension of the simplex by this amount will
+                       be reported. For example, setting this to 1 will
+                       only report the cofacets of a simplex.
+  */
+
+  template <class OutputIterator> void cofaces( const Simplex& simplex, OutputIterator result, std::size_t codimension = 0 ) const
+  {
+    if( simplex.empty() )
+      return;
+
+    // The largest vertex of the simplex is part of every path from the
+    // root to a coface.
+    auto vertex = *simplex.begin();
+    auto size   = simplex.size();
+
+    if( !this->hasLabel( vertex ) )
+      return;
+
+    std::vector<VertexType> path;
+
+    for( auto node = _labels[ std::size_t( vertex ) ]; node != npos; node = _nodes[node].nextLabel )
+    {
+      auto depth = _nodes[node].depth;
+
+      if( depth < size || ( codimension != 0 && depth > size + codimension ) )
+        continue;
+
+      if( !this->containsPath( node, simplex ) )
+        continue;
+
+      // All simplices in the subtree of the node are cofaces, with the
+      // exception of the node itself if it represents the simplex.
+      this->path( node, path );
+      this->traverse( node, path, depth == size, size + codimension, codimension != 0, result );
+    }
+  }
+
+  /**
+    Reports all simplices of the simplex tree in lexicographical order
+    of their ascending vertex sequences.
+
+    @param result Output iterator for storing the simplices
+  */
+
+  template <class OutputIterator> void simplices( OutputIterator result ) const
+  {
+    std::vector<VertexType> path;
+    this->traverse( 0, path, true, 0, false, result );
+  }
+
+  /** @returns Number of simplices in the simplex tree */
+  std::size_t size() const
+  {
+    return _nodes.size() - 1;
+  }
+
+  /** @returns true if the simplex tree does not contain any simplices */
+  bool empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+    @returns Maximum dimension of the simplices in the simplex tree
+    @throws std::runtime_error for empty simplex trees
+  */
+
+  std::size_t dimension() const
+  {
+    if( this->empty() )
+      throw std::runtime_error( "Unable to query dimensionality of empty simplex tree" );
+
+    std::size_t depth = 0;
+    for( auto&& node : _nodes )
+      depth = std::max( depth, node.depth );
+
+    return depth - 1;
+  }
+
+private:
+
+  /** Marker for missing nodes */
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  struct Node
+  {
+    VertexType  vertex    = VertexType();
+    DataType    data      = DataType();
+    std::size_t parent    = npos;
+    std::size_t nextLabel = npos;
+    std::size_t depth     = 0;
+
+    /** Children of the node, sorted by their vertex */
+    std::vector<std::size_t> children;
+  };
+
+  /** @returns Child of a node with a given vertex, or npos */
+  std::size_t child( std::size_t node, VertexType vertex ) const
+  {
+    auto&& children = _nodes[node].children;
+    auto it         = std::lower_bound( children.begin(), children.end(), vertex,
+                                        [this] ( std::size_t c, VertexType v )
+                                        {
+                                          return _nodes[c].vertex < v;
+                                        } );
+
+    if( it != children.end() && _nodes[*it].vertex == vertex )
+      return *it;
+    else
+      return npos;
+  }
+
+  /** @returns Node of a simplex, or npos if the simplex does not exist */
+  std::size_t find( const Simplex& simplex ) const
+  {
+    if( simplex.empty() )
+      return npos;
+
+    std::size_t node = 0;
+
+    for( auto it = simplex.rbegin(); it != simplex.rend() && node != npos; ++it )
+      node = this->child( node, *it );
+
+    return node;
+  }
+
+  /**
+    Inserts all simplices that are spanned by a suffix of a sorted
+    sequence of vertices below a given node, i.e. the node itself and
+    all of its faces that extend the node.
+  */
+
+  void insert( const std::vector<VertexType>& vertices, std::size_t first, std::size_t node, DataType data )
+  {
+    for( std::size_t i = first; i < vertices.size(); i++ )
+    {
+      auto c = this->child( node, vertices[i] );
+
+      if( c == npos )
+        c = this->addChild( node, vertices[i], data );
+
+      this->insert( vertices, i + 1, c, data );
+    }
+  }
+
+  /** Adds a new child with a given vertex to a node */
+  std::size_t addChild( std::size_t node, VertexType vertex, DataType data )
+  {
+    auto index = _nodes.size();
+
+    Node child;
+    child.vertex = vertex;
+    child.data   = data;
+    child.parent = node;
+    child.depth  = _nodes[node].depth + 1;
+
+    auto label = std::size_t( vertex );
+
+    if( _labels.size() <= label )
+      _labels.resize( label + 1, npos );
+
+    child.nextLabel = _labels[label];
+    _labels[label]  = index;
+
+    _nodes.push_back( child );
+
+    auto&& children = _nodes[node].children;
+    auto it         = std::lower_bound( children.begin(), children.end(), vertex,
+                                        [this] ( std::size_t c, VertexType v )
+                                        {
+                                          return _nodes[c].vertex < v;
+                                        } );
+
+    children.insert( it, index );
+    return index;
+  }
+
+  /** @returns true if nodes with a given vertex label exist */
+  bool hasLabel( VertexType vertex ) const
+  {
+    return std::size_t( vertex ) < _labels.size() && _labels[ std::size_t( vertex ) ] != npos;
+  }
+
+  /** Checks whether the path from a node to the root contains a simplex */
+  bool containsPath( std::size_t node, const Simplex& simplex ) const
+  {
+    // Both the path and the simplex are traversed with decreasing
+    // vertices.
+    auto it = simplex.begin();
+
+    for( ; node != 0 && it != simplex.end(); node = _nodes[node].parent )
+    {
+      if( _nodes[node].vertex == *it )
+        ++it;
+      else if( _nodes[node].vertex < *it )
+        return false;
+    }
+
+    return it == simplex.end();
+  }
+
+  /** Stores the vertices along the path from the root to a node */
+  void path( std::size_t node, std::vector<VertexType>& vertices ) const
+  {
+    vertices.clear();
+
+    for( ; node != 0; node = _nodes[node].parent )
+      vertices.push_back( _nodes[node].vertex );
+
+    std::reverse( vertices.begin(), vertices.end() );
+  }
+
+  /**
+    Reports all simplices in the subtree of a node in depth-first order.
+
+    @param node     Node to start the traversal with
+    @param path     Vertices along the path from the root to the node
+    @param skip     Flag indicating whether the node itself is skipped
+    @param depth    Maximum depth of nodes to report
+    @param limit    Flag indicating whether the depth is limited; if set,
+                    only nodes at the given depth will be reported
+    @param result   Output iterator for storing the simplices
+  */
+
+  template <class OutputIterator> void traverse( std::size_t node,
+                                                 std::vector<VertexType>& path,
+                                                 bool skip,
+                                                 std::size_t depth,
+                                                 bool limit,
+                                                 OutputIterator& result ) const
+  {
+    auto&& current = _nodes[node];
+
+    if( !skip && ( !limit || current.depth == depth ) )
+      *result++ = Simplex( path.begin(), path.end(), current.data );
+
+    if( limit && current.depth >= depth )
+      return;
+
+    for( auto&& c : current.children )
+    {
+      path.push_back( _nodes[c].vertex );
+      this->traverse( c, path, false, depth, limit, result );
+      path.pop_back();
+    }
+  }
+
+  /** Nodes of the trie; the first node is the root */
+  std::vector<Node> _nodes;
+
+  /** First node for every vertex label, used for sibling links */
+  std::vector<std::size_t> _labels;
+};
+
+template <class Simplex> constexpr std::size_t SimplexTree<Simplex>::npos;
+
+/**
+  Converts a simplicial complex into a simplex tree, keeping the data of
+  every simplex.
+*/
+
+template <class SimplicialComplex> SimplexTree<typename SimplicialComplex::ValueType> makeSimplexTree( const SimplicialComplex& K )
+{
+  return SimplexTree<typename SimplicialComplex::ValueType>( K.begin(), K.end() );
+}
+
+/**
+  Converts a simplex tree into a simplicial complex. Since the simplex
+  tree does not store the order of simplices, the complex is sorted by
+  the data of its simplices, which results in a valid filtration if the
+  data of every face is less than or equal to the data of its cofaces.
+*/
+
+template <class Simplex> SimplicialComplex<Simplex> makeSimplicialComplex( const SimplexTree<Simplex>& T )
+{
+  std::vector<Simplex> simplices;
+  simplices.reserve( T.size() );
+
+  T.simplices( std::back_inserter( simplices ) );
+
+  std::sort( simplices.begin(), simplices.end(), filtrations::Data<Simplex>() );
+  return SimplicialComplex<Simplex>( simplices.begin(), simplices.end() );
+}
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
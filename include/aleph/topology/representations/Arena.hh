@@ -0,0 +1,244 @@
+#ifndef ALEPH_TOPOLOGY_REPRESENTATIONS_ARENA_HH__
+#define ALEPH_TOPOLOGY_REPRESENTATIONS_ARENA_HH__
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+namespace representations
+{
+
+/**
+  @class Arena
+  @brief Boundary matrix representation with contiguous column storage
+
+  Stores the indices of all columns in a single arena instead of using
+  one container per column. Every column owns a chunk of the arena whose
+  capacity is a power of two. If a column outgrows its chunk, the chunk
+  is returned to a free list for its size class and a new chunk is taken
+  from the pool (or appended to the arena).
+
+  Column additions are calculated in a scratch buffer that is reused by
+  all operations, so the reduction of a matrix performs no allocations
+  apart from the occasional growth of the arena itself.
+*/
+
+template <class IndexType = unsigned> class Arena
+{
+public:
+  using Index = IndexType;
+
+  void setNumColumns( Index numColumns )
+  {
+    _columns.resize( static_cast<std::size_t>( numColumns ) );
+    _dimensions.resize( static_cast<std::size_t>( numColumns ) );
+  }
+
+  Index getNumColumns() const
+  {
+    return static_cast<Index>( _columns.size() );
+  }
+
+  std::pair<Index, bool> getMaximumIndex( Index column ) const
+  {
+    auto&& c = _columns.at( static_cast<std::size_t>( column ) );
+
+    if( c.size == 0 )
+      return std::make_pair( Index(0), false );
+    else
+      return std::make_pair( _entries[ c.offset + c.size - 1 ], true );
+  }
+
+  void addColumns( Index source, Index target )
+  {
+    auto&& sourceColumn = _columns.at( static_cast<std::size_t>( source ) );
+    auto&& targetColumn = _columns.at( static_cast<std::size_t>( target ) );
+
+    // Only grow the scratch buffer; shrinking it would result in
+    // additional initializations the next time it grows.
+    if( _scratch.size() < sourceColumn.size + targetColumn.size )
+      _scratch.resize( sourceColumn.size + targetColumn.size );
+
+    auto sourceBegin = _entries.begin() + static_cast<std::ptrdiff_t>( sourceColumn.offset );
+    auto targetBegin = _entries.begin() + static_cast<std::ptrdiff_t>( targetColumn.offset );
+
+    auto end = std::set_symmetric_difference( sourceBegin, sourceBegin + static_cast<std::ptrdiff_t>( sourceColumn.size ),
+                                              targetBegin, targetBegin + static_cast<std::ptrdiff_t>( targetColumn.size ),
+                                              _scratch.begin() );
+
+    this->assign( target, _scratch.begin(), end );
+  }
+
+  template <class InputIterator> void setColumn( Index column,
+                                                 InputIterator begin, InputIterator end )
+  {
+    _scratch.assign( begin, end );
+
+    // Ensures proper sorting order. Else, the reduction algorithm will
+    // not be able to reduce the matrix.
+    std::sort( _scratch.begin(), _scratch.end() );
+
+    this->assign( column, _scratch.begin(), _scratch.end() );
+
+    // Upon initialization, the column must by necessity have the dimension
+    // that is indicated by the amount of indices in its boundary. The case
+    // of 0-simplices needs special handling.
+    _dimensions.at( static_cast<std::size_t>( column ) )
+        = _scratch.empty() ? 0
+                           : static_cast<Index>( _scratch.size() - 1 );
+  }
+
+  std::vector<Index> getColumn( Index column ) const
+  {
+    auto&& c     = _columns.at( static_cast<std::size_t>( column ) );
+    auto   begin = _entries.begin() + static_cast<std::ptrdiff_t>( c.offset );
+
+    return { begin, begin + static_cast<std::ptrdiff_t>( c.size ) };
+  }
+
+  void clearColumn( Index column )
+  {
+    this->release( _columns.at( static_cast<std::size_t>( column ) ) );
+  }
+
+  void setDimension( Index column, Index dimension )
+  {
+    _dimensions.at( static_cast<std::size_t>( column ) ) = dimension;
+  }
+
+  Index getDimension( Index column ) const
+  {
+    return _dimensions.at( static_cast<std::size_t>( column ) );
+  }
+
+  Index getDimension() const
+  {
+    if( _dimensions.empty() )
+      return Index(0);
+    else
+      return *std::max_element( _dimensions.begin(), _dimensions.end() );
+  }
+
+  bool operator==( const Arena& other ) const
+  {
+    if( _columns.size() != other._columns.size() || _dimensions != other._dimensions )
+      return false;
+
+    // The layout of the arena depends on the order of operations, so
+    // only the contents of individual columns can be compared.
+    for( std::size_t j = 0; j < _columns.size(); j++ )
+    {
+      auto&& c = _columns[j];
+      auto&& d = other._columns[j];
+
+      if( c.size != d.size )
+        return false;
+
+      auto begin1 = _entries.begin()       + static_cast<std::ptrdiff_t>( c.offset );
+      auto begin2 = other._entries.begin() + static_cast<std::ptrdiff_t>( d.offset );
+
+      if( !std::equal( begin1, begin1 + static_cast<std::ptrdiff_t>( c.size ), begin2 ) )
+        return false;
+    }
+
+    return true;
+  }
+
+private:
+
+  /** Describes the chunk of the arena that belongs to a column */
+  struct Column
+  {
+    std::size_t offset   = 0;
+    std::size_t size     = 0;
+    std::size_t capacity = 0;
+  };
+
+  /** @returns Size class of a chunk, i.e. the binary logarithm of its capacity */
+  static std::size_t sizeClass( std::size_t capacity )
+  {
+    std::size_t k = 0;
+
+    while( ( std::size_t(1) << k ) < capacity )
+      ++k;
+
+    return k;
+  }
+
+  /**
+    Stores a sorted range of indices in a column, acquiring a larger
+    chunk if necessary. The range must not overlap with the arena.
+  */
+
+  template <class Iterator> void assign( Index column, Iterator begin, Iterator end )
+  {
+    auto&& c = _columns.at( static_cast<std::size_t>( column ) );
+    auto   n = static_cast<std::size_t>( std::distance( begin, end ) );
+
+    if( n > c.capacity )
+    {
+      this->release( c );
+
+      auto k = sizeClass( n );
+
+      if( _freeChunks.size() <= k )
+        _freeChunks.resize( k + 1 );
+
+      c.capacity = std::size_t(1) << k;
+
+      if( !_freeChunks[k].empty() )
+      {
+        c.offset = _freeChunks[k].back();
+        _freeChunks[k].pop_back();
+      }
+      else
+      {
+        c.offset = _entries.size();
+        _entries.resize( _entries.size() + c.capacity );
+      }
+    }
+
+    std::copy( begin, end, _entries.begin() + static_cast<std::ptrdiff_t>( c.offset ) );
+    c.size = n;
+  }
+
+  /** Returns the chunk of a column to the pool */
+  void release( Column& c )
+  {
+    if( c.capacity != 0 )
+      _freeChunks[ sizeClass( c.capacity ) ].push_back( c.offset );
+
+    c = Column();
+  }
+
+  /** Chunks of all columns */
+  std::vector<Column> _columns;
+
+  /** Storage for the indices of all columns */
+  std::vector<Index> _entries;
+
+  /** Offsets of unused chunks, stored by size class */
+  std::vector< std::vector<std::size_t> > _freeChunks;
+
+  /** Scratch buffer for column operations */
+  std::vector<Index> _scratch;
+
+  std::vector<Index> _dimensions;
+};
+
+} // namespace representations
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,434 @@
+#ifndef ALEPH_TOPOLOGY_REPRESENTATIONS_BIT_TREE_HH__
+#define ALEPH_TOPOLOGY_REPRESENTATIONS_BIT_TREE_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+namespace representations
+{
+
+/**
+  @class BitTree
+  @brief Boundary matrix representation with an active pivot column
+
+  Columns are stored as sorted vectors, just like in the `Vector`
+  representation. The column that is the target of column additions,
+  however, is kept in a 64-ary bit tree while it is being reduced.
+  Adding another column to it only toggles the bits of the entries
+  of the source column, and querying the pivot amounts to following
+  the highest set bit down the tree. There is no need to merge two
+  sorted columns for every addition.
+
+  Loading a column into the tree and converting it back only pays off
+  if the column is the target of several additions. Hence, the first
+  addition to a column merges two sorted vectors, and only subsequent
+  additions to the same column activate the tree. This is the common
+  case for dualized matrices, where most columns need at most a single
+  addition.
+
+  The active column is converted back into a sorted vector as soon as
+  another column becomes the target of an addition or if the column
+  is modified otherwise. This works well with the usual reduction
+  algorithms, which reduce one column at a time.
+
+  The idea follows the bit tree columns of the PHAT library:
+
+  > PHAT -- Persistent Homology Algorithm Toolbox
+  > Ulrich Bauer, Michael Kerber, Jan Reininghaus, Hubert Wagner
+  > Journal of Symbolic Computation, Volume 78, 2017, Pages 76--90
+*/
+
+template <class IndexType = unsigned> class BitTree
+{
+public:
+  using Index = IndexType;
+
+  void setNumColumns( Index numColumns )
+  {
+    this->flush();
+
+    _data.resize( static_cast<std::size_t>( numColumns ) );
+    _dimensions.resize( static_cast<std::size_t>( numColumns ) );
+  }
+
+  Index getNumColumns() const
+  {
+    return static_cast<Index>( _data.size() );
+  }
+
+  std::pair<Index, bool> getMaximumIndex( Index column ) const
+  {
+    if( column == _active )
+      return this->getActiveMaximumIndex();
+
+    auto&& c = _data[ static_cast<std::size_t>( column ) ];
+
+    if( c.empty() )
+      return std::make_pair( Index(0), false );
+    else
+      return std::make_pair( c.back(), true );
+  }
+
+  // Additions are rare in comparison to pivot queries. Keeping them out
+  // of line ensures that the pivot queries of a reduction algorithm are
+  // still being inlined, which matters for matrices with many columns.
+  __attribute__(( noinline )) void addColumns( Index source, Index target )
+  {
+    auto&& sourceColumn = _data.at( static_cast<std::size_t>( source ) );
+
+    if( target != _active )
+    {
+      this->flush();
+
+      if( _target != target )
+      {
+        _target    = target;
+        _numMerges = 0;
+      }
+
+      // The first additions to a column are performed by merging; the
+      // tree is only used for the subsequent additions.
+      if( _numMerges < mergeLimit )
+      {
+        auto&& targetColumn = _data.at( static_cast<std::size_t>( target ) );
+
+        _buffer.clear();
+        _buffer.reserve( sourceColumn.size() + targetColumn.size() );
+
+        std::set_symmetric_difference( sourceColumn.begin(), sourceColumn.end(),
+                                       targetColumn.begin(), targetColumn.end(),
+                                       std::back_inserter( _buffer ) );
+
+        targetColumn.swap( _buffer );
+
+        ++_numMerges;
+        return;
+      }
+
+      this->activate( target );
+    }
+
+    if( sourceColumn.empty() )
+      return;
+
+    this->reserve( static_cast<std::size_t>( sourceColumn.back() ) );
+
+    for( auto&& index : sourceColumn )
+      this->toggle( static_cast<std::size_t>( index ) );
+  }
+
+  template <class InputIterator> void setColumn( Index column,
+                                                 InputIterator begin, InputIterator end )
+  {
+    if( column == _active )
+      this->deactivate();
+
+    if( column == _target )
+      _numMerges = 0;
+
+    _data.at( static_cast<std::size_t>( column ) ).assign( begin, end );
+
+    // Ensures proper sorting order. Else, the reduction algorithm will
+    // not be able to reduce the matrix.
+    std::sort( _data.at( static_cast<std::size_t>( column ) ).begin(), _data.at( static_cast<std::size_t>( column ) ).end() );
+
+    // Upon initialization, the column must by necessity have the dimension
+    // that is indicated by the amount of indices in its boundary. The case
+    // of 0-simplices needs special handling.
+    _dimensions.at( static_cast<std::size_t>( column ) )
+        = begin == end ? 0
+                       : static_cast<Index>( std::distance( begin, end ) - 1 );
+  }
+
+  std::vector<Index> getColumn( Index column ) const
+  {
+    if( column == _active )
+    {
+      std::vector<Index> result;
+
+      // Traversing the leaves is sufficient here because this function
+      // is not part of the reduction itself.
+      for( std::size_t block = _offset; block < _tree.size(); block++ )
+      {
+        for( std::size_t bit = 0; bit < blockSize; bit++ )
+        {
+          if( _tree[block] & mask( bit ) )
+            result.push_back( static_cast<Index>( ( block - _offset ) * blockSize + bit ) );
+        }
+      }
+
+      return result;
+    }
+
+    return _data.at( static_cast<std::size_t>( column ) );
+  }
+
+  void clearColumn( Index column )
+  {
+    if( column == _active )
+      this->deactivate();
+
+    if( column == _target )
+      _numMerges = 0;
+
+    _data.at( static_cast<std::size_t>( column ) ).clear();
+  }
+
+  void setDimension( Index column, Index dimension )
+  {
+    _dimensions.at( static_cast<std::size_t>( column ) ) = dimension;
+  }
+
+  Index getDimension( Index column ) const
+  {
+    return _dimensions.at( static_cast<std::size_t>( column ) );
+  }
+
+  Index getDimension() const
+  {
+    if( _dimensions.empty() )
+      return Index(0);
+    else
+      return *std::max_element( _dimensions.begin(), _dimensions.end() );
+  }
+
+  bool operator==( const BitTree& other ) const
+  {
+    if( _data.size() != other._data.size() || _dimensions != other._dimensions )
+      return false;
+
+    for( std::size_t j = 0; j < _data.size(); j++ )
+      if( this->getColumn( Index(j) ) != other.getColumn( Index(j) ) )
+        return false;
+
+    return true;
+  }
+
+private:
+  using Block = std::uint64_t;
+
+  static constexpr std::size_t blockSize  = 64;
+  static constexpr std::size_t blockShift = 6;
+
+  /** Number of additions to a column that are performed by merging */
+  static constexpr std::size_t mergeLimit = 1;
+
+  /** @returns Maximum index of the active column */
+  std::pair<Index, bool> getActiveMaximumIndex() const
+  {
+    if( _tree.empty() || _tree.front() == 0 )
+      return std::make_pair( Index(0), false );
+    else
+      return std::make_pair( static_cast<Index>( this->getMaximumEntry() ), true );
+  }
+
+  /**
+    Denotes the absence of an active column or a target. The number of
+    columns is always smaller than this value.
+  */
+
+  static constexpr Index none() noexcept
+  {
+    return std::numeric_limits<Index>::max();
+  }
+
+  /**
+    Returns the mask of an entry within its block. Higher entries are
+    stored in lower bits so that the maximum entry of a block is given
+    by its number of trailing zeroes.
+  */
+
+  static Block mask( std::size_t indexInBlock ) noexcept
+  {
+    return Block(1) << ( blockSize - indexInBlock - 1 );
+  }
+
+  /**
+    Sets up an empty tree that is able to store all entries up to
+    a given value.
+  */
+
+  void initialize( std::size_t maximum )
+  {
+    std::size_t leaves = maximum / blockSize + 1;
+    std::size_t blocks = 1;
+    std::size_t upper  = 1;
+
+    while( blocks * blockSize < leaves )
+    {
+      blocks *= blockSize;
+      upper  += blocks;
+    }
+
+    _offset = upper;
+    _tree.assign( upper + leaves, Block(0) );
+  }
+
+  /**
+    Ensures that the tree is able to store a given entry. The active
+    column is preserved if the tree needs to grow.
+  */
+
+  void reserve( std::size_t entry )
+  {
+    if( !_tree.empty() && entry < ( _tree.size() - _offset ) * blockSize )
+      return;
+
+    std::vector<Index> entries;
+
+    if( !_tree.empty() )
+      this->extract( 0, &entries );
+
+    // Use the number of columns as a lower bound in order to avoid
+    // re-allocations for the usual case of square matrices.
+    this->initialize( std::max( entry, _data.size() ) );
+
+    for( auto&& e : entries )
+      this->toggle( static_cast<std::size_t>( e ) );
+  }
+
+  /** Toggles an entry and propagates the change to the root if required */
+  void toggle( std::size_t entry )
+  {
+    std::size_t indexInLevel = entry >> blockShift;
+    std::size_t address      = indexInLevel + _offset;
+    std::size_t indexInBlock = entry & ( blockSize - 1 );
+    Block m                  = mask( indexInBlock );
+
+    _tree[address] ^= m;
+
+    // The parent only needs to be updated if the current block either
+    // became empty or was empty before.
+    while( address != 0 && !( _tree[address] & ~m ) )
+    {
+      indexInBlock   = indexInLevel & ( blockSize - 1 );
+      indexInLevel >>= blockShift;
+      address        = ( address - 1 ) >> blockShift;
+      m              = mask( indexInBlock );
+
+      _tree[address] ^= m;
+    }
+  }
+
+  /** @returns Maximum entry in the tree; the tree must not be empty */
+  std::size_t getMaximumEntry() const
+  {
+    std::size_t node  = 0;
+    std::size_t next  = 0;
+    std::size_t index = 0;
+
+    while( next < _tree.size() )
+    {
+      node  = next;
+      index = blockSize - 1 - static_cast<std::size_t>( __builtin_ctzll( _tree[node] ) );
+      next  = ( node << blockShift ) + index + 1;
+    }
+
+    return ( ( node - _offset ) << blockShift ) + index;
+  }
+
+  /**
+    Removes all entries of the subtree of a node and reports them in
+    ascending order, provided that an output vector is specified. This
+    only visits the blocks that contain entries, instead of searching
+    for the maximum entry from the root for every entry.
+  */
+
+  void extract( std::size_t node, std::vector<Index>* entries )
+  {
+    Block block  = _tree[node];
+    _tree[node]  = 0;
+
+    while( block != 0 )
+    {
+      auto index = static_cast<std::size_t>( __builtin_clzll( block ) );
+      block     ^= mask( index );
+
+      if( node >= _offset )
+      {
+        if( entries )
+          entries->push_back( static_cast<Index>( ( ( node - _offset ) << blockShift ) + index ) );
+      }
+      else
+        this->extract( ( node << blockShift ) + index + 1, entries );
+    }
+  }
+
+  /** Makes a column the active one by loading it into the tree */
+  void activate( Index column )
+  {
+    auto&& c = _data.at( static_cast<std::size_t>( column ) );
+
+    this->reserve( c.empty() ? 0 : static_cast<std::size_t>( c.back() ) );
+
+    for( auto&& index : c )
+      this->toggle( static_cast<std::size_t>( index ) );
+
+    _active = column;
+  }
+
+  /** Stores the active column as a sorted vector and clears the tree */
+  void flush()
+  {
+    if( _active == none() )
+      return;
+
+    auto&& c = _data.at( static_cast<std::size_t>( _active ) );
+    c.clear();
+
+    this->extract( 0, &c );
+
+    _active = none();
+  }
+
+  /** Discards the active column without storing it */
+  void deactivate()
+  {
+    this->extract( 0, nullptr );
+
+    _active = none();
+  }
+
+  std::vector< std::vector<Index> > _data;
+  std::vector<Index> _dimensions;
+
+  /** Blocks of the tree, stored level by level, starting from the root */
+  std::vector<Block> _tree;
+
+  /** Offset of the leaf level in the tree */
+  std::size_t _offset = 0;
+
+  /** Active column, i.e. the column that is stored in the tree */
+  Index _active = none();
+
+  /** Target of the last addition that has been performed by merging */
+  Index _target = none();
+
+  /** Number of additions to the target that have been performed by merging */
+  std::size_t _numMerges = 0;
+
+  /** Buffer for merging columns, which is re-used for every merge */
+  std::vector<Index> _buffer;
+};
+
+template <class IndexType> constexpr std::size_t BitTree<IndexType>::blockSize;
+template <class IndexType> constexpr std::size_t BitTree<IndexType>::blockShift;
+template <class IndexType> constexpr std::size_t BitTree<IndexType>::mergeLimit;
+
+} // namespace representations
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
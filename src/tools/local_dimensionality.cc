@@ -5,6 +5,10 @@
   Given an input point cloud, it performs local dimensionality
   estimation (using different schmes) and stores the estimates
   along with the original point cloud.
+
+  Nearest neighbours are calculated exactly by default. For point clouds
+  of high dimension, an approximate calculation that uses a forest of
+  random projection trees may be selected via `--approximate`.
 */
 
 #include <aleph/containers/DimensionalityEstimators.hh>
@@ -12,7 +16,8 @@
 #include <aleph/containers/PointCloud.hh>
 
 #include <aleph/geometry/FLANN.hh>
-#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/KDTree.hh>
+#include <aleph/geometry/RandomProjectionForest.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
 
@@ -33,64 +38,24 @@ using Distance   = aleph::geometry::distances::Euclidean<DataType>;
 #ifdef ALEPH_WITH_FLANN
   using NearestNeighbours = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+  using NearestNeighbours = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
-int main( int argc, char** argv )
-{
-  std::string method = "pca";
-  unsigned k         = 8;
-  unsigned K         = 0;
-  unsigned n         = 1;
-  bool smooth        = false;
-
-  {
-    static option commandLineOptions[] =
-    {
-      { "k"          , required_argument, nullptr, 'k' },
-      { "K"          , required_argument, nullptr, 'K' },
-      { "method"     , required_argument, nullptr, 'm' },
-      { "n"          , required_argument, nullptr, 'n' },
-      { "smooth"     , no_argument      , nullptr, 's' },
-      { nullptr      , 0                , nullptr,  0  }
-    };
+using ApproximateNearestNeighbours = aleph::geometry::RandomProjectionForest<PointCloud, Distance>;
 
-    int option = 0;
-    while( ( option = getopt_long( argc, argv, "k:K:m:n:s", commandLineOptions, nullptr ) ) != -1 )
-    {
-      switch( option )
-      {
-      case 'k':
-        k = static_cast<unsigned>( std::stoull( optarg ) );
-        break;
-      case 'K':
-        K = static_cast<unsigned>( std::stoull( optarg ) );
-        break;
-      case 'm':
-        method = optarg;
-        break;
-      case 'n':
-        n = static_cast<unsigned>( std::stoull( optarg ) );
-        break;
-      case 's':
-        smooth = true;
-        break;
-      }
-    }
-  }
-
-  if( ( argc - optind ) < 1 )
-    return -1;
-
-  std::string filename = argv[ optind++ ];
-
-  std::cerr << "* Loading point cloud from '" << filename << "'...";
-
-  PointCloud pc = aleph::containers::load<DataType>( filename );
-
-  std::cerr << "finished\n"
-            << "* Loaded point cloud with " << pc.size() << " points of dimension " << pc.dimension() << "\n";
+/**
+  Estimates the local dimensionality of every point of a point cloud
+  and optionally smoothes the estimates. The nearest neighbour search
+  is performed by the specified wrapper class.
+*/
 
+template <class NearestNeighbours> std::vector<double> estimateDimensionalities( const PointCloud& pc,
+                                                                                 const std::string& method,
+                                                                                 unsigned k,
+                                                                                 unsigned K,
+                                                                                 unsigned n,
+                                                                                 bool smooth )
+{
   std::vector<double> dimensionalities;
 
   if( method == "pca" )
@@ -145,8 +110,6 @@ int main( int argc, char** argv )
 
   std::cerr << "finished\n";
 
-  // Output ------------------------------------------------------------
-
   if( smooth )
   {
     std::cerr << "* Performing smoothing operation with k=" << k << " and n=" << n << "...";
@@ -165,6 +128,75 @@ int main( int argc, char** argv )
     std::cerr << "\n";
   }
 
+  return dimensionalities;
+}
+
+int main( int argc, char** argv )
+{
+  std::string method = "pca";
+  unsigned k         = 8;
+  unsigned K         = 0;
+  unsigned n         = 1;
+  bool approximate   = false;
+  bool smooth        = false;
+
+  {
+    static option commandLineOptions[] =
+    {
+      { "approximate", no_argument      , nullptr, 'a' },
+      { "k"          , required_argument, nullptr, 'k' },
+      { "K"          , required_argument, nullptr, 'K' },
+      { "method"     , required_argument, nullptr, 'm' },
+      { "n"          , required_argument, nullptr, 'n' },
+      { "smooth"     , no_argument      , nullptr, 's' },
+      { nullptr      , 0                , nullptr,  0  }
+    };
+
+    int option = 0;
+    while( ( option = getopt_long( argc, argv, "ak:K:m:n:s", commandLineOptions, nullptr ) ) != -1 )
+    {
+      switch( option )
+      {
+      case 'a':
+        approximate = true;
+        break;
+      case 'k':
+        k = static_cast<unsigned>( std::stoull( optarg ) );
+        break;
+      case 'K':
+        K = static_cast<unsigned>( std::stoull( optarg ) );
+        break;
+      case 'm':
+        method = optarg;
+        break;
+      case 'n':
+        n = static_cast<unsigned>( std::stoull( optarg ) );
+        break;
+      case 's':
+        smooth = true;
+        break;
+      }
+    }
+  }
+
+  if( ( argc - optind ) < 1 )
+    return -1;
+
+  std::string filename = argv[ optind++ ];
+
+  std::cerr << "* Loading point cloud from '" << filename << "'...";
+
+  PointCloud pc = aleph::containers::load<DataType>( filename );
+
+  std::cerr << "finished\n"
+            << "* Loaded point cloud with " << pc.size() << " points of dimension " << pc.dimension() << "\n";
+
+  auto dimensionalities
+    = approximate ? estimateDimensionalities<ApproximateNearestNeighbours>( pc, method, k, K, n, smooth )
+                  : estimateDimensionalities<NearestNeighbours>( pc, method, k, K, n, smooth );
+
+  // Output ------------------------------------------------------------
+
   for( auto&& d : dimensionalities )
     std::cout << d << "\n";
 }
@@ -7,7 +7,7 @@
 #ifdef ALEPH_WITH_FLANN
   #include <aleph/geometry/FLANN.hh>
 #else
-  #include <aleph/geometry/BruteForce.hh>
+  #include <aleph/geometry/KDTree.hh>
 #endif
 
 #include <aleph/geometry/SphereSampling.hh>
@@ -52,7 +52,7 @@ using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
 #ifdef ALEPH_WITH_FLANN
   using NearestNeighbours = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+  using NearestNeighbours = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
 template <class Functor> std::vector<DataType> extract( const PointCloud& pointCloud, Functor f )
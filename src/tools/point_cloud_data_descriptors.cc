@@ -24,8 +24,8 @@
 #include <aleph/containers/DataDescriptors.hh>
 #include <aleph/containers/PointCloud.hh>
 
-#include <aleph/geometry/BruteForce.hh>
 #include <aleph/geometry/FLANN.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/VietorisRipsComplex.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
@@ -50,7 +50,7 @@ using Distance   = aleph::geometry::distances::Euclidean<DataType>;
 #ifdef ALEPH_WITH_FLANN
   using Wrapper = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  using Wrapper = aleph::geometry::BruteForce<PointCloud, Distance>;
+  using Wrapper = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
 void normalizeValues( std::vector<DataType>& values )
@@ -84,13 +84,7 @@ std::vector<DataType> calculateDataDescriptor( const std::string& name, const Po
 {
   if( name == "density" )
   {
-    #ifdef ALEPH_WITH_FLANN
-      return aleph::containers::estimateDensityDistanceToMeasure<Distance, PointCloud, Wrapper>( pointCloud, k );
-    #else
-      // The function will automatically fall back to the default
-      // wrapper.
-      return aleph::containers::estimateDensityDistanceToMeasure<Distance>( pointCloud, k );
-    #endif
+    return aleph::containers::estimateDensityDistanceToMeasure<Distance, PointCloud, Wrapper>( pointCloud, k );
   }
   else if( name == "eccentricity" )
     return aleph::containers::eccentricities<Distance>( pointCloud, p );
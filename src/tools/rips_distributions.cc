@@ -2,8 +2,8 @@
 
 #include <aleph/config/FLANN.hh>
 
-#include <aleph/geometry/BruteForce.hh>
 #include <aleph/geometry/FLANN.hh>
+#include <aleph/geometry/KDTree.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
 #include <aleph/geometry/distances/Manhattan.hh>
@@ -66,7 +66,7 @@ template <class Distance> void calculateDegrees( const PointCloud& pointCloud, D
 #ifdef ALEPH_WITH_FLANN
   using NearestNeighbours = aleph::geometry::FLANN<PointCloud, Distance>;
 #else
-  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+  using NearestNeighbours = aleph::geometry::KDTree<PointCloud, Distance>;
 #endif
 
   NearestNeighbours nn( pointCloud );
@@ -50,6 +50,7 @@
 #include <getopt.h>
 
 #include <aleph/persistenceDiagrams/Envelope.hh>
+#include <aleph/persistenceDiagrams/PairwiseMatrix.hh>
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 #include <aleph/persistenceDiagrams/PersistenceIndicatorFunction.hh>
 
@@ -67,6 +68,7 @@ using DataType                     = double;
 using PersistenceDiagram           = aleph::PersistenceDiagram<DataType>;
 using PersistenceIndicatorFunction = aleph::math::StepFunction<DataType>;
 using EnvelopeFunction             = aleph::math::PiecewiseLinearFunction<DataType>;
+using SymmetricMatrix              = aleph::math::SymmetricMatrix<double>;
 
 /*
   Auxiliary structure for describing a data set. I need this in order to
@@ -89,7 +91,7 @@ void usage()
 {
   std::cerr << "Usage: topological_distance [--power=POWER] [--kernel] [--exp] [--sigma]\n"
             << "                            [--hausdorff|envelope|indicator|scale-space|wasserstein]\n"
-            << "                            [--clean] [--factor=FACTOR] FILES\n"
+            << "                            [--clean] [--factor=FACTOR] [--checkpoint=FILE] FILES\n"
             << "\n"
             << "Calculates distances between a set of persistence diagrams, stored\n"
             << "in FILES. By default, this tool calculates Hausdorff distances for\n"
@@ -107,6 +109,10 @@ void usage()
             << "The distance matrix is written to STDOUT. Rows and columns will be\n"
             << "separated by whitespace.\n"
             << "\n"
+            << "Use --checkpoint=FILE to store intermediate results of the matrix\n"
+            << "calculation in FILE. If the calculation is interrupted, running\n"
+            << "the tool with the same arguments again resumes the calculation.\n"
+            << "\n"
             << "This tool tries to be smart and is able to detect whether a set of\n"
             << "persistence diagrams belongs to the same group. This works only if\n"
             << "each file contains a suffix with digits that is preceded by either\n"
@@ -136,28 +142,33 @@ void usage()
   or R.
 */
 
-void storeMatrix( const std::vector< std::vector<double> >& M, std::ostream& out )
+void storeMatrix( const SymmetricMatrix& M, std::ostream& out )
 {
-  if( M.empty() )
-    return;
-
-  auto rows = M.size();
-  auto cols = M.front().size();
+  auto n = M.numRows();
 
-  for( decltype(rows) row = 0; row < rows; row++ )
+  for( decltype(n) row = 0; row < n; row++ )
   {
-    for( decltype(cols) col = 0; col < cols; col++ )
+    for( decltype(n) col = 0; col < n; col++ )
     {
       if( col != 0 )
         out << " ";
 
-      out << M[row][col];
+      out << M(row, col);
     }
 
     out << "\n";
   }
 }
 
+/*
+  Describes a data set after preprocessing: for every dimension between
+  the minimum and the maximum dimension, it contains a pointer to the
+  corresponding part of the data set, or a null pointer if the data set
+  does not have any information about the dimension.
+*/
+
+using PreparedDataSet = std::vector<const DataSet*>;
+
 /*
   Calculates the topological distance between two data sets using persistence
   indicator functions. This requires enumerating all dimensions and finding a
@@ -165,33 +176,25 @@ void storeMatrix( const std::vector< std::vector<double> >& M, std::ostream& out
   be found, the calculation defaults to calculating the norm.
 */
 
-double distancePIF( const std::vector<DataSet>& dataSet1,
-                    const std::vector<DataSet>& dataSet2,
-                    unsigned minDimension,
-                    unsigned maxDimension,
+double distancePIF( const PreparedDataSet& dataSet1,
+                    const PreparedDataSet& dataSet2,
                     double power,
                     bool normalize )
 {
-  auto getPersistenceIndicatorFunction = [] ( const std::vector<DataSet>& dataSet, unsigned dimension )
+  auto getPersistenceIndicatorFunction = [] ( const PreparedDataSet& dataSet, std::size_t index )
   {
-    auto it = std::find_if( dataSet.begin(), dataSet.end(),
-                            [&dimension] ( const DataSet& dataSet )
-                            {
-                              return dataSet.dimension == dimension;
-                            } );
-
-    if( it != dataSet.end() )
-      return PersistenceIndicatorFunction( it->persistenceIndicatorFunction );
+    if( dataSet[index] )
+      return PersistenceIndicatorFunction( dataSet[index]->persistenceIndicatorFunction );
     else
       return PersistenceIndicatorFunction();
   };
 
   double d = 0.0;
 
-  for( unsigned dimension = minDimension; dimension <= maxDimension; dimension++ )
+  for( std::size_t index = 0; index < dataSet1.size(); index++ )
   {
-    auto f = getPersistenceIndicatorFunction( dataSet1, dimension );
-    auto g = getPersistenceIndicatorFunction( dataSet2, dimension );
+    auto f = getPersistenceIndicatorFunction( dataSet1, index );
+    auto g = getPersistenceIndicatorFunction( dataSet2, index );
 
     if( normalize )
     {
@@ -216,32 +219,24 @@ double distancePIF( const std::vector<DataSet>& dataSet1,
   function is found, the method defaults to calculating the norm.
 */
 
-double distanceEnvelopeFunctions( const std::vector<DataSet>& dataSet1,
-                                  const std::vector<DataSet>& dataSet2,
-                                  unsigned minDimension,
-                                  unsigned maxDimension,
+double distanceEnvelopeFunctions( const PreparedDataSet& dataSet1,
+                                  const PreparedDataSet& dataSet2,
                                   double power )
 {
-  auto getEnvelopeFunction = [] ( const std::vector<DataSet>& dataSet, unsigned dimension )
+  auto getEnvelopeFunction = [] ( const PreparedDataSet& dataSet, std::size_t index )
   {
-    auto it = std::find_if( dataSet.begin(), dataSet.end(),
-                            [&dimension] ( const DataSet& dataSet )
-                            {
-                              return dataSet.dimension == dimension;
-                            } );
-
-    if( it != dataSet.end() )
-      return EnvelopeFunction( it->envelopeFunction );
+    if( dataSet[index] )
+      return EnvelopeFunction( dataSet[index]->envelopeFunction );
     else
       return EnvelopeFunction();
   };
 
   double d = 0.0;
 
-  for( unsigned dimension = minDimension; dimension <= maxDimension; dimension++ )
+  for( std::size_t index = 0; index < dataSet1.size(); index++ )
   {
-    auto f = getEnvelopeFunction( dataSet1, dimension );
-    auto g = getEnvelopeFunction( dataSet2, dimension );
+    auto f = getEnvelopeFunction( dataSet1, index );
+    auto g = getEnvelopeFunction( dataSet2, index );
 
     g = -g;
     if( power == 1.0 )
@@ -262,36 +257,29 @@ double distanceEnvelopeFunctions( const std::vector<DataSet>& dataSet1,
 */
 
 template <class Functor>
-double persistenceDiagramDistance( const std::vector<DataSet>& dataSet1,
-                                   const std::vector<DataSet>& dataSet2,
-                                   unsigned minDimension,
-                                   unsigned maxDimension,
+double persistenceDiagramDistance( const PreparedDataSet& dataSet1,
+                                   const PreparedDataSet& dataSet2,
                                    double power,
-                                   Functor functor = [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2, double power )
-                                   {
-                                     return aleph::distances::wassersteinDistance( D1, D2, power );
-                                   } )
+                                   Functor functor )
 {
-  auto getPersistenceDiagram = [] ( const std::vector<DataSet>& dataSet, unsigned dimension )
+  // Missing dimensions are represented by an empty persistence diagram,
+  // which is shared among all calls.
+  static const PersistenceDiagram empty;
+
+  auto getPersistenceDiagram = [] ( const PreparedDataSet& dataSet, std::size_t index ) -> const PersistenceDiagram&
   {
-    auto it = std::find_if( dataSet.begin(), dataSet.end(),
-                            [&dimension] ( const DataSet& dataSet )
-                            {
-                              return dataSet.dimension == dimension;
-                            } );
-
-    if( it != dataSet.end() )
-      return PersistenceDiagram( it->persistenceDiagram );
+    if( dataSet[index] )
+      return dataSet[index]->persistenceDiagram;
     else
-      return PersistenceDiagram();
+      return empty;
   };
 
   double d = 0.0;
 
-  for( unsigned dimension = minDimension; dimension <= maxDimension; dimension++ )
+  for( std::size_t index = 0; index < dataSet1.size(); index++ )
   {
-    auto D1 = getPersistenceDiagram( dataSet1, dimension );
-    auto D2 = getPersistenceDiagram( dataSet2, dimension );
+    auto&& D1 = getPersistenceDiagram( dataSet1, index );
+    auto&& D2 = getPersistenceDiagram( dataSet2, index );
 
     d += functor( D1, D2, power );
   }
@@ -300,6 +288,80 @@ double persistenceDiagramDistance( const std::vector<DataSet>& dataSet1,
   return d;
 }
 
+/*
+  Functor for calculating the topological distance between two data
+  sets, using the measure that has been selected by the client. Every
+  data set is preprocessed once by looking up its parts for all of the
+  dimensions, so that individual pairs do not have to search for them.
+*/
+
+struct DataSetDistance
+{
+  unsigned minDimension;
+  unsigned maxDimension;
+
+  double power;
+  double sigma;
+
+  bool calculateKernel;
+  bool normalize;
+  bool useEnvelopeFunctionDistance;
+  bool useExponentialFunction;
+  bool useIndicatorFunctionDistance;
+  bool useScaleSpaceKernel;
+  bool verbose;
+
+  std::function< double( const PersistenceDiagram&, const PersistenceDiagram&, double ) > functor;
+
+  PreparedDataSet prepare( const std::vector<DataSet>& dataSet ) const
+  {
+    PreparedDataSet result( maxDimension - minDimension + 1, nullptr );
+
+    for( auto&& part : dataSet )
+    {
+      if( part.dimension < minDimension || part.dimension > maxDimension )
+        continue;
+
+      // Use the first part with the given dimension
+      auto&& pointer = result[ part.dimension - minDimension ];
+      if( !pointer )
+        pointer = &part;
+    }
+
+    return result;
+  }
+
+  double operator()( const PreparedDataSet& dataSet1, const PreparedDataSet& dataSet2 ) const
+  {
+    double d = 0.0;
+
+    // The distance of a data set to itself is zero by definition, so it
+    // does not have to be calculated. This does not apply to kernels.
+    if( &dataSet1 == &dataSet2 && !useScaleSpaceKernel )
+      d = 0.0;
+    else if( useIndicatorFunctionDistance )
+      d = distancePIF( dataSet1, dataSet2, power, normalize );
+    else if( useEnvelopeFunctionDistance )
+      d = distanceEnvelopeFunctions( dataSet1, dataSet2, power );
+    else
+      d = persistenceDiagramDistance( dataSet1, dataSet2, power, functor );
+
+    if( calculateKernel )
+    {
+      // Subtracting from zero ensures that a distance of zero is not
+      // reported as a negative zero in the output.
+      d = 0.0 - d;
+      if( useExponentialFunction )
+        d = std::exp( sigma * d );
+    }
+
+    if( verbose )
+      std::cerr << ".";
+
+    return d;
+  }
+};
+
 std::pair<DataType, DataType> getMinimumAndMaximum( const PersistenceDiagram& diagram )
 {
   DataType min = std::numeric_limits<DataType>::max();
@@ -389,6 +451,7 @@ int main( int argc, char** argv )
 {
   static option commandLineOptions[] =
   {
+    { "checkpoint" , required_argument, nullptr, 'C' },
     { "factor"     , required_argument, nullptr, 'f' },
     { "power"      , required_argument, nullptr, 'p' },
     { "sigma"      , required_argument, nullptr, 's' },
@@ -405,6 +468,7 @@ int main( int argc, char** argv )
     { nullptr      , 0                , nullptr,  0  }
   };
 
+  std::string checkpoint            = std::string();
   DataType infinityFactor           = DataType();
   double power                      = 2.0;
   double sigma                      = 1.0;
@@ -421,10 +485,13 @@ int main( int argc, char** argv )
   bool verbose                      = false;
 
   int option = 0;
-  while( ( option = getopt_long( argc, argv, "f:p:s:ceEhinklrvSw", commandLineOptions, nullptr ) ) != -1 )
+  while( ( option = getopt_long( argc, argv, "C:f:p:s:ceEhinklrvSw", commandLineOptions, nullptr ) ) != -1 )
   {
     switch( option )
     {
+    case 'C':
+      checkpoint = optarg;
+      break;
     case 'f':
       infinityFactor = static_cast<DataType>( std::stod( optarg ) );
       break;
@@ -717,42 +784,20 @@ int main( int argc, char** argv )
     std::cerr << "* Calculating pairwise " << type << " with p=" << power << "...";
   }
 
-  std::vector< std::vector<double> > distances;
-  distances.resize( dataSets.size(), std::vector<double>( dataSets.size() ) );
-
-  {
-    std::size_t n = dataSets.size();
-    std::size_t m = dataSets.size() * ( dataSets.size() - 1 ) / 2;
-
-    #pragma omp parallel for
-    for( std::size_t k = 0; k < m; k++ )
-    {
-      auto row = std::size_t( double( n - 2 ) - std::floor( std::sqrt( -8.0* double( k ) + double( 4*n*(n-1) ) - double( 7 ) ) / 2.0 - 0.5 ) );
-      auto col = std::size_t( k + row + 1 - n*(n-1)/2 + (n-row)*( (n-row)-1 ) / 2 );
-
-      double d = 0.0;
-
-      if( useIndicatorFunctionDistance )
-        d = distancePIF( dataSets.at(row), dataSets.at(col), minDimension, maxDimension, power, normalize );
-      else if( useEnvelopeFunctionDistance )
-        d = distanceEnvelopeFunctions( dataSets.at(row), dataSets.at(col), minDimension, maxDimension, power );
-      else
-        d = persistenceDiagramDistance( dataSets.at(row), dataSets.at(col), minDimension, maxDimension, power, functor );
-
-      if( calculateKernel )
-      {
-        d = -d;
-        if( useExponentialFunction )
-          d = std::exp( sigma * d );
-      }
-
-      distances[row][col] = d;
-      distances[col][row] = d;
-
-      if( verbose )
-        std::cerr << ".";
-    }
-  }
+  DataSetDistance distance = { minDimension,
+                               maxDimension,
+                               power,
+                               sigma,
+                               calculateKernel,
+                               normalize,
+                               useEnvelopeFunctionDistance,
+                               useExponentialFunction,
+                               useIndicatorFunctionDistance,
+                               useScaleSpaceKernel,
+                               verbose,
+                               functor };
+
+  auto distances = aleph::pairwiseMatrix( dataSets, distance, checkpoint );
 
   std::cerr << "finished\n";
 
@@ -0,0 +1,443 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/AlphaComplex.hh>
+#include <aleph/geometry/CechComplex.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+
+/**
+  Checks that two simplicial complexes have the same persistent homology
+  in all dimensions below the dimension of the points, up to points on
+  the diagonal.
+*/
+
+template <class SimplicialComplex> void compare( const SimplicialComplex& K, const SimplicialComplex& L, std::size_t dimension )
+{
+  using Simplex  = typename SimplicialComplex::ValueType;
+  using DataType = typename Simplex::DataType;
+
+  auto D1 = calculatePersistenceDiagrams( K );
+  auto D2 = calculatePersistenceDiagrams( L );
+
+  auto points = [] ( std::vector< PersistenceDiagram<DataType> >& diagrams, std::size_t d )
+  {
+    std::vector< std::pair<DataType, DataType> > result;
+
+    for( auto&& D : diagrams )
+    {
+      if( D.dimension() != d )
+        continue;
+
+      for( auto&& p : D )
+      {
+        if( std::abs( p.y() - p.x() ) > DataType(1e-5) )
+          result.push_back( std::make_pair( p.x(), p.y() ) );
+      }
+    }
+
+    std::sort( result.begin(), result.end() );
+    return result;
+  };
+
+  for( std::size_t d = 0; d < dimension; d++ )
+  {
+    auto P = points( D1, d );
+    auto Q = points( D2, d );
+
+    ALEPH_ASSERT_EQUAL( P.size(), Q.size() );
+
+    for( std::size_t i = 0; i < P.size(); i++ )
+    {
+      ALEPH_ASSERT_THROW( std::abs( P[i].first - Q[i].first ) < DataType(1e-4) );
+      ALEPH_ASSERT_THROW( P[i].second == Q[i].second || std::abs( P[i].second - Q[i].second ) < DataType(1e-4) );
+    }
+  }
+}
+
+template <class T> PointCloud<T> makeRandom( std::size_t n, std::size_t dimension )
+{
+  PointCloud<T> pointCloud( n, dimension );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<T> p( dimension );
+
+    for( auto&& x : p )
+      x = distribution( rng );
+
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  return pointCloud;
+}
+
+template <class T> void testRandom()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex of random points" );
+
+  for( std::size_t dimension : { 2, 3 } )
+  {
+    auto pointCloud = makeRandom<T>( dimension == 2 ? 12 : 10, dimension );
+
+    auto K = buildAlphaComplex( pointCloud );
+    auto L = buildCechComplex( pointCloud, T(10) );
+
+    ALEPH_ASSERT_THROW( K.size() < L.size() );
+
+    compare( K, L, dimension );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testGrid()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex of a grid" );
+
+  // Points on a grid are co-circular and co-spherical, so the Delaunay
+  // triangulation is not unique.
+  {
+    PointCloud<T> pointCloud( 3 * 3, 2 );
+
+    std::size_t i = 0;
+
+    for( unsigned x = 0; x < 3; x++ )
+      for( unsigned y = 0; y < 3; y++ )
+        pointCloud.set( i++, { T(x), T(y) } );
+
+    compare( buildAlphaComplex( pointCloud ), buildCechComplex( pointCloud, T(10) ), 2 );
+  }
+
+  {
+    PointCloud<T> pointCloud( 2 * 2 * 2, 3 );
+
+    std::size_t i = 0;
+
+    for( unsigned x = 0; x < 2; x++ )
+      for( unsigned y = 0; y < 2; y++ )
+        for( unsigned z = 0; z < 2; z++ )
+          pointCloud.set( i++, { T(x), T(y), T(z) } );
+
+    compare( buildAlphaComplex( pointCloud ), buildCechComplex( pointCloud, T(10) ), 3 );
+  }
+
+  // The Euler characteristic of the complex of a larger grid must be
+  // that of a point; this fails if degenerate cells are created.
+  {
+    PointCloud<T> pointCloud( 5 * 5 * 5, 3 );
+
+    std::size_t i = 0;
+
+    for( unsigned x = 0; x < 5; x++ )
+      for( unsigned y = 0; y < 5; y++ )
+        for( unsigned z = 0; z < 5; z++ )
+          pointCloud.set( i++, { T(x), T(y), T(z) } );
+
+    auto K = buildAlphaComplex( pointCloud );
+
+    long chi = 0;
+
+    for( auto&& s : K )
+      chi += s.dimension() % 2 == 0 ? 1 : -1;
+
+    ALEPH_ASSERT_EQUAL( chi, 1 );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSize()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex size" );
+
+  std::size_t n   = 1000;
+  auto pointCloud = makeRandom<T>( n, 2 );
+  auto K          = buildAlphaComplex( pointCloud );
+
+  std::size_t triangles = 0;
+
+  for( auto&& s : K )
+  {
+    if( s.dimension() == 2 )
+      ++triangles;
+  }
+
+  // Euler's formula bounds the number of triangles of a planar
+  // triangulation.
+  ALEPH_ASSERT_THROW( triangles <= 2 * n );
+  ALEPH_ASSERT_THROW( triangles >= n );
+
+  // Duplicate points are connected to the original point
+  {
+    auto p = pointCloud[3];
+    pointCloud.set( 17, p.begin(), p.end() );
+  }
+
+  auto L  = buildAlphaComplex( pointCloud );
+  auto D1 = calculatePersistenceDiagrams( L );
+
+  ALEPH_ASSERT_EQUAL( D1.front().dimension(), 0 );
+  ALEPH_ASSERT_EQUAL( D1.front().betti(),     1 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testExceptions()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex of invalid inputs" );
+
+  {
+    PointCloud<T> pointCloud( 10, 4 );
+
+    bool thrown = false;
+
+    try
+    {
+      buildAlphaComplex( pointCloud );
+    }
+    catch( std::runtime_error& )
+    {
+      thrown = true;
+    }
+
+    ALEPH_ASSERT_THROW( thrown );
+  }
+
+  ALEPH_TEST_END();
+}
+
+/** Counts the simplices of a simplicial complex for every dimension */
+template <class SimplicialComplex> std::vector<std::size_t> count( const SimplicialComplex& K )
+{
+  std::vector<std::size_t> result;
+
+  for( auto&& s : K )
+  {
+    if( s.dimension() >= result.size() )
+      result.resize( s.dimension() + 1 );
+
+    ++result[ s.dimension() ];
+  }
+
+  return result;
+}
+
+template <class T> void testDegenerate()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex of degenerate inputs" );
+
+  // Fewer points than required for a simplex of full dimension
+  {
+    PointCloud<T> pointCloud( 1, 3 );
+    pointCloud.set( 0, { T(1), T(2), T(3) } );
+
+    ALEPH_ASSERT_THROW( count( buildAlphaComplex( pointCloud ) ) == std::vector<std::size_t>( { 1 } ) );
+  }
+
+  {
+    PointCloud<T> pointCloud( 2, 2 );
+    pointCloud.set( 0, { T(0), T(0) } );
+    pointCloud.set( 1, { T(3), T(4) } );
+
+    auto K = buildAlphaComplex( pointCloud );
+
+    ALEPH_ASSERT_THROW( count( K ) == std::vector<std::size_t>( { 2, 1 } ) );
+    ALEPH_ASSERT_EQUAL( K.at(2).data(), T(5) );
+  }
+
+  // Collinear points form a path in both dimensions
+  for( std::size_t dimension : { 2, 3 } )
+  {
+    std::size_t n = 10;
+    PointCloud<T> pointCloud( n, dimension );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto x = T( ( i * 7 ) % n );
+
+      if( dimension == 2 )
+        pointCloud.set( i, { x, 2 * x } );
+      else
+        pointCloud.set( i, { x, 2 * x, -x } );
+    }
+
+    auto K = buildAlphaComplex( pointCloud );
+
+    ALEPH_ASSERT_THROW( count( K ) == std::vector<std::size_t>( { n, n - 1 } ) );
+
+    compare( K, buildCechComplex( pointCloud, T(100) ), 1 );
+  }
+
+  // Coplanar points in three dimensions result in a triangulation of
+  // the plane
+  {
+    std::size_t n = 12;
+
+    auto points     = makeRandom<T>( n, 2 );
+    auto pointCloud = PointCloud<T>( n, 3 );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      // Rounding the coordinates ensures that the points are exactly
+      // coplanar.
+      auto x = std::round( points[i][0] * 64 ) / 64;
+      auto y = std::round( points[i][1] * 64 ) / 64;
+
+      pointCloud.set( i, { x, y, x + 2 * y } );
+    }
+
+    auto K = buildAlphaComplex( pointCloud );
+    auto c = count( K );
+
+    ALEPH_ASSERT_EQUAL( c.size(), 3 );
+    ALEPH_ASSERT_EQUAL( c[0] - c[1] + c[2], 1 );
+
+    compare( K, buildCechComplex( pointCloud, T(10) ), 2 );
+  }
+
+  // Identical points are duplicates of the first one
+  {
+    PointCloud<T> pointCloud( 5, 2 );
+
+    for( std::size_t i = 0; i < 5; i++ )
+      pointCloud.set( i, { T(1), T(1) } );
+
+    auto K  = buildAlphaComplex( pointCloud );
+    auto D1 = calculatePersistenceDiagrams( K );
+
+    ALEPH_ASSERT_THROW( count( K ) == std::vector<std::size_t>( { 5, 4 } ) );
+    ALEPH_ASSERT_EQUAL( D1.front().betti(), 1 );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <std::size_t D> void checkTriangulation( const std::vector< std::array<double, D> >& points, std::size_t dimension )
+{
+  auto basis = geometry::detail::affineBasis( points );
+
+  ALEPH_ASSERT_EQUAL( basis.size(), dimension + 1 );
+
+  if( dimension == D )
+  {
+    geometry::detail::DelaunayTriangulation<D> triangulation( points, basis );
+    ALEPH_ASSERT_THROW( triangulation.isValid() );
+  }
+  else if( dimension == D - 1 )
+  {
+    geometry::detail::DelaunayTriangulation<D, D - 1> triangulation( points, basis );
+    ALEPH_ASSERT_THROW( triangulation.isValid() );
+  }
+}
+
+void testTriangulation()
+{
+  ALEPH_TEST_BEGIN( "Delaunay triangulation validity" );
+
+  std::mt19937 rng( 23 );
+
+  // Points on a small lattice include many duplicates as well as many
+  // co-circular and co-spherical points.
+  {
+    std::uniform_int_distribution<int> distribution( 0, 7 );
+
+    std::vector< std::array<double, 2> > points2( 500 );
+    std::vector< std::array<double, 3> > points3( 500 );
+
+    for( auto&& p : points2 )
+      p = { { double( distribution( rng ) ), double( distribution( rng ) ) } };
+
+    for( auto&& p : points3 )
+      p = { { double( distribution( rng ) ), double( distribution( rng ) ), double( distribution( rng ) ) } };
+
+    checkTriangulation( points2, 2 );
+    checkTriangulation( points3, 3 );
+  }
+
+  // Points that are almost co-circular or co-spherical are challenging
+  // for predicates that are evaluated with limited precision.
+  {
+    std::uniform_real_distribution<double> distribution( 0.0, 2 * M_PI );
+
+    std::vector< std::array<double, 2> > points2;
+    std::vector< std::array<double, 3> > points3;
+
+    for( std::size_t i = 0; i < 500; i++ )
+    {
+      auto phi   = distribution( rng );
+      auto theta = distribution( rng ) / 2;
+
+      points2.push_back( { { 1e5 + std::cos( phi ), 1e5 + std::sin( phi ) } } );
+      points3.push_back( { { std::sin( theta ) * std::cos( phi ), std::sin( theta ) * std::sin( phi ), std::cos( theta ) } } );
+    }
+
+    points2.push_back( { { 1e5, 1e5 } } );
+    points3.push_back( { { 0.0, 0.0, 0.0 } } );
+
+    checkTriangulation( points2, 2 );
+    checkTriangulation( points3, 3 );
+  }
+
+  // Points in a lower-dimensional subspace
+  {
+    std::uniform_int_distribution<int> distribution( -8, 8 );
+
+    std::vector< std::array<double, 2> > points2( 200 );
+    std::vector< std::array<double, 3> > points3( 200 );
+
+    for( auto&& p : points2 )
+    {
+      auto t = double( distribution( rng ) ) / 8;
+      p      = { { t, 0.5 + 3 * t } };
+    }
+
+    for( auto&& p : points3 )
+    {
+      auto s = double( distribution( rng ) ) / 8;
+      auto t = double( distribution( rng ) ) / 8;
+      p      = { { s, t, s - t } };
+    }
+
+    checkTriangulation( points2, 1 );
+    checkTriangulation( points3, 2 );
+  }
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testRandom<float> ();
+  testRandom<double>();
+
+  testGrid<float> ();
+  testGrid<double>();
+
+  testSize<float> ();
+  testSize<double>();
+
+  testExceptions<float> ();
+  testExceptions<double>();
+
+  testDegenerate<float> ();
+  testDegenerate<double>();
+
+  testTriangulation();
+}
@@ -0,0 +1,139 @@
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/representations/Set.hh>
+#include <aleph/topology/representations/Vector.hh>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace distances;
+using namespace topology;
+
+/**
+  Reference implementation of the conversion that maps every simplex
+  to its index by hashing. Faces are created via the boundary iterator
+  of every simplex.
+*/
+
+template <class Representation, class SimplicialComplex> BoundaryMatrix<Representation> makeBoundaryMatrixReference( const SimplicialComplex& K, std::size_t max = 0 )
+{
+  using Simplex = typename SimplicialComplex::ValueType;
+  using Index   = typename BoundaryMatrix<Representation>::Index;
+
+  BoundaryMatrix<Representation> M;
+  M.setNumColumns( static_cast<Index>( K.size() ) );
+
+  std::unordered_map<Simplex, Index> simplex_to_index;
+
+  {
+    Index i = Index(0);
+
+    for( auto&& simplex : K )
+      simplex_to_index[simplex] = i++;
+  }
+
+  Index j = Index(0);
+
+  for( auto&& itSimplex = K.begin(); itSimplex != K.end(); ++itSimplex )
+  {
+    if( !max || j < max )
+    {
+      std::vector<Index> column;
+
+      for( auto&& itBoundary = itSimplex->begin_boundary(); itBoundary != itSimplex->end_boundary(); ++itBoundary )
+        column.push_back( simplex_to_index[ *itBoundary ] );
+
+      M.setColumn( j, column.begin(), column.end() );
+    }
+    else
+      M.setDimension( j, static_cast<Index>( itSimplex->dimension() ) );
+
+    ++j;
+  }
+
+  return M;
+}
+
+template <class T> void testSimple()
+{
+  ALEPH_TEST_BEGIN( "Boundary matrix conversion: simple complex" );
+
+  using Simplex           = Simplex<T, unsigned>;
+  using SimplicialComplex = SimplicialComplex<Simplex>;
+  using Representation    = representations::Vector<unsigned>;
+
+  SimplicialComplex K = {
+    {0}, {1}, {2}, {3},
+    {0,1}, {0,2}, {1,2}, {2,3},
+    {0,1,2}
+  };
+
+  auto M = makeBoundaryMatrix<Representation>( K );
+
+  ALEPH_ASSERT_EQUAL( M.getNumColumns(), K.size() );
+  ALEPH_ASSERT_THROW( M == makeBoundaryMatrixReference<Representation>( K ) );
+
+  ALEPH_ASSERT_THROW( M.getColumn(4) == std::vector<unsigned>( { 0, 1 } ) );
+  ALEPH_ASSERT_THROW( M.getColumn(7) == std::vector<unsigned>( { 2, 3 } ) );
+  ALEPH_ASSERT_THROW( M.getColumn(8) == std::vector<unsigned>( { 4, 5, 6 } ) );
+
+  ALEPH_ASSERT_EQUAL( M.getDimension(8), 2 );
+
+  for( std::size_t max : { 1, 4, 6, 9 } )
+    ALEPH_ASSERT_THROW( makeBoundaryMatrix<Representation>( K, max ) == makeBoundaryMatrixReference<Representation>( K, max ) );
+
+  // The complex is not closed under taking faces; missing faces must
+  // be handled as before.
+  SimplicialComplex L = {
+    {0}, {1}, {0,1}, {0,1,2}
+  };
+
+  ALEPH_ASSERT_THROW( makeBoundaryMatrix<Representation>( L ) == makeBoundaryMatrixReference<Representation>( L ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T, class Representation> void testRips()
+{
+  ALEPH_TEST_BEGIN( "Boundary matrix conversion: Vietoris--Rips complex" );
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  BruteForce<PointCloud<T>, Euclidean<T> > wrapper( pointCloud );
+
+  auto K  = buildVietorisRipsComplex( wrapper, T(0.5), 3 );
+  auto M1 = makeBoundaryMatrix<Representation>( K );
+  auto M2 = makeBoundaryMatrixReference<Representation>( K );
+
+  ALEPH_ASSERT_THROW( M1.getNumColumns() > 0 );
+  ALEPH_ASSERT_THROW( M1 == M2 );
+  ALEPH_ASSERT_THROW( M1.dualize() == M2.dualize() );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testSimple<float> ();
+  testSimple<double>();
+
+  testRips<double, representations::Vector<unsigned> >     ();
+  testRips<float,  representations::Vector<unsigned long> >();
+  testRips<double, representations::Set<unsigned> >        ();
+}
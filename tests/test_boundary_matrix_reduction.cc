@@ -1,18 +1,21 @@
 #include <tests/Base.hh>
 
 #include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/algorithms/ChunkParallel.hh>
 #include <aleph/persistentHomology/algorithms/Standard.hh>
 #include <aleph/persistentHomology/algorithms/Twist.hh>
 
 #include <aleph/topology/BoundaryMatrix.hh>
 
+#include <aleph/topology/representations/Arena.hh>
+#include <aleph/topology/representations/BitTree.hh>
 #include <aleph/topology/representations/Set.hh>
 #include <aleph/topology/representations/Vector.hh>
 
 #include <algorithm>
 #include <vector>
 
-template <class T> void testNonSquare()
+template <class Representation> void testNonSquare()
 {
   ALEPH_TEST_BEGIN( "Boundary matrix reduction for non-square matrices" );
 
@@ -20,7 +23,7 @@ template <class T> void testNonSquare()
   using namespace topology;
   using namespace representations;
 
-  using Representation = Vector<T>;
+  using T              = typename Representation::Index;
   using Matrix         = BoundaryMatrix<Representation>;
   using Index          = typename Matrix::Index;
 
@@ -198,6 +201,7 @@ template <class M> void reduceBoundaryMatrix( const M& m )
 
   ALEPH_ASSERT_THROW( m.getNumColumns() > 0 );
 
+  using ChunkAlgorithm    = aleph::persistentHomology::algorithms::ChunkParallel;
   using StandardAlgorithm = aleph::persistentHomology::algorithms::Standard;
   using TwistAlgorithm    = aleph::persistentHomology::algorithms::Twist;
 
@@ -205,7 +209,7 @@ template <class M> void reduceBoundaryMatrix( const M& m )
   using Pairing = aleph::PersistencePairing<Index>;
 
   std::vector<Pairing> pairings;
-  pairings.reserve( 4 );
+  pairings.reserve( 6 );
 
   pairings.push_back( aleph::calculatePersistencePairing<StandardAlgorithm>( m ) );
   pairings.push_back( aleph::calculatePersistencePairing<StandardAlgorithm>( m.dualize() ) );
@@ -213,6 +217,9 @@ template <class M> void reduceBoundaryMatrix( const M& m )
   pairings.push_back( aleph::calculatePersistencePairing<TwistAlgorithm>( m ) );
   pairings.push_back( aleph::calculatePersistencePairing<TwistAlgorithm>( m.dualize() ) );
 
+  pairings.push_back( aleph::calculatePersistencePairing<ChunkAlgorithm>( m ) );
+  pairings.push_back( aleph::calculatePersistencePairing<ChunkAlgorithm>( m.dualize() ) );
+
   ALEPH_ASSERT_THROW( m != m.dualize() );
   ALEPH_ASSERT_THROW( m == m.dualize().dualize() );
 
@@ -242,14 +249,20 @@ template <class T> void setupBoundaryMatrix()
 
   ALEPH_TEST_BEGIN( "Boundary matrix setup & loading" );
 
-  using Set    = Set<T>;
-  using Vector = Vector<T>;
+  using Arena   = Arena<T>;
+  using BitTree = BitTree<T>;
+  using Set     = Set<T>;
+  using Vector  = Vector<T>;
 
   auto m1 = BoundaryMatrix<Set>::load( CMAKE_SOURCE_DIR + std::string( "/tests/input/Triangle.txt" ) );
   auto m2 = BoundaryMatrix<Vector>::load( CMAKE_SOURCE_DIR + std::string( "/tests/input/Triangle.txt" ) );
+  auto m3 = BoundaryMatrix<Arena>::load( CMAKE_SOURCE_DIR + std::string( "/tests/input/Triangle.txt" ) );
+  auto m4 = BoundaryMatrix<BitTree>::load( CMAKE_SOURCE_DIR + std::string( "/tests/input/Triangle.txt" ) );
 
   reduceBoundaryMatrix( m1 );
   reduceBoundaryMatrix( m2 );
+  reduceBoundaryMatrix( m3 );
+  reduceBoundaryMatrix( m4 );
 
   ALEPH_TEST_END();
 }
@@ -261,8 +274,15 @@ int main()
   setupBoundaryMatrix<int>();
   setupBoundaryMatrix<long>();
 
-  testNonSquare<int>          ();
-  testNonSquare<long>         ();
-  testNonSquare<unsigned int> ();
-  testNonSquare<unsigned long>();
+  using namespace aleph::topology::representations;
+
+  testNonSquare< Vector<int> >          ();
+  testNonSquare< Vector<long> >         ();
+  testNonSquare< Vector<unsigned int> > ();
+  testNonSquare< Vector<unsigned long> >();
+
+  testNonSquare< BitTree<int> >          ();
+  testNonSquare< BitTree<long> >         ();
+  testNonSquare< BitTree<unsigned int> > ();
+  testNonSquare< BitTree<unsigned long> >();
 }
@@ -0,0 +1,130 @@
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/algorithms/ChunkParallel.hh>
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+
+#include <aleph/topology/representations/Arena.hh>
+#include <aleph/topology/representations/BitTree.hh>
+#include <aleph/topology/representations/Set.hh>
+#include <aleph/topology/representations/Vector.hh>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace distances;
+using namespace persistentHomology::algorithms;
+using namespace topology;
+
+/**
+  Reduces a boundary matrix with the chunk algorithm for different
+  numbers of chunks and checks that all pivots coincide with the ones
+  of the twist algorithm.
+*/
+
+template <class Representation> void testMatrix( const BoundaryMatrix<Representation>& M )
+{
+  using Index = typename Representation::Index;
+
+  auto expected = M;
+
+  Twist twist;
+  twist( expected );
+
+  for( std::size_t numChunks : { 0, 1, 2, 7, 64 } )
+  {
+    auto actual = M;
+
+    ChunkParallel chunkParallel( numChunks );
+    chunkParallel( actual );
+
+    ALEPH_ASSERT_EQUAL( expected.getNumColumns(), actual.getNumColumns() );
+
+    for( Index j = 0; j < M.getNumColumns(); j++ )
+      ALEPH_ASSERT_THROW( expected.getMaximumIndex( j ) == actual.getMaximumIndex( j ) );
+  }
+
+  auto pairing1 = calculatePersistencePairing<Twist>( M );
+  auto pairing2 = calculatePersistencePairing<ChunkParallel>( M );
+
+  ALEPH_ASSERT_THROW( pairing1.empty() == false );
+  ALEPH_ASSERT_THROW( pairing1 == pairing2 );
+}
+
+template <class T, class Representation> void testRandomPointCloud()
+{
+  ALEPH_TEST_BEGIN( "Chunk-parallel reduction: random point cloud" );
+
+  unsigned n = 60;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  PointCloud<T> pointCloud( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  BruteForce<PointCloud<T>, Euclidean<T> > wrapper( pointCloud );
+
+  auto K = buildVietorisRipsComplex( wrapper, T(0.4), 3 );
+  auto M = makeBoundaryMatrix<Representation>( K );
+
+  testMatrix( M );
+  testMatrix( M.dualize() );
+
+  ALEPH_TEST_END();
+}
+
+template <class T, class Representation> void testIris()
+{
+  ALEPH_TEST_BEGIN( "Chunk-parallel reduction: Iris data" );
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  BruteForce<PointCloud<T>, Euclidean<T> > wrapper( pointCloud );
+
+  auto K = buildVietorisRipsComplex( wrapper, T(0.5), 3 );
+  auto M = makeBoundaryMatrix<Representation>( K );
+
+  testMatrix( M );
+  testMatrix( M.dualize() );
+
+  auto diagrams1 = calculatePersistenceDiagrams<Twist, Representation>( K );
+  auto diagrams2 = calculatePersistenceDiagrams<ChunkParallel, Representation>( K );
+
+  ALEPH_ASSERT_EQUAL( diagrams1.size(), diagrams2.size() );
+
+  for( std::size_t i = 0; i < diagrams1.size(); i++ )
+    ALEPH_ASSERT_THROW( diagrams1[i] == diagrams2[i] );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  using namespace representations;
+
+  testRandomPointCloud<double, Vector<unsigned> >();
+  testRandomPointCloud<double, Set<unsigned> >   ();
+  testRandomPointCloud<double, Arena<unsigned> > ();
+  testRandomPointCloud<double, BitTree<unsigned> >();
+  testRandomPointCloud<float,  Vector<unsigned long> >();
+
+  testIris<double, Vector<unsigned> >();
+  testIris<float,  Arena<unsigned> > ();
+}
@@ -15,6 +15,13 @@
 
 #include <aleph/topology/filtrations/Data.hh>
 
+#include <aleph/topology/representations/Vector.hh>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using namespace aleph;
@@ -89,8 +96,185 @@ template <class T> void test()
   ALEPH_TEST_END();
 }
 
+/** Records all merges that are reported during the calculation */
+template <class Vertex, class Data> struct MergeRecorder
+{
+  void initialize( Vertex v )
+  {
+    vertices.push_back( v );
+  }
+
+  void operator()( Vertex younger, Vertex older, Data creation, Data destruction, Vertex u, Vertex v )
+  {
+    merges.push_back( std::make_tuple( younger, older, creation, destruction, u, v ) );
+  }
+
+  void operator()( Vertex root, Data creation )
+  {
+    roots.push_back( std::make_pair( root, creation ) );
+  }
+
+  std::vector<Vertex> vertices;
+  std::vector< std::tuple<Vertex, Vertex, Data, Data, Vertex, Vertex> > merges;
+  std::vector< std::pair<Vertex, Data> > roots;
+};
+
+template <class T> void testParallel()
+{
+  ALEPH_TEST_BEGIN( "Zero-dimensional persistent homology: sequential and parallel calculation" );
+
+  using PointCloud = PointCloud<T>;
+  using Distance   = Euclidean<T>;
+  using Wrapper    = BruteForce<PointCloud, Distance>;
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_colon_separated.txt" ) );
+
+  Wrapper wrapper( pointCloud );
+  RipsSkeleton<Wrapper> ripsSkeleton;
+
+  auto K = ripsSkeleton( wrapper, T(0.8) );
+
+  using Simplex  = typename decltype(K)::ValueType;
+  using Vertex   = typename Simplex::VertexType;
+  using Pairing  = PersistencePairing<Vertex>;
+  using Traits   = traits::PersistencePairingCalculation<Pairing>;
+  using Recorder = MergeRecorder<Vertex, T>;
+
+  K.sort( filtrations::Data<Simplex>() );
+
+  Recorder r1;
+  Recorder r2;
+
+  auto t1 = calculateZeroDimensionalPersistenceDiagram<Simplex, Traits>( K, r1 );
+  auto t2 = calculateZeroDimensionalPersistenceDiagramParallel<Simplex, Traits>( K, r2 );
+
+  ALEPH_ASSERT_THROW( std::get<0>( t1 ) == std::get<0>( t2 ) );
+  ALEPH_ASSERT_THROW( std::get<1>( t1 ) == std::get<1>( t2 ) );
+
+  ALEPH_ASSERT_EQUAL( r1.vertices.size(), pointCloud.size() );
+  ALEPH_ASSERT_THROW( std::is_sorted( r1.vertices.begin(), r1.vertices.end() ) );
+  ALEPH_ASSERT_THROW( r1.vertices == r2.vertices );
+  ALEPH_ASSERT_THROW( r1.merges   == r2.merges );
+  ALEPH_ASSERT_THROW( r1.roots    == r2.roots );
+
+  // Every merge destroys exactly one component
+  ALEPH_ASSERT_EQUAL( r1.merges.size() + r1.roots.size(), pointCloud.size() );
+
+  // The pairing must coincide with the one of the full reduction
+  auto M       = makeBoundaryMatrix< representations::Vector<Vertex> >( K );
+  auto pairing = calculatePersistencePairing<defaults::ReductionAlgorithm>( M );
+
+  for( auto&& pair : std::get<1>( t1 ) )
+  {
+    if( pair.second < K.size() )
+    {
+      ALEPH_ASSERT_THROW( pairing.contains( pair.first, pair.second ) );
+    }
+    else
+    {
+      ALEPH_ASSERT_THROW( pairing.contains( pair.first ) );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSparseVertices()
+{
+  ALEPH_TEST_BEGIN( "Zero-dimensional persistent homology: sparse vertex labels" );
+
+  using Simplex = Simplex<T, unsigned>;
+
+  // Large vertex labels are not stored in a lookup table
+  SimplicialComplex<Simplex> K = {
+    Simplex( 0u,                T(0) ),
+    Simplex( 1000000u,          T(1) ),
+    Simplex( 4000000000u,       T(2) ),
+    Simplex( 7u,                T(3) ),
+    Simplex( {0u, 1000000u},    T(4) ),
+    Simplex( {7u, 4000000000u}, T(5) ),
+    Simplex( {0u, 7u},          T(6) ),
+    Simplex( {1000000u, 7u},    T(7) )
+  };
+
+  auto D1 = std::get<0>( calculateZeroDimensionalPersistenceDiagram( K ) );
+  auto D2 = std::get<0>( calculateZeroDimensionalPersistenceDiagramParallel( K ) );
+
+  ALEPH_ASSERT_THROW( D1 == D2 );
+  ALEPH_ASSERT_EQUAL( D1.size(), 4 );
+
+  using Point = typename decltype(D1)::Point;
+
+  std::vector<Point> expected = { Point( T(1), T(4) ), Point( T(3), T(5) ), Point( T(2), T(6) ), Point( T(0) ) };
+
+  ALEPH_ASSERT_THROW( std::equal( D1.begin(), D1.end(), expected.begin() ) );
+
+  // Edges whose vertices are missing cannot be handled
+  SimplicialComplex<Simplex> L = {
+    Simplex( 0u,                T(0) ), Simplex( {0u, 1u}, T(1) )
+  };
+
+  ALEPH_EXPECT_EXCEPTION( calculateZeroDimensionalPersistenceDiagram( L ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testEssentialOrder()
+{
+  ALEPH_TEST_BEGIN( "Zero-dimensional persistent homology: order of essential classes" );
+
+  using Simplex = Simplex<T, unsigned>;
+  using Pairing = PersistencePairing<unsigned>;
+  using Traits  = traits::PersistencePairingCalculation<Pairing>;
+
+  // Both components are represented by a root whose position does not
+  // correspond to the filtration order of its creator.
+  SimplicialComplex<Simplex> K = {
+    Simplex( 0u,       T(0) ),
+    Simplex( 1u,       T(1) ),
+    Simplex( 2u,       T(2) ),
+    Simplex( 3u,       T(3) ),
+    Simplex( {3u, 0u}, T(4) ),
+    Simplex( {2u, 1u}, T(5) )
+  };
+
+  auto t1 = calculateZeroDimensionalPersistenceDiagram<Simplex, Traits>( K );
+  auto t2 = calculateZeroDimensionalPersistenceDiagramParallel<Simplex, Traits>( K );
+
+  auto&& D1 = std::get<0>( t1 );
+  auto&& D2 = std::get<0>( t2 );
+
+  ALEPH_ASSERT_THROW( D1 == D2 );
+  ALEPH_ASSERT_EQUAL( D1.size(), 4 );
+
+  using Point = typename std::remove_reference<decltype(D1)>::type::Point;
+
+  std::vector<Point> expected = { Point( T(3), T(4) ), Point( T(2), T(5) ), Point( T(0) ), Point( T(1) ) };
+
+  ALEPH_ASSERT_THROW( std::equal( D1.begin(), D1.end(), expected.begin() ) );
+
+  std::vector<unsigned> creators;
+
+  for( auto&& pair : std::get<1>( t1 ) )
+    if( pair.second >= K.size() )
+      creators.push_back( pair.first );
+
+  ALEPH_ASSERT_THROW( creators == std::vector<unsigned>( { 0u, 1u } ) );
+
+  ALEPH_TEST_END();
+}
+
 int main()
 {
   test<float> ();
   test<double>();
+
+  testParallel<float> ();
+  testParallel<double>();
+
+  testSparseVertices<float> ();
+  testSparseVertices<double>();
+
+  testEssentialOrder<float> ();
+  testEssentialOrder<double>();
 }
@@ -1,8 +1,11 @@
 #include <tests/Base.hh>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <numeric>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
@@ -11,6 +14,7 @@
 #include <cmath>
 
 #include <aleph/geometry/CoverTree.hh>
+#include <aleph/geometry/FlatCoverTree.hh>
 
 #include <aleph/topology/UnionFind.hh>
 
@@ -500,6 +504,92 @@ template <class T> void test2D()
   ALEPH_TEST_END();
 }
 
+// Metric on the indices of a set of points; this is required for the
+// flat cover tree.
+template <class T> struct IndexMetric
+{
+  const std::vector< Point<T> >* points;
+
+  T operator()( std::size_t i, std::size_t j ) const
+  {
+    return EuclideanMetric<T>()( points->at(i), points->at(j) );
+  }
+};
+
+template <class T> void testFlat()
+{
+  ALEPH_TEST_BEGIN( "Flat cover tree" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(-10), T(10) );
+
+  std::vector< Point<T> > points;
+
+  for( std::size_t i = 0; i < 2000; i++ )
+    points.push_back( { distribution( rng ), distribution( rng ) } );
+
+  // Duplicates must not prevent the construction
+  for( std::size_t i = 0; i < 10; i++ )
+    points.push_back( points[i] );
+
+  IndexMetric<T> metric = { &points };
+
+  {
+    FlatCoverTree< IndexMetric<T> > tree( 0, metric );
+
+    ALEPH_ASSERT_THROW( tree.empty() );
+    ALEPH_ASSERT_THROW( tree.isValid() );
+  }
+
+  FlatCoverTree< IndexMetric<T> > tree( points.size(), metric );
+
+  ALEPH_ASSERT_EQUAL( tree.size(), points.size() );
+  ALEPH_ASSERT_THROW( tree.checkCoveringInvariant() );
+  ALEPH_ASSERT_THROW( tree.checkSeparatingInvariant() );
+  ALEPH_ASSERT_THROW( tree.checkDistanceBounds() );
+
+  for( std::size_t q = 0; q < points.size(); q += 37 )
+  {
+    std::vector< std::pair<T, std::size_t> > expected;
+
+    for( std::size_t i = 0; i < points.size(); i++ )
+      expected.push_back( std::make_pair( metric( q, i ), i ) );
+
+    std::sort( expected.begin(), expected.end() );
+
+    {
+      std::vector< std::pair<std::size_t, T> > neighbours;
+      tree.radiusSearch( q, T(2), std::back_inserter( neighbours ) );
+
+      std::set<std::size_t> actual;
+      for( auto&& neighbour : neighbours )
+        actual.insert( neighbour.first );
+
+      std::set<std::size_t> reference;
+      for( auto&& pair : expected )
+        if( pair.first < T(2) )
+          reference.insert( pair.second );
+
+      ALEPH_ASSERT_THROW( actual == reference );
+    }
+
+    {
+      std::vector< std::pair<std::size_t, T> > neighbours;
+      tree.neighbourSearch( q, 15, std::back_inserter( neighbours ) );
+
+      ALEPH_ASSERT_EQUAL( neighbours.size(), 15 );
+
+      for( std::size_t i = 0; i < neighbours.size(); i++ )
+      {
+        ALEPH_ASSERT_EQUAL( neighbours[i].first,  expected[i].second );
+        ALEPH_ASSERT_EQUAL( neighbours[i].second, expected[i].first );
+      }
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main( int, char** )
 {
   //testSimple<double>();
@@ -510,4 +600,7 @@ int main( int, char** )
 
   test2D<double>();
   test2D<float> ();
+
+  testFlat<double>();
+  testFlat<float> ();
 }
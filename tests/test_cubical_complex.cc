@@ -0,0 +1,390 @@
+#include <tests/Base.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/algorithms/CubicalCohomology.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/CubicalComplex.hh>
+
+#include <aleph/topology/representations/Vector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace aleph;
+using namespace persistentHomology::algorithms;
+using namespace topology;
+
+/**
+  Calculates the persistence diagrams of a cubical complex by reducing
+  its explicit boundary matrix. Cells are sorted by their values, their
+  dimension, and their index.
+*/
+
+template <class T> std::vector< PersistenceDiagram<T> > calculateReferenceDiagrams( const CubicalComplex<T>& K )
+{
+  using Index          = unsigned;
+  using Representation = representations::Vector<Index>;
+
+  std::vector<std::size_t> cells( K.size() );
+  std::vector<T> values( K.size() );
+  std::vector<unsigned> dimensions( K.size() );
+
+  for( std::size_t c = 0; c < K.size(); c++ )
+  {
+    cells[c]      = c;
+    values[c]     = K.value( c );
+    dimensions[c] = K.cellDimension( c );
+  }
+
+  std::sort( cells.begin(), cells.end(),
+             [&] ( std::size_t a, std::size_t b )
+             {
+               if( values[a] != values[b] )
+                 return K.precedes( values[a], values[b] );
+               else if( dimensions[a] != dimensions[b] )
+                 return dimensions[a] < dimensions[b];
+               else
+                 return a < b;
+             } );
+
+  std::vector<Index> positions( K.size() );
+
+  for( std::size_t i = 0; i < cells.size(); i++ )
+    positions[ cells[i] ] = Index(i);
+
+  BoundaryMatrix<Representation> M;
+  M.setNumColumns( Index( K.size() ) );
+
+  for( std::size_t i = 0; i < cells.size(); i++ )
+  {
+    std::vector<std::size_t> faces;
+    K.boundary( cells[i], std::back_inserter( faces ) );
+
+    std::vector<Index> column;
+
+    for( auto&& face : faces )
+      column.push_back( positions[face] );
+
+    std::sort( column.begin(), column.end() );
+
+    M.setColumn( Index(i), column.begin(), column.end() );
+    M.setDimension( Index(i), Index( dimensions[ cells[i] ] ) );
+  }
+
+  auto pairing = calculatePersistencePairing( M );
+
+  std::map< unsigned, PersistenceDiagram<T> > diagrams;
+
+  for( auto&& pair : pairing )
+  {
+    auto d = dimensions[ cells[ pair.first ] ];
+
+    diagrams[d].setDimension( d );
+
+    if( pair.second < M.getNumColumns() )
+      diagrams[d].add( values[ cells[ pair.first ] ], values[ cells[ pair.second ] ] );
+    else
+      diagrams[d].add( values[ cells[ pair.first ] ] );
+  }
+
+  std::vector< PersistenceDiagram<T> > result;
+
+  for( auto&& pair : diagrams )
+    result.push_back( pair.second );
+
+  return result;
+}
+
+/**
+  Compares the persistence diagrams of the implicit engine to the ones
+  of the explicit boundary matrix. Points of zero persistence as well
+  as empty diagrams are ignored.
+*/
+
+template <class T> void compareDiagrams( std::vector< PersistenceDiagram<T> > expected,
+                                         std::vector< PersistenceDiagram<T> > actual )
+{
+  auto prepare = [] ( std::vector< PersistenceDiagram<T> >& diagrams )
+  {
+    for( auto&& D : diagrams )
+    {
+      D.removeDiagonal();
+      std::sort( D.begin(), D.end() );
+    }
+
+    diagrams.erase( std::remove_if( diagrams.begin(), diagrams.end(),
+                                    [] ( const PersistenceDiagram<T>& D )
+                                    {
+                                      return D.empty();
+                                    } ),
+                    diagrams.end() );
+  };
+
+  prepare( expected );
+  prepare( actual );
+
+  ALEPH_ASSERT_EQUAL( expected.size(), actual.size() );
+
+  for( std::size_t i = 0; i < expected.size(); i++ )
+  {
+    ALEPH_ASSERT_EQUAL( expected[i].dimension(), actual[i].dimension() );
+    ALEPH_ASSERT_EQUAL( expected[i].size(),      actual[i].size() );
+    ALEPH_ASSERT_THROW( expected[i] == actual[i] );
+  }
+}
+
+/**
+  Creates random vertex values for a given shape. Integer values result
+  in many ties, which have to be resolved consistently. Since values are
+  truncated towards zero, they include negative zeros as well.
+*/
+
+template <class T> std::vector<T> makeValues( const std::vector<std::size_t>& shape, bool integral, unsigned seed )
+{
+  std::size_t n = 1;
+
+  for( auto&& m : shape )
+    n *= m;
+
+  std::mt19937 rng( seed );
+  std::uniform_real_distribution<T> distribution( T(-10), T(10) );
+
+  std::vector<T> values( n );
+
+  for( auto&& value : values )
+  {
+    value = distribution( rng );
+
+    if( integral )
+      value = std::trunc( value );
+  }
+
+  return values;
+}
+
+template <class T> void testComplex()
+{
+  ALEPH_TEST_BEGIN( "Cubical complex: cells" );
+
+  CubicalComplex<T> K( { 3, 4, 2 }, makeValues<T>( { 3, 4, 2 }, false, 42 ) );
+
+  ALEPH_ASSERT_EQUAL( K.dimension(),   3 );
+  ALEPH_ASSERT_EQUAL( K.numVertices(), 24 );
+  ALEPH_ASSERT_EQUAL( K.size(),        5 * 7 * 3 );
+
+  std::vector<std::size_t> counts( 4 );
+  long chi = 0;
+
+  for( std::size_t c = 0; c < K.size(); c++ )
+  {
+    auto d = K.cellDimension( c );
+
+    ++counts[d];
+    chi += d % 2 == 0 ? 1 : -1;
+
+    std::vector<std::size_t> faces;
+    std::vector<std::size_t> vertices;
+
+    K.boundary( c, std::back_inserter( faces ) );
+    K.vertices( c, std::back_inserter( vertices ) );
+
+    ALEPH_ASSERT_EQUAL( faces.size(),    2 * d );
+    ALEPH_ASSERT_EQUAL( vertices.size(), std::size_t(1) << d );
+
+    // Every face has a smaller value, and the cell is among the
+    // co-faces of all of its faces
+    for( auto&& face : faces )
+    {
+      std::vector<std::size_t> cofaces;
+      K.coboundary( face, std::back_inserter( cofaces ) );
+
+      ALEPH_ASSERT_EQUAL( K.cellDimension( face ), d - 1 );
+      ALEPH_ASSERT_THROW( K.value( face ) <= K.value( c ) );
+      ALEPH_ASSERT_THROW( std::find( cofaces.begin(), cofaces.end(), c ) != cofaces.end() );
+    }
+  }
+
+  ALEPH_ASSERT_EQUAL( counts[0], 24 );
+  ALEPH_ASSERT_EQUAL( counts[1], 2 * 4 * 2 + 3 * 3 * 2 + 3 * 4 * 1 );
+  ALEPH_ASSERT_EQUAL( counts[3], 2 * 3 * 1 );
+  ALEPH_ASSERT_EQUAL( chi, 1 );
+
+  ALEPH_ASSERT_EQUAL( K.vertexToCell( 0 ),  0 );
+  ALEPH_ASSERT_EQUAL( K.vertexToCell( 23 ), K.size() - 1 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testDiagrams()
+{
+  ALEPH_TEST_BEGIN( "Cubical complex: persistence diagrams" );
+
+  using Filtration = typename CubicalComplex<T>::Filtration;
+
+  std::vector< std::vector<std::size_t> > shapes = {
+    { 25 },
+    { 9, 13 },
+    { 1, 10 },
+    { 6, 5, 7 },
+    { 4, 1, 5 },
+    { 3, 4, 3, 3 }
+  };
+
+  unsigned seed = 0;
+
+  for( auto&& shape : shapes )
+  {
+    for( bool integral : { false, true } )
+    {
+      for( auto filtration : { Filtration::LowerStar, Filtration::UpperStar } )
+      {
+        CubicalComplex<T> K( shape, makeValues<T>( shape, integral, seed++ ), filtration );
+
+        CubicalCohomology<T> cubicalCohomology( K );
+
+        auto expected = calculateReferenceDiagrams( K );
+        auto actual   = cubicalCohomology();
+
+        ALEPH_ASSERT_EQUAL( actual.size(), shape.size() );
+        ALEPH_ASSERT_EQUAL( actual.front().betti(), 1 );
+
+        compareDiagrams( expected, actual );
+
+        // A smaller index type must not change the results
+        auto other = CubicalCohomology<T, std::uint32_t>( K )();
+
+        ALEPH_ASSERT_EQUAL( actual.size(), other.size() );
+
+        for( std::size_t i = 0; i < actual.size(); i++ )
+          ALEPH_ASSERT_THROW( actual[i] == other[i] );
+      }
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testImage()
+{
+  ALEPH_TEST_BEGIN( "Cubical complex: image with known features" );
+
+  // Two basins separated by a ridge, and a ring enclosing a single
+  // pixel of a smaller value
+  std::vector<T> values = {
+    0, 0, 5, 1, 1, 1, 1,
+    0, 0, 5, 1, 7, 7, 7,
+    5, 5, 5, 1, 7, 2, 7,
+    1, 1, 1, 1, 7, 7, 7
+  };
+
+  CubicalComplex<T> K( { 4, 7 }, values );
+
+  auto diagrams = CubicalCohomology<T>( K )();
+
+  ALEPH_ASSERT_EQUAL( diagrams.size(), 2 );
+
+  auto&& D0 = diagrams[0];
+  auto&& D1 = diagrams[1];
+
+  ALEPH_ASSERT_EQUAL( D0.dimension(), 0 );
+  ALEPH_ASSERT_EQUAL( D1.dimension(), 1 );
+
+  std::vector< std::pair<T, T> > expected0 = { { T(0), std::numeric_limits<T>::infinity() }, { T(1), T(5) }, { T(2), T(7) } };
+
+  std::vector< std::pair<T, T> > actual0;
+
+  for( auto&& p : D0 )
+    actual0.push_back( std::make_pair( p.x(), p.y() ) );
+
+  std::sort( actual0.begin(), actual0.end() );
+
+  ALEPH_ASSERT_THROW( actual0 == expected0 );
+
+  // The ring is filled at the same time it is closed
+  ALEPH_ASSERT_EQUAL( D1.size(), 0 );
+
+  // In the upper-star filtration, the ring appears first and creates
+  // a cycle that is destroyed by the pixel in its interior.
+  CubicalComplex<T> L( { 4, 7 }, values, CubicalComplex<T>::Filtration::UpperStar );
+
+  auto E = CubicalCohomology<T>( L )();
+
+  ALEPH_ASSERT_EQUAL( E.size(),         2 );
+  ALEPH_ASSERT_EQUAL( E[0].betti(),     1 );
+  ALEPH_ASSERT_EQUAL( E[1].size(),      1 );
+  ALEPH_ASSERT_EQUAL( E[1].begin()->x(), T(7) );
+  ALEPH_ASSERT_EQUAL( E[1].begin()->y(), T(2) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testExceptions()
+{
+  ALEPH_TEST_BEGIN( "Cubical complex: invalid inputs" );
+
+  auto throws = [] ( const std::vector<std::size_t>& shape, std::size_t n )
+  {
+    try
+    {
+      CubicalComplex<T> K( shape, std::vector<T>( n ) );
+    }
+    catch( std::runtime_error& )
+    {
+      return true;
+    }
+
+    return false;
+  };
+
+  ALEPH_ASSERT_THROW( throws( {},        1 ) );
+  ALEPH_ASSERT_THROW( throws( { 3, 0 },  0 ) );
+  ALEPH_ASSERT_THROW( throws( { 3, 4 }, 11 ) );
+  ALEPH_ASSERT_THROW( throws( { 3, 4 }, 12 ) == false );
+
+  // The lower-star patterns of the engine grow exponentially with the
+  // dimension of the grid and exceed the memory limit.
+  {
+    std::vector<std::size_t> shape( 11, 2 );
+    CubicalComplex<T> K( shape, std::vector<T>( std::size_t(1) << shape.size() ) );
+
+    bool thrown = false;
+
+    try
+    {
+      CubicalCohomology<T> cubicalCohomology( K );
+    }
+    catch( std::runtime_error& )
+    {
+      thrown = true;
+    }
+
+    ALEPH_ASSERT_THROW( thrown );
+  }
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testComplex<float> ();
+  testComplex<double>();
+
+  testDiagrams<float> ();
+  testDiagrams<double>();
+
+  testImage<float> ();
+  testImage<double>();
+
+  testExceptions<float> ();
+  testExceptions<double>();
+}
@@ -2,10 +2,16 @@
 
 #include <aleph/geometry/distances/Euclidean.hh>
 #include <aleph/geometry/distances/Hamming.hh>
+#include <aleph/geometry/distances/Infinity.hh>
+#include <aleph/geometry/distances/Kernels.hh>
 #include <aleph/geometry/distances/Manhattan.hh>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
+#include <cmath>
+
 using namespace aleph;
 using namespace geometry;
 using namespace distances;
@@ -64,6 +70,129 @@ template <class T> void testManhattanDistance()
   ALEPH_TEST_END();
 }
 
+template <class T> void testInfinityDistance()
+{
+  ALEPH_TEST_BEGIN( "Infinity distance" );
+
+  std::vector<T> x = {1,2,3};
+  std::vector<T> y = {4,7,6};
+
+  auto functor  = InfinityDistance<T>();
+  auto distance = functor( x.begin(), y.begin(), x.size() );
+
+  ALEPH_ASSERT_EQUAL( distance, T(5) );
+  ALEPH_ASSERT_EQUAL( distance, functor( y.begin(), x.begin(), y.size() ) );
+
+  ALEPH_TEST_END();
+}
+
+/**
+  Compares the evaluation of a distance functor for contiguous ranges,
+  which may use a vectorized kernel, with an expected value.
+*/
+
+template <class Distance, class T> void compareKernel( const std::vector<T>& x, const std::vector<T>& y, T expected )
+{
+  Distance distance;
+
+  ALEPH_ASSERT_EQUAL( distance( x.begin(), y.begin(), x.size() ), expected );
+  ALEPH_ASSERT_EQUAL( distance( x.data(),  y.data(),  x.size() ), expected );
+}
+
+template <class T> void testKernels()
+{
+  ALEPH_TEST_BEGIN( "Distance kernels" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_int_distribution<int> distribution( -8, 8 );
+
+  for( auto instructionSet : { kernels::InstructionSet::Scalar,
+                               kernels::InstructionSet::SSE2,
+                               kernels::InstructionSet::AVX2,
+                               kernels::InstructionSet::AVX512 } )
+  {
+    kernels::setInstructionSet( instructionSet );
+
+    ALEPH_ASSERT_THROW( kernels::instructionSet() <= kernels::supportedInstructionSet() );
+
+    for( std::size_t n = 1; n < 70; n++ )
+    {
+      std::vector<T> x( n );
+      std::vector<T> y( n );
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        x[i] = T( distribution( rng ) );
+        y[i] = i % 3 == 0 ? x[i] : T( distribution( rng ) );
+      }
+
+      // Coordinates are small integers, so all results are exact,
+      // regardless of the order of operations.
+      T euclidean = T();
+      T hamming   = T();
+      T infinity  = T();
+      T manhattan = T();
+
+      for( std::size_t i = 0; i < n; i++ )
+      {
+        auto d     = std::abs( x[i] - y[i] );
+        euclidean += d * d;
+        hamming   += x[i] != y[i] ? T(1) : T(0);
+        infinity   = std::max( infinity, d );
+        manhattan += d;
+      }
+
+      compareKernel< Euclidean<T> >       ( x, y, euclidean );
+      compareKernel< Hamming<T> >         ( x, y, hamming   );
+      compareKernel< InfinityDistance<T> >( x, y, infinity  );
+      compareKernel< Manhattan<T> >       ( x, y, manhattan );
+    }
+  }
+
+  kernels::setInstructionSet( kernels::InstructionSet::AVX512 );
+
+  ALEPH_ASSERT_THROW( kernels::instructionSet() == kernels::supportedInstructionSet() );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testOneToMany()
+{
+  ALEPH_TEST_BEGIN( "Distance kernels: one-to-many" );
+
+  std::mt19937 rng( 23 );
+  std::uniform_real_distribution<T> distribution( T(-1), T(1) );
+
+  std::size_t n         = 100;
+  std::size_t dimension = 33;
+
+  std::vector<T> points( n * dimension );
+  std::vector<T> query( dimension );
+
+  for( auto&& x : points )
+    x = distribution( rng );
+
+  for( auto&& x : query )
+    x = distribution( rng );
+
+  std::vector<T> distances( n );
+
+  Euclidean<T> distance;
+  oneToMany( distance, query.data(), points.data(), n, dimension, distances.data() );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    T expected = T();
+
+    for( std::size_t j = 0; j < dimension; j++ )
+      expected += ( query[j] - points[i*dimension+j] ) * ( query[j] - points[i*dimension+j] );
+
+    ALEPH_ASSERT_THROW( std::abs( distances[i] - expected ) <= T(1e-4) * expected );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   testEuclideanDistance<float> ();
@@ -74,4 +203,13 @@ int main(int, char**)
 
   testManhattanDistance<float> ();
   testManhattanDistance<double>();
+
+  testInfinityDistance<float> ();
+  testInfinityDistance<double>();
+
+  testKernels<float> ();
+  testKernels<double>();
+
+  testOneToMany<float> ();
+  testOneToMany<double>();
 }
@@ -0,0 +1,142 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/EdgeCollapse.hh>
+#include <aleph/geometry/RipsExpander.hh>
+#include <aleph/geometry/RipsSkeleton.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+
+/**
+  Checks that the flag complexes of two graphs have the same persistent
+  homology in all dimensions that are not affected by the truncation of
+  the expansion.
+*/
+
+template <class SimplicialComplex> void compare( const SimplicialComplex& K, const SimplicialComplex& L, unsigned dimension )
+{
+  using Simplex  = typename SimplicialComplex::ValueType;
+  using DataType = typename Simplex::DataType;
+
+  RipsExpander<SimplicialComplex> ripsExpander;
+
+  auto K1 = ripsExpander.expand( K, dimension, true );
+  auto L1 = ripsExpander.expand( L, dimension, true );
+
+  K1.sort( topology::filtrations::Data<Simplex>() );
+  L1.sort( topology::filtrations::Data<Simplex>() );
+
+  auto D1 = calculatePersistenceDiagrams( K1 );
+  auto D2 = calculatePersistenceDiagrams( L1 );
+
+  auto points = [] ( std::vector< PersistenceDiagram<DataType> >& diagrams, std::size_t d )
+  {
+    std::vector< std::pair<DataType, DataType> > result;
+
+    for( auto&& D : diagrams )
+    {
+      if( D.dimension() != d )
+        continue;
+
+      D.removeDiagonal();
+
+      for( auto&& p : D )
+        result.push_back( std::make_pair( p.x(), p.y() ) );
+    }
+
+    std::sort( result.begin(), result.end() );
+    return result;
+  };
+
+  for( std::size_t d = 0; d < dimension; d++ )
+    ALEPH_ASSERT_THROW( points( D1, d ) == points( D2, d ) );
+}
+
+template <class T> void testRandom()
+{
+  ALEPH_TEST_BEGIN( "Edge collapse of a random point cloud" );
+
+  using PointCloud        = PointCloud<T>;
+  using Distance          = distances::Euclidean<T>;
+  using NearestNeighbours = BruteForce<PointCloud, Distance>;
+
+  std::size_t n = 100;
+
+  PointCloud pointCloud( n, 3 );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  NearestNeighbours nn( pointCloud );
+  RipsSkeleton<NearestNeighbours> ripsSkeleton;
+
+  auto K = ripsSkeleton( nn, T(0.5) );
+  auto L = collapseEdges( K );
+
+  ALEPH_ASSERT_EQUAL( std::distance( K.range(0).first, K.range(0).second ), std::distance( L.range(0).first, L.range(0).second ) );
+  ALEPH_ASSERT_THROW( L.size() < K.size() );
+
+  compare( K, L, 3 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testGrid()
+{
+  ALEPH_TEST_BEGIN( "Edge collapse of a grid" );
+
+  using PointCloud        = PointCloud<T>;
+  using Distance          = distances::Euclidean<T>;
+  using NearestNeighbours = BruteForce<PointCloud, Distance>;
+
+  // Points on a grid result in many edges with the same weight, which
+  // checks the handling of ties.
+  PointCloud pointCloud( 5 * 5 * 2, 3 );
+
+  std::size_t i = 0;
+
+  for( unsigned x = 0; x < 5; x++ )
+    for( unsigned y = 0; y < 5; y++ )
+      for( unsigned z = 0; z < 2; z++ )
+        pointCloud.set( i++, { T(x), T(y), T(z) } );
+
+  NearestNeighbours nn( pointCloud );
+  RipsSkeleton<NearestNeighbours> ripsSkeleton;
+
+  auto K = ripsSkeleton( nn, T(2.5) );
+  auto L = collapseEdges( K );
+
+  ALEPH_ASSERT_THROW( L.size() < K.size() );
+
+  compare( K, L, 3 );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testRandom<float> ();
+  testRandom<double>();
+
+  testGrid<float> ();
+  testGrid<double>();
+}
@@ -0,0 +1,219 @@
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/RipsExpander.hh>
+#include <aleph/geometry/RipsSkeleton.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+#include <aleph/topology/FlatSimplicialComplex.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/topology/representations/Vector.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace topology;
+
+template <class K, class L> bool equal( const K& k, const L& l )
+{
+  if( k.size() != l.size() )
+    return false;
+
+  auto itL = l.begin();
+  for( auto itK = k.begin(); itK != k.end(); ++itK, ++itL )
+  {
+    if( *itK != *itL || itK->data() != itL->data() )
+      return false;
+  }
+
+  return true;
+}
+
+template <class T> void testQueries()
+{
+  ALEPH_TEST_BEGIN( "Flat simplicial complex: queries" );
+
+  using Simplex = Simplex<T, unsigned>;
+  using Complex = FlatSimplicialComplex<Simplex>;
+
+  Complex K = {
+    {0,1,2}, {0,1}, {0,2}, {1,2}, {2,3}, {0}, {1}, {2}, {3}
+  };
+
+  ALEPH_ASSERT_EQUAL( K.size(), 9 );
+  ALEPH_ASSERT_EQUAL( K.dimension(), 2 );
+
+  ALEPH_ASSERT_THROW( K.contains( {0,2} ) );
+  ALEPH_ASSERT_THROW( K.contains( {1,3} ) == false );
+  ALEPH_ASSERT_THROW( K.find( {1,3} ) == K.end() );
+  ALEPH_ASSERT_THROW( *K.find( {2,3} ) == Simplex( {2,3} ) );
+
+  ALEPH_ASSERT_EQUAL( K.index( {0,1,2} ), 0 );
+  ALEPH_ASSERT_EQUAL( K.index( {3} ),     8 );
+  ALEPH_EXPECT_EXCEPTION( K.index( {4} ), std::runtime_error );
+
+  {
+    auto pair = K.range(1);
+    ALEPH_ASSERT_EQUAL( std::distance( pair.first, pair.second ), 4 );
+
+    std::vector<Simplex> edges( pair.first, pair.second );
+    ALEPH_ASSERT_THROW( edges.front() == Simplex( {0,1} ) );
+    ALEPH_ASSERT_THROW( edges.back()  == Simplex( {2,3} ) );
+
+    ALEPH_ASSERT_EQUAL( std::distance( K.range(2).first, K.range(2).second ), 1 );
+    ALEPH_ASSERT_EQUAL( std::distance( K.range(3).first, K.range(3).second ), 0 );
+  }
+
+  {
+    std::vector<unsigned> vertices;
+    K.vertices( std::back_inserter( vertices ) );
+
+    ALEPH_ASSERT_THROW( vertices == std::vector<unsigned>( { 0, 1, 2, 3 } ) );
+  }
+
+  // Duplicates are ignored and new simplices become visible in all of
+  // the lookup structures.
+  K.push_back( {0,1} );
+  K.push_back( {1,3} );
+
+  ALEPH_ASSERT_EQUAL( K.size(), 10 );
+  ALEPH_ASSERT_EQUAL( K.index( {1,3} ), 9 );
+  ALEPH_ASSERT_EQUAL( std::distance( K.range(1).first, K.range(1).second ), 5 );
+
+  K.sort();
+
+  ALEPH_ASSERT_EQUAL( K.index( {0} ), 0 );
+  ALEPH_ASSERT_THROW( std::is_sorted( K.begin(), K.end() ) );
+  ALEPH_ASSERT_THROW( std::equal( K.begin(), K.end(), K.begin_lexicographical() ) );
+
+  ALEPH_ASSERT_THROW( K.replace( K.find( {1,3} ), Simplex( {1,3}, T(2) ) ) );
+  ALEPH_ASSERT_EQUAL( K.find( {1,3} )->data(), T(2) );
+  ALEPH_ASSERT_THROW( K.replace( K.find( {1,3} ), Simplex( {0,1} ) ) == false );
+  ALEPH_ASSERT_THROW( K.replace( K.find( {1,3} ), Simplex( {0,3} ) ) );
+  ALEPH_ASSERT_THROW( K.contains( {0,3} ) );
+  ALEPH_ASSERT_THROW( K.contains( {1,3} ) == false );
+
+  K.remove( {2} );
+
+  ALEPH_ASSERT_EQUAL( K.size(), 5 );
+  ALEPH_ASSERT_THROW( K.contains( {0,2} ) == false );
+  ALEPH_ASSERT_THROW( K.contains( {0,1,2} ) == false );
+  ALEPH_ASSERT_THROW( K.contains( {0,3} ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testConsistency()
+{
+  ALEPH_TEST_BEGIN( "Flat simplicial complex: consistency" );
+
+  using Simplex = Simplex<T, unsigned>;
+
+  std::vector<Simplex> simplices = {
+    {{0,1,2}, T(3)}, {{0,1,3}, T(4)}, {{0}, T(0)}, {{1}, T(1)}
+  };
+
+  SimplicialComplex<Simplex>     K( simplices.begin(), simplices.end() );
+  FlatSimplicialComplex<Simplex> L( simplices.begin(), simplices.end() );
+
+  K.createMissingFaces();
+  L.createMissingFaces();
+
+  ALEPH_ASSERT_EQUAL( K.size(), L.size() );
+
+  K.recalculateWeights( false );
+  L.recalculateWeights( false );
+
+  K.sort( filtrations::Data<Simplex>() );
+  L.sort( filtrations::Data<Simplex>() );
+
+  ALEPH_ASSERT_THROW( equal( K, L ) );
+  ALEPH_ASSERT_THROW( std::equal( K.begin_lexicographical(), K.end_lexicographical(), L.begin_lexicographical() ) );
+  ALEPH_ASSERT_THROW( std::equal( K.begin_dimension(), K.end_dimension(), L.begin_dimension() ) );
+
+  for( auto&& simplex : K )
+    ALEPH_ASSERT_EQUAL( K.index( simplex ), L.index( simplex ) );
+
+  using Representation = representations::Vector<unsigned>;
+
+  ALEPH_ASSERT_THROW( makeBoundaryMatrix<Representation>( K ) == makeBoundaryMatrix<Representation>( L ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRipsComplex()
+{
+  ALEPH_TEST_BEGIN( "Flat simplicial complex: Vietoris--Rips complex" );
+
+  using PointCloud = PointCloud<T>;
+  using Distance   = distances::Euclidean<T>;
+  using Wrapper    = BruteForce<PointCloud, Distance>;
+  using Index      = typename Wrapper::IndexType;
+  using Simplex    = Simplex<T, Index>;
+  using Complex1   = SimplicialComplex<Simplex>;
+  using Complex2   = FlatSimplicialComplex<Simplex>;
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  Wrapper wrapper( pointCloud );
+  RipsSkeleton<Wrapper> ripsSkeleton;
+
+  auto skeleton = ripsSkeleton( wrapper, T(0.5) );
+
+  RipsExpander<Complex1> ripsExpander1;
+  RipsExpander<Complex2> ripsExpander2;
+
+  auto K1 = ripsExpander1( skeleton, 3 );
+  auto K2 = ripsExpander2( Complex2( skeleton.begin(), skeleton.end() ), 3 );
+
+  K1 = ripsExpander1.assignMaximumWeight( K1 );
+  K2 = ripsExpander2.assignMaximumWeight( K2 );
+
+  K1.sort( filtrations::Data<Simplex>() );
+  K2.sort( filtrations::Data<Simplex>() );
+
+  ALEPH_ASSERT_THROW( K1.size() > 0 );
+  ALEPH_ASSERT_THROW( equal( K1, K2 ) );
+
+  using Representation = representations::Vector<unsigned>;
+
+  ALEPH_ASSERT_THROW( makeBoundaryMatrix<Representation>( K1 ) == makeBoundaryMatrix<Representation>( K2 ) );
+
+  auto D1 = calculatePersistenceDiagrams( K1 );
+  auto D2 = calculatePersistenceDiagrams( K2 );
+
+  ALEPH_ASSERT_EQUAL( D1.size(), D2.size() );
+
+  for( std::size_t i = 0; i < D1.size(); i++ )
+    ALEPH_ASSERT_THROW( D1[i] == D2[i] );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testQueries<float> ();
+  testQueries<double>();
+
+  testConsistency<float> ();
+  testConsistency<double>();
+
+  testRipsComplex<float> ();
+  testRipsComplex<double>();
+}
@@ -0,0 +1,191 @@
+#include <aleph/containers/PointCloud.hh>
+#include <aleph/containers/SmallVector.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/RipsExpander.hh>
+#include <aleph/geometry/RipsSkeleton.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Conversions.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/topology/representations/Vector.hh>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace topology;
+
+void testSmallVector()
+{
+  ALEPH_TEST_BEGIN( "Small vector" );
+
+  SmallVector<unsigned, 3> v;
+
+  ALEPH_ASSERT_THROW( v.empty() );
+  ALEPH_ASSERT_THROW( v.isInline() );
+
+  v.push_back( 3 );
+  v.push_back( 1 );
+  v.push_back( 2 );
+
+  ALEPH_ASSERT_EQUAL( v.size(), 3 );
+  ALEPH_ASSERT_THROW( v.isInline() );
+
+  auto w = v;
+
+  v.push_back( 0 );
+
+  ALEPH_ASSERT_EQUAL( v.size(), 4 );
+  ALEPH_ASSERT_THROW( v.isInline() == false );
+  ALEPH_ASSERT_THROW( w.isInline() );
+  ALEPH_ASSERT_THROW( v != w );
+
+  std::vector<unsigned> expected = { 3, 1, 2, 0 };
+
+  ALEPH_ASSERT_THROW( std::equal( v.begin(), v.end(), expected.begin() ) );
+  ALEPH_ASSERT_EQUAL( hash_value( v ), boost::hash< std::vector<unsigned> >()( expected ) );
+
+  // Swapping inline and heap storage must keep both vectors intact
+  std::swap( v, w );
+
+  ALEPH_ASSERT_EQUAL( v.size(), 3 );
+  ALEPH_ASSERT_EQUAL( w.size(), 4 );
+  ALEPH_ASSERT_THROW( v.isInline() );
+  ALEPH_ASSERT_THROW( std::equal( w.begin(), w.end(), expected.begin() ) );
+
+  auto x = std::move( w );
+
+  ALEPH_ASSERT_THROW( std::equal( x.begin(), x.end(), expected.begin() ) );
+
+  x.erase( x.begin() + 1, x.begin() + 3 );
+
+  ALEPH_ASSERT_EQUAL( x.size(), 2 );
+  ALEPH_ASSERT_EQUAL( x.at(0), 3 );
+  ALEPH_ASSERT_EQUAL( x.at(1), 0 );
+
+  SmallVector<int, 2> y( 1, 5 );
+
+  ALEPH_ASSERT_EQUAL( y.size(), 1 );
+  ALEPH_ASSERT_EQUAL( y.front(), 5 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSimplex()
+{
+  ALEPH_TEST_BEGIN( "Inline simplex" );
+
+  using Simplex1 = Simplex<T, unsigned>;
+  using Simplex2 = InlineSimplex<T, unsigned>;
+  using Simplex3 = InlineSimplex<T, unsigned, 1>;
+
+  Simplex1 s1 = { 2, 0, 1, 2 };
+  Simplex2 s2 = { 2, 0, 1, 2 };
+  Simplex3 s3 = { 2, 0, 1, 2 };
+
+  ALEPH_ASSERT_EQUAL( s1.size(), 3 );
+  ALEPH_ASSERT_EQUAL( s2.size(), 3 );
+  ALEPH_ASSERT_EQUAL( s3.size(), 3 );
+
+  ALEPH_ASSERT_THROW( std::equal( s1.begin(), s1.end(), s2.begin() ) );
+  ALEPH_ASSERT_THROW( std::equal( s1.begin(), s1.end(), s3.begin() ) );
+
+  ALEPH_ASSERT_EQUAL( hash_value( s1 ), hash_value( s2 ) );
+  ALEPH_ASSERT_EQUAL( hash_value( s1 ), hash_value( s3 ) );
+
+  ALEPH_ASSERT_THROW( s2 == Simplex2( { 0, 1, 2 } ) );
+  ALEPH_ASSERT_THROW( s2 <  Simplex2( { 0, 1, 3 } ) );
+
+  std::vector<Simplex1> boundary1( s1.begin_boundary(), s1.end_boundary() );
+  std::vector<Simplex2> boundary2( s2.begin_boundary(), s2.end_boundary() );
+  std::vector<Simplex3> boundary3( s3.begin_boundary(), s3.end_boundary() );
+
+  ALEPH_ASSERT_EQUAL( boundary1.size(), 3 );
+  ALEPH_ASSERT_EQUAL( boundary2.size(), 3 );
+  ALEPH_ASSERT_EQUAL( boundary3.size(), 3 );
+
+  for( std::size_t i = 0; i < boundary1.size(); i++ )
+  {
+    ALEPH_ASSERT_THROW( std::equal( boundary1[i].begin(), boundary1[i].end(), boundary2[i].begin() ) );
+    ALEPH_ASSERT_THROW( std::equal( boundary1[i].begin(), boundary1[i].end(), boundary3[i].begin() ) );
+  }
+
+  ALEPH_ASSERT_THROW( boundary2.front() == Simplex2( { 0, 1 } ) );
+  ALEPH_ASSERT_THROW( boundary2.back()  == Simplex2( { 1, 2 } ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRipsComplex()
+{
+  ALEPH_TEST_BEGIN( "Inline simplex: Vietoris--Rips complex" );
+
+  using PointCloud = PointCloud<T>;
+  using Distance   = distances::Euclidean<T>;
+  using Wrapper    = BruteForce<PointCloud, Distance>;
+  using Index      = typename Wrapper::IndexType;
+
+  using Simplex1   = Simplex<T, Index>;
+  using Simplex2   = InlineSimplex<T, Index>;
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  Wrapper wrapper( pointCloud );
+
+  RipsSkeleton<Wrapper, Simplex1> ripsSkeleton1;
+  RipsSkeleton<Wrapper, Simplex2> ripsSkeleton2;
+
+  RipsExpander< SimplicialComplex<Simplex1> > ripsExpander1;
+  RipsExpander< SimplicialComplex<Simplex2> > ripsExpander2;
+
+  auto K1 = ripsExpander1( ripsSkeleton1( wrapper, T(0.5) ), 3 );
+  auto K2 = ripsExpander2( ripsSkeleton2( wrapper, T(0.5) ), 3 );
+
+  K1 = ripsExpander1.assignMaximumWeight( K1 );
+  K2 = ripsExpander2.assignMaximumWeight( K2 );
+
+  K1.sort( filtrations::Data<Simplex1>() );
+  K2.sort( filtrations::Data<Simplex2>() );
+
+  ALEPH_ASSERT_EQUAL( K1.size(), K2.size() );
+
+  auto it2 = K2.begin();
+  for( auto it1 = K1.begin(); it1 != K1.end(); ++it1, ++it2 )
+  {
+    ALEPH_ASSERT_EQUAL( it1->size(), it2->size() );
+    ALEPH_ASSERT_EQUAL( it1->data(), it2->data() );
+    ALEPH_ASSERT_THROW( std::equal( it1->begin(), it1->end(), it2->begin() ) );
+  }
+
+  using Representation = representations::Vector<unsigned>;
+
+  auto M1 = makeBoundaryMatrix<Representation>( K1 );
+  auto M2 = makeBoundaryMatrix<Representation>( K2 );
+
+  ALEPH_ASSERT_THROW( M1 == M2 );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testSmallVector();
+
+  testSimplex<float> ();
+  testSimplex<double>();
+
+  testRipsComplex<float> ();
+  testRipsComplex<double>();
+}
@@ -1,7 +1,12 @@
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
 #include <set>
 #include <string>
+#include <vector>
 
+#include <aleph/persistenceDiagrams/distances/detail/JonkerVolgenant.hh>
 #include <aleph/persistenceDiagrams/distances/detail/Matrix.hh>
 #include <aleph/persistenceDiagrams/distances/detail/Munkres.hh>
 
@@ -9,7 +14,7 @@
 
 using namespace aleph::distances::detail;
 
-template <class T> void threeByThree()
+template <class T, template <class> class Solver> void threeByThree()
 {
   ALEPH_TEST_BEGIN( "Solving a three-by-three matrix" );
 
@@ -19,7 +24,7 @@ template <class T> void threeByThree()
   m(1,0) = static_cast<T>(2); m(1,1) = static_cast<T>(4); m(1,2) = static_cast<T>(6);
   m(2,0) = static_cast<T>(3); m(2,1) = static_cast<T>(6); m(2,2) = static_cast<T>(9);
 
-  Munkres<T> solver( m );
+  Solver<T> solver( m );
   solver();
 
   auto cost = solver.cost( m );
@@ -30,7 +35,7 @@ template <class T> void threeByThree()
   ALEPH_TEST_END();
 }
 
-template <class T> void fourByFour()
+template <class T, template <class> class Solver> void fourByFour()
 {
   ALEPH_TEST_BEGIN( "Solving a four-by-four matrix" );
 
@@ -41,7 +46,7 @@ template <class T> void fourByFour()
   m(2,0) = static_cast<T>(11); m(2,1) = static_cast<T>(69); m(2,2) = static_cast<T>( 5); m(2,3) = static_cast<T>(86);
   m(3,0) = static_cast<T>( 8); m(3,1) = static_cast<T>( 9); m(3,2) = static_cast<T>(98); m(3,3) = static_cast<T>(23);
 
-  Munkres<T> solver( m );
+  Solver<T> solver( m );
   solver();
 
   auto cost = solver.cost( m );
@@ -83,23 +88,90 @@ template <class T> void fourByFour()
   ALEPH_TEST_END();
 }
 
+template <class T> void random()
+{
+  ALEPH_TEST_BEGIN( "Comparing solvers on random matrices" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_int_distribution<unsigned> value( 0, 100 );
+  std::uniform_real_distribution<double> coin( 0.0, 1.0 );
+
+  for( std::size_t n = 1; n <= 40; n++ )
+  {
+    Matrix<T> m( n );
+
+    // Forbidden entries are marked by the maximum value, but one of the
+    // diagonals remains permitted so that every row can be assigned.
+    for( std::size_t row = 0; row < n; row++ )
+    {
+      for( std::size_t col = 0; col < n; col++ )
+      {
+        if( n % 2 == 0 && ( row + col ) % n != 0 && coin( rng ) < 0.3 )
+          m( row, col ) = std::numeric_limits<T>::max();
+        else
+          m( row, col ) = static_cast<T>( value( rng ) );
+      }
+    }
+
+    Munkres<T> munkres( m );
+    munkres();
+
+    JonkerVolgenant<T> jonkerVolgenant( m );
+    jonkerVolgenant();
+
+    ALEPH_ASSERT_EQUAL( munkres.cost( m ), jonkerVolgenant.cost( m ) );
+
+    std::vector< std::pair<std::size_t, std::size_t> > matching;
+    jonkerVolgenant.matching( std::back_inserter( matching ) );
+
+    std::set<std::size_t> columns;
+
+    for( auto&& pair : matching )
+      columns.insert( pair.second );
+
+    ALEPH_ASSERT_EQUAL( matching.size(), n );
+    ALEPH_ASSERT_EQUAL( columns.size(),  n );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main()
 {
   // 3x3 ---------------------------------------------------------------
 
-  threeByThree<int>           ();
-  threeByThree<unsigned int>  ();
-  threeByThree<long>          ();
-  threeByThree<unsigned long> ();
-  threeByThree<float>         ();
-  threeByThree<double>        ();
+  threeByThree<int,           Munkres>();
+  threeByThree<unsigned int,  Munkres>();
+  threeByThree<long,          Munkres>();
+  threeByThree<unsigned long, Munkres>();
+  threeByThree<float,         Munkres>();
+  threeByThree<double,        Munkres>();
+
+  threeByThree<int,           JonkerVolgenant>();
+  threeByThree<unsigned int,  JonkerVolgenant>();
+  threeByThree<long,          JonkerVolgenant>();
+  threeByThree<unsigned long, JonkerVolgenant>();
+  threeByThree<float,         JonkerVolgenant>();
+  threeByThree<double,        JonkerVolgenant>();
 
   // 4x4 ---------------------------------------------------------------
 
-  fourByFour<int>           ();
-  fourByFour<unsigned int>  ();
-  fourByFour<long>          ();
-  fourByFour<unsigned long> ();
-  fourByFour<float>         ();
-  fourByFour<double>        ();
+  fourByFour<int,           Munkres>();
+  fourByFour<unsigned int,  Munkres>();
+  fourByFour<long,          Munkres>();
+  fourByFour<unsigned long, Munkres>();
+  fourByFour<float,         Munkres>();
+  fourByFour<double,        Munkres>();
+
+  fourByFour<int,           JonkerVolgenant>();
+  fourByFour<unsigned int,  JonkerVolgenant>();
+  fourByFour<long,          JonkerVolgenant>();
+  fourByFour<unsigned long, JonkerVolgenant>();
+  fourByFour<float,         JonkerVolgenant>();
+  fourByFour<double,        JonkerVolgenant>();
+
+  // Random matrices ---------------------------------------------------
+
+  random<float> ();
+  random<double>();
 }
@@ -3,16 +3,27 @@
 #include <aleph/containers/PointCloud.hh>
 
 #include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/CoverTreeNeighbours.hh>
 #include <aleph/geometry/FLANN.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/NearestNeighbours.hh>
+#include <aleph/geometry/RandomProjectionForest.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
+#include <aleph/geometry/distances/Hamming.hh>
+#include <aleph/geometry/distances/Infinity.hh>
+#include <aleph/geometry/distances/Manhattan.hh>
 
 #include <tests/Base.hh>
 
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <utility>
 #include <vector>
 
 #include <cassert>
+#include <cmath>
 
 using namespace aleph;
 using namespace geometry;
@@ -86,6 +97,380 @@ template <class T> void test()
   testInternal< FLANN<PointCloud, Distance> >( pointCloud );
 #endif
   testInternal< BruteForce<PointCloud, Distance> >( pointCloud );
+  testInternal< CoverTreeNeighbours<PointCloud, Distance> >( pointCloud );
+  testInternal< KDTree<PointCloud, Distance> >( pointCloud );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testBruteForce()
+{
+  ALEPH_TEST_BEGIN( "Brute-force nearest-neighbour calculation" );
+
+  using PointCloud = PointCloud<T>;
+  using Distance   = Euclidean<T>;
+  using Wrapper    = BruteForce<PointCloud, Distance>;
+
+  // Use a number of points that results in an odd number of tiles, and
+  // a partial last tile.
+  std::size_t n = 333;
+  std::size_t d = 3;
+
+  PointCloud pointCloud( n, d );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  Distance dist;
+  std::vector< std::vector<T> > D( n, std::vector<T>( n ) );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto p = pointCloud[i];
+
+    for( std::size_t j = 0; j < n; j++ )
+    {
+      auto q  = pointCloud[j];
+      D[i][j] = std::sqrt( dist( p.begin(), q.begin(), d ) );
+    }
+  }
+
+  Wrapper wrapper( pointCloud );
+  typename Wrapper::NeighbourList neighbours;
+
+  {
+    T radius = T(0.2);
+
+    wrapper.radiusSearch( radius, neighbours );
+
+    ALEPH_ASSERT_EQUAL( neighbours.size(), n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      std::vector<std::size_t> expected;
+      for( std::size_t j = 0; j < n; j++ )
+        if( D[i][j] < radius )
+          expected.push_back( j );
+
+      ALEPH_ASSERT_EQUAL( neighbours.degree(i), expected.size() );
+      ALEPH_ASSERT_THROW( std::equal( expected.begin(), expected.end(),
+                                      neighbours.indices.begin() + static_cast<std::ptrdiff_t>( neighbours.offsets[i] ) ) );
+    }
+  }
+
+  {
+    unsigned k = 7;
+
+    wrapper.neighbourSearch( k, neighbours );
+
+    ALEPH_ASSERT_EQUAL( neighbours.size(), n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      std::vector< std::pair<T, std::size_t> > expected;
+      for( std::size_t j = 0; j < n; j++ )
+        expected.push_back( std::make_pair( D[i][j], j ) );
+
+      std::sort( expected.begin(), expected.end() );
+
+      ALEPH_ASSERT_EQUAL( neighbours.degree(i), k );
+      ALEPH_ASSERT_EQUAL( neighbours.indices[ neighbours.offsets[i] ], i );
+
+      for( std::size_t l = 0; l < k; l++ )
+        ALEPH_ASSERT_THROW( std::abs( neighbours.distances[ neighbours.offsets[i] + l ] - expected[l].first ) < T(1e-5) );
+    }
+  }
+
+  {
+    std::vector< std::vector<std::size_t> > indices;
+    std::vector< std::vector<T> > distances;
+
+    wrapper.neighbourSearch( static_cast<unsigned>( 2 * n ), indices, distances );
+
+    ALEPH_ASSERT_EQUAL( indices.size(), n );
+    for( auto&& i : indices )
+      ALEPH_ASSERT_EQUAL( i.size(), n );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T, class Distance> void testCoverTreeInternal( T radius )
+{
+  using PointCloud = PointCloud<T>;
+
+  std::size_t n = 500;
+  std::size_t d = 5;
+
+  PointCloud pointCloud( n, d );
+
+  std::mt19937 rng( 23 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<T> p( d );
+
+    for( auto&& x : p )
+      x = distribution( rng );
+
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  BruteForce<PointCloud, Distance> bruteForce( pointCloud );
+  CoverTreeNeighbours<PointCloud, Distance> coverTree( pointCloud );
+
+  typename BruteForce<PointCloud, Distance>::NeighbourList expected;
+  typename CoverTreeNeighbours<PointCloud, Distance>::NeighbourList actual;
+
+  bruteForce.radiusSearch( radius, expected );
+  coverTree.radiusSearch( radius, actual );
+
+  ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+  ALEPH_ASSERT_THROW( expected.indices == actual.indices );
+
+  for( unsigned k : { 1u, 10u, 600u } )
+  {
+    bruteForce.neighbourSearch( k, expected );
+    coverTree.neighbourSearch( k, actual );
+
+    ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+
+    // Ties may be broken differently, so only the distances have to
+    // coincide.
+    for( std::size_t i = 0; i < expected.distances.size(); i++ )
+      ALEPH_ASSERT_THROW( std::abs( expected.distances[i] - actual.distances[i] ) < T(1e-5) );
+  }
+}
+
+template <class T> void testCoverTree()
+{
+  ALEPH_TEST_BEGIN( "Cover tree nearest-neighbour calculation" );
+
+  testCoverTreeInternal< T, Euclidean<T> >       ( T(0.4) );
+  testCoverTreeInternal< T, Manhattan<T> >       ( T(0.8) );
+  testCoverTreeInternal< T, InfinityDistance<T> >( T(0.3) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T, class Distance> void testKDTreeInternal( std::size_t d, T radius, T scale = T(1) )
+{
+  using PointCloud = PointCloud<T>;
+
+  std::size_t n = 1000;
+
+  PointCloud pointCloud( n, d );
+
+  std::mt19937 rng( 23 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<T> p( d );
+
+    // Use a coarse grid for some of the points in order to obtain ties
+    // and duplicate coordinates.
+    for( auto&& x : p )
+      x = scale * ( i % 2 ? distribution( rng ) : std::round( 4 * distribution( rng ) ) / 4 );
+
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  BruteForce<PointCloud, Distance> bruteForce( pointCloud );
+  KDTree<PointCloud, Distance> kdTree( pointCloud );
+
+  typename BruteForce<PointCloud, Distance>::NeighbourList expected;
+  typename KDTree<PointCloud, Distance>::NeighbourList actual;
+
+  bruteForce.radiusSearch( radius, expected );
+  kdTree.radiusSearch( radius, actual );
+
+  ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto begin = static_cast<std::ptrdiff_t>( actual.offsets[i] );
+    auto end   = static_cast<std::ptrdiff_t>( actual.offsets[i+1] );
+
+    // Neighbours are sorted by distance
+    ALEPH_ASSERT_THROW( std::is_sorted( actual.distances.begin() + begin, actual.distances.begin() + end ) );
+
+    std::vector<std::size_t> indices( actual.indices.begin() + begin, actual.indices.begin() + end );
+    std::sort( indices.begin(), indices.end() );
+
+    ALEPH_ASSERT_THROW( std::equal( indices.begin(), indices.end(), expected.indices.begin() + begin ) );
+  }
+
+  // Since both backends break ties by index, the results have to be
+  // identical.
+  for( unsigned k : { 1u, 8u, 1200u } )
+  {
+    bruteForce.neighbourSearch( k, expected );
+    kdTree.neighbourSearch( k, actual );
+
+    ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+    ALEPH_ASSERT_THROW( expected.indices == actual.indices );
+  }
+}
+
+template <class T> void testKDTree()
+{
+  ALEPH_TEST_BEGIN( "kd-tree nearest-neighbour calculation" );
+
+  testKDTreeInternal< T, Euclidean<T> >( 2,  T(0.1) );
+  testKDTreeInternal< T, Euclidean<T> >( 3,  T(0.2) );
+  testKDTreeInternal< T, Euclidean<T> >( 10, T(0.8) );
+  testKDTreeInternal< T, Manhattan<T> >( 3,  T(0.3) );
+
+  // Coordinates differ by more than one, so their differences are not
+  // a lower bound of the contributions to the Hamming distance.
+  testKDTreeInternal< T, Hamming<T> >  ( 4,  T(3), T(10) );
+  testKDTreeInternal< T, Hamming<T> >  ( 6,  T(5), T(10) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandomProjectionForest()
+{
+  ALEPH_TEST_BEGIN( "Random projection forest nearest-neighbour calculation" );
+
+  using PointCloud = PointCloud<T>;
+  using Distance   = Euclidean<T>;
+  using Forest     = RandomProjectionForest<PointCloud, Distance>;
+
+  // Sample points from a low-dimensional subspace with some noise, which
+  // is a typical situation for high-dimensional data.
+  std::size_t n = 1000;
+  std::size_t d = 50;
+  std::size_t e = 5;
+
+  PointCloud pointCloud( n, d );
+
+  std::mt19937 rng( 42 );
+  std::normal_distribution<T> distribution( T(0), T(1) );
+
+  std::vector<T> basis( e * d );
+  for( auto&& x : basis )
+    x = distribution( rng );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<T> c( e );
+    for( auto&& x : c )
+      x = distribution( rng );
+
+    std::vector<T> p( d );
+
+    for( std::size_t j = 0; j < d; j++ )
+    {
+      p[j] = T(0.01) * distribution( rng );
+
+      for( std::size_t l = 0; l < e; l++ )
+        p[j] += c[l] * basis[l * d + j];
+    }
+
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  BruteForce<PointCloud, Distance> bruteForce( pointCloud );
+
+  typename Forest::NeighbourList expected;
+  typename Forest::NeighbourList actual;
+
+  // A forest with a single leaf is exact ------------------------------
+
+  {
+    Forest forest( pointCloud, 1, n, 0 );
+
+    T radius = T(4);
+
+    bruteForce.radiusSearch( radius, expected );
+    forest.radiusSearch( radius, actual );
+
+    ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+    ALEPH_ASSERT_THROW( expected.indices == actual.indices );
+
+    bruteForce.neighbourSearch( 10, expected );
+    forest.neighbourSearch( 10, actual );
+
+    ALEPH_ASSERT_THROW( expected.indices == actual.indices );
+  }
+
+  // Approximate results -----------------------------------------------
+
+  {
+    unsigned k = 10;
+
+    Forest forest( pointCloud );
+
+    bruteForce.neighbourSearch( k, expected );
+    forest.neighbourSearch( k, actual );
+
+    ALEPH_ASSERT_THROW( expected.offsets == actual.offsets );
+
+    std::size_t hits = 0;
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto begin = static_cast<std::ptrdiff_t>( actual.offsets[i] );
+      auto end   = static_cast<std::ptrdiff_t>( actual.offsets[i+1] );
+
+      ALEPH_ASSERT_EQUAL( actual.indices[ actual.offsets[i] ], i );
+      ALEPH_ASSERT_THROW( std::is_sorted( actual.distances.begin() + begin, actual.distances.begin() + end ) );
+
+      std::vector<std::size_t> u( expected.indices.begin() + begin, expected.indices.begin() + end );
+      std::vector<std::size_t> v( actual.indices.begin() + begin, actual.indices.begin() + end );
+      std::vector<std::size_t> w;
+
+      std::sort( u.begin(), u.end() );
+      std::sort( v.begin(), v.end() );
+      std::set_intersection( u.begin(), u.end(), v.begin(), v.end(), std::back_inserter( w ) );
+
+      hits += w.size();
+    }
+
+    ALEPH_ASSERT_THROW( static_cast<double>( hits ) / static_cast<double>( n * k ) > 0.9 );
+
+    // Radius search results are a symmetric subset of the exact results
+    T radius = T(6);
+
+    bruteForce.radiusSearch( radius, expected );
+    forest.radiusSearch( radius, actual );
+
+    ALEPH_ASSERT_EQUAL( actual.size(), n );
+    ALEPH_ASSERT_THROW( actual.indices.size() <= expected.indices.size() );
+    ALEPH_ASSERT_THROW( actual.indices.size() >= expected.indices.size() / 2 );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto begin = static_cast<std::ptrdiff_t>( actual.offsets[i] );
+      auto end   = static_cast<std::ptrdiff_t>( actual.offsets[i+1] );
+
+      ALEPH_ASSERT_THROW( std::includes( expected.indices.begin() + static_cast<std::ptrdiff_t>( expected.offsets[i] ),
+                                         expected.indices.begin() + static_cast<std::ptrdiff_t>( expected.offsets[i+1] ),
+                                         actual.indices.begin() + begin,
+                                         actual.indices.begin() + end ) );
+
+      for( auto l = actual.offsets[i]; l < actual.offsets[i+1]; l++ )
+      {
+        auto j = actual.indices[l];
+
+        ALEPH_ASSERT_THROW( std::binary_search( actual.indices.begin() + static_cast<std::ptrdiff_t>( actual.offsets[j] ),
+                                                actual.indices.begin() + static_cast<std::ptrdiff_t>( actual.offsets[j+1] ),
+                                                i ) );
+      }
+    }
+
+    // Requesting more neighbours than points reports all points
+    Forest( pointCloud, 1, 32, 0 ).neighbourSearch( static_cast<unsigned>( 2 * n ), actual );
+
+    for( std::size_t i = 0; i < n; i++ )
+      ALEPH_ASSERT_EQUAL( actual.degree(i), n );
+  }
 
   ALEPH_TEST_END();
 }
@@ -94,4 +479,16 @@ int main()
 {
   test<float> ();
   test<double>();
+
+  testBruteForce<float> ();
+  testBruteForce<double>();
+
+  testCoverTree<float> ();
+  testCoverTree<double>();
+
+  testKDTree<float> ();
+  testKDTree<double>();
+
+  testRandomProjectionForest<float> ();
+  testRandomProjectionForest<double>();
 }
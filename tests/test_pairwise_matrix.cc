@@ -0,0 +1,253 @@
+#include <tests/Base.hh>
+
+#include <aleph/persistenceDiagrams/PairwiseMatrix.hh>
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
+#include <aleph/persistenceDiagrams/distances/Hausdorff.hh>
+#include <aleph/persistenceDiagrams/distances/Wasserstein.hh>
+
+#include <aleph/persistenceDiagrams/kernels/MultiScaleKernel.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cmath>
+#include <cstdio>
+
+template <class T> std::vector< aleph::PersistenceDiagram<T> > makeDiagrams( std::size_t n )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+  std::uniform_int_distribution<std::size_t> size( 0, 10 );
+
+  std::vector< aleph::PersistenceDiagram<T> > diagrams( n );
+
+  for( auto&& D : diagrams )
+  {
+    auto m = size( rng );
+
+    for( std::size_t i = 0; i < m; i++ )
+    {
+      auto x = coordinate( rng );
+      auto y = coordinate( rng );
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+  }
+
+  return diagrams;
+}
+
+/** Distance functor that preprocesses diagrams by sorting their persistence values */
+template <class T> struct SortedPersistence
+{
+  std::atomic<unsigned>* preparations;
+
+  std::vector<T> prepare( const aleph::PersistenceDiagram<T>& D ) const
+  {
+    ++( *preparations );
+
+    std::vector<T> persistence;
+
+    for( auto&& p : D )
+      persistence.push_back( p.persistence() );
+
+    std::sort( persistence.begin(), persistence.end() );
+    return persistence;
+  }
+
+  T operator()( const std::vector<T>& x, const std::vector<T>& y ) const
+  {
+    T d = T();
+
+    for( std::size_t i = 0; i < std::max( x.size(), y.size() ); i++ )
+    {
+      auto a = i < x.size() ? x[i] : T();
+      auto b = i < y.size() ? y[i] : T();
+      d     += std::abs( a - b );
+    }
+
+    return d;
+  }
+};
+
+/** Checks whether a function throws a runtime error */
+template <class F> bool throwsRuntimeError( F f )
+{
+  try
+  {
+    f();
+  }
+  catch( std::runtime_error& )
+  {
+    return true;
+  }
+
+  return false;
+}
+
+template <class T> void testSerial()
+{
+  ALEPH_TEST_BEGIN( "Pairwise matrix: comparison with serial calculation" );
+
+  using PersistenceDiagram = aleph::PersistenceDiagram<T>;
+
+  auto diagrams = makeDiagrams<T>( 23 );
+
+  auto wasserstein = [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+  {
+    return aleph::distances::wassersteinDistance( D1, D2, T(2) );
+  };
+
+  auto kernel = [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+  {
+    return aleph::multiScaleKernel( D1, D2, 1.0 );
+  };
+
+  for( std::size_t tileSize : { 1, 4, 16, 100 } )
+  {
+    auto W = aleph::pairwiseMatrix( diagrams, wasserstein, std::string(), tileSize );
+    auto K = aleph::pairwiseMatrix( diagrams, kernel,      std::string(), tileSize );
+
+    ALEPH_ASSERT_EQUAL( W.numRows(), diagrams.size() );
+    ALEPH_ASSERT_EQUAL( K.numRows(), diagrams.size() );
+
+    for( std::size_t i = 0; i < diagrams.size(); i++ )
+    {
+      for( std::size_t j = 0; j < diagrams.size(); j++ )
+      {
+        ALEPH_ASSERT_EQUAL( W(i,j), wasserstein( diagrams[std::min(i,j)], diagrams[std::max(i,j)] ) );
+        ALEPH_ASSERT_EQUAL( K(i,j), kernel( diagrams[std::min(i,j)], diagrams[std::max(i,j)] ) );
+      }
+
+      ALEPH_ASSERT_EQUAL( W(i,i), T() );
+    }
+  }
+
+  {
+    std::vector<PersistenceDiagram> empty;
+    auto M = aleph::pairwiseMatrix( empty, wasserstein );
+
+    ALEPH_ASSERT_EQUAL( M.numRows(), 0 );
+  }
+
+  ALEPH_ASSERT_THROW( throwsRuntimeError( [&] () { aleph::pairwiseMatrix( diagrams, wasserstein, std::string(), 0 ); } ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testPreparation()
+{
+  ALEPH_TEST_BEGIN( "Pairwise matrix: preprocessing" );
+
+  auto diagrams = makeDiagrams<T>( 37 );
+
+  std::atomic<unsigned> preparations( 0 );
+  SortedPersistence<T> f{ &preparations };
+
+  auto M = aleph::pairwiseMatrix( diagrams, f, std::string(), 5 );
+
+  ALEPH_ASSERT_EQUAL( preparations.load(), diagrams.size() );
+
+  for( std::size_t i = 0; i < diagrams.size(); i++ )
+  {
+    for( std::size_t j = i; j < diagrams.size(); j++ )
+      ALEPH_ASSERT_EQUAL( M(i,j), f( f.prepare( diagrams[i] ), f.prepare( diagrams[j] ) ) );
+  }
+
+  // The distance functors cache points and kd-trees per diagram, which
+  // must not change any of the distances.
+  aleph::distances::BottleneckDistance<T> bottleneck;
+  aleph::distances::WassersteinDistance<T> wasserstein( T(2), 0.01 );
+
+  auto B = aleph::pairwiseMatrix( diagrams, bottleneck );
+  auto W = aleph::pairwiseMatrix( diagrams, wasserstein );
+
+  for( std::size_t i = 0; i < diagrams.size(); i++ )
+  {
+    for( std::size_t j = i; j < diagrams.size(); j++ )
+    {
+      ALEPH_ASSERT_EQUAL( B(i,j), aleph::distances::bottleneckDistance( diagrams[i], diagrams[j] ) );
+      ALEPH_ASSERT_EQUAL( W(i,j), aleph::distances::wassersteinDistance( diagrams[i], diagrams[j], T(2), 0.01 ) );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testCheckpoint()
+{
+  ALEPH_TEST_BEGIN( "Pairwise matrix: checkpoint" );
+
+  using PersistenceDiagram = aleph::PersistenceDiagram<T>;
+
+  auto diagrams   = makeDiagrams<T>( 29 );
+  auto checkpoint = std::string( CMAKE_CURRENT_BINARY_DIR ) + "/test_pairwise_matrix.bin";
+
+  std::remove( checkpoint.c_str() );
+
+  std::atomic<unsigned> evaluations( 0 );
+
+  auto hausdorff = [&evaluations] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2 )
+  {
+    ++evaluations;
+    return aleph::distances::hausdorffDistance( D1, D2 );
+  };
+
+  auto M = aleph::pairwiseMatrix( diagrams, hausdorff, checkpoint, 4 );
+
+  ALEPH_ASSERT_EQUAL( evaluations.load(), diagrams.size() * ( diagrams.size() + 1 ) / 2 );
+
+  // Resuming from a complete checkpoint must not evaluate the functor
+  // at all but result in the same matrix.
+  evaluations = 0;
+
+  auto N = aleph::pairwiseMatrix( diagrams, hausdorff, checkpoint, 4 );
+
+  ALEPH_ASSERT_EQUAL( evaluations.load(), 0 );
+
+  for( std::size_t i = 0; i < diagrams.size(); i++ )
+  {
+    for( std::size_t j = 0; j < diagrams.size(); j++ )
+      ALEPH_ASSERT_EQUAL( M(i,j), N(i,j) );
+  }
+
+  // A checkpoint of a different matrix must not be used
+  ALEPH_ASSERT_THROW( throwsRuntimeError( [&] () { aleph::pairwiseMatrix( diagrams, hausdorff, checkpoint, 5 ); } ) );
+
+  diagrams.pop_back();
+  ALEPH_ASSERT_THROW( throwsRuntimeError( [&] () { aleph::pairwiseMatrix( diagrams, hausdorff, checkpoint, 4 ); } ) );
+
+  std::remove( checkpoint.c_str() );
+
+  // A checkpoint that cannot be written must be reported before any
+  // value is calculated.
+  evaluations = 0;
+
+  auto unwritable = std::string( CMAKE_CURRENT_BINARY_DIR ) + "/missing/test_pairwise_matrix.bin";
+
+  ALEPH_ASSERT_THROW( throwsRuntimeError( [&] () { aleph::pairwiseMatrix( diagrams, hausdorff, unwritable, 4 ); } ) );
+  ALEPH_ASSERT_EQUAL( evaluations.load(), 0 );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testSerial<float> ();
+  testSerial<double>();
+
+  testPreparation<float> ();
+  testPreparation<double>();
+
+  testCheckpoint<float> ();
+  testCheckpoint<double>();
+}
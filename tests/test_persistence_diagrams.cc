@@ -14,10 +14,12 @@
 
 #include <aleph/persistenceDiagrams/kernels/KernelEmbedding.hh>
 #include <aleph/persistenceDiagrams/kernels/MultiScaleKernel.hh>
+#include <aleph/persistenceDiagrams/kernels/SlicedWasserstein.hh>
 
 #include <algorithm>
 #include <limits>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 #include <cmath>
@@ -81,8 +83,106 @@ template <class T> void testBottleneckDistance()
     ALEPH_ASSERT_THROW( d12 > T() );
     ALEPH_ASSERT_THROW( d21 > T() );
 
+    // Matching (3.9,9.9) to the diagonal is cheaper than matching it to
+    // (3.9,4.0), which would result in a distance of 5.9.
     ALEPH_ASSERT_EQUAL( d12, d21 );
-    ALEPH_ASSERT_EQUAL( d21, T(9.9)-T(4.0) );
+    ALEPH_ASSERT_THROW( std::abs( d21 - T(3.0) ) < T(1e-6) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+/**
+  Infinity distance of a different type, which forces the Bottleneck
+  distance to use the explicit bipartite graph. This serves as the
+  reference for the geometric matching.
+*/
+
+template <class T> struct ReferenceDistance : aleph::geometry::distances::InfinityDistance<T>
+{
+};
+
+template <class T> void testBottleneckDistanceGeometric()
+{
+  ALEPH_TEST_BEGIN( "Bottleneck distance: geometric matching" );
+
+  using Diagram = aleph::PersistenceDiagram<T>;
+  using namespace aleph::distances;
+
+  std::mt19937 rng( 42 );
+
+  // Coordinates on a coarse grid result in many ties between distances,
+  // as well as in points on the diagonal
+  auto makeDiagram = [&rng] ( unsigned n, bool coarse )
+  {
+    std::uniform_real_distribution<T> distribution( T(0), T(10) );
+    Diagram D;
+
+    for( unsigned i = 0; i < n; i++ )
+    {
+      auto x = distribution( rng );
+      auto y = distribution( rng );
+
+      if( coarse )
+      {
+        x = T( int(x) );
+        y = T( int(y) );
+      }
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+
+    return D;
+  };
+
+  for( unsigned k = 0; k < 60; k++ )
+  {
+    auto D1 = makeDiagram( k % 23,       k % 3 == 0 );
+    auto D2 = makeDiagram( ( 7 * k ) % 19, k % 3 == 0 );
+
+    auto expected = bottleneckDistance<T, ReferenceDistance<T> >( D1, D2 );
+    auto actual   = bottleneckDistance( D1, D2 );
+
+    ALEPH_ASSERT_EQUAL( actual, expected );
+    ALEPH_ASSERT_EQUAL( bottleneckDistance( D2, D1 ), actual );
+
+    for( double epsilon : { 0.01, 0.1, 0.5 } )
+    {
+      auto approximation = bottleneckDistance( D1, D2, epsilon );
+
+      ALEPH_ASSERT_THROW( approximation >= actual );
+      ALEPH_ASSERT_THROW( static_cast<double>( approximation ) <= ( 1.0 + epsilon ) * static_cast<double>( actual ) + 1e-6 );
+    }
+  }
+
+  // Essential points are only matched among each other
+  {
+    auto D1 = makeDiagram( 10, false );
+    auto D2 = D1;
+
+    D1.add( T(1) );
+    D1.add( T(4) );
+    D2.add( T(2) );
+
+    ALEPH_ASSERT_EQUAL( bottleneckDistance( D1, D2 ), std::numeric_limits<T>::infinity() );
+
+    D2.add( T(7) );
+
+    ALEPH_ASSERT_EQUAL( bottleneckDistance( D1, D2 ), T(3) );
+  }
+
+  // Empty diagrams
+  {
+    Diagram D1;
+    Diagram D2;
+
+    D2.add( T(1), T(3) );
+
+    ALEPH_ASSERT_EQUAL( bottleneckDistance( D1, D1 ), T(0) );
+    ALEPH_ASSERT_EQUAL( bottleneckDistance( D1, D2 ), T(1) );
   }
 
   ALEPH_TEST_END();
@@ -315,6 +415,146 @@ template <class T> void testPointSetDistances()
   ALEPH_TEST_END();
 }
 
+template <class T> void testSlicedWasserstein()
+{
+  ALEPH_TEST_BEGIN( "Sliced Wasserstein distance and kernel" );
+
+  using PersistenceDiagram = aleph::PersistenceDiagram<T>;
+
+  // Single point -----------------------------------------------------
+  //
+  // For a point (0,1) and an empty diagram, every direction contributes
+  // |<p - proj(p), theta>|, whose average over all directions is known
+  // analytically.
+
+  {
+    PersistenceDiagram D1;
+    PersistenceDiagram D2;
+
+    D1.add( T(0), T(1) );
+
+    ALEPH_ASSERT_THROW( std::abs( aleph::slicedWassersteinDistance( D1, D2, 1 ) - 0.5 ) < 1e-12 );
+    ALEPH_ASSERT_THROW( std::abs( aleph::slicedWassersteinDistance( D1, D2, 1000 ) - std::sqrt( 2.0 ) / M_PI ) < 1e-3 );
+
+    // Points with infinite coordinates are ignored
+    auto D3 = D1;
+    D3.add( T(0), std::numeric_limits<T>::infinity() );
+
+    ALEPH_ASSERT_EQUAL( aleph::slicedWassersteinDistance( D1, D2 ), aleph::slicedWassersteinDistance( D3, D2 ) );
+  }
+
+  // Reference calculation --------------------------------------------
+  //
+  // Compares the sorted merge with an explicit projection of both point
+  // sets for every direction.
+
+  auto reference = [] ( const PersistenceDiagram& D1, const PersistenceDiagram& D2, unsigned directions )
+  {
+    double result = 0.0;
+
+    for( unsigned k = 0; k < directions; k++ )
+    {
+      auto theta = -M_PI / 2 + M_PI * k / directions;
+      auto c     = std::cos( theta );
+      auto s     = std::sin( theta );
+
+      std::vector<double> a;
+      std::vector<double> b;
+
+      for( auto&& p : D1 )
+      {
+        auto x = static_cast<double>( p.x() );
+        auto y = static_cast<double>( p.y() );
+
+        a.push_back( c * x + s * y );
+        b.push_back( ( c + s ) * ( x + y ) / 2 );
+      }
+
+      for( auto&& q : D2 )
+      {
+        auto x = static_cast<double>( q.x() );
+        auto y = static_cast<double>( q.y() );
+
+        b.push_back( c * x + s * y );
+        a.push_back( ( c + s ) * ( x + y ) / 2 );
+      }
+
+      std::sort( a.begin(), a.end() );
+      std::sort( b.begin(), b.end() );
+
+      for( std::size_t i = 0; i < a.size(); i++ )
+        result += std::abs( a[i] - b[i] );
+    }
+
+    return result / directions;
+  };
+
+  for( unsigned directions : { 1, 7, 50 } )
+  {
+    auto D1 = createRandomPersistenceDiagram<T>( 37 );
+    auto D2 = createRandomPersistenceDiagram<T>( 23 );
+
+    aleph::SlicedWasserstein<T> sw( directions );
+
+    auto d12 = sw.distance( D1, D2 );
+    auto d21 = sw.distance( D2, D1 );
+
+    ALEPH_ASSERT_THROW( std::abs( d12 - reference( D1, D2, directions ) ) < 1e-9 );
+    ALEPH_ASSERT_EQUAL( d12, d21 );
+    ALEPH_ASSERT_EQUAL( sw.distance( D1, D1 ), 0.0 );
+
+    // Every direction is bounded by twice the 1-Wasserstein distance with
+    // respect to the Euclidean distance between points.
+    auto w = aleph::distances::wassersteinDistance( D1, D2, T(1) );
+    ALEPH_ASSERT_THROW( d12 <= 2 * std::sqrt( 2.0 ) * w * ( 1 + 1e-5 ) );
+  }
+
+  // Kernel & Gram matrix ---------------------------------------------
+
+  {
+    std::vector<PersistenceDiagram> diagrams;
+
+    for( unsigned i = 0; i < 17; i++ )
+      diagrams.push_back( createRandomPersistenceDiagram<T>( i ) );
+
+    auto K = aleph::slicedWassersteinKernelMatrix( diagrams, 0.5, 20 );
+
+    ALEPH_ASSERT_EQUAL( K.numRows(), diagrams.size() );
+
+    for( std::size_t i = 0; i < diagrams.size(); i++ )
+    {
+      ALEPH_ASSERT_EQUAL( K(i,i), 1.0 );
+
+      for( std::size_t j = i + 1; j < diagrams.size(); j++ )
+      {
+        auto k = aleph::slicedWassersteinKernel( diagrams[i], diagrams[j], 0.5, 20 );
+        auto d = aleph::slicedWassersteinDistance( diagrams[i], diagrams[j], 20 );
+
+        ALEPH_ASSERT_EQUAL( K(i,j), k );
+        ALEPH_ASSERT_THROW( std::abs( k - std::exp( -d / 0.5 ) ) < 1e-12 );
+        ALEPH_ASSERT_THROW( k > 0.0 && k <= 1.0 );
+      }
+    }
+  }
+
+  {
+    bool thrown = false;
+
+    try
+    {
+      aleph::SlicedWasserstein<T> sw( 0 );
+    }
+    catch( std::runtime_error& )
+    {
+      thrown = true;
+    }
+
+    ALEPH_ASSERT_THROW( thrown );
+  }
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testWassersteinDistance()
 {
   ALEPH_TEST_BEGIN( "Wasserstein distance" );
@@ -358,11 +598,103 @@ template <class T> void testWassersteinDistance()
   ALEPH_TEST_END();
 }
 
+template <class T> void testWassersteinDistanceAuction()
+{
+  ALEPH_TEST_BEGIN( "Wasserstein distance: auction" );
+
+  using Diagram = aleph::PersistenceDiagram<T>;
+  using namespace aleph::distances;
+
+  std::mt19937 rng( 23 );
+
+  auto makeDiagram = [&rng] ( unsigned n, bool coarse )
+  {
+    std::uniform_real_distribution<T> distribution( T(0), T(10) );
+    Diagram D;
+
+    for( unsigned i = 0; i < n; i++ )
+    {
+      auto x = distribution( rng );
+      auto y = distribution( rng );
+
+      if( coarse )
+      {
+        x = T( int(x) );
+        y = T( int(y) );
+      }
+
+      if( x > y )
+        std::swap( x, y );
+
+      D.add( x, y );
+    }
+
+    return D;
+  };
+
+  // The exact assignment solver serves as the exact reference
+  for( unsigned k = 0; k < 30; k++ )
+  {
+    auto D1 = makeDiagram( 1 + k % 17,       k % 3 == 0 );
+    auto D2 = makeDiagram( ( 5 * k ) % 13, k % 3 == 0 );
+
+    for( T power : { T(1), T(2), T(3.5) } )
+    {
+      auto expected = wassersteinDistance( D1, D2, power );
+
+      for( double epsilon : { 0.001, 0.1 } )
+      {
+        auto d12 = wassersteinDistance( D1, D2, power, epsilon );
+        auto d21 = wassersteinDistance( D2, D1, power, epsilon );
+
+        for( auto d : { d12, d21 } )
+        {
+          ALEPH_ASSERT_THROW( static_cast<double>( d ) >= static_cast<double>( expected ) * ( 1.0 - 1e-4 ) );
+          ALEPH_ASSERT_THROW( static_cast<double>( d ) <= static_cast<double>( expected ) * ( 1.0 + epsilon ) + 1e-4 );
+        }
+      }
+    }
+  }
+
+  // Essential points are only matched among each other
+  {
+    auto D1 = makeDiagram( 10, false );
+    auto D2 = D1;
+
+    D1.add( T(1) );
+    D1.add( T(4) );
+    D2.add( T(2) );
+
+    ALEPH_ASSERT_EQUAL( wassersteinDistance( D1, D2, T(1), 0.01 ), std::numeric_limits<T>::infinity() );
+
+    D2.add( T(7) );
+
+    ALEPH_ASSERT_THROW( std::abs( wassersteinDistance( D1, D2, T(1), 0.01 ) - T(4) ) < T(1e-4) );
+    ALEPH_ASSERT_THROW( std::abs( wassersteinDistance( D1, D2, T(2), 0.01 ) - T( std::sqrt(10) ) ) < T(1e-4) );
+  }
+
+  // Empty diagrams
+  {
+    Diagram D1;
+    Diagram D2;
+
+    D2.add( T(1), T(3) );
+
+    ALEPH_ASSERT_EQUAL( wassersteinDistance( D1, D1, T(1), 0.01 ), T(0) );
+    ALEPH_ASSERT_EQUAL( wassersteinDistance( D1, D2, T(1), 0.01 ), T(1) );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   testBottleneckDistance<float> ();
   testBottleneckDistance<double>();
 
+  testBottleneckDistanceGeometric<float> ();
+  testBottleneckDistanceGeometric<double>();
+
   testEnvelope<float> ();
   testEnvelope<double>();
 
@@ -387,6 +719,12 @@ int main(int, char**)
   testPointSetDistances<float> ();
   testPointSetDistances<double>();
 
+  testSlicedWasserstein<float> ();
+  testSlicedWasserstein<double>();
+
   testWassersteinDistance<float> ();
   testWassersteinDistance<double>();
+
+  testWassersteinDistanceAuction<float> ();
+  testWassersteinDistanceAuction<double>();
 }
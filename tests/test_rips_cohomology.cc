@@ -0,0 +1,217 @@
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+#include <aleph/geometry/distances/Manhattan.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/algorithms/RipsCohomology.hh>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cmath>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace distances;
+using namespace persistentHomology::algorithms;
+
+/**
+  Compares the persistence diagrams of the implicit engine to the ones
+  of an explicit Vietoris--Rips complex. Points of zero persistence as
+  well as empty diagrams are ignored.
+*/
+
+template <class T> void compareDiagrams( std::vector< PersistenceDiagram<T> > expected,
+                                         std::vector< PersistenceDiagram<T> > actual )
+{
+  auto prepare = [] ( std::vector< PersistenceDiagram<T> >& diagrams )
+  {
+    for( auto&& D : diagrams )
+    {
+      D.removeDiagonal();
+      std::sort( D.begin(), D.end() );
+    }
+
+    diagrams.erase( std::remove_if( diagrams.begin(), diagrams.end(),
+                                    [] ( const PersistenceDiagram<T>& D )
+                                    {
+                                      return D.empty();
+                                    } ),
+                    diagrams.end() );
+  };
+
+  prepare( expected );
+  prepare( actual );
+
+  ALEPH_ASSERT_EQUAL( expected.size(), actual.size() );
+
+  for( std::size_t i = 0; i < expected.size(); i++ )
+  {
+    ALEPH_ASSERT_EQUAL( expected[i].dimension(), actual[i].dimension() );
+    ALEPH_ASSERT_EQUAL( expected[i].size(),      actual[i].size() );
+    ALEPH_ASSERT_THROW( expected[i] == actual[i] );
+  }
+}
+
+template <class T, class Distance> void testPointCloud( const PointCloud<T>& pointCloud, T epsilon, unsigned dimension )
+{
+  using Wrapper = BruteForce<PointCloud<T>, Distance>;
+
+  Wrapper wrapper( pointCloud );
+
+  auto K        = buildVietorisRipsComplex( wrapper, epsilon, dimension );
+  auto expected = calculatePersistenceDiagrams( K );
+
+  RipsCohomology<T> ripsCohomology( pointCloud, Distance(), epsilon );
+
+  auto actual = ripsCohomology( dimension );
+
+  ALEPH_ASSERT_THROW( actual.empty() == false );
+  ALEPH_ASSERT_EQUAL( actual.front().betti(), expected.front().betti() );
+
+  compareDiagrams( expected, actual );
+}
+
+template <class T> void testIris()
+{
+  ALEPH_TEST_BEGIN( "Implicit Rips cohomology: Iris data" );
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  ALEPH_ASSERT_THROW( pointCloud.size() == 150 );
+
+  testPointCloud<T, Euclidean<T> >( pointCloud, T(0.5), 2 );
+  testPointCloud<T, Euclidean<T> >( pointCloud, T(1.0), 3 );
+  testPointCloud<T, Manhattan<T> >( pointCloud, T(1.0), 3 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testCircle()
+{
+  ALEPH_TEST_BEGIN( "Implicit Rips cohomology: noisy circle" );
+
+  unsigned n = 64;
+
+  std::mt19937 rng( 42 );
+  std::normal_distribution<T> noise( T(0), T(0.05) );
+
+  PointCloud<T> pointCloud( n, 2 );
+
+  for( unsigned i = 0; i < n; i++ )
+  {
+    auto phi = T( 2 * M_PI * i / n );
+
+    pointCloud.set( i, { std::cos( phi ) + noise( rng ),
+                         std::sin( phi ) + noise( rng ) } );
+  }
+
+  testPointCloud<T, Euclidean<T> >( pointCloud, T(2.5), 2 );
+  testPointCloud<T, Euclidean<T> >( pointCloud, T(0.8), 3 );
+
+  // Without any threshold, the circle must be killed eventually, so
+  // the only essential feature is the connected component.
+  RipsCohomology<T> ripsCohomology( pointCloud, Euclidean<T>() );
+
+  auto diagrams = ripsCohomology( 2 );
+
+  ALEPH_ASSERT_EQUAL( diagrams.size(), 2 );
+  ALEPH_ASSERT_EQUAL( diagrams[0].betti(), 1 );
+  ALEPH_ASSERT_EQUAL( diagrams[1].betti(), 0 );
+
+  // The circle itself should be the most persistent feature.
+  auto&& D = diagrams[1];
+
+  auto it = std::max_element( D.begin(), D.end(),
+                              [] ( const typename PersistenceDiagram<T>::Point& p,
+                                   const typename PersistenceDiagram<T>::Point& q )
+                              {
+                                return p.persistence() < q.persistence();
+                              } );
+
+  ALEPH_ASSERT_THROW( it != D.end() );
+  ALEPH_ASSERT_THROW( it->persistence() > T(1) );
+
+  // A finite threshold that exceeds all distances stores neighbour
+  // lists instead of the distance matrix, but the co-faces have to be
+  // enumerated in the same order.
+  RipsCohomology<T> sparseRipsCohomology( pointCloud, Euclidean<T>(), T(3) );
+
+  auto sparseDiagrams = sparseRipsCohomology( 3 );
+  diagrams            = ripsCohomology( 3 );
+
+  ALEPH_ASSERT_EQUAL( sparseDiagrams.size(), diagrams.size() );
+
+  for( std::size_t i = 0; i < diagrams.size(); i++ )
+  {
+    ALEPH_ASSERT_EQUAL( sparseDiagrams[i].size(), diagrams[i].size() );
+    ALEPH_ASSERT_THROW( std::equal( diagrams[i].begin(), diagrams[i].end(), sparseDiagrams[i].begin() ) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testDistanceMatrix()
+{
+  ALEPH_TEST_BEGIN( "Implicit Rips cohomology: distance matrix" );
+
+  // Square with side length 1 and diagonal length 2; this gives rise to
+  // a single cycle that is born at 1 and dies at 2.
+  math::SymmetricMatrix<T> D( 4 );
+
+  D(0,1) = T(1);
+  D(1,2) = T(1);
+  D(2,3) = T(1);
+  D(3,0) = T(1);
+  D(0,2) = T(2);
+  D(1,3) = T(2);
+
+  RipsCohomology<T> ripsCohomology( D );
+
+  auto diagrams = ripsCohomology( 2 );
+
+  ALEPH_ASSERT_EQUAL( diagrams.size(), 2 );
+
+  ALEPH_ASSERT_EQUAL( diagrams[0].size(),  4 );
+  ALEPH_ASSERT_EQUAL( diagrams[0].betti(), 1 );
+
+  ALEPH_ASSERT_EQUAL( diagrams[1].size(),  1 );
+  ALEPH_ASSERT_EQUAL( diagrams[1].betti(), 0 );
+
+  ALEPH_ASSERT_THROW( *diagrams[1].begin() == typename PersistenceDiagram<T>::Point( T(1), T(2) ) );
+
+  // With a threshold that does not permit the diagonals, the cycle is
+  // essential.
+  RipsCohomology<T> truncatedRipsCohomology( D, T(1.5) );
+
+  diagrams = truncatedRipsCohomology( 3 );
+
+  ALEPH_ASSERT_EQUAL( diagrams.size(), 2 );
+  ALEPH_ASSERT_EQUAL( diagrams[1].size(),  1 );
+  ALEPH_ASSERT_EQUAL( diagrams[1].betti(), 1 );
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testDistanceMatrix<float> ();
+  testDistanceMatrix<double>();
+
+  testCircle<float> ();
+  testCircle<double>();
+
+  testIris<float> ();
+  testIris<double>();
+}
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -230,6 +231,65 @@ template <class Data, class Vertex> void expanderComparison()
   ALEPH_TEST_END();
 }
 
+template <class Data, class Vertex> void parallelExpansion()
+{
+  ALEPH_TEST_BEGIN( "Parallel Rips expansion" );
+
+  using Simplex           = Simplex<Data, Vertex>;
+  using SimplicialComplex = SimplicialComplex<Simplex>;
+
+  // Random graph with non-contiguous vertex indices and random weights;
+  // some edges refer to vertices that are not part of the complex.
+  std::vector<Simplex> simplices;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+
+  unsigned n = 150;
+
+  for( unsigned i = 0; i < n; i++ )
+    simplices.push_back( Simplex( Vertex( 2 * i + 1 ), Data( distribution( rng ) / 10 ) ) );
+
+  for( unsigned i = 0; i < n + 10; i++ )
+  {
+    for( unsigned j = i + 1; j < n + 10; j++ )
+    {
+      if( distribution( rng ) < 0.15 )
+        simplices.push_back( Simplex( { Vertex( 2 * i + 1 ), Vertex( 2 * j + 1 ) }, Data( distribution( rng ) ) ) );
+    }
+  }
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+  RipsExpander<SimplicialComplex> ripsExpander;
+
+  auto compare = [] ( SimplicialComplex& K1, SimplicialComplex& K2 )
+  {
+    K1.sort( aleph::topology::filtrations::Data<Simplex>() );
+    K2.sort( aleph::topology::filtrations::Data<Simplex>() );
+
+    ALEPH_ASSERT_EQUAL( K1.size(), K2.size() );
+    ALEPH_ASSERT_THROW( K1 == K2 );
+
+    for( auto it1 = K1.begin(), it2 = K2.begin(); it1 != K1.end(); ++it1, ++it2 )
+      ALEPH_ASSERT_EQUAL( it1->data(), it2->data() );
+  };
+
+  for( unsigned dimension : { 0u, 1u, 2u, 4u } )
+  {
+    auto K1 = ripsExpander( K, dimension );
+    auto K2 = ripsExpander.expand( K, dimension );
+
+    compare( K1, K2 );
+
+    auto K3 = ripsExpander.assignMaximumWeight( ripsExpander( K, dimension ) );
+    auto K4 = ripsExpander.expand( K, dimension, true );
+
+    compare( K3, K4 );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main()
 {
   triangle<double, unsigned>();
@@ -251,4 +311,9 @@ int main()
   expanderComparison<double, short   >();
   expanderComparison<float,  unsigned>();
   expanderComparison<float,  short   >();
+
+  parallelExpansion<double, unsigned>();
+  parallelExpansion<double, short   >();
+  parallelExpansion<float,  unsigned>();
+  parallelExpansion<float,  short   >();
 }
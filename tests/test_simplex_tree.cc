@@ -0,0 +1,150 @@
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <tests/Base.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplexTree.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+#include <aleph/topology/Spine.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+using namespace topology;
+
+template <class T> void testSimple()
+{
+  ALEPH_TEST_BEGIN( "Simplex tree: simple complex" );
+
+  using Simplex = Simplex<T, unsigned>;
+
+  SimplexTree<Simplex> S;
+
+  ALEPH_ASSERT_THROW( S.empty() );
+  ALEPH_ASSERT_THROW( S.insert( Simplex( {0,1,2}, T(2) ) ) );
+  ALEPH_ASSERT_THROW( S.insert( Simplex( {0,1,2}, T(3) ) ) == false );
+  ALEPH_ASSERT_THROW( S.insert( Simplex( {2,3},   T(1) ) ) );
+
+  // Missing faces are created with the data of their coface
+  ALEPH_ASSERT_EQUAL( S.size(), 9 );
+  ALEPH_ASSERT_EQUAL( S.dimension(), 2 );
+  ALEPH_ASSERT_EQUAL( S.data( {0,1} ), T(2) );
+  ALEPH_ASSERT_EQUAL( S.data( {2} ),   T(2) );
+  ALEPH_ASSERT_EQUAL( S.data( {3} ),   T(1) );
+
+  ALEPH_ASSERT_THROW( S.contains( {1,2} ) );
+  ALEPH_ASSERT_THROW( S.contains( {1,3} ) == false );
+  ALEPH_ASSERT_THROW( S.contains( {4} )   == false );
+  ALEPH_EXPECT_EXCEPTION( S.data( {0,3} ), std::runtime_error );
+
+  S.setData( {0}, T(0) );
+  ALEPH_ASSERT_EQUAL( S.data( {0} ), T(0) );
+
+  {
+    std::vector<Simplex> cofaces;
+    S.cofaces( {2}, std::back_inserter( cofaces ) );
+
+    std::set<Simplex> expected = { {0,2}, {1,2}, {2,3}, {0,1,2} };
+
+    ALEPH_ASSERT_EQUAL( cofaces.size(), expected.size() );
+    ALEPH_ASSERT_THROW( std::set<Simplex>( cofaces.begin(), cofaces.end() ) == expected );
+  }
+
+  {
+    std::vector<Simplex> cofacets;
+    S.cofaces( {2}, std::back_inserter( cofacets ), 1 );
+
+    std::set<Simplex> expected = { {0,2}, {1,2}, {2,3} };
+    ALEPH_ASSERT_THROW( std::set<Simplex>( cofacets.begin(), cofacets.end() ) == expected );
+  }
+
+  {
+    std::vector<Simplex> cofaces;
+    S.cofaces( {0,2}, std::back_inserter( cofaces ) );
+
+    ALEPH_ASSERT_EQUAL( cofaces.size(), 1 );
+    ALEPH_ASSERT_THROW( cofaces.front() == Simplex( {0,1,2} ) );
+    ALEPH_ASSERT_EQUAL( cofaces.front().data(), T(2) );
+
+    cofaces.clear();
+    S.cofaces( {0,3}, std::back_inserter( cofaces ) );
+
+    ALEPH_ASSERT_THROW( cofaces.empty() );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRips()
+{
+  ALEPH_TEST_BEGIN( "Simplex tree: Vietoris--Rips complex" );
+
+  auto pointCloud = load<T>( CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" ) );
+
+  BruteForce<PointCloud<T>, distances::Euclidean<T> > wrapper( pointCloud );
+
+  auto K = buildVietorisRipsComplex( wrapper, T(0.5), 3 );
+
+  using Simplex = typename decltype(K)::ValueType;
+
+  auto S = makeSimplexTree( K );
+
+  ALEPH_ASSERT_EQUAL( S.size(), K.size() );
+  ALEPH_ASSERT_EQUAL( S.dimension(), K.dimension() );
+
+  for( auto&& simplex : K )
+    ALEPH_ASSERT_EQUAL( S.data( simplex ), simplex.data() );
+
+  // Round trip; the complex of the Vietoris--Rips expansion is sorted by
+  // its weights, so the order needs to coincide.
+  auto L = makeSimplicialComplex( S );
+
+  ALEPH_ASSERT_EQUAL( K.size(), L.size() );
+  ALEPH_ASSERT_THROW( std::equal( K.begin(), K.end(), L.begin() ) );
+
+  {
+    std::vector<Simplex> simplices;
+    S.simplices( std::back_inserter( simplices ) );
+
+    ALEPH_ASSERT_EQUAL( simplices.size(), K.size() );
+  }
+
+  // Cofacets need to coincide with the ones of the coface map that is
+  // used for calculating the spine of a complex.
+  auto cofaceMap = buildCofaceMap( K );
+
+  for( auto&& simplex : K )
+  {
+    std::vector<Simplex> cofacets;
+    S.cofaces( simplex, std::back_inserter( cofacets ), 1 );
+
+    auto&& expected = cofaceMap.at( simplex );
+
+    ALEPH_ASSERT_EQUAL( cofacets.size(), expected.size() );
+
+    for( auto&& cofacet : cofacets )
+      ALEPH_ASSERT_THROW( expected.find( cofacet ) != expected.end() );
+  }
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testSimple<float> ();
+  testSimple<double>();
+
+  testRips<float> ();
+  testRips<double>();
+}
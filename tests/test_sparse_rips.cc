@@ -0,0 +1,259 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/SparseVietorisRipsComplex.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace aleph;
+using namespace containers;
+using namespace geometry;
+
+template <class T> PointCloud<T> makeCircle( std::size_t n )
+{
+  PointCloud<T> pointCloud( n, 2 );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> angles( T(0), T(2 * M_PI) );
+  std::normal_distribution<T> noise( T(0), T(0.05) );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto phi = angles( rng );
+    pointCloud.set( i, { std::cos( phi ) + noise( rng ), std::sin( phi ) + noise( rng ) } );
+  }
+
+  return pointCloud;
+}
+
+template <class T> void testGreedyPermutation()
+{
+  ALEPH_TEST_BEGIN( "Greedy permutation" );
+
+  using Distance = geometry::distances::Euclidean<T>;
+  using Traits   = geometry::distances::Traits<Distance>;
+
+  std::size_t n = 500;
+
+  PointCloud<T> pointCloud( n, 3 );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(1) );
+
+  for( std::size_t i = 0; i < n; i++ )
+    pointCloud.set( i, { distribution( rng ), distribution( rng ), distribution( rng ) } );
+
+  // Duplicate points must appear at the end of the permutation
+  {
+    auto p = pointCloud[3];
+
+    pointCloud.set( 17, p.begin(), p.end() );
+    pointCloud.set( 42, p.begin(), p.end() );
+  }
+
+  std::vector<T> radii;
+  auto order = greedyPermutation<Distance>( pointCloud, radii );
+
+  ALEPH_ASSERT_EQUAL( order.size(), n );
+  ALEPH_ASSERT_EQUAL( radii.size(), n );
+
+  // Quadratic reference implementation with the same tie-breaking
+  // rules as the greedy permutation
+  Distance dist;
+  Traits traits;
+
+  auto distance = [&] ( std::size_t i, std::size_t j )
+  {
+    auto&& p = pointCloud[i];
+    auto&& q = pointCloud[j];
+
+    return static_cast<T>( traits.from( dist( p.data(), q.data(), p.size() ) ) );
+  };
+
+  std::vector<T> nearest( n, std::numeric_limits<T>::infinity() );
+  std::vector<bool> inserted( n );
+
+  std::size_t c = 0;
+
+  for( std::size_t k = 0; k < n; k++ )
+  {
+    ALEPH_ASSERT_EQUAL( order[k], c );
+    ALEPH_ASSERT_EQUAL( radii[c], nearest[c] );
+
+    inserted[c] = true;
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      if( !inserted[i] )
+        nearest[i] = std::min( nearest[i], distance( c, i ) );
+    }
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      if( !inserted[i] && ( inserted[c] || nearest[i] > nearest[c] ) )
+        c = i;
+    }
+  }
+
+  ALEPH_ASSERT_EQUAL( order[n-2], 17 );
+  ALEPH_ASSERT_EQUAL( order[n-1], 42 );
+  ALEPH_ASSERT_EQUAL( radii[42],   T(0) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testEdges()
+{
+  ALEPH_TEST_BEGIN( "Sparse Vietoris--Rips complex edges" );
+
+  using Distance          = geometry::distances::Euclidean<T>;
+  using NearestNeighbours = BruteForce<PointCloud<T>, Distance>;
+
+  auto pointCloud = makeCircle<T>( 200 );
+  T epsilon       = T(0.5);
+
+  auto K = buildSparseVietorisRipsComplex<Distance>( pointCloud, epsilon, 1 );
+  auto L = buildVietorisRipsComplex( NearestNeighbours( pointCloud ), T(10), 1 );
+
+  ALEPH_ASSERT_THROW( K.size() < L.size() );
+
+  // Every edge appears no earlier than in the Vietoris--Rips complex,
+  // and no later than the approximation factor permits
+  for( auto&& s : K )
+  {
+    if( s.dimension() != 1 )
+      continue;
+
+    auto it = L.find( s );
+
+    ALEPH_ASSERT_THROW( it != L.end() );
+    ALEPH_ASSERT_THROW( s.data() >= it->data() );
+    ALEPH_ASSERT_THROW( s.data() <= ( 1 + epsilon ) * it->data() * ( 1 + 10 * std::numeric_limits<T>::epsilon() ) );
+  }
+
+  // A threshold only removes the simplices with larger scales
+  T threshold = T(0.5);
+
+  auto M = buildSparseVietorisRipsComplex<Distance>( pointCloud, epsilon, 1, threshold );
+
+  std::size_t m = 0;
+
+  for( auto&& s : K )
+  {
+    if( s.data() <= threshold )
+      ++m;
+  }
+
+  ALEPH_ASSERT_THROW( M.size() < K.size() );
+  ALEPH_ASSERT_EQUAL( M.size(), m );
+
+  for( auto&& s : M )
+    ALEPH_ASSERT_THROW( K.find( s ) != K.end() && K.find( s )->data() == s.data() );
+
+  // Without any edges, only the vertices remain
+  auto N = buildSparseVietorisRipsComplex<Distance>( pointCloud, epsilon, 0 );
+
+  ALEPH_ASSERT_EQUAL( N.size(), pointCloud.size() );
+
+  for( auto&& s : N )
+    ALEPH_ASSERT_EQUAL( s.dimension(), 0 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testDiagrams()
+{
+  ALEPH_TEST_BEGIN( "Sparse Vietoris--Rips complex persistence diagrams" );
+
+  using Distance          = geometry::distances::Euclidean<T>;
+  using NearestNeighbours = BruteForce<PointCloud<T>, Distance>;
+
+  auto pointCloud = makeCircle<T>( 60 );
+
+  auto L  = buildVietorisRipsComplex( NearestNeighbours( pointCloud ), T(10), 2 );
+  auto D2 = calculatePersistenceDiagrams( L );
+
+  for( T epsilon : { T(0.1), T(0.5), T(1.0) } )
+  {
+    auto K  = buildSparseVietorisRipsComplex<Distance>( pointCloud, epsilon, 2 );
+    auto D1 = calculatePersistenceDiagrams( K );
+
+    ALEPH_ASSERT_THROW( K.size() <= L.size() );
+
+    // The sorted death times of the connected components are
+    // interleaved, because all of them are born at zero.
+    auto deaths = [] ( const PersistenceDiagram<T>& D )
+    {
+      std::vector<T> result;
+
+      for( auto&& p : D )
+        result.push_back( p.y() );
+
+      std::sort( result.begin(), result.end(), std::greater<T>() );
+      return result;
+    };
+
+    auto deaths1 = deaths( D1.front() );
+    auto deaths2 = deaths( D2.front() );
+
+    ALEPH_ASSERT_EQUAL( deaths1.size(), deaths2.size() );
+
+    for( std::size_t i = 1; i < deaths1.size(); i++ )
+    {
+      ALEPH_ASSERT_THROW( deaths1[i] >= deaths2[i] * ( 1 - 10 * std::numeric_limits<T>::epsilon() ) );
+      ALEPH_ASSERT_THROW( deaths1[i] <= deaths2[i] * ( 1 + epsilon ) * ( 1 + 10 * std::numeric_limits<T>::epsilon() ) );
+    }
+
+    // Multiplicative interleaving corresponds to an additive one for
+    // the logarithms of the diagrams.
+    auto logarithm = [] ( PersistenceDiagram<T> D )
+    {
+      PersistenceDiagram<T> E;
+
+      D.removeDiagonal();
+
+      for( auto&& p : D )
+        E.add( std::log( p.x() ), std::log( p.y() ) );
+
+      return E;
+    };
+
+    ALEPH_ASSERT_EQUAL( D1.size(), 2 );
+    ALEPH_ASSERT_EQUAL( D2.size(), 2 );
+
+    auto E1 = logarithm( D1.back() );
+    auto E2 = logarithm( D2.back() );
+
+    ALEPH_ASSERT_THROW( E1.size() > 0 );
+    ALEPH_ASSERT_THROW( aleph::distances::bottleneckDistance( E1, E2 ) <= std::log( 1 + epsilon ) + T(1e-4) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+int main()
+{
+  testGreedyPermutation<float> ();
+  testGreedyPermutation<double>();
+
+  testEdges<float> ();
+  testEdges<double>();
+
+  testDiagrams<float> ();
+  testDiagrams<double>();
+}
@@ -1,7 +1,9 @@
 #include <tests/Base.hh>
 
+#include <aleph/topology/DenseUnionFind.hh>
 #include <aleph/topology/UnionFind.hh>
 
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <typeinfo>
@@ -64,6 +66,47 @@ template <class T> void test()
   ALEPH_TEST_END();
 }
 
+template <class T> void testDense()
+{
+  ALEPH_TEST_BEGIN( "Dense Union--Find (" + std::string( typeid(T).name() ) + ")" );
+
+  DenseUnionFind<T> uf( 9 );
+
+  ALEPH_ASSERT_EQUAL( uf.size(), 9 );
+
+  for( T vertex = 0; vertex < 9; vertex++ )
+    ALEPH_ASSERT_EQUAL( uf.find(vertex), vertex );
+
+  uf.merge(1,2);
+  uf.merge(5,6);
+  uf.merge(5,8);
+
+  ALEPH_ASSERT_EQUAL( uf.find(1), uf.find(2) );
+  ALEPH_ASSERT_EQUAL( uf.find(5), uf.find(6) );
+  ALEPH_ASSERT_EQUAL( uf.find(6), uf.find(8) );
+  ALEPH_ASSERT_THROW( uf.find(1) != uf.find(5) );
+
+  uf.merge(3,4);
+
+  auto root = uf.merge(1,5);
+
+  ALEPH_ASSERT_EQUAL( root, uf.find(2) );
+  ALEPH_ASSERT_EQUAL( root, uf.find(8) );
+  ALEPH_ASSERT_EQUAL( uf.merge(2,6), root );
+
+  std::vector<T> roots;
+  uf.roots( std::back_inserter( roots ) );
+
+  ALEPH_ASSERT_EQUAL( roots.size(), 4 );
+  ALEPH_ASSERT_THROW( std::is_sorted( roots.begin(), roots.end() ) );
+  ALEPH_ASSERT_THROW( std::find( roots.begin(), roots.end(), root )       != roots.end() );
+  ALEPH_ASSERT_THROW( std::find( roots.begin(), roots.end(), T(0) )       != roots.end() );
+  ALEPH_ASSERT_THROW( std::find( roots.begin(), roots.end(), T(7) )       != roots.end() );
+  ALEPH_ASSERT_THROW( std::find( roots.begin(), roots.end(), uf.find(3) ) != roots.end() );
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   test<unsigned short>();
@@ -72,4 +115,8 @@ int main(int, char**)
   test<unsigned>      ();
   test<long>          ();
   test<unsigned long> ();
+
+  testDense<unsigned short>();
+  testDense<unsigned>      ();
+  testDense<std::size_t>   ();
 }